@@ -201,6 +201,8 @@
 #define MATSOLVERMATLAB          'matlab'
 #define MATSOLVERPETSC           'petsc'
 #define MATSOLVERBAS             'bas'
+#define MATSOLVERPARILU          'parilu'
+#define MATSOLVERSUPERNODAL      'supernodal'
 #define MATSOLVERCUSPARSE        'cusparse'
 #define MATSOLVERCUDA            'cuda'
 #define MATSOLVERHIPSPARSE       'hipsparse'
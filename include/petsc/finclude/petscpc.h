@@ -93,6 +93,7 @@
 #define PCHPDDM 'hpddm'
 #define PCH2OPUS 'h2opus'
 #define PCMPI 'mpi'
+#define PCFSAI 'fsai'
 
 #define PCMGType PetscEnum
 #define PCMGCycleType PetscEnum
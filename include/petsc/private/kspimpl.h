@@ -348,6 +348,22 @@ static inline PetscErrorCode KSP_MatMult(KSP ksp, Mat A, Vec x, Vec y)
   PetscFunctionReturn(PETSC_SUCCESS);
 }
 
+/* y = A x with the optional (x,y), ||x|| and ||y|| of MatMultDot(), with the operator transposed for transpose solves */
+static inline PetscErrorCode KSP_MatMultDot(KSP ksp, Mat A, Vec x, Vec y, PetscScalar *xdoty, PetscReal *xnorm, PetscReal *ynorm)
+{
+  PetscFunctionBegin;
+  if (ksp->transpose_solve) {
+    PetscCall(MatMultTranspose(A, x, y));
+    if (xdoty) PetscCall(VecDotBegin(x, y, xdoty));
+    if (xnorm) PetscCall(VecNormBegin(x, NORM_2, xnorm));
+    if (ynorm) PetscCall(VecNormBegin(y, NORM_2, ynorm));
+    if (xdoty) PetscCall(VecDotEnd(x, y, xdoty));
+    if (xnorm) PetscCall(VecNormEnd(x, NORM_2, xnorm));
+    if (ynorm) PetscCall(VecNormEnd(y, NORM_2, ynorm));
+  } else PetscCall(MatMultDot(A, x, y, xdoty, xnorm, ynorm));
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
+
 static inline PetscErrorCode KSP_MatMultTranspose(KSP ksp, Mat A, Vec x, Vec y)
 {
   PetscFunctionBegin;
@@ -217,6 +217,7 @@ struct _MatOps {
   /*150*/
   PetscErrorCode (*transposesymbolic)(Mat, Mat *);
   PetscErrorCode (*eliminatezeros)(Mat, PetscBool);
+  PetscErrorCode (*multdot)(Mat, Vec, Vec, PetscScalar *, PetscReal *, PetscReal *);
 };
 /*
     If you add MatOps entries above also add them to the MATOP enum
@@ -387,6 +388,20 @@ struct _MatStash {
   MPI_Datatype    blocktype;
   size_t          blocktype_size;
   InsertMode     *insertmode; /* Pointer to check mat->insertmode and set upon message arrival in case no local values have been set. */
+
+  /* The following variables are used for flushing the stash during MatSetValues(), see MatStashFlush_Private() */
+  PetscInt       flush_size;        /* flush the stash when it has this many blocks, 0 to never flush */
+  PetscMPIInt    flush_tag[2];      /* tags of the flushed messages, alternating between assemblies */
+  PetscMPIInt    flush_parity;      /* number of assemblies done modulo 2 */
+  PetscMPIInt   *flush_nsent;       /* number of flushed messages sent to each rank in this assembly */
+  PetscSegBuffer flush_sendreqs;    /* requests of the flushed messages */
+  PetscSegBuffer flush_sendbufs;    /* buffers of the flushed messages, one per flush */
+  MatStashFrame *flush_recvframes;  /* flushed messages received in this assembly */
+  PetscMPIInt    flush_nrecvs;      /* number of flushed messages received so far */
+  PetscMPIInt    flush_maxrecvs;    /* allocated length of flush_recvframes */
+  PetscMPIInt    flush_nexpect;     /* number of flushed messages to receive, known after MatStashScatterBegin_Private() */
+  PetscMPIInt    flush_recvframe;   /* index of the flushed message being processed */
+  PetscInt       flush_recvframe_i; /* index of block within that message */
 };
 
 #if !defined(PETSC_HAVE_MPIUNI)
@@ -403,6 +418,7 @@ PETSC_INTERN PetscErrorCode MatStashValuesRowBlocked_Private(MatStash *, PetscIn
 PETSC_INTERN PetscErrorCode MatStashValuesColBlocked_Private(MatStash *, PetscInt, PetscInt, const PetscInt[], const PetscScalar[], PetscInt, PetscInt, PetscInt);
 PETSC_INTERN PetscErrorCode MatStashScatterBegin_Private(Mat, MatStash *, PetscInt *);
 PETSC_INTERN PetscErrorCode MatStashScatterGetMesg_Private(MatStash *, PetscMPIInt *, PetscInt **, PetscInt **, PetscScalar **, PetscInt *);
+PETSC_INTERN PetscErrorCode MatStashFlush_Private(Mat, MatStash *, PetscInt *);
 PETSC_INTERN PetscErrorCode MatGetInfo_External(Mat, MatInfoType, MatInfo *);
 
 typedef struct {
@@ -421,6 +437,48 @@ typedef struct {
 } Mat_CompressedRow;
 PETSC_EXTERN PetscErrorCode MatCheckCompressedRow(Mat, PetscInt, Mat_CompressedRow *, PetscInt *, PetscInt, PetscReal);
 
+/* Level sets of one sweep of a sparse triangular solve; the rows of a level only depend on rows of earlier levels */
+typedef struct {
+  PetscInt  nlevels; /* number of levels */
+  PetscInt *ptr;     /* rows of level k are rows[ptr[k]] to rows[ptr[k+1]-1] */
+  PetscInt *rows;
+  PetscInt *i, *j;   /* dependencies of each row when the sweep does not follow the stored rows of the factor */
+  PetscInt *idx;     /* location of each dependency in the values of the factor */
+} Mat_SolveLevels;
+PETSC_INTERN PetscErrorCode MatSolveLevelsUse_Private(Mat, PetscBool *);
+PETSC_INTERN PetscErrorCode MatSolveLevelsCreate_Private(PetscInt, const PetscInt[], const PetscInt[], const PetscInt[], PetscBool, PetscBool, Mat_SolveLevels *);
+PETSC_INTERN PetscErrorCode MatSolveLevelsReset_Private(Mat_SolveLevels *);
+PETSC_INTERN PetscErrorCode MatSolveLevelsView_Private(const Mat_SolveLevels *, const char[], PetscViewer);
+
+/* Coloring of the rows of a sequential matrix for multicolor MatSOR(); rows of the same color are not coupled */
+typedef struct {
+  PetscBool        setup;        /* -mat_sor_multicolor has been checked for this nonzero structure */
+  PetscObjectState nonzerostate; /* nonzero state of the matrix when it was checked */
+  PetscInt         ncolors;      /* number of colors, 0 if multicolor MatSOR() is not used */
+  PetscInt        *ptr;          /* rows of color c are rows[ptr[c]] to rows[ptr[c+1]-1] */
+  PetscInt        *rows;
+  PetscInt        *color; /* color of each row */
+} Mat_SORColors;
+PETSC_INTERN PetscErrorCode MatSORColorsSetUp_Private(Mat, PetscInt, const PetscInt[], const PetscInt[], Mat_SORColors *);
+PETSC_INTERN PetscErrorCode MatSORColorsReset_Private(Mat_SORColors *);
+PETSC_INTERN PetscErrorCode MatSORColorsView_Private(const Mat_SORColors *, PetscViewer);
+
+/* Entries of MatSetValues() staged by each OpenMP thread with MAT_THREADED_ASSEMBLY, merged at assembly with the COO routines */
+typedef struct {
+  PetscInt        nthreads;
+  PetscSegBuffer *segi, *segj, *segv; /* entries staged by each thread since the last assembly */
+  PetscCount      ncoo;               /* the COO pattern given to MatSetPreallocationCOO() at the last merge, ncoo is -1 before the first merge */
+  PetscInt       *coo_i, *coo_j;
+  PetscScalar    *coo_v;
+} Mat_ThreadedAssembly;
+PETSC_INTERN PetscErrorCode MatThreadedAssemblyCreate_Private(Mat, Mat_ThreadedAssembly **);
+PETSC_INTERN PetscErrorCode MatThreadedAssemblyDestroy_Private(Mat_ThreadedAssembly **);
+PETSC_INTERN PetscErrorCode MatThreadedAssemblySetValues_Private(Mat, PetscInt, const PetscInt[], PetscInt, const PetscInt[], const PetscScalar[]);
+PETSC_INTERN PetscErrorCode MatThreadedAssemblyMerge_Private(Mat, MatAssemblyType);
+
+/* block structure of AIJ matrices detected at assembly with -mat_detect_block_size */
+PETSC_INTERN PetscErrorCode MatDetectBlockSize_Private(Mat);
+
 typedef struct { /* used by MatCreateRedundantMatrix() for reusing matredundant */
   PetscInt     nzlocal, nsends, nrecvs;
   PetscMPIInt *send_rank, *recv_rank;
@@ -490,6 +548,8 @@ struct _p_Mat {
   char                *solvertype;
   PetscBool            checksymmetryonassembly, checknullspaceonassembly;
   PetscReal            checksymmetrytol;
+  PetscBool            detectblocksize, detectblocksizeconvert; /* -mat_detect_block_size, detect the block structure in MatAssemblyEnd() */
+  PetscObjectState     detectblocksizestate;                    /* nonzero state of the last detection */
   Mat                  schur;                            /* Schur complement matrix */
   MatFactorSchurStatus schur_status;                     /* status of the Schur complement matrix */
   Mat_Redundant       *redundant;                        /* used by MatCreateRedundantMatrix() */
@@ -506,6 +566,7 @@ struct _p_Mat {
   PetscBool            transupdated;            /* whether or not the explicitly generated transpose is up-to-date */
   char                *factorprefix;            /* the prefix to use with factored matrix that is created */
   PetscBool            hash_active;             /* indicates MatSetValues() is being handled by hashing */
+  Mat_ThreadedAssembly *threadedassembly;       /* set by MAT_THREADED_ASSEMBLY */
 };
 
 PETSC_INTERN PetscErrorCode MatAXPY_Basic(Mat, PetscScalar, Mat, MatStructure);
@@ -525,6 +586,7 @@ PETSC_INTERN PetscErrorCode MatZeroRowsMapLocal_Private(Mat, PetscInt, const Pet
 */
 PETSC_INTERN PetscErrorCode MatView_Binary_BlockSizes(Mat, PetscViewer);
 PETSC_INTERN PetscErrorCode MatLoad_Binary_BlockSizes(Mat, PetscViewer);
+PETSC_INTERN PetscErrorCode MatLoad_Binary_BalanceRows(Mat, PetscViewer, PetscInt *[]);
 
 /*
     Object for partitioning graphs
@@ -1643,6 +1705,7 @@ PETSC_EXTERN PetscErrorCode PetscCDGetASMBlocks(const PetscCoarsenData *, const
 PETSC_EXTERN PetscErrorCode MatFDColoringApply_AIJ(Mat, MatFDColoring, Vec, void *);
 
 PETSC_EXTERN PetscLogEvent MAT_Mult;
+PETSC_EXTERN PetscLogEvent MAT_MultDot;
 PETSC_EXTERN PetscLogEvent MAT_MultAdd;
 PETSC_EXTERN PetscLogEvent MAT_MultTranspose;
 PETSC_EXTERN PetscLogEvent MAT_MultHermitianTranspose;
@@ -1729,6 +1792,7 @@ PETSC_EXTERN PetscLogEvent MAT_HIPSPARSECopyFromGPU;
 PETSC_EXTERN PetscLogEvent MAT_HIPSPARSEGenerateTranspose;
 PETSC_EXTERN PetscLogEvent MAT_HIPSPARSESolveAnalysis;
 PETSC_EXTERN PetscLogEvent MAT_SetValuesBatch;
+PETSC_EXTERN PetscLogEvent MAT_Autotune;
 PETSC_EXTERN PetscLogEvent MAT_ViennaCLCopyToGPU;
 PETSC_EXTERN PetscLogEvent MAT_DenseCopyToGPU;
 PETSC_EXTERN PetscLogEvent MAT_DenseCopyFromGPU;
@@ -22,6 +22,7 @@ PETSC_EXTERN PetscLogEvent PETSCSF_SectSF;
 PETSC_EXTERN PetscLogEvent PETSCSF_RemoteOff;
 PETSC_EXTERN PetscLogEvent PETSCSF_Pack;
 PETSC_EXTERN PetscLogEvent PETSCSF_Unpack;
+PETSC_EXTERN PetscLogEvent PETSCSF_AutoSelect;
 
 typedef enum {
   PETSCSF_ROOT2LEAF = 0,
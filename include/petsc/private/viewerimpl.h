@@ -31,6 +31,8 @@ struct _p_PetscViewer {
   PetscBool         setupcalled;
 };
 
+PETSC_EXTERN PetscErrorCode PetscViewerBinaryReadMMap_Private(PetscViewer, PetscInt, PetscDataType, void **, PetscObject);
+
 PETSC_INTERN PetscMPIInt Petsc_Viewer_keyval;
 PETSC_INTERN PetscMPIInt Petsc_Viewer_Stdout_keyval;
 PETSC_INTERN PetscMPIInt Petsc_Viewer_Stderr_keyval;
@@ -64,6 +64,13 @@ typedef const char *MatType;
 #define MATAIJSELL                   "aijsell"
 #define MATSEQAIJSELL                "seqaijsell"
 #define MATMPIAIJSELL                "mpiaijsell"
+#define MATSEQAIJOMP                 "seqaijomp"
+#define MATSEQAIJDELTA               "seqaijdelta"
+#define MATSEQAIJAUTO                "seqaijauto"
+#define MATSEQAIJMERGE               "seqaijmerge"
+#define MATAIJMIXED                  "aijmixed"
+#define MATSEQAIJMIXED               "seqaijmixed"
+#define MATMPIAIJMIXED               "mpiaijmixed"
 #define MATAIJMKL                    "aijmkl"
 #define MATSEQAIJMKL                 "seqaijmkl"
 #define MATMPIAIJMKL                 "mpiaijmkl"
@@ -165,6 +172,8 @@ typedef const char *MatSolverType;
 #define MATSOLVERMATLAB       "matlab"
 #define MATSOLVERPETSC        "petsc"
 #define MATSOLVERBAS          "bas"
+#define MATSOLVERPARILU       "parilu"
+#define MATSOLVERSUPERNODAL   "supernodal"
 #define MATSOLVERCUSPARSE     "cusparse"
 #define MATSOLVERCUDA         "cuda"
 #define MATSOLVERHIPSPARSE    "hipsparse"
@@ -264,6 +273,7 @@ typedef const char *MatProductAlgorithm;
 #define MATPRODUCTALGORITHMBHEAP           "btheap"
 #define MATPRODUCTALGORITHMLLCONDENSED     "llcondensed"
 #define MATPRODUCTALGORITHMROWMERGE        "rowmerge"
+#define MATPRODUCTALGORITHMTHREADED        "threaded"
 #define MATPRODUCTALGORITHMOUTERPRODUCT    "outerproduct"
 #define MATPRODUCTALGORITHMATB             "at*b"
 #define MATPRODUCTALGORITHMRAP             "rap"
@@ -636,7 +646,8 @@ typedef enum {
   MAT_FORM_EXPLICIT_TRANSPOSE     = 24,
   MAT_STRUCTURAL_SYMMETRY_ETERNAL = 25,
   MAT_SPD_ETERNAL                 = 26,
-  MAT_OPTION_MAX                  = 27
+  MAT_THREADED_ASSEMBLY           = 27,
+  MAT_OPTION_MAX                  = 28
 } MatOption;
 
 PETSC_EXTERN const char *const *MatOptions;
@@ -702,6 +713,7 @@ PETSC_EXTERN PetscErrorCode MatDenseGetSubMatrix(Mat, PetscInt, PetscInt, PetscI
 PETSC_EXTERN PetscErrorCode MatDenseRestoreSubMatrix(Mat, Mat *);
 
 PETSC_EXTERN PetscErrorCode MatMult(Mat, Vec, Vec);
+PETSC_EXTERN PetscErrorCode MatMultDot(Mat, Vec, Vec, PetscScalar *, PetscReal *, PetscReal *);
 PETSC_EXTERN PetscErrorCode MatMultDiagonalBlock(Mat, Vec, Vec);
 PETSC_EXTERN PetscErrorCode MatMultAdd(Mat, Vec, Vec, Vec);
 PETSC_EXTERN PetscErrorCode MatMultTranspose(Mat, Vec, Vec);
@@ -757,6 +769,7 @@ PETSC_EXTERN PetscErrorCode MatIsStructurallySymmetricKnown(Mat, PetscBool *, Pe
 PETSC_EXTERN PetscErrorCode MatIsSPDKnown(Mat, PetscBool *, PetscBool *);
 PETSC_EXTERN PetscErrorCode MatMissingDiagonal(Mat, PetscBool *, PetscInt *);
 PETSC_EXTERN PetscErrorCode MatLoad(Mat, PetscViewer);
+PETSC_EXTERN PetscErrorCode MatLoadSetRowWeightFunction(Mat, PetscErrorCode (*)(Mat, PetscInt, PetscInt, const PetscInt[], PetscReal[], void *), void *);
 
 PETSC_EXTERN PetscErrorCode MatGetRowIJ(Mat, PetscInt, PetscBool, PetscBool, PetscInt *, const PetscInt *[], const PetscInt *[], PetscBool *);
 PETSC_EXTERN PetscErrorCode MatRestoreRowIJ(Mat, PetscInt, PetscBool, PetscBool, PetscInt *, const PetscInt *[], const PetscInt *[], PetscBool *);
@@ -2012,7 +2025,8 @@ typedef enum {
   MATOP_MPICONCATENATESEQ     = 144,
   MATOP_DESTROYSUBMATRICES    = 145,
   MATOP_TRANSPOSE_SOLVE       = 146,
-  MATOP_GET_VALUES_LOCAL      = 147
+  MATOP_GET_VALUES_LOCAL      = 147,
+  MATOP_MULT_DOT              = 152
 } MatOperation;
 PETSC_EXTERN PetscErrorCode MatSetOperation(Mat, MatOperation, void (*)(void));
 PETSC_EXTERN PetscErrorCode MatGetOperation(Mat, MatOperation, void (**)(void));
@@ -502,3 +502,7 @@ PETSC_EXTERN PetscErrorCode PCAmgXGetResources(PC, void *);
 
 PETSC_EXTERN PetscErrorCode PCMatSetApplyOperation(PC, MatOperation);
 PETSC_EXTERN PetscErrorCode PCMatGetApplyOperation(PC, MatOperation *);
+
+PETSC_EXTERN PetscErrorCode PCFSAISetLevels(PC, PetscInt);
+PETSC_EXTERN PetscErrorCode PCFSAISetThreshold(PC, PetscReal);
+PETSC_EXTERN PetscErrorCode PCFSAISetAdaptive(PC, PetscBool, PetscInt, PetscInt, PetscReal);
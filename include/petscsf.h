@@ -131,6 +131,8 @@ PETSC_EXTERN PetscErrorCode PetscSFWindowSetFlavorType(PetscSF, PetscSFWindowFla
 PETSC_EXTERN PetscErrorCode PetscSFWindowGetFlavorType(PetscSF, PetscSFWindowFlavorType *);
 PETSC_EXTERN PetscErrorCode PetscSFWindowSetInfo(PetscSF, MPI_Info);
 PETSC_EXTERN PetscErrorCode PetscSFWindowGetInfo(PetscSF, MPI_Info *);
+PETSC_EXTERN PetscErrorCode PetscSFBasicSetPartitionSize(PetscSF, PetscInt);
+PETSC_EXTERN PetscErrorCode PetscSFBasicGetPartitionSize(PetscSF, PetscInt *);
 PETSC_EXTERN PetscErrorCode PetscSFSetRankOrder(PetscSF, PetscBool);
 PETSC_EXTERN PetscErrorCode PetscSFSetGraph(PetscSF, PetscInt, PetscInt, PetscInt *, PetscCopyMode, PetscSFNode *, PetscCopyMode);
 PETSC_EXTERN PetscErrorCode PetscSFSetGraphWithPattern(PetscSF, PetscLayout, PetscSFPattern);
@@ -171,6 +173,12 @@ PETSC_EXTERN PetscErrorCode PetscSFReduceBegin(PetscSF, MPI_Datatype, const void
 PETSC_EXTERN PetscErrorCode PetscSFReduceEnd(PetscSF, MPI_Datatype, const void *, void *, MPI_Op) PETSC_ATTRIBUTE_MPI_POINTER_WITH_TYPE(3, 2) PETSC_ATTRIBUTE_MPI_POINTER_WITH_TYPE(4, 2);
 PETSC_EXTERN PetscErrorCode PetscSFReduceWithMemTypeBegin(PetscSF, MPI_Datatype, PetscMemType, const void *, PetscMemType, void *, MPI_Op) PETSC_ATTRIBUTE_MPI_POINTER_WITH_TYPE(4, 2) PETSC_ATTRIBUTE_MPI_POINTER_WITH_TYPE(6, 2);
 
+/* Several broadcasts or reductions on different star forests with a single round of messages */
+PETSC_EXTERN PetscErrorCode PetscSFBcastBatchBegin(PetscInt, const PetscSF[], const MPI_Datatype[], const void *const[], void *const[], MPI_Op);
+PETSC_EXTERN PetscErrorCode PetscSFBcastBatchEnd(PetscInt, const PetscSF[], const MPI_Datatype[], const void *const[], void *const[], MPI_Op);
+PETSC_EXTERN PetscErrorCode PetscSFReduceBatchBegin(PetscInt, const PetscSF[], const MPI_Datatype[], const void *const[], void *const[], MPI_Op);
+PETSC_EXTERN PetscErrorCode PetscSFReduceBatchEnd(PetscInt, const PetscSF[], const MPI_Datatype[], const void *const[], void *const[], MPI_Op);
+
 /* Atomically modifies (using provided operation) rootdata using leafdata from each leaf, value at root at time of modification is returned in leafupdate. */
 PETSC_EXTERN PetscErrorCode PetscSFFetchAndOpBegin(PetscSF, MPI_Datatype, void *, const void *, void *, MPI_Op) PETSC_ATTRIBUTE_MPI_POINTER_WITH_TYPE(3, 2) PETSC_ATTRIBUTE_MPI_POINTER_WITH_TYPE(4, 2) PETSC_ATTRIBUTE_MPI_POINTER_WITH_TYPE(5, 2);
 PETSC_EXTERN PetscErrorCode PetscSFFetchAndOpEnd(PetscSF, MPI_Datatype, void *, const void *, void *, MPI_Op) PETSC_ATTRIBUTE_MPI_POINTER_WITH_TYPE(3, 2) PETSC_ATTRIBUTE_MPI_POINTER_WITH_TYPE(4, 2) PETSC_ATTRIBUTE_MPI_POINTER_WITH_TYPE(5, 2);
@@ -31,6 +31,8 @@ typedef const char *PetscSFType;
 #define PETSCSFGATHER     "gather"
 #define PETSCSFALLTOALL   "alltoall"
 #define PETSCSFWINDOW     "window"
+#define PETSCSFNODE       "node"
+#define PETSCSFAUTO       "auto"
 
 /*S
    PetscSFNode - specifier of owner and index
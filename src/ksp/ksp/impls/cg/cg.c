@@ -97,6 +97,23 @@ static PetscErrorCode KSPSetUp_CG(KSP ksp)
 */
 #define VecXDot(x, y, a) (((cg->type) == (KSP_CG_HERMITIAN)) ? VecDot(x, y, a) : VecTDot(x, y, a))
 
+/*
+     y <- A x together with VecXDot(x, y, a); MatMultDot() computes the Hermitian product in a single pass, which is the
+     only one needed for real scalars
+*/
+#if defined(PETSC_USE_COMPLEX)
+static PetscErrorCode KSPCGMatMultTDot_Private(KSP ksp, Mat A, Vec x, Vec y, PetscScalar *a)
+{
+  PetscFunctionBegin;
+  PetscCall(KSP_MatMult(ksp, A, x, y));
+  PetscCall(VecTDot(x, y, a));
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
+  #define KSP_MatMultXDot(ksp, A, x, y, a) (((cg->type) == (KSP_CG_HERMITIAN)) ? KSP_MatMultDot(ksp, A, x, y, a, NULL, NULL) : KSPCGMatMultTDot_Private(ksp, A, x, y, a))
+#else
+  #define KSP_MatMultXDot(ksp, A, x, y, a) KSP_MatMultDot(ksp, A, x, y, a, NULL, NULL)
+#endif
+
 /*
      KSPSolve_CG - This routine actually applies the conjugate gradient method
 
@@ -245,8 +262,7 @@ static PetscErrorCode KSPSolve_CG(KSP ksp)
       }
     }
     dpiold = dpi;
-    PetscCall(KSP_MatMult(ksp, Amat, P, W)); /*     w <- Ap                          */
-    PetscCall(VecXDot(P, W, &dpi));          /*     dpi <- p'w                       */
+    PetscCall(KSP_MatMultXDot(ksp, Amat, P, W, &dpi)); /*     w <- Ap, dpi <- p'w              */
     KSPCheckDot(ksp, dpi);
     betaold = beta;
 
@@ -404,9 +420,8 @@ static PetscErrorCode KSPSolve_CG_SingleReduction(KSP ksp)
     break;
   case KSP_NORM_NATURAL:
     PetscCall(KSP_PCApply(ksp, R, Z)); /*    z <- Br                           */
-    PetscCall(KSP_MatMult(ksp, Amat, Z, S));
-    PetscCall(VecXDot(Z, S, &delta)); /*    delta <- z'*A*z = r'*B*A*B*r      */
-    PetscCall(VecXDot(Z, R, &beta));  /*    beta <- z'*r                      */
+    PetscCall(KSP_MatMultXDot(ksp, Amat, Z, S, &delta)); /*    delta <- z'*A*z = r'*B*A*B*r      */
+    PetscCall(VecXDot(Z, R, &beta));                     /*    beta <- z'*r                      */
     KSPCheckDot(ksp, beta);
     dp = PetscSqrtReal(PetscAbsScalar(beta)); /*    dp <- r'*z = r'*B*r = e'*A'*B*A*e */
     break;
@@ -425,9 +440,8 @@ static PetscErrorCode KSPSolve_CG_SingleReduction(KSP ksp)
 
   if (ksp->normtype != KSP_NORM_PRECONDITIONED && (ksp->normtype != KSP_NORM_NATURAL)) { PetscCall(KSP_PCApply(ksp, R, Z)); /*    z <- Br                           */ }
   if (ksp->normtype != KSP_NORM_NATURAL) {
-    PetscCall(KSP_MatMult(ksp, Amat, Z, S));
-    PetscCall(VecXDot(Z, S, &delta)); /*    delta <- z'*A*z = r'*B*A*B*r      */
-    PetscCall(VecXDot(Z, R, &beta));  /*    beta <- z'*r                      */
+    PetscCall(KSP_MatMultXDot(ksp, Amat, Z, S, &delta)); /*    delta <- z'*A*z = r'*B*A*B*r      */
+    PetscCall(VecXDot(Z, R, &beta));                     /*    beta <- z'*r                      */
     KSPCheckDot(ksp, beta);
   }
 
@@ -459,8 +473,7 @@ static PetscErrorCode KSPSolve_CG_SingleReduction(KSP ksp)
     }
     dpiold = dpi;
     if (!i) {
-      PetscCall(KSP_MatMult(ksp, Amat, P, W)); /*    w <- Ap                           */
-      PetscCall(VecXDot(P, W, &dpi));          /*    dpi <- p'w                        */
+      PetscCall(KSP_MatMultXDot(ksp, Amat, P, W, &dpi)); /*    w <- Ap, dpi <- p'w               */
     } else {
       PetscCall(VecAYPX(W, beta / betaold, S));                 /*    w <- Ap                           */
       dpi = delta - beta * beta * dpiold / (betaold * betaold); /*    dpi <- p'w                        */
@@ -480,8 +493,7 @@ static PetscErrorCode KSPSolve_CG_SingleReduction(KSP ksp)
     PetscCall(VecAXPY(R, -a, W)); /*    r <- r - aw                       */
     if (ksp->normtype == KSP_NORM_PRECONDITIONED && ksp->chknorm < i + 2) {
       PetscCall(KSP_PCApply(ksp, R, Z)); /*    z <- Br                           */
-      PetscCall(KSP_MatMult(ksp, Amat, Z, S));
-      PetscCall(VecNorm(Z, NORM_2, &dp)); /*    dp <- z'*z                        */
+      PetscCall(KSP_MatMultDot(ksp, Amat, Z, S, NULL, &dp, NULL)); /*    s <- Az, dp <- z'*z               */
       KSPCheckNorm(ksp, dp);
     } else if (ksp->normtype == KSP_NORM_UNPRECONDITIONED && ksp->chknorm < i + 2) {
       PetscCall(VecNorm(R, NORM_2, &dp)); /*    dp <- r'*r                        */
@@ -24,7 +24,7 @@ static PetscErrorCode KSPSolve_PIPECG(KSP ksp)
   PetscReal   dp = 0.0;
   Vec         X, B, Z, P, W, Q, U, M, N, R, S;
   Mat         Amat, Pmat;
-  PetscBool   diagonalscale;
+  PetscBool   diagonalscale, havedelta = PETSC_FALSE;
 
   PetscFunctionBegin;
   PetscCall(PCGetDiagonalScale(ksp->pc, &diagonalscale));
@@ -56,10 +56,10 @@ static PetscErrorCode KSPSolve_PIPECG(KSP ksp)
 
   switch (ksp->normtype) {
   case KSP_NORM_PRECONDITIONED:
-    PetscCall(VecNormBegin(U, NORM_2, &dp)); /*     dp <- u'*u = e'*A'*B'*B*A'*e'     */
-    PetscCall(PetscCommSplitReductionBegin(PetscObjectComm((PetscObject)U)));
-    PetscCall(KSP_MatMult(ksp, Amat, U, W)); /*     w <- Au   */
-    PetscCall(VecNormEnd(U, NORM_2, &dp));
+    /* the product and both reductions are fused, the loop below then does not need to compute delta at its first iteration */
+    PetscCall(KSP_MatMultDot(ksp, Amat, U, W, &delta, &dp, NULL)); /*     w <- Au, delta <- u'*w, dp <- u'*u = e'*A'*B'*B*A'*e' */
+    delta     = PetscConj(delta);                                 /*     delta <- w'*u  */
+    havedelta = PETSC_TRUE;
     break;
   case KSP_NORM_UNPRECONDITIONED:
     PetscCall(VecNormBegin(R, NORM_2, &dp)); /*     dp <- r'*r = e'*A'*A*e            */
@@ -96,7 +96,7 @@ static PetscErrorCode KSPSolve_PIPECG(KSP ksp)
       PetscCall(VecNormBegin(U, NORM_2, &dp));
     }
     if (!(i == 0 && ksp->normtype == KSP_NORM_NATURAL)) PetscCall(VecDotBegin(R, U, &gamma));
-    PetscCall(VecDotBegin(W, U, &delta));
+    if (!(i == 0 && havedelta)) PetscCall(VecDotBegin(W, U, &delta));
     PetscCall(PetscCommSplitReductionBegin(PetscObjectComm((PetscObject)R)));
 
     PetscCall(KSP_PCApply(ksp, W, M));       /*   m <- Bw       */
@@ -108,7 +108,7 @@ static PetscErrorCode KSPSolve_PIPECG(KSP ksp)
       PetscCall(VecNormEnd(U, NORM_2, &dp));
     }
     if (!(i == 0 && ksp->normtype == KSP_NORM_NATURAL)) PetscCall(VecDotEnd(R, U, &gamma));
-    PetscCall(VecDotEnd(W, U, &delta));
+    if (!(i == 0 && havedelta)) PetscCall(VecDotEnd(W, U, &delta));
 
     if (i > 0) {
       if (ksp->normtype == KSP_NORM_NATURAL) dp = PetscSqrtReal(PetscAbsScalar(gamma));
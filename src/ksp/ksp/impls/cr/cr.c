@@ -36,29 +36,27 @@ static PetscErrorCode KSPSolve_CR(KSP ksp)
   }
   /* This may be true only on a subset of MPI ranks; setting it here so it will be detected by the first norm computation below */
   if (ksp->reason == KSP_DIVERGED_PC_FAILED) PetscCall(VecSetInf(R));
-  PetscCall(KSP_PCApply(ksp, R, P));        /*   P   <- B*R         */
-  PetscCall(KSP_MatMult(ksp, Amat, P, AP)); /*   AP  <- A*P         */
-  PetscCall(VecCopy(P, RT));                /*   RT  <- P           */
-  PetscCall(VecCopy(AP, ART));              /*   ART <- AP          */
-  PetscCall(VecDotBegin(RT, ART, &btop));   /*   (RT,ART)           */
+  PetscCall(KSP_PCApply(ksp, R, P)); /*   P   <- B*R         */
 
   if (ksp->normtype == KSP_NORM_PRECONDITIONED) {
-    PetscCall(VecNormBegin(RT, NORM_2, &dp)); /*   dp <- RT'*RT       */
-    PetscCall(VecDotEnd(RT, ART, &btop));     /*   (RT,ART)           */
-    PetscCall(VecNormEnd(RT, NORM_2, &dp));   /*   dp <- RT'*RT       */
+    PetscCall(KSP_MatMultDot(ksp, Amat, P, AP, &btop, &dp, NULL)); /*   AP <- A*P, (P,AP), dp <- P'*P */
     KSPCheckNorm(ksp, dp);
   } else if (ksp->normtype == KSP_NORM_NONE) {
-    dp = 0.0;                             /* meaningless value that is passed to monitor and convergence test */
-    PetscCall(VecDotEnd(RT, ART, &btop)); /*   (RT,ART)           */
+    dp = 0.0;                                                      /* meaningless value that is passed to monitor and convergence test */
+    PetscCall(KSP_MatMultDot(ksp, Amat, P, AP, &btop, NULL, NULL)); /*   AP <- A*P, (P,AP)  */
   } else if (ksp->normtype == KSP_NORM_UNPRECONDITIONED) {
-    PetscCall(VecNormBegin(R, NORM_2, &dp)); /*   dp <- R'*R         */
-    PetscCall(VecDotEnd(RT, ART, &btop));    /*   (RT,ART)           */
-    PetscCall(VecNormEnd(R, NORM_2, &dp));   /*   dp <- RT'*RT       */
+    PetscCall(KSP_MatMult(ksp, Amat, P, AP)); /*   AP  <- A*P         */
+    PetscCall(VecDotBegin(P, AP, &btop));     /*   (P,AP)             */
+    PetscCall(VecNormBegin(R, NORM_2, &dp));  /*   dp <- R'*R         */
+    PetscCall(VecDotEnd(P, AP, &btop));       /*   (P,AP)             */
+    PetscCall(VecNormEnd(R, NORM_2, &dp));    /*   dp <- R'*R         */
     KSPCheckNorm(ksp, dp);
   } else if (ksp->normtype == KSP_NORM_NATURAL) {
-    PetscCall(VecDotEnd(RT, ART, &btop));     /*   (RT,ART)           */
-    dp = PetscSqrtReal(PetscAbsScalar(btop)); /* dp = sqrt(R,AR)      */
+    PetscCall(KSP_MatMultDot(ksp, Amat, P, AP, &btop, NULL, NULL)); /*   AP <- A*P, (P,AP)  */
+    dp = PetscSqrtReal(PetscAbsScalar(btop));                       /* dp = sqrt(R,AR)      */
   } else SETERRQ(PetscObjectComm((PetscObject)ksp), PETSC_ERR_SUP, "KSPNormType of %d not supported", (int)ksp->normtype);
+  PetscCall(VecCopy(P, RT));   /*   RT  <- P           */
+  PetscCall(VecCopy(AP, ART)); /*   ART <- AP          */
   if (PetscAbsScalar(btop) < 0.0) {
     ksp->reason = KSP_DIVERGED_INDEFINITE_MAT;
     PetscCall(PetscInfo(ksp, "diverging due to indefinite or negative definite matrix\n"));
@@ -89,22 +87,20 @@ static PetscErrorCode KSPSolve_CR(KSP ksp)
 
     PetscCall(VecAXPY(X, ai, P));               /*   X   <- X + ai*P     */
     PetscCall(VecAXPY(RT, -ai, Q));             /*   RT  <- RT - ai*Q    */
-    PetscCall(KSP_MatMult(ksp, Amat, RT, ART)); /*   ART <-   A*RT       */
     bbot = btop;
-    PetscCall(VecDotBegin(RT, ART, &btop));
 
     if (ksp->normtype == KSP_NORM_PRECONDITIONED) {
-      PetscCall(VecNormBegin(RT, NORM_2, &dp)); /*   dp <- || RT ||      */
-      PetscCall(VecDotEnd(RT, ART, &btop));
-      PetscCall(VecNormEnd(RT, NORM_2, &dp)); /*   dp <- || RT ||      */
+      PetscCall(KSP_MatMultDot(ksp, Amat, RT, ART, &btop, &dp, NULL)); /*   ART <- A*RT, (RT,ART), dp <- || RT || */
       KSPCheckNorm(ksp, dp);
     } else if (ksp->normtype == KSP_NORM_NATURAL) {
-      PetscCall(VecDotEnd(RT, ART, &btop));
-      dp = PetscSqrtReal(PetscAbsScalar(btop)); /* dp = sqrt(R,AR)       */
+      PetscCall(KSP_MatMultDot(ksp, Amat, RT, ART, &btop, NULL, NULL)); /*   ART <- A*RT, (RT,ART) */
+      dp = PetscSqrtReal(PetscAbsScalar(btop));                         /* dp = sqrt(R,AR)       */
     } else if (ksp->normtype == KSP_NORM_NONE) {
-      PetscCall(VecDotEnd(RT, ART, &btop));
-      dp = 0.0; /* meaningless value that is passed to monitor and convergence test */
+      PetscCall(KSP_MatMultDot(ksp, Amat, RT, ART, &btop, NULL, NULL)); /*   ART <- A*RT, (RT,ART) */
+      dp = 0.0;                                                         /* meaningless value that is passed to monitor and convergence test */
     } else if (ksp->normtype == KSP_NORM_UNPRECONDITIONED) {
+      PetscCall(KSP_MatMult(ksp, Amat, RT, ART)); /*   ART <-   A*RT       */
+      PetscCall(VecDotBegin(RT, ART, &btop));
       PetscCall(VecAXPY(R, ai, AP));           /*   R   <- R - ai*AP    */
       PetscCall(VecNormBegin(R, NORM_2, &dp)); /*   dp <- R'*R          */
       PetscCall(VecDotEnd(RT, ART, &btop));
@@ -321,6 +321,131 @@ int main(int argc, char **args)
       suffix: sell
       args: -ksp_monitor_short -ksp_gmres_cgs_refinement_type refine_always -m 9 -n 9 -mat_type sell
 
+   test:
+      suffix: seqaijomp
+      env: OMP_NUM_THREADS=2
+      args: -ksp_monitor_short -m 5 -n 5 -ksp_gmres_cgs_refinement_type refine_always -mat_seqaij_type seqaijomp
+      output_file: output/ex2_1.out
+
+   test:
+      suffix: seqaijomp_2
+      nsize: 2
+      env: OMP_NUM_THREADS=2
+      args: -ksp_monitor_short -m 5 -n 5 -ksp_gmres_cgs_refinement_type refine_always -mat_seqaij_type seqaijomp -mat_aijomp_first_touch
+      output_file: output/ex2_2.out
+
+   test:
+      suffix: seqaijomp_bicg
+      env: OMP_NUM_THREADS=2
+      args: -ksp_monitor_short -ksp_type bicg -pc_type none -mat_seqaij_type seqaijomp -mat_aijomp_first_touch
+
+   test:
+      suffix: seqaijdelta
+      args: -ksp_monitor_short -m 5 -n 5 -ksp_gmres_cgs_refinement_type refine_always -mat_seqaij_type seqaijdelta
+      output_file: output/ex2_1.out
+
+   test:
+      suffix: seqaijdelta_sor
+      args: -ksp_monitor_short -ksp_type cg -pc_type sor -pc_sor_symmetric -pc_sor_its 2 -mat_seqaij_type seqaijdelta -mat_aijdelta_block_size 7
+
+   test:
+      suffix: seqaijauto
+      args: -ksp_monitor_short -m 5 -n 5 -ksp_gmres_cgs_refinement_type refine_always -mat_seqaij_type seqaijauto -mat_aijauto_candidates seqaij,seqaijsell,seqaijdelta
+      output_file: output/ex2_1.out
+
+   test:
+      suffix: seqaijauto_2
+      nsize: 2
+      args: -ksp_monitor_short -m 5 -n 5 -ksp_gmres_cgs_refinement_type refine_always -mat_seqaij_type seqaijauto
+      output_file: output/ex2_2.out
+
+   test:
+      suffix: seqaijauto_view
+      args: -ksp_monitor_short -m 5 -n 5 -ksp_gmres_cgs_refinement_type refine_always -mat_type seqaijauto -mat_aijauto_candidates seqaijdelta -mat_aijauto_its 2 -ksp_view_mat ::ascii_info
+
+   test:
+      suffix: seqaijmerge
+      env: OMP_NUM_THREADS=2
+      args: -ksp_monitor_short -m 5 -n 5 -ksp_gmres_cgs_refinement_type refine_always -mat_seqaij_type seqaijmerge
+      output_file: output/ex2_1.out
+
+   test:
+      suffix: seqaijmerge_2
+      nsize: 2
+      args: -ksp_monitor_short -m 5 -n 5 -ksp_gmres_cgs_refinement_type refine_always -mat_seqaij_type seqaijmerge -mat_aijmerge_tiles 7
+      output_file: output/ex2_2.out
+
+   test:
+      suffix: seqaijmerge_tiles
+      env: OMP_NUM_THREADS=1
+      args: -ksp_monitor_short -m 5 -n 5 -ksp_gmres_cgs_refinement_type refine_always -mat_type seqaijmerge -mat_aijmerge_tiles 50 -ksp_view_mat ::ascii_info
+
+   test:
+      suffix: solve_levels
+      env: OMP_NUM_THREADS=2
+      args: -ksp_monitor_short -m 5 -n 5 -ksp_gmres_cgs_refinement_type refine_always -mat_solve_levels
+      output_file: output/ex2_1.out
+
+   test:
+      suffix: solve_levels_2
+      nsize: 2
+      args: -ksp_monitor_short -m 5 -n 5 -ksp_gmres_cgs_refinement_type refine_always -sub_mat_solve_levels
+      output_file: output/ex2_2.out
+
+   test:
+      suffix: solve_levels_view
+      args: -ksp_monitor_short -m 5 -n 5 -ksp_type cg -pc_type {{ilu icc}separate output} -mat_solve_levels -ksp_view
+
+   test:
+      suffix: solve_levels_transpose
+      args: -ksp_monitor_short -m 9 -n 7 -ksp_type bicg -pc_type ilu -pc_factor_levels {{0 2}separate output} -pc_factor_mat_ordering_type rcm -mat_solve_levels
+
+   test:
+      suffix: solve_levels_icc
+      args: -ksp_monitor_short -m 9 -n 7 -ksp_type cg -pc_type icc -pc_factor_mat_ordering_type {{natural rcm}separate output} -mat_solve_levels
+
+   test:
+      suffix: sor_multicolor
+      args: -ksp_monitor_short -m 9 -n 7 -ksp_type cg -pc_type sor -mat_sor_multicolor -mat_type {{aij baij}}
+      output_file: output/ex2_sor_multicolor.out
+
+   test:
+      suffix: sor_multicolor_eisenstat
+      args: -ksp_monitor_short -m 9 -n 7 -pc_type eisenstat -pc_eisenstat_omega 1.2 -mat_sor_multicolor -mat_type {{aij baij}}
+      output_file: output/ex2_sor_multicolor_eisenstat.out
+
+   test:
+      suffix: sor_multicolor_view
+      nsize: 2
+      args: -ksp_monitor_short -m 9 -n 7 -ksp_type cg -pc_type bjacobi -sub_pc_type sor -sub_pc_sor_omega 1.2 -sub_mat_sor_multicolor -sub_mat_sor_multicolor_type jp -ksp_view
+
+   test:
+      suffix: parilu
+      args: -ksp_monitor_short -m 9 -n 7 -pc_type ilu -pc_factor_mat_solver_type parilu -mat_parilu_sweeps {{1 3}separate output} -mat_parilu_solve_sweeps {{0 2}separate output}
+
+   test:
+      suffix: parilu_icc
+      args: -ksp_monitor_short -m 9 -n 7 -ksp_type cg -pc_type icc -pc_factor_mat_solver_type parilu -mat_parilu_solve_sweeps {{0 2}separate output}
+
+   test:
+      suffix: parilu_view
+      args: -ksp_monitor_short -m 9 -n 7 -ksp_type cg -pc_type icc -pc_factor_mat_solver_type parilu -mat_parilu_sweeps 5 -mat_parilu_solve_sweeps 2 -ksp_view
+
+   test:
+      suffix: supernodal
+      args: -ksp_monitor_short -m 9 -n 7 -pc_type lu -pc_factor_mat_solver_type supernodal -ksp_view
+
+   test:
+      suffix: supernodal_cholesky
+      args: -ksp_monitor_short -m 9 -n 7 -ksp_type cg -pc_type cholesky -pc_factor_mat_solver_type supernodal -mat_type {{aij sbaij}} -pc_factor_mat_ordering_type {{nd qmd}}
+      output_file: output/ex2_supernodal_cholesky.out
+
+   test:
+      suffix: aijmixed
+      nsize: 2
+      requires: !complex
+      args: -ksp_monitor_short -ksp_type bicg -pc_type none -mat_type aijmixed
+
    test:
       requires: mumps
       suffix: sell_mumps
@@ -389,6 +514,22 @@ int main(int argc, char **args)
       nsize: 1
       args: -ksp_monitor -ksp_type gmres -pc_type bjacobi -sub_pc_type icc -ksp_pc_side symmetric -pc_bjacobi_blocks 2
 
+   test:
+      suffix: fsai
+      nsize: {{1 2}}
+      args: -m 20 -n 20 -ksp_type cg -pc_type fsai -pc_fsai_levels 2 -pc_fsai_threshold 0.01 -ksp_converged_reason
+      output_file: output/ex2_fsai.out
+
+   test:
+      suffix: fsai_exact
+      filter: grep -v "Norm of error"
+      args: -m 5 -n 5 -ksp_type cg -pc_type fsai -pc_fsai_levels 10 -ksp_converged_reason
+
+   test:
+      suffix: fsai_adaptive
+      nsize: 2
+      args: -m 20 -n 20 -ksp_type gmres -ksp_pc_side symmetric -pc_type fsai -pc_fsai_adaptive -ksp_converged_reason
+
    test:
       suffix: help
       requires: !openblas !blis !mkl !hpddm !complex !kokkos_kernels !amgx !ml !spai !hypre !viennacl !parms !h2opus !metis !parmetis !superlu_dist !mkl_sparse_optimize !mkl_sparse !mkl_pardiso !mkl_cpardiso !cuda !hip defined(PETSC_USE_LOG) defined(PETSC_USE_INFO) cxx
@@ -222,4 +222,10 @@ PetscErrorCode FormElementRhs(PetscScalar x, PetscScalar y, PetscReal H, PetscSc
       nsize: 2
       args: -ksp_monitor_short
 
+   test:
+      suffix: flush
+      nsize: 2
+      output_file: output/ex3_1.out
+      args: -ksp_monitor_short -matstash_flush_size {{1 16}}
+
 TEST*/
@@ -275,7 +275,7 @@ PetscErrorCode PCView_Factor(PC pc, PetscViewer viewer)
     if (factor->factortype == MAT_FACTOR_ILU || factor->factortype == MAT_FACTOR_ICC) {
       if (factor->info.dt > 0) {
         PetscCall(PetscViewerASCIIPrintf(viewer, "  drop tolerance %g\n", (double)factor->info.dt));
-        PetscCall(PetscViewerASCIIPrintf(viewer, "  max nonzeros per row %" PetscInt_FMT "\n", (PetscInt)factor->info.dtcount));
+        PetscCall(PetscViewerASCIIPrintf(viewer, "  max fill entries per row %" PetscInt_FMT "\n", (PetscInt)factor->info.dtcount));
         PetscCall(PetscViewerASCIIPrintf(viewer, "  column permutation tolerance %g\n", (double)factor->info.dtcol));
       } else if (factor->info.levels == 1) {
         PetscCall(PetscViewerASCIIPrintf(viewer, "  %" PetscInt_FMT " level of fill\n", (PetscInt)factor->info.levels));
@@ -185,25 +185,33 @@ PetscErrorCode PCFactorSetShiftAmount(PC pc, PetscReal shiftamount)
 
 /*@
   PCFactorSetDropTolerance - The preconditioner will use an `PCILU`
-  based on a drop tolerance.
+  based on a drop tolerance, the threshold ILU or ILUT.
 
   Logically Collective
 
   Input Parameters:
 + pc          - the preconditioner context
 . dt          - the drop tolerance, try from 1.e-10 to .1
-. dtcol       - tolerance for column pivot, good values [0.1 to 0.01]
-- maxrowcount - the max number of nonzeros allowed in a row, best value
-                 depends on the number of nonzeros in row of original matrix
+. dtcol       - tolerance for column pivot, good values [0.1 to 0.01], 0 for no column pivoting
+- maxrowcount - the max number of fill entries allowed in each of the L and U parts of a row of the factors, in addition to
+                 the number of nonzeros of the row of the original matrix in that part
 
   Options Database Key:
 . -pc_factor_drop_tolerance <dt,dtcol,maxrowcount> - Sets drop tolerance
 
   Level: intermediate
 
-  Note:
-  There are NO default values for the 3 parameters, you must set them with reasonable values for your
-  matrix. We don't know how to compute reasonable values.
+  Notes:
+  The entries of a row of the factors whose norm is at most `dt` times the norm of the row of the matrix are dropped, then only the
+  largest entries of the L and U parts of the row are kept. The nonzero structure of the factors depends on the values of the matrix,
+  so it is recomputed by each numerical factorization. Use `PETSC_DEFAULT` for `dt`, which is then .005, and for `maxrowcount`, which is
+  then 1.5 times the largest number of nonzeros of a row of the matrix. For `MATSEQBAIJ` matrices the blocks are dropped by their
+  Frobenius norm and `dtcol` is ignored.
+
+  With `dtcol` > 0, the diagonal entry of a row of U is exchanged with the largest entry of the row if it is smaller than `dtcol` times
+  this entry, which changes the column ordering. This can avoid small pivots of matrices that are far from diagonally dominant.
+
+  There are no good default values for the 3 parameters, reasonable values depend on your matrix.
 
 .seealso: [](ch_ksp), `PCILU`
 @*/
@@ -42,10 +42,10 @@ PetscErrorCode PCFactorSetDropTolerance_ILU(PC pc, PetscReal dt, PetscReal dtcol
 
 static PetscErrorCode PCSetFromOptions_ILU(PC pc, PetscOptionItems *PetscOptionsObject)
 {
-  PetscInt  itmp;
+  PetscInt  itmp, dtmax = 3;
   PetscBool flg, set;
   PC_ILU   *ilu = (PC_ILU *)pc->data;
-  PetscReal tol;
+  PetscReal tol, dt[3];
 
   PetscFunctionBegin;
   PetscOptionsHeadBegin(PetscOptionsObject, "ILU Options");
@@ -53,6 +53,11 @@ static PetscErrorCode PCSetFromOptions_ILU(PC pc, PetscOptionItems *PetscOptions
 
   PetscCall(PetscOptionsInt("-pc_factor_levels", "levels of fill", "PCFactorSetLevels", (PetscInt)((PC_Factor *)ilu)->info.levels, &itmp, &flg));
   if (flg) ((PC_Factor *)ilu)->info.levels = itmp;
+  dt[0] = ((PC_Factor *)ilu)->info.dt;
+  dt[1] = ((PC_Factor *)ilu)->info.dtcol;
+  dt[2] = ((PC_Factor *)ilu)->info.dtcount;
+  PetscCall(PetscOptionsRealArray("-pc_factor_drop_tolerance", "<dt,dtcol,maxrowcount>", "PCFactorSetDropTolerance", dt, &dtmax, &flg));
+  if (flg) PetscCall(PCFactorSetDropTolerance(pc, dt[0], dt[1], (PetscInt)dt[2]));
 
   PetscCall(PetscOptionsBool("-pc_factor_diagonal_fill", "Allow fill into empty diagonal entry", "PCFactorSetAllowDiagonalFill", ((PC_Factor *)ilu)->info.diagonal_fill ? PETSC_TRUE : PETSC_FALSE, &flg, &set));
   if (set) ((PC_Factor *)ilu)->info.diagonal_fill = (PetscReal)flg;
@@ -249,9 +254,10 @@ static PetscErrorCode PCApplySymmetricRight_ILU(PC pc, Vec x, Vec y)
 .  -pc_factor_nonzeros_along_diagonal                    - reorder the matrix before factorization to remove zeros from the diagonal,
                                                          this decreases the chance of getting a zero pivot
 .  -pc_factor_mat_ordering_type <natural,nd,1wd,rcm,qmd> - set the row/column ordering of the factored matrix
--  -pc_factor_pivot_in_blocks                            - for block ILU(k) factorization, i.e. with `MATBAIJ` matrices with block size larger
+.  -pc_factor_pivot_in_blocks                            - for block ILU(k) factorization, i.e. with `MATBAIJ` matrices with block size larger
                                                          than 1 the diagonal blocks are factored with partial pivoting (this increases the
                                                          stability of the ILU factorization
+-  -pc_factor_drop_tolerance <dt,dtcol,maxrowcount>      - use the threshold ILU instead of ILU(k), see `PCFactorSetDropTolerance()`
 
    Level: beginner
 
@@ -266,6 +272,14 @@ static PetscErrorCode PCApplySymmetricRight_ILU(PC pc, Vec x, Vec y)
    If you are using `MATSEQAIJCUSPARSE` matrices (or `MATMPIAIJCUSPARSE` matrices with block Jacobi), factorization
    is never done on the GPU).
 
+   For `MATSEQAIJ` and `MATSEQBAIJ` matrices `PCFactorSetDropTolerance()` selects a threshold ILU, ILUT, whose fill is determined by the size of the
+   entries instead of their level, which usually needs less fill than ILU(k) for the same convergence on nonsymmetric problems. For `MATSEQAIJ`
+   matrices it can also use column pivoting, ILUTP.
+
+   For `MATSEQAIJ` matrices `-mat_solve_levels` computes level sets of the triangular factors after the numerical factorization
+   and applies the preconditioner one level at a time, with the rows of each level processed by the OpenMP threads. `-ksp_view`
+   reports the number and size of the levels, many small levels mean the factors have little parallelism.
+
 .seealso: [](ch_ksp), `PCCreate()`, `PCSetType()`, `PCType`, `PC`, `PCSOR`, `MatOrderingType`, `PCLU`, `PCICC`, `PCCHOLESKY`,
           `PCFactorSetZeroPivot()`, `PCFactorSetShiftSetType()`, `PCFactorSetAmount()`,
           `PCFactorSetDropTolerance()`, `PCFactorSetFill()`, `PCFactorSetMatOrderingType()`, `PCFactorSetReuseOrdering()`,
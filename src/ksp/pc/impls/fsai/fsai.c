@@ -0,0 +1,717 @@
+/*
+  Factorized sparse approximate inverse preconditioner, M^{-1} = G^H G with G lower triangular and G A G^H close to the identity.
+  Each row of G is given by a small dense symmetric positive definite system, independent of the other rows, so the rows are
+  computed by OpenMP threads; the application of the preconditioner is two sparse matrix-vector products.
+*/
+#include <petsc/private/pcimpl.h> /*I "petscpc.h" I*/
+#include <petscblaslapack.h>
+#if defined(PETSC_HAVE_OPENMP)
+  #include <omp.h>
+#endif
+
+typedef struct {
+  PetscInt  levels;    /* the static pattern is the lower triangular part of the pattern of A^levels */
+  PetscReal threshold; /* entries of |D^{-1/2} A D^{-1/2}|^levels smaller than this are not in the static pattern */
+  PetscBool adaptive;  /* grow the pattern of each row from its diagonal entry instead */
+  PetscInt  maxsteps;  /* number of adaptive steps of each row */
+  PetscInt  stepsize;  /* number of entries added to a row by each adaptive step */
+  PetscReal tol;       /* a row stops growing once an adaptive step decreases its Kaporin number by less than this, relatively */
+  PetscInt *pi, *pj;   /* static pattern of the strictly lower triangular part of the local rows, in global column indices */
+  Mat       G, Gt;     /* the factor and its Hermitian transpose */
+  Vec       work;
+  PetscReal fill;      /* nonzeros of G over the nonzeros of the lower triangular part of A */
+  PetscInt  nfallback; /* rows whose dense system was not positive definite and were replaced by the Jacobi row */
+} PC_FSAI;
+
+/* replaces the entries of a MATSEQAIJ or MATMPIAIJ matrix by their absolute values */
+static PetscErrorCode PCFSAIMatAbs_Private(Mat A)
+{
+  Mat       parts[2] = {A, NULL};
+  PetscBool isseq;
+
+  PetscFunctionBegin;
+  PetscCall(PetscObjectBaseTypeCompare((PetscObject)A, MATSEQAIJ, &isseq));
+  if (!isseq) PetscCall(MatMPIAIJGetSeqAIJ(A, &parts[0], &parts[1], NULL));
+  for (PetscInt p = 0; p < 2 && parts[p]; p++) {
+    PetscScalar *a;
+    PetscInt     nz;
+    MatInfo      info;
+
+    PetscCall(MatGetInfo(parts[p], MAT_LOCAL, &info));
+    nz = (PetscInt)info.nz_used;
+    PetscCall(MatSeqAIJGetArray(parts[p], &a));
+    for (PetscInt k = 0; k < nz; k++) a[k] = PetscAbsScalar(a[k]);
+    PetscCall(MatSeqAIJRestoreArray(parts[p], &a));
+  }
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
+
+/* computes fsai->pi and fsai->pj, the strictly lower triangular part of the pattern of A^levels, filtered with the threshold */
+static PetscErrorCode PCFSAIStaticPattern_Private(PC pc, Mat A)
+{
+  PC_FSAI *fsai = (PC_FSAI *)pc->data;
+  Mat      P    = A, Ahat = NULL;
+  PetscInt rstart, rend;
+
+  PetscFunctionBegin;
+  PetscCall(MatGetOwnershipRange(A, &rstart, &rend));
+  if (fsai->levels > 1 || fsai->threshold > 0) {
+    Vec d;
+
+    PetscCall(MatDuplicate(A, MAT_COPY_VALUES, &Ahat));
+    PetscCall(MatCreateVecs(A, &d, NULL));
+    PetscCall(MatGetDiagonal(A, d));
+    PetscCall(VecSqrtAbs(d));
+    PetscCall(VecReciprocal(d));
+    PetscCall(MatDiagonalScale(Ahat, d, d));
+    PetscCall(VecDestroy(&d));
+    PetscCall(PCFSAIMatAbs_Private(Ahat));
+    P = Ahat;
+    for (PetscInt l = 1; l < fsai->levels; l++) {
+      Mat Q;
+
+      PetscCall(MatMatMult(P, Ahat, MAT_INITIAL_MATRIX, PETSC_DEFAULT, &Q));
+      if (P != Ahat) PetscCall(MatDestroy(&P));
+      P = Q;
+    }
+  }
+
+  /* the first pass counts the entries of each row, the second one stores them */
+  PetscCall(PetscFree2(fsai->pi, fsai->pj));
+  PetscCall(PetscMalloc1(rend - rstart + 1, &fsai->pi));
+  fsai->pi[0] = 0;
+  for (PetscInt pass = 0; pass < 2; pass++) {
+    for (PetscInt i = rstart; i < rend; i++) {
+      const PetscInt    *cols;
+      const PetscScalar *vals;
+      PetscInt           ncols, nz = 0;
+
+      PetscCall(MatGetRow(P, i, &ncols, &cols, &vals));
+      for (PetscInt k = 0; k < ncols && cols[k] < i; k++) {
+        if (P != A && PetscRealPart(vals[k]) < fsai->threshold) continue;
+        if (pass) fsai->pj[fsai->pi[i - rstart] + nz] = cols[k];
+        nz++;
+      }
+      PetscCall(MatRestoreRow(P, i, &ncols, &cols, &vals));
+      if (!pass) fsai->pi[i - rstart + 1] = fsai->pi[i - rstart] + nz;
+    }
+    if (!pass) {
+      PetscInt *pi = fsai->pi;
+
+      /* PetscFree2() frees pi and pj together */
+      PetscCall(PetscMalloc2(rend - rstart + 1, &fsai->pi, pi[rend - rstart], &fsai->pj));
+      PetscCall(PetscArraycpy(fsai->pi, pi, rend - rstart + 1));
+      PetscCall(PetscFree(pi));
+    }
+  }
+  if (P != A && P != Ahat) PetscCall(MatDestroy(&P));
+  PetscCall(MatDestroy(&Ahat));
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
+
+/*
+  Solves S(idx,idx) g = -S(idx,li) for the np sorted indices idx, all smaller than li, and computes psi = S(li,li) + S(li,idx) g,
+  the inverse of the diagonal entry of the row of the inverse of S(idx+li,idx+li). Returns PETSC_FALSE when S(idx,idx) or psi is not
+  positive definite. It is called by the OpenMP threads, so it must not call PETSc functions.
+*/
+static PetscBool PCFSAISolveRow_Private(const PetscInt si[], const PetscInt sj[], const PetscScalar sa[], PetscInt li, PetscInt np, const PetscInt idx[], PetscScalar dense[], PetscScalar g[], PetscReal *psi)
+{
+  PetscScalar  s = 0.0;
+  PetscBLASInt bn = (PetscBLASInt)np, one = 1, info = 0;
+
+  for (PetscInt k = 0; k < np * np; k++) dense[k] = 0.0;
+  for (PetscInt k = 0; k < np; k++) {
+    PetscInt l = 0;
+
+    g[k] = 0.0;
+    for (PetscInt e = si[idx[k]]; e < si[idx[k] + 1]; e++) {
+      if (sj[e] == li) {
+        g[k] = -sa[e];
+        break;
+      }
+      while (l < np && idx[l] < sj[e]) l++;
+      if (l < np && idx[l] == sj[e]) dense[k + l * np] = sa[e];
+    }
+  }
+  if (np) {
+    LAPACKpotrf_("L", &bn, dense, &bn, &info);
+    if (info) return PETSC_FALSE;
+    LAPACKpotrs_("L", &bn, &one, dense, &bn, g, &bn, &info);
+    if (info) return PETSC_FALSE;
+  }
+  for (PetscInt e = si[li], l = 0; e < si[li + 1] && sj[e] <= li; e++) {
+    if (sj[e] == li) s += sa[e];
+    while (l < np && idx[l] < sj[e]) l++;
+    if (l < np && idx[l] == sj[e]) s += sa[e] * g[l];
+  }
+  *psi = PetscRealPart(s);
+  return *psi > 0.0 ? PETSC_TRUE : PETSC_FALSE;
+}
+
+/* per thread work space of the row computations */
+typedef struct {
+  PetscScalar *dense, *w;
+  PetscReal   *score;
+  PetscInt    *idx, *cand, *flag;
+} PCFSAIWork;
+
+/*
+  Grows the pattern of row li of S by at most stepsize entries in each of maxsteps steps, choosing the columns j < li with the
+  largest |(S [g; 1])_j|^2 / S(j,j), the decrease of the Kaporin number when j is added. Returns the number of off-diagonal entries.
+  It is called by the OpenMP threads, so it must not call PETSc functions.
+*/
+static PetscInt PCFSAIAdaptiveRow_Private(const PC_FSAI *fsai, const PetscInt si[], const PetscInt sj[], const PetscScalar sa[], const PetscInt sdiag[], PetscInt li, PCFSAIWork *wk, PetscScalar g[], PetscReal *psi, PetscBool *ok)
+{
+  PetscInt  np = 0, *idx = wk->idx, *cand = wk->cand, *flag = wk->flag;
+  PetscReal psiold;
+
+  *ok = PCFSAISolveRow_Private(si, sj, sa, li, 0, idx, wk->dense, g, psi);
+  if (!*ok) return 0;
+  psiold = *psi;
+  for (PetscInt step = 0; step < fsai->maxsteps; step++) {
+    PetscInt nc = 0, nnew = 0;
+
+    /* the gradient from the rows of the pattern, flag[] is 1 for the columns in the pattern and 2 for the candidates */
+    for (PetscInt k = -1; k < np; k++) {
+      PetscInt    r = k < 0 ? li : idx[k];
+      PetscScalar c = k < 0 ? 1.0 : g[k];
+
+      for (PetscInt e = si[r]; e < si[r + 1] && sj[e] < li; e++) {
+        PetscInt j = sj[e];
+
+        if (flag[j] == 1) continue;
+        if (!flag[j]) {
+          flag[j]    = 2;
+          wk->w[j]   = 0.0;
+          cand[nc++] = j;
+        }
+        wk->w[j] += PetscConj(sa[e]) * c;
+      }
+    }
+    for (PetscInt c = 0; c < nc; c++) {
+      PetscInt  j = cand[c];
+      PetscReal d = sdiag[j] >= 0 ? PetscRealPart(sa[sdiag[j]]) : 0.0;
+
+      wk->score[c] = d > 0.0 ? PetscRealPart(wk->w[j] * PetscConj(wk->w[j])) / d : 0.0;
+      flag[j]      = 0;
+    }
+    for (PetscInt s = 0; s < fsai->stepsize; s++) {
+      PetscInt  best = -1, p = np;
+      PetscReal max  = 0.0;
+
+      for (PetscInt c = 0; c < nc; c++) {
+        if (wk->score[c] > max) {
+          max  = wk->score[c];
+          best = c;
+        }
+      }
+      if (best < 0) break;
+      wk->score[best] = 0.0;
+      while (p > 0 && idx[p - 1] > cand[best]) {
+        idx[p] = idx[p - 1];
+        p--;
+      }
+      idx[p]       = cand[best];
+      flag[idx[p]] = 1;
+      np++;
+      nnew++;
+    }
+    if (!nnew) break;
+    *ok = PCFSAISolveRow_Private(si, sj, sa, li, np, idx, wk->dense, g, psi);
+    if (!*ok || psiold - *psi < fsai->tol * psiold) break;
+    psiold = *psi;
+  }
+  for (PetscInt k = 0; k < np; k++) flag[idx[k]] = 0;
+  return np;
+}
+
+static PetscErrorCode PCSetUp_FSAI(PC pc)
+{
+  PC_FSAI           *fsai = (PC_FSAI *)pc->data;
+  Mat                A, S, *subs = NULL;
+  IS                 isU = NULL;
+  const PetscInt    *U = NULL, *si, *sj;
+  const PetscScalar *sa;
+  PetscInt           rstart, rend, m, mc, M, nS, shift = 0, maxnp = 0, nt = 1, nfail = 0, nerr = -1, nz = 0;
+  PetscInt          *srow, *sp, *sdiag = NULL, *status, *gi, *gj, *gn;
+  PetscScalar       *gv;
+  PetscBool          isaij, isseq, done;
+  PCFSAIWork        *wk;
+  MatInfo            info;
+  PetscReal          nzA;
+
+  PetscFunctionBegin;
+  PetscCall(PetscObjectBaseTypeCompareAny((PetscObject)pc->pmat, &isaij, MATSEQAIJ, MATMPIAIJ, ""));
+  if (isaij) {
+    A = pc->pmat;
+    PetscCall(PetscObjectReference((PetscObject)A));
+  } else PetscCall(MatConvert(pc->pmat, MATAIJ, MAT_INITIAL_MATRIX, &A));
+  PetscCall(PetscObjectBaseTypeCompare((PetscObject)A, MATSEQAIJ, &isseq));
+  PetscCall(MatGetOwnershipRange(A, &rstart, &rend));
+  PetscCall(MatGetLocalSize(A, &m, &mc));
+  PetscCall(MatGetSize(A, &M, NULL));
+  PetscCheck(m == mc, PETSC_COMM_SELF, PETSC_ERR_ARG_SIZ, "PCFSAI requires the same local row and column sizes, not %" PetscInt_FMT " and %" PetscInt_FMT, m, mc);
+  PetscCall(MatDestroy(&fsai->G));
+  PetscCall(MatDestroy(&fsai->Gt));
+  PetscCall(VecDestroy(&fsai->work));
+  if (fsai->adaptive) PetscCall(PetscFree2(fsai->pi, fsai->pj));
+  else if (!fsai->pi || pc->flag == DIFFERENT_NONZERO_PATTERN) PetscCall(PCFSAIStaticPattern_Private(pc, A));
+
+  /* S holds the rows needed by the local rows of G: all of A, the diagonal block of A, or the rows and columns in the static pattern */
+  if (isseq) S = A;
+  else if (fsai->adaptive) {
+    PetscCall(MatMPIAIJGetSeqAIJ(A, &S, NULL, NULL));
+    shift = rstart;
+  } else {
+    PetscInt *u, nu = fsai->pi[m] + m;
+
+    PetscCall(PetscMalloc1(nu, &u));
+    PetscCall(PetscArraycpy(u, fsai->pj, fsai->pi[m]));
+    for (PetscInt r = 0; r < m; r++) u[fsai->pi[m] + r] = rstart + r;
+    PetscCall(PetscSortRemoveDupsInt(&nu, u));
+    PetscCall(ISCreateGeneral(PETSC_COMM_SELF, nu, u, PETSC_OWN_POINTER, &isU));
+    PetscCall(MatCreateSubMatrices(A, 1, &isU, &isU, MAT_INITIAL_MATRIX, &subs));
+    PetscCall(ISGetIndices(isU, &U));
+    S = subs[0];
+  }
+  PetscCall(MatGetRowIJ(S, 0, PETSC_FALSE, PETSC_FALSE, &nS, &si, &sj, &done));
+  PetscCheck(done, PETSC_COMM_SELF, PETSC_ERR_SUP, "Cannot get the nonzero structure of the local matrix");
+  PetscCall(MatSeqAIJGetArrayRead(S, &sa));
+
+  /* the rows of S of the local rows, and the static pattern with the indices of S */
+  PetscCall(PetscMalloc2(m, &srow, m, &status));
+  for (PetscInt r = 0; r < m; r++) {
+    if (U) PetscCall(PetscFindInt(rstart + r, nS, U, &srow[r]));
+    else srow[r] = rstart + r - shift;
+  }
+  sp = fsai->pj;
+  if (U) {
+    PetscCall(PetscMalloc1(fsai->pi[m], &sp));
+    for (PetscInt k = 0; k < fsai->pi[m]; k++) PetscCall(PetscFindInt(fsai->pj[k], nS, U, &sp[k]));
+  }
+  if (fsai->adaptive) {
+    maxnp = fsai->maxsteps * fsai->stepsize;
+    PetscCall(PetscMalloc1(nS, &sdiag));
+    for (PetscInt r = 0; r < nS; r++) {
+      sdiag[r] = -1;
+      for (PetscInt e = si[r]; e < si[r + 1]; e++) {
+        if (sj[e] == r) sdiag[r] = e;
+      }
+    }
+  } else {
+    for (PetscInt r = 0; r < m; r++) maxnp = PetscMax(maxnp, fsai->pi[r + 1] - fsai->pi[r]);
+  }
+
+  /* row r of G is computed in gj[gi[r]] and gv[gi[r]], with room for maxnp off-diagonal entries in the adaptive case */
+  PetscCall(PetscMalloc1(m + 1, &gi));
+  PetscCall(PetscMalloc1(m, &gn));
+  for (PetscInt r = 0; r <= m; r++) gi[r] = fsai->adaptive ? r * (maxnp + 1) : fsai->pi[r] + r;
+  PetscCall(PetscMalloc2(gi[m], &gj, gi[m], &gv));
+#if defined(PETSC_HAVE_OPENMP)
+  nt = PetscMax(PetscNumOMPThreads, 1);
+#endif
+  PetscCall(PetscCalloc1(nt, &wk));
+  for (PetscInt t = 0; t < nt; t++) {
+    PetscCall(PetscMalloc2(PetscMax(maxnp * maxnp, 1), &wk[t].dense, PetscMax(maxnp, 1), &wk[t].idx));
+    if (fsai->adaptive) {
+      PetscCall(PetscMalloc3(nS, &wk[t].w, nS, &wk[t].score, nS, &wk[t].cand));
+      PetscCall(PetscCalloc1(nS, &wk[t].flag));
+    }
+  }
+
+  PetscPragmaOMP(parallel num_threads((int)nt))
+  {
+    PetscInt tid = 0;
+
+#if defined(PETSC_HAVE_OPENMP)
+    tid = omp_get_thread_num();
+#endif
+    PetscPragmaOMP(for schedule(dynamic, 16))
+    for (PetscInt r = 0; r < m; r++) {
+      PetscInt        li = srow[r], np, *cols = gj + gi[r];
+      const PetscInt *idx;
+      PetscScalar    *g = gv + gi[r];
+      PetscReal       psi;
+      PetscBool       ok;
+
+      if (fsai->adaptive) {
+        np  = PCFSAIAdaptiveRow_Private(fsai, si, sj, sa, sdiag, li, &wk[tid], g, &psi, &ok);
+        idx = wk[tid].idx;
+      } else {
+        np  = fsai->pi[r + 1] - fsai->pi[r];
+        idx = sp + fsai->pi[r];
+        ok  = PCFSAISolveRow_Private(si, sj, sa, li, np, idx, wk[tid].dense, g, &psi);
+      }
+      status[r] = 0;
+      if (!ok) {
+        /* not positive definite, use the Jacobi row if the diagonal entry is positive */
+        np        = 0;
+        status[r] = PCFSAISolveRow_Private(si, sj, sa, li, 0, NULL, NULL, NULL, &psi) ? 1 : 2;
+        if (status[r] == 2) psi = 1.0;
+      }
+      for (PetscInt k = 0; k < np; k++) {
+        cols[k] = idx[k];
+        g[k]    = PetscConj(g[k]) / PetscSqrtReal(psi);
+      }
+      cols[np] = li;
+      g[np]    = 1.0 / PetscSqrtReal(psi);
+      gn[r]    = np + 1;
+    }
+  }
+
+  for (PetscInt r = m - 1; r >= 0; r--) {
+    if (status[r] == 1) nfail++;
+    if (status[r] == 2) nerr = r;
+  }
+  PetscCheck(nerr < 0, PETSC_COMM_SELF, PETSC_ERR_ARG_INCOMP, "PCFSAI requires a symmetric positive definite matrix, the diagonal entry of row %" PetscInt_FMT " is not positive", rstart + nerr);
+  /* compact the rows and give them the global column indices */
+  for (PetscInt r = 0; r < m; r++) {
+    PetscCall(PetscArraymove(gj + nz, gj + gi[r], gn[r]));
+    PetscCall(PetscArraymove(gv + nz, gv + gi[r], gn[r]));
+    gi[r] = nz;
+    nz += gn[r];
+    for (PetscInt k = gi[r]; k < nz; k++) gj[k] = U ? U[gj[k]] : gj[k] + shift;
+  }
+  gi[m] = nz;
+
+  PetscCall(MatCreate(PetscObjectComm((PetscObject)A), &fsai->G));
+  PetscCall(MatSetSizes(fsai->G, m, m, M, M));
+  PetscCall(MatSetType(fsai->G, ((PetscObject)A)->type_name));
+  PetscCall(MatSeqAIJSetPreallocationCSR(fsai->G, gi, gj, gv));
+  PetscCall(MatMPIAIJSetPreallocationCSR(fsai->G, gi, gj, gv));
+  PetscCall(MatHermitianTranspose(fsai->G, MAT_INITIAL_MATRIX, &fsai->Gt));
+  PetscCall(MatCreateVecs(fsai->G, NULL, &fsai->work));
+
+  PetscCall(MatGetInfo(A, MAT_GLOBAL_SUM, &info));
+  nzA = (info.nz_used + M) / 2;
+  PetscCall(MatGetInfo(fsai->G, MAT_GLOBAL_SUM, &info));
+  fsai->fill = nzA > 0 ? info.nz_used / nzA : 0.0;
+  PetscCall(MPIU_Allreduce(&nfail, &fsai->nfallback, 1, MPIU_INT, MPI_SUM, PetscObjectComm((PetscObject)pc)));
+  PetscCall(PetscInfo(pc, "Factor with %g times the nonzeros of the lower triangular part of the matrix, %" PetscInt_FMT " rows replaced by Jacobi rows\n", (double)fsai->fill, fsai->nfallback));
+
+  for (PetscInt t = 0; t < nt; t++) {
+    PetscCall(PetscFree2(wk[t].dense, wk[t].idx));
+    if (fsai->adaptive) {
+      PetscCall(PetscFree3(wk[t].w, wk[t].score, wk[t].cand));
+      PetscCall(PetscFree(wk[t].flag));
+    }
+  }
+  PetscCall(PetscFree(wk));
+  PetscCall(PetscFree2(gj, gv));
+  PetscCall(PetscFree(gi));
+  PetscCall(PetscFree(gn));
+  PetscCall(PetscFree(sdiag));
+  if (U) PetscCall(PetscFree(sp));
+  PetscCall(PetscFree2(srow, status));
+  PetscCall(MatSeqAIJRestoreArrayRead(S, &sa));
+  PetscCall(MatRestoreRowIJ(S, 0, PETSC_FALSE, PETSC_FALSE, &nS, &si, &sj, &done));
+  if (U) PetscCall(ISRestoreIndices(isU, &U));
+  PetscCall(ISDestroy(&isU));
+  if (subs) PetscCall(MatDestroySubMatrices(1, &subs));
+  PetscCall(MatDestroy(&A));
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
+
+static PetscErrorCode PCApply_FSAI(PC pc, Vec x, Vec y)
+{
+  PC_FSAI *fsai = (PC_FSAI *)pc->data;
+
+  PetscFunctionBegin;
+  PetscCall(MatMult(fsai->G, x, fsai->work));
+  PetscCall(MatMult(fsai->Gt, fsai->work, y));
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
+
+static PetscErrorCode PCApplyTranspose_FSAI(PC pc, Vec x, Vec y)
+{
+  PC_FSAI *fsai = (PC_FSAI *)pc->data;
+
+  PetscFunctionBegin;
+  PetscCall(MatMultTranspose(fsai->Gt, x, fsai->work));
+  PetscCall(MatMultTranspose(fsai->G, fsai->work, y));
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
+
+static PetscErrorCode PCApplySymmetricLeft_FSAI(PC pc, Vec x, Vec y)
+{
+  PC_FSAI *fsai = (PC_FSAI *)pc->data;
+
+  PetscFunctionBegin;
+  PetscCall(MatMult(fsai->G, x, y));
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
+
+static PetscErrorCode PCApplySymmetricRight_FSAI(PC pc, Vec x, Vec y)
+{
+  PC_FSAI *fsai = (PC_FSAI *)pc->data;
+
+  PetscFunctionBegin;
+  PetscCall(MatMult(fsai->Gt, x, y));
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
+
+static PetscErrorCode PCReset_FSAI(PC pc)
+{
+  PC_FSAI *fsai = (PC_FSAI *)pc->data;
+
+  PetscFunctionBegin;
+  PetscCall(MatDestroy(&fsai->G));
+  PetscCall(MatDestroy(&fsai->Gt));
+  PetscCall(VecDestroy(&fsai->work));
+  PetscCall(PetscFree2(fsai->pi, fsai->pj));
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
+
+static PetscErrorCode PCDestroy_FSAI(PC pc)
+{
+  PetscFunctionBegin;
+  PetscCall(PCReset_FSAI(pc));
+  PetscCall(PetscObjectComposeFunction((PetscObject)pc, "PCFSAISetLevels_C", NULL));
+  PetscCall(PetscObjectComposeFunction((PetscObject)pc, "PCFSAISetThreshold_C", NULL));
+  PetscCall(PetscObjectComposeFunction((PetscObject)pc, "PCFSAISetAdaptive_C", NULL));
+  PetscCall(PetscFree(pc->data));
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
+
+static PetscErrorCode PCSetFromOptions_FSAI(PC pc, PetscOptionItems *PetscOptionsObject)
+{
+  PC_FSAI  *fsai = (PC_FSAI *)pc->data;
+  PetscInt  levels = fsai->levels, maxsteps = fsai->maxsteps, stepsize = fsai->stepsize;
+  PetscReal threshold = fsai->threshold, tol = fsai->tol;
+  PetscBool adaptive = fsai->adaptive, flg1, flg2, flg3, flg4;
+
+  PetscFunctionBegin;
+  PetscOptionsHeadBegin(PetscOptionsObject, "FSAI options");
+  PetscCall(PetscOptionsBoundedInt("-pc_fsai_levels", "The static pattern is the lower triangular part of the pattern of A^levels", "PCFSAISetLevels", levels, &levels, &flg1, 1));
+  if (flg1) PetscCall(PCFSAISetLevels(pc, levels));
+  PetscCall(PetscOptionsReal("-pc_fsai_threshold", "Drop the entries of |D^{-1/2} A D^{-1/2}|^levels smaller than this from the static pattern", "PCFSAISetThreshold", threshold, &threshold, &flg1));
+  if (flg1) PetscCall(PCFSAISetThreshold(pc, threshold));
+  PetscCall(PetscOptionsBool("-pc_fsai_adaptive", "Compute the pattern of each row adaptively", "PCFSAISetAdaptive", adaptive, &adaptive, &flg1));
+  PetscCall(PetscOptionsBoundedInt("-pc_fsai_adaptive_max_steps", "Number of adaptive steps of each row", "PCFSAISetAdaptive", maxsteps, &maxsteps, &flg2, 0));
+  PetscCall(PetscOptionsBoundedInt("-pc_fsai_adaptive_step_size", "Number of entries added to a row by each adaptive step", "PCFSAISetAdaptive", stepsize, &stepsize, &flg3, 1));
+  PetscCall(PetscOptionsReal("-pc_fsai_adaptive_tolerance", "Relative decrease of the Kaporin number below which a row stops growing", "PCFSAISetAdaptive", tol, &tol, &flg4));
+  if (flg1 || flg2 || flg3 || flg4) PetscCall(PCFSAISetAdaptive(pc, adaptive, maxsteps, stepsize, tol));
+  PetscOptionsHeadEnd();
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
+
+static PetscErrorCode PCView_FSAI(PC pc, PetscViewer viewer)
+{
+  PC_FSAI  *fsai = (PC_FSAI *)pc->data;
+  PetscBool iascii;
+
+  PetscFunctionBegin;
+  PetscCall(PetscObjectTypeCompare((PetscObject)viewer, PETSCVIEWERASCII, &iascii));
+  if (iascii) {
+    if (fsai->adaptive) {
+      PetscCall(PetscViewerASCIIPrintf(viewer, "  adaptive pattern: %" PetscInt_FMT " steps of at most %" PetscInt_FMT " entries per row, tolerance %g\n", fsai->maxsteps, fsai->stepsize, (double)fsai->tol));
+    } else if (fsai->threshold > 0) {
+      PetscCall(PetscViewerASCIIPrintf(viewer, "  static pattern: lower triangular part of A^%" PetscInt_FMT ", threshold %g\n", fsai->levels, (double)fsai->threshold));
+    } else {
+      PetscCall(PetscViewerASCIIPrintf(viewer, "  static pattern: lower triangular part of A^%" PetscInt_FMT "\n", fsai->levels));
+    }
+    if (fsai->G) {
+      PetscCall(PetscViewerASCIIPrintf(viewer, "  factor nonzeros: %g times the lower triangular part of the matrix\n", (double)fsai->fill));
+      if (fsai->nfallback) PetscCall(PetscViewerASCIIPrintf(viewer, "  %" PetscInt_FMT " rows without a positive definite system replaced by Jacobi rows\n", fsai->nfallback));
+    }
+  }
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
+
+static PetscErrorCode PCFSAISetLevels_FSAI(PC pc, PetscInt levels)
+{
+  PC_FSAI *fsai = (PC_FSAI *)pc->data;
+
+  PetscFunctionBegin;
+  PetscCheck(levels >= 1, PetscObjectComm((PetscObject)pc), PETSC_ERR_ARG_OUTOFRANGE, "Number of levels %" PetscInt_FMT " must be at least 1", levels);
+  if (levels != fsai->levels) PetscCall(PetscFree2(fsai->pi, fsai->pj));
+  fsai->levels = levels;
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
+
+/*@
+  PCFSAISetLevels - Sets the power of the matrix whose pattern gives the static pattern of the `PCFSAI` factor
+
+  Logically Collective
+
+  Input Parameters:
++ pc     - the preconditioner context
+- levels - the static pattern of the factor is the lower triangular part of the pattern of A^levels, default 1
+
+  Options Database Key:
+. -pc_fsai_levels <1> - the power of the matrix
+
+  Level: intermediate
+
+  Note:
+  Larger powers give a more accurate factor with more nonzeros, use `PCFSAISetThreshold()` to keep the pattern sparse.
+
+.seealso: [](ch_ksp), `PCFSAI`, `PCFSAISetThreshold()`, `PCFSAISetAdaptive()`
+@*/
+PetscErrorCode PCFSAISetLevels(PC pc, PetscInt levels)
+{
+  PetscFunctionBegin;
+  PetscValidHeaderSpecific(pc, PC_CLASSID, 1);
+  PetscValidLogicalCollectiveInt(pc, levels, 2);
+  PetscTryMethod(pc, "PCFSAISetLevels_C", (PC, PetscInt), (pc, levels));
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
+
+static PetscErrorCode PCFSAISetThreshold_FSAI(PC pc, PetscReal threshold)
+{
+  PC_FSAI *fsai = (PC_FSAI *)pc->data;
+
+  PetscFunctionBegin;
+  if (threshold != fsai->threshold) PetscCall(PetscFree2(fsai->pi, fsai->pj));
+  fsai->threshold = threshold;
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
+
+/*@
+  PCFSAISetThreshold - Sets the threshold for dropping entries from the static pattern of the `PCFSAI` factor
+
+  Logically Collective
+
+  Input Parameters:
++ pc        - the preconditioner context
+- threshold - the entries of |D^{-1/2} A D^{-1/2}|^levels smaller than this are not in the pattern, where D is the diagonal of A, default 0
+
+  Options Database Key:
+. -pc_fsai_threshold <0> - the threshold
+
+  Level: intermediate
+
+.seealso: [](ch_ksp), `PCFSAI`, `PCFSAISetLevels()`, `PCFSAISetAdaptive()`
+@*/
+PetscErrorCode PCFSAISetThreshold(PC pc, PetscReal threshold)
+{
+  PetscFunctionBegin;
+  PetscValidHeaderSpecific(pc, PC_CLASSID, 1);
+  PetscValidLogicalCollectiveReal(pc, threshold, 2);
+  PetscTryMethod(pc, "PCFSAISetThreshold_C", (PC, PetscReal), (pc, threshold));
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
+
+static PetscErrorCode PCFSAISetAdaptive_FSAI(PC pc, PetscBool adaptive, PetscInt maxsteps, PetscInt stepsize, PetscReal tol)
+{
+  PC_FSAI *fsai = (PC_FSAI *)pc->data;
+
+  PetscFunctionBegin;
+  fsai->adaptive = adaptive;
+  if (maxsteps != PETSC_DEFAULT) {
+    PetscCheck(maxsteps >= 0, PetscObjectComm((PetscObject)pc), PETSC_ERR_ARG_OUTOFRANGE, "Number of adaptive steps %" PetscInt_FMT " cannot be negative", maxsteps);
+    fsai->maxsteps = maxsteps;
+  }
+  if (stepsize != PETSC_DEFAULT) {
+    PetscCheck(stepsize >= 1, PetscObjectComm((PetscObject)pc), PETSC_ERR_ARG_OUTOFRANGE, "Adaptive step size %" PetscInt_FMT " must be at least 1", stepsize);
+    fsai->stepsize = stepsize;
+  }
+  if (tol != (PetscReal)PETSC_DEFAULT) fsai->tol = tol;
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
+
+/*@
+  PCFSAISetAdaptive - Sets whether the pattern of the `PCFSAI` factor is computed adaptively, and the parameters of the adaptive pattern
+
+  Logically Collective
+
+  Input Parameters:
++ pc       - the preconditioner context
+. adaptive - `PETSC_TRUE` to compute the pattern adaptively
+. maxsteps - number of adaptive steps of each row, default 3
+. stepsize - number of entries added to a row by each adaptive step, default 5
+- tol      - a row stops growing once an adaptive step decreases its Kaporin number by less than `tol`, relatively, default 1.e-3
+
+  Options Database Keys:
++ -pc_fsai_adaptive                   - compute the pattern adaptively
+. -pc_fsai_adaptive_max_steps <3>     - number of adaptive steps
+. -pc_fsai_adaptive_step_size <5>     - entries added by each step
+- -pc_fsai_adaptive_tolerance <1.e-3> - relative decrease of the Kaporin number
+
+  Level: intermediate
+
+  Notes:
+  Use `PETSC_DEFAULT` to keep the current values of `maxsteps`, `stepsize` and `tol`.
+
+  Each row starts with its diagonal entry, and each step adds the entries to its left that most decrease the Kaporin condition
+  number of G A G^H, chosen from the columns of the rows already in the pattern. In parallel the adaptive pattern only
+  has the columns owned by the process, so the factor is block diagonal.
+
+.seealso: [](ch_ksp), `PCFSAI`, `PCFSAISetLevels()`, `PCFSAISetThreshold()`
+@*/
+PetscErrorCode PCFSAISetAdaptive(PC pc, PetscBool adaptive, PetscInt maxsteps, PetscInt stepsize, PetscReal tol)
+{
+  PetscFunctionBegin;
+  PetscValidHeaderSpecific(pc, PC_CLASSID, 1);
+  PetscValidLogicalCollectiveBool(pc, adaptive, 2);
+  PetscValidLogicalCollectiveInt(pc, maxsteps, 3);
+  PetscValidLogicalCollectiveInt(pc, stepsize, 4);
+  PetscValidLogicalCollectiveReal(pc, tol, 5);
+  PetscTryMethod(pc, "PCFSAISetAdaptive_C", (PC, PetscBool, PetscInt, PetscInt, PetscReal), (pc, adaptive, maxsteps, stepsize, tol));
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
+
+/*MC
+   PCFSAI - Factorized sparse approximate inverse preconditioner for symmetric, or Hermitian, positive definite matrices
+
+   Options Database Keys:
++  -pc_fsai_levels <1>                   - the static pattern is the lower triangular part of the pattern of A^levels
+.  -pc_fsai_threshold <0>                - drop the entries of |D^{-1/2} A D^{-1/2}|^levels smaller than this from the static pattern
+.  -pc_fsai_adaptive                     - compute the pattern of each row adaptively instead
+.  -pc_fsai_adaptive_max_steps <3>       - number of adaptive steps of each row
+.  -pc_fsai_adaptive_step_size <5>       - number of entries added to a row by each adaptive step
+-  -pc_fsai_adaptive_tolerance <1.e-3>   - relative decrease of the Kaporin number below which a row stops growing
+
+   Level: intermediate
+
+   Notes:
+   The preconditioner is G^H G, where the lower triangular G with a given sparsity pattern minimizes the Kaporin condition number
+   of G A G^H. Each row of G is computed from a small dense system with the entries of A in the
+   rows and columns of its pattern, independently of the other rows, so the rows are computed by the OpenMP threads. Applying the
+   preconditioner only needs `MatMult()` with G and G^H, which are `MATAIJ` matrices of the type of the preconditioning matrix, so
+   there are no triangular solves.
+
+   The static pattern is computed with the whole matrix and does not depend on the number of MPI processes, the rows of A needed
+   by the local rows of G are obtained with `MatCreateSubMatrices()`. The adaptive pattern only uses the
+   diagonal block of each process. Rows whose dense system is not positive definite are replaced by the row of the Jacobi preconditioner.
+
+   Matrices that are not `MATAIJ` are converted to `MATAIJ` first. `KSPCG` can be used since the preconditioner is symmetric, and
+   `PC_SYMMETRIC` applies G on the left and G^H on the right.
+
+   This complements `PCSPAI`, which computes an unfactored sparse approximate inverse with an external package, and `PCJACOBI`, which is
+   `PCFSAI` with the pattern of the diagonal.
+
+   References:
++  * - L. Yu. Kolotilina and A. Yu. Yeremin, Factorized sparse approximate inverse preconditionings I. Theory, SIAM J. Matrix Anal. Appl. 14 (1993)
+-  * - C. Janna and M. Ferronato, Adaptive pattern research for block FSAI preconditioning, SIAM J. Sci. Comput. 33 (2011)
+
+.seealso: [](ch_ksp), `PCCreate()`, `PCSetType()`, `PCType`, `PC`, `PCFSAISetLevels()`, `PCFSAISetThreshold()`, `PCFSAISetAdaptive()`,
+          `PCSPAI`, `PCJACOBI`, `PCICC`
+M*/
+
+PETSC_EXTERN PetscErrorCode PCCreate_FSAI(PC pc)
+{
+  PC_FSAI *fsai;
+
+  PetscFunctionBegin;
+  PetscCall(PetscNew(&fsai));
+  fsai->levels   = 1;
+  fsai->maxsteps = 3;
+  fsai->stepsize = 5;
+  fsai->tol      = 1.e-3;
+  pc->data       = (void *)fsai;
+
+  pc->ops->apply               = PCApply_FSAI;
+  pc->ops->applytranspose      = PCApplyTranspose_FSAI;
+  pc->ops->applysymmetricleft  = PCApplySymmetricLeft_FSAI;
+  pc->ops->applysymmetricright = PCApplySymmetricRight_FSAI;
+  pc->ops->setup               = PCSetUp_FSAI;
+  pc->ops->reset               = PCReset_FSAI;
+  pc->ops->destroy             = PCDestroy_FSAI;
+  pc->ops->setfromoptions      = PCSetFromOptions_FSAI;
+  pc->ops->view                = PCView_FSAI;
+  PetscCall(PetscObjectComposeFunction((PetscObject)pc, "PCFSAISetLevels_C", PCFSAISetLevels_FSAI));
+  PetscCall(PetscObjectComposeFunction((PetscObject)pc, "PCFSAISetThreshold_C", PCFSAISetThreshold_FSAI));
+  PetscCall(PetscObjectComposeFunction((PetscObject)pc, "PCFSAISetAdaptive_C", PCFSAISetAdaptive_FSAI));
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
@@ -421,8 +421,14 @@ PetscErrorCode PCSORSetIterations(PC pc, PetscInt its, PetscInt lits)
 
           If omega != 1, you will need to set the `MAT_USE_INODES` option to `PETSC_FALSE` on the matrix.
 
+          With the matrix option -mat_sor_multicolor the (local) `MATSEQAIJ` or `MATSEQBAIJ` matrix is colored once with `MatColoringApply()`,
+          of type -mat_sor_multicolor_type (greedy by default), and the sweeps relax the rows of one color concurrently with OpenMP threads,
+          the colors in increasing order for forward sweeps and decreasing order for backward sweeps. This is SOR of the matrix
+          permuted by colors, so it usually needs more iterations than SOR in the natural ordering. It also supports `PCEISENSTAT`
+          and, for `MATSEQBAIJ`, omega != 1.
+
 .seealso: [](ch_ksp), `PCCreate()`, `PCSetType()`, `PCType`, `PC`, `PCJACOBI`,
-          `PCSORSetIterations()`, `PCSORSetSymmetric()`, `PCSORSetOmega()`, `PCEISENSTAT`, `MatSetOption()`
+          `PCSORSetIterations()`, `PCSORSetSymmetric()`, `PCSORSetOmega()`, `PCEISENSTAT`, `MatSetOption()`, `MatColoring`
 M*/
 
 PETSC_EXTERN PetscErrorCode PCCreate_SOR(PC pc)
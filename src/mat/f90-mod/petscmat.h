@@ -71,7 +71,8 @@
       PetscEnum, parameter :: MAT_FORM_EXPLICIT_TRANSPOSE = 24
       PetscEnum, parameter :: MAT_STRUCTURAL_SYMMETRY_ETERNAL = 25
       PetscEnum, parameter :: MAT_SPD_ETERNAL = 26
-      PetscEnum, parameter :: MAT_OPTION_MAX = 27
+      PetscEnum, parameter :: MAT_THREADED_ASSEMBLY = 27
+      PetscEnum, parameter :: MAT_OPTION_MAX = 28
 !
 !  MatFactorShiftType
 !
@@ -311,6 +312,7 @@
       PetscEnum, parameter :: MATOP_DESTROYSUBMATRICES=145
       PetscEnum, parameter :: MATOP_TRANSPOSE_SOLVE=146
       PetscEnum, parameter :: MATOP_GET_VALUES_LOCAL=147
+      PetscEnum, parameter :: MATOP_MULT_DOT=152
 !
 ! MatProduct
       PetscEnum, parameter :: MATPRODUCT_UNSPECIFIED=0
@@ -623,6 +625,7 @@
 !DEC$ ATTRIBUTES DLLEXPORT::MATOP_DESTROYSUBMATRICES
 !DEC$ ATTRIBUTES DLLEXPORT::MATOP_TRANSPOSE_SOLVE
 !DEC$ ATTRIBUTES DLLEXPORT::MATOP_GET_VALUES_LOCAL
+!DEC$ ATTRIBUTES DLLEXPORT::MATOP_MULT_DOT
 !DEC$ ATTRIBUTES DLLEXPORT::MATPRODUCT_UNSPECIFIED
 !DEC$ ATTRIBUTES DLLEXPORT::MATPRODUCT_AB
 !DEC$ ATTRIBUTES DLLEXPORT::MATPRODUCT_AtB
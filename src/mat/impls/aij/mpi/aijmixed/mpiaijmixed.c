@@ -0,0 +1,79 @@
+#include <../src/mat/impls/aij/mpi/mpiaij.h>
+
+PETSC_INTERN PetscErrorCode MatConvert_SeqAIJ_SeqAIJMixed(Mat, MatType, MatReuse, Mat *);
+
+static PetscErrorCode MatMPIAIJSetPreallocation_MPIAIJMixed(Mat B, PetscInt d_nz, const PetscInt d_nnz[], PetscInt o_nz, const PetscInt o_nnz[])
+{
+  Mat_MPIAIJ *b = (Mat_MPIAIJ *)B->data;
+
+  PetscFunctionBegin;
+  PetscCall(MatMPIAIJSetPreallocation_MPIAIJ(B, d_nz, d_nnz, o_nz, o_nnz));
+  PetscCall(MatConvert_SeqAIJ_SeqAIJMixed(b->A, MATSEQAIJMIXED, MAT_INPLACE_MATRIX, &b->A));
+  PetscCall(MatConvert_SeqAIJ_SeqAIJMixed(b->B, MATSEQAIJMIXED, MAT_INPLACE_MATRIX, &b->B));
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
+
+PETSC_INTERN PetscErrorCode MatConvert_MPIAIJ_MPIAIJMixed(Mat A, MatType type, MatReuse reuse, Mat *newmat)
+{
+  Mat         B = *newmat;
+  Mat_MPIAIJ *b;
+
+  PetscFunctionBegin;
+  if (reuse == MAT_INITIAL_MATRIX) PetscCall(MatDuplicate(A, MAT_COPY_VALUES, &B));
+
+  /* the local blocks of a preallocated matrix are converted here, otherwise in MatMPIAIJSetPreallocation() */
+  b = (Mat_MPIAIJ *)B->data;
+  if (b->A) PetscCall(MatConvert_SeqAIJ_SeqAIJMixed(b->A, MATSEQAIJMIXED, MAT_INPLACE_MATRIX, &b->A));
+  if (b->B) PetscCall(MatConvert_SeqAIJ_SeqAIJMixed(b->B, MATSEQAIJMIXED, MAT_INPLACE_MATRIX, &b->B));
+
+  B->ops->multdot = NULL; /* MatMultDot_MPIAIJ() would use the full precision entries of the off-diagonal block */
+  PetscCall(PetscObjectChangeTypeName((PetscObject)B, MATMPIAIJMIXED));
+  PetscCall(PetscObjectComposeFunction((PetscObject)B, "MatMPIAIJSetPreallocation_C", MatMPIAIJSetPreallocation_MPIAIJMixed));
+  *newmat = B;
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
+
+PETSC_EXTERN PetscErrorCode MatCreate_MPIAIJMixed(Mat A)
+{
+  PetscFunctionBegin;
+  PetscCall(MatSetType(A, MATMPIAIJ));
+  PetscCall(MatConvert_MPIAIJ_MPIAIJMixed(A, MATMPIAIJMIXED, MAT_INPLACE_MATRIX, &A));
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
+
+/*MC
+   MATMPIAIJMIXED - MATMPIAIJMIXED = "mpiaijmixed" - A parallel sparse matrix type whose diagonal and off-diagonal
+   blocks are `MATSEQAIJMIXED` matrices, so that its products with vectors use single precision matrix entries.
+
+   Options Database Key:
+. -mat_type mpiaijmixed - sets the matrix type to `MATMPIAIJMIXED` during a call to `MatSetFromOptions()`
+
+   Level: intermediate
+
+.seealso: [](ch_matrices), `Mat`, `MATAIJMIXED`, `MATSEQAIJMIXED`, `MATMPIAIJ`, `MatConvert()`
+M*/
+
+/*MC
+   MATAIJMIXED - "aijmixed" - A matrix type whose products with vectors use single precision matrix entries while the
+   vectors and the arithmetic keep full precision.
+
+   This matrix type is identical to `MATSEQAIJMIXED` when constructed with a single process communicator,
+   and `MATMPIAIJMIXED` otherwise.  As a result, for single process communicators,
+   `MatSeqAIJSetPreallocation()` is supported, and similarly `MatMPIAIJSetPreallocation()` is supported
+   for communicators controlling multiple processes.  It is recommended that you call both of
+   the above preallocation routines for simplicity.
+
+   Options Database Key:
+. -mat_type aijmixed - sets the matrix type to `MATAIJMIXED`
+
+  Level: intermediate
+
+  Note:
+  To precondition with a single precision copy of the operator, use
+.vb
+   MatConvert(A, MATAIJMIXED, MAT_INITIAL_MATRIX, &P);
+   KSPSetOperators(ksp, A, P);
+.ve
+
+.seealso: [](ch_matrices), `Mat`, `MATSEQAIJMIXED`, `MATMPIAIJMIXED`, `MATSEQAIJ`, `MATMPIAIJ`, `MATAIJSELL`
+M*/
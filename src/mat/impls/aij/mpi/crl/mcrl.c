@@ -124,6 +124,7 @@ PETSC_INTERN PetscErrorCode MatConvert_MPIAIJ_MPIAIJCRL(Mat A, MatType type, Mat
   B->ops->assemblyend = MatAssemblyEnd_MPIAIJCRL;
   B->ops->destroy     = MatDestroy_MPIAIJCRL;
   B->ops->mult        = MatMult_AIJCRL;
+  B->ops->multdot     = NULL;
 
   /* If A has already been assembled, compute the permutation. */
   if (A->assembled) PetscCall(MatMPIAIJCRL_create_aijcrl(B));
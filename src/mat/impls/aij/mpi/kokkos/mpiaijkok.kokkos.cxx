@@ -1737,6 +1737,7 @@ static PetscErrorCode MatSetOps_MPIAIJKokkos(Mat B)
   B->ops->assemblyend           = MatAssemblyEnd_MPIAIJKokkos;
   B->ops->mult                  = MatMult_MPIAIJKokkos;
   B->ops->multadd               = MatMultAdd_MPIAIJKokkos;
+  B->ops->multdot               = NULL;
   B->ops->multtranspose         = MatMultTranspose_MPIAIJKokkos;
   B->ops->productsetfromoptions = MatProductSetFromOptions_MPIAIJKokkos;
   B->ops->destroy               = MatDestroy_MPIAIJKokkos;
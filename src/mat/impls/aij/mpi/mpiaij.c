@@ -68,6 +68,9 @@ PetscErrorCode MatDestroy_MPIAIJ(Mat mat)
   PetscCall(PetscObjectComposeFunction((PetscObject)mat, "MatMPIAIJSetUseScalableIncreaseOverlap_C", NULL));
   PetscCall(PetscObjectComposeFunction((PetscObject)mat, "MatConvert_mpiaij_mpiaijperm_C", NULL));
   PetscCall(PetscObjectComposeFunction((PetscObject)mat, "MatConvert_mpiaij_mpiaijsell_C", NULL));
+#if !defined(PETSC_USE_COMPLEX)
+  PetscCall(PetscObjectComposeFunction((PetscObject)mat, "MatConvert_mpiaij_mpiaijmixed_C", NULL));
+#endif
 #if defined(PETSC_HAVE_MKL_SPARSE)
   PetscCall(PetscObjectComposeFunction((PetscObject)mat, "MatConvert_mpiaij_mpiaijmkl_C", NULL));
 #endif
@@ -420,6 +423,7 @@ PetscErrorCode MatCreateColmap_MPIAIJ_Private(Mat mat)
     rp1[_i] = col; \
     ap1[_i] = value; \
     A->nonzerostate++; \
+    MatSeqAIJMarkDirtyRow_Private(a, row, N + 1); \
   a_noinsert:; \
     ailen[row] = nrow1; \
   } while (0)
@@ -465,6 +469,7 @@ PetscErrorCode MatCreateColmap_MPIAIJ_Private(Mat mat)
     rp2[_i] = col; \
     ap2[_i] = value; \
     B->nonzerostate++; \
+    MatSeqAIJMarkDirtyRow_Private(b, row, N + 1); \
   b_noinsert:; \
     bilen[row] = nrow2; \
   } while (0)
@@ -608,6 +613,7 @@ PetscErrorCode MatSetValues_MPIAIJ(Mat mat, PetscInt m, const PetscInt im[], Pet
         } else {
           PetscCall(MatStashValuesCol_Private(&mat->stash, im[i], n, in, PetscSafePointerPlusOffset(v, i), m, (PetscBool)(ignorezeroentries && (addv == ADD_VALUES))));
         }
+        if (mat->stash.flush_size) PetscCall(MatStashFlush_Private(mat, &mat->stash, mat->rmap->range));
       }
     }
   }
@@ -1049,6 +1055,51 @@ static PetscErrorCode MatMult_MPIAIJ(Mat A, Vec xx, Vec yy)
   PetscFunctionReturn(PETSC_SUCCESS);
 }
 
+/* the off-diagonal part is added row by row to the product with the diagonal block, accumulating the local inner products */
+static PetscErrorCode MatMultDot_MPIAIJ(Mat A, Vec xx, Vec yy, PetscScalar *xdoty, PetscReal *xnorm, PetscReal *ynorm)
+{
+  Mat_MPIAIJ        *a = (Mat_MPIAIJ *)A->data;
+  Mat_SeqAIJ        *b = (Mat_SeqAIJ *)a->B->data;
+  PetscInt           nt, m = A->rmap->n, n;
+  VecScatter         Mvctx = a->Mvctx;
+  const PetscScalar *x, *lx;
+  const MatScalar   *ba;
+  PetscScalar       *y, sum, local[3] = {0.0, 0.0, 0.0}, global[3];
+
+  PetscFunctionBegin;
+  PetscCall(VecGetLocalSize(xx, &nt));
+  PetscCheck(nt == A->cmap->n, PETSC_COMM_SELF, PETSC_ERR_ARG_SIZ, "Incompatible partition of A (%" PetscInt_FMT ") and xx (%" PetscInt_FMT ")", A->cmap->n, nt);
+  PetscCall(VecScatterBegin(Mvctx, xx, a->lvec, INSERT_VALUES, SCATTER_FORWARD));
+  PetscUseTypeMethod(a->A, mult, xx, yy);
+  PetscCall(VecScatterEnd(Mvctx, xx, a->lvec, INSERT_VALUES, SCATTER_FORWARD));
+  PetscCall(MatSeqAIJGetArrayRead(a->B, &ba));
+  PetscCall(VecGetArrayRead(xx, &x));
+  PetscCall(VecGetArrayRead(a->lvec, &lx));
+  PetscCall(VecGetArray(yy, &y));
+  for (PetscInt i = 0; i < m; i++) {
+    const PetscInt  *idx = b->j + b->i[i];
+    const MatScalar *v   = ba + b->i[i];
+
+    n   = b->i[i + 1] - b->i[i];
+    sum = y[i];
+    PetscSparseDensePlusDot(sum, lx, v, idx, n);
+    y[i] = sum;
+    local[0] += x[i] * PetscConj(sum);
+    local[1] += x[i] * PetscConj(x[i]);
+    local[2] += sum * PetscConj(sum);
+  }
+  PetscCall(PetscLogFlops(2.0 * b->nz + 6.0 * m));
+  PetscCall(VecRestoreArray(yy, &y));
+  PetscCall(VecRestoreArrayRead(a->lvec, &lx));
+  PetscCall(VecRestoreArrayRead(xx, &x));
+  PetscCall(MatSeqAIJRestoreArrayRead(a->B, &ba));
+  PetscCall(MPIU_Allreduce(local, global, 3, MPIU_SCALAR, MPIU_SUM, PetscObjectComm((PetscObject)A)));
+  *xdoty = global[0];
+  *xnorm = PetscSqrtReal(PetscRealPart(global[1]));
+  *ynorm = PetscSqrtReal(PetscRealPart(global[2]));
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
+
 static PetscErrorCode MatMultDiagonalBlock_MPIAIJ(Mat A, Vec bb, Vec xx)
 {
   Mat_MPIAIJ *a = (Mat_MPIAIJ *)A->data;
@@ -2857,7 +2908,8 @@ static struct _MatOps MatOps_Values = {MatSetValues_MPIAIJ,
                                        MatCreateGraph_Simple_AIJ,
                                        NULL,
                                        /*150*/ NULL,
-                                       MatEliminateZeros_MPIAIJ};
+                                       MatEliminateZeros_MPIAIJ,
+                                       MatMultDot_MPIAIJ};
 
 static PetscErrorCode MatStoreValues_MPIAIJ(Mat mat)
 {
@@ -3034,7 +3086,7 @@ PetscErrorCode MatLoad_MPIAIJ(Mat newMat, PetscViewer viewer)
 
 PetscErrorCode MatLoad_MPIAIJ_Binary(Mat mat, PetscViewer viewer)
 {
-  PetscInt     header[4], M, N, m, nz, rows, cols, sum, i;
+  PetscInt     header[4], M, N, m, nz, sum, i;
   PetscInt    *rowidxs, *colidxs;
   PetscScalar *matvals;
 
@@ -3056,17 +3108,21 @@ PetscErrorCode MatLoad_MPIAIJ_Binary(Mat mat, PetscViewer viewer)
   /* set global sizes if not set already */
   if (mat->rmap->N < 0) mat->rmap->N = M;
   if (mat->cmap->N < 0) mat->cmap->N = N;
-  PetscCall(PetscLayoutSetUp(mat->rmap));
-  PetscCall(PetscLayoutSetUp(mat->cmap));
 
   /* check if the matrix sizes are correct */
-  PetscCall(MatGetSize(mat, &rows, &cols));
-  PetscCheck(M == rows && N == cols, PETSC_COMM_SELF, PETSC_ERR_FILE_UNEXPECTED, "Matrix in file of different sizes (%" PetscInt_FMT ", %" PetscInt_FMT ") than the input matrix (%" PetscInt_FMT ", %" PetscInt_FMT ")", M, N, rows, cols);
+  PetscCheck(M == mat->rmap->N && N == mat->cmap->N, PETSC_COMM_SELF, PETSC_ERR_FILE_UNEXPECTED, "Matrix in file of different sizes (%" PetscInt_FMT ", %" PetscInt_FMT ") than the input matrix (%" PetscInt_FMT ", %" PetscInt_FMT ")", M, N, mat->rmap->N, mat->cmap->N);
+
+  /* set local sizes balancing the nonzeros if requested, then rowidxs holds the local row lengths */
+  PetscCall(MatLoad_Binary_BalanceRows(mat, viewer, &rowidxs));
+  PetscCall(PetscLayoutSetUp(mat->rmap));
+  PetscCall(PetscLayoutSetUp(mat->cmap));
 
   /* read in row lengths and build row indices */
   PetscCall(MatGetLocalSize(mat, &m, NULL));
-  PetscCall(PetscMalloc1(m + 1, &rowidxs));
-  PetscCall(PetscViewerBinaryReadAll(viewer, rowidxs + 1, m, PETSC_DECIDE, M, PETSC_INT));
+  if (!rowidxs) {
+    PetscCall(PetscMalloc1(m + 1, &rowidxs));
+    PetscCall(PetscViewerBinaryReadAll(viewer, rowidxs + 1, m, PETSC_DECIDE, M, PETSC_INT));
+  }
   rowidxs[0] = 0;
   for (i = 0; i < m; i++) rowidxs[i + 1] += rowidxs[i];
   if (nz != PETSC_MAX_INT) {
@@ -6011,6 +6067,9 @@ PetscErrorCode MatGetBrowsOfAoCols_MPIAIJ(Mat A, Mat B, MatReuse scall, PetscInt
 PETSC_INTERN PetscErrorCode MatConvert_MPIAIJ_MPIAIJCRL(Mat, MatType, MatReuse, Mat *);
 PETSC_INTERN PetscErrorCode MatConvert_MPIAIJ_MPIAIJPERM(Mat, MatType, MatReuse, Mat *);
 PETSC_INTERN PetscErrorCode MatConvert_MPIAIJ_MPIAIJSELL(Mat, MatType, MatReuse, Mat *);
+#if !defined(PETSC_USE_COMPLEX)
+PETSC_INTERN PetscErrorCode MatConvert_MPIAIJ_MPIAIJMixed(Mat, MatType, MatReuse, Mat *);
+#endif
 #if defined(PETSC_HAVE_MKL_SPARSE)
 PETSC_INTERN PetscErrorCode MatConvert_MPIAIJ_MPIAIJMKL(Mat, MatType, MatReuse, Mat *);
 #endif
@@ -6380,6 +6439,8 @@ static PetscErrorCode MatCOOStructDestroy_MPIAIJ(void *data)
   PetscCall(PetscFree(coo->Ajmap2));
   PetscCall(PetscFree(coo->Bjmap2));
   PetscCall(PetscFree(coo->Cperm1));
+  PetscCall(PetscFree(coo->Atstart));
+  PetscCall(PetscFree(coo->Btstart));
   PetscCall(PetscFree2(coo->sendbuf, coo->recvbuf));
   PetscCall(PetscFree(coo));
   PetscFunctionReturn(PETSC_SUCCESS);
@@ -6670,8 +6731,9 @@ PetscErrorCode MatSetPreallocationCOO_MPIAIJ(Mat mat, PetscCount coo_n, PetscInt
   MatType          rtype;
   Mat_SeqAIJ      *a, *b;
   PetscObjectState state;
-  PetscCall(PetscCalloc1(Annz, &Aa)); /* Zero matrix on device */
-  PetscCall(PetscCalloc1(Bnnz, &Ba));
+  PetscCall(PetscMalloc1(1, &coo));
+  PetscCall(MatSeqAIJCOOSetUpThreads_Private(Annz, &Ajmap1, &Aperm1, &Aa, &coo->Anthreads, &coo->Atstart)); /* Zero matrix on device */
+  PetscCall(MatSeqAIJCOOSetUpThreads_Private(Bnnz, &Bjmap1, &Bperm1, &Ba, &coo->Bnthreads, &coo->Btstart));
   /* make Aj[] local, i.e, based off the start column of the diagonal portion */
   if (cstart) {
     for (k = 0; k < Annz; k++) Aj[k] -= cstart;
@@ -6699,7 +6761,6 @@ PetscErrorCode MatSetPreallocationCOO_MPIAIJ(Mat mat, PetscCount coo_n, PetscInt
   PetscCall(MatCreateVecs(mpiaij->B, &mpiaij->lvec, NULL));
 
   // Put the COO struct in a container and then attach that to the matrix
-  PetscCall(PetscMalloc1(1, &coo));
   coo->n       = coo_n;
   coo->sf      = sf2;
   coo->sendlen = nleaves;
@@ -6768,27 +6829,22 @@ static PetscErrorCode MatSetValuesCOO_MPIAIJ(Mat mat, const PetscScalar v[], Ins
   PetscCall(MatSeqAIJGetArray(B, &Ba));
 
   /* Pack entries to be sent to remote */
+  PetscPragmaOMP(parallel for schedule(static) num_threads((int)coo->Anthreads) if (coo->Anthreads > 1))
   for (PetscCount i = 0; i < coo->sendlen; i++) sendbuf[i] = v[Cperm1[i]];
 
   /* Send remote entries to their owner and overlap the communication with local computation */
   PetscCall(PetscSFReduceWithMemTypeBegin(coo->sf, MPIU_SCALAR, PETSC_MEMTYPE_HOST, sendbuf, PETSC_MEMTYPE_HOST, recvbuf, MPI_REPLACE));
-  /* Add local entries to A and B */
-  for (PetscCount i = 0; i < coo->Annz; i++) { /* All nonzeros in A are either zero'ed or added with a value (i.e., initialized) */
-    PetscScalar sum = 0.0;                     /* Do partial summation first to improve numerical stability */
-    for (PetscCount k = Ajmap1[i]; k < Ajmap1[i + 1]; k++) sum += v[Aperm1[k]];
-    Aa[i] = (imode == INSERT_VALUES ? 0.0 : Aa[i]) + sum;
-  }
-  for (PetscCount i = 0; i < coo->Bnnz; i++) {
-    PetscScalar sum = 0.0;
-    for (PetscCount k = Bjmap1[i]; k < Bjmap1[i + 1]; k++) sum += v[Bperm1[k]];
-    Ba[i] = (imode == INSERT_VALUES ? 0.0 : Ba[i]) + sum;
-  }
+  /* Add local entries to A and B. All nonzeros in A are either zero'ed or added with a value (i.e., initialized) */
+  MatSeqAIJCOOSetValues_Private(coo->Anthreads, coo->Atstart, Ajmap1, Aperm1, v, imode, Aa);
+  MatSeqAIJCOOSetValues_Private(coo->Bnthreads, coo->Btstart, Bjmap1, Bperm1, v, imode, Ba);
   PetscCall(PetscSFReduceEnd(coo->sf, MPIU_SCALAR, sendbuf, recvbuf, MPI_REPLACE));
 
-  /* Add received remote entries to A and B */
+  /* Add received remote entries to A and B, Aimap2[] and Bimap2[] have no repeats so the nonzeros can be divided among threads */
+  PetscPragmaOMP(parallel for schedule(static) num_threads((int)coo->Anthreads) if (coo->Anthreads > 1))
   for (PetscCount i = 0; i < coo->Annz2; i++) {
     for (PetscCount k = Ajmap2[i]; k < Ajmap2[i + 1]; k++) Aa[Aimap2[i]] += recvbuf[Aperm2[k]];
   }
+  PetscPragmaOMP(parallel for schedule(static) num_threads((int)coo->Bnthreads) if (coo->Bnthreads > 1))
   for (PetscCount i = 0; i < coo->Bnnz2; i++) {
     for (PetscCount k = Bjmap2[i]; k < Bjmap2[i + 1]; k++) Ba[Bimap2[i]] += recvbuf[Bperm2[k]];
   }
@@ -6862,6 +6918,9 @@ PETSC_EXTERN PetscErrorCode MatCreate_MPIAIJ(Mat B)
   PetscCall(PetscObjectComposeFunction((PetscObject)B, "MatDiagonalScaleLocal_C", MatDiagonalScaleLocal_MPIAIJ));
   PetscCall(PetscObjectComposeFunction((PetscObject)B, "MatConvert_mpiaij_mpiaijperm_C", MatConvert_MPIAIJ_MPIAIJPERM));
   PetscCall(PetscObjectComposeFunction((PetscObject)B, "MatConvert_mpiaij_mpiaijsell_C", MatConvert_MPIAIJ_MPIAIJSELL));
+#if !defined(PETSC_USE_COMPLEX)
+  PetscCall(PetscObjectComposeFunction((PetscObject)B, "MatConvert_mpiaij_mpiaijmixed_C", MatConvert_MPIAIJ_MPIAIJMixed));
+#endif
 #if defined(PETSC_HAVE_CUDA)
   PetscCall(PetscObjectComposeFunction((PetscObject)B, "MatConvert_mpiaij_mpiaijcusparse_C", MatConvert_MPIAIJ_MPIAIJCUSPARSE));
 #endif
@@ -8138,6 +8197,7 @@ PETSC_EXTERN void matsetvaluesmpiaij_(Mat *mmat, PetscInt *mm, const PetscInt im
         } else {
           PetscCall(MatStashValuesCol_Private(&mat->stash, im[i], n, in, v + i, m, (PetscBool)(ignorezeroentries && (addv == ADD_VALUES))));
         }
+        if (mat->stash.flush_size) PetscCall(MatStashFlush_Private(mat, &mat->stash, mat->rmap->range));
       }
     }
     PetscCall(MatSeqAIJRestoreArray(A, &aa));
@@ -84,6 +84,8 @@ typedef struct {
   PetscCount  *Aimap2, *Ajmap2, *Aperm2;   /* Lengths: [Annz2], [Annz2+1], [Atot2]. Remote entries to diag */
   PetscCount  *Bimap2, *Bjmap2, *Bperm2;   /* Lengths: [Bnnz2], [Bnnz2+1], [Btot2]. Remote entries to offdiag */
   PetscCount  *Cperm1;                     /* [sendlen] Permutation to fill MPI send buffer. 'C' for communication */
+  PetscInt     Anthreads, Bnthreads;       /* Number of OpenMP threads setting the local entries of A and B in MatSetValuesCOO() */
+  PetscCount  *Atstart, *Btstart;          /* Lengths: [Anthreads+1], [Bnthreads+1]. Nonzeros of A and B set by each thread */
   PetscScalar *sendbuf, *recvbuf;          /* Buffers for remote values in MatSetValuesCOO() */
   PetscInt     sendlen, recvlen;           /* Lengths (in unit of PetscScalar) of send/recvbuf */
 } MatCOOStruct_MPIAIJ;
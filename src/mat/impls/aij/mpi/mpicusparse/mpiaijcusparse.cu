@@ -480,6 +480,7 @@ PETSC_INTERN PetscErrorCode MatConvert_MPIAIJ_MPIAIJCUSPARSE(Mat B, MatType, Mat
   A->ops->assemblyend           = MatAssemblyEnd_MPIAIJCUSPARSE;
   A->ops->mult                  = MatMult_MPIAIJCUSPARSE;
   A->ops->multadd               = MatMultAdd_MPIAIJCUSPARSE;
+  A->ops->multdot               = NULL;
   A->ops->multtranspose         = MatMultTranspose_MPIAIJCUSPARSE;
   A->ops->setfromoptions        = MatSetFromOptions_MPIAIJCUSPARSE;
   A->ops->destroy               = MatDestroy_MPIAIJCUSPARSE;
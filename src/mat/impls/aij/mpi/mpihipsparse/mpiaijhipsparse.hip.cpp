@@ -458,6 +458,7 @@ PETSC_INTERN PetscErrorCode MatConvert_MPIAIJ_MPIAIJHIPSPARSE(Mat B, MatType mty
   A->ops->assemblyend           = MatAssemblyEnd_MPIAIJHIPSPARSE;
   A->ops->mult                  = MatMult_MPIAIJHIPSPARSE;
   A->ops->multadd               = MatMultAdd_MPIAIJHIPSPARSE;
+  A->ops->multdot               = NULL;
   A->ops->multtranspose         = MatMultTranspose_MPIAIJHIPSPARSE;
   A->ops->setfromoptions        = MatSetFromOptions_MPIAIJHIPSPARSE;
   A->ops->destroy               = MatDestroy_MPIAIJHIPSPARSE;
@@ -149,9 +149,11 @@ PetscErrorCode MatPtAPNumeric_MPIAIJ_MPIAIJ_scalable(Mat A, Mat P, Mat C)
   PetscCheck(api[AP_loc->rmap->n] == nout, PETSC_COMM_SELF, PETSC_ERR_ARG_INCOMP, "Incorrect mapping %" PetscInt_FMT " != %" PetscInt_FMT, api[AP_loc->rmap->n], nout);
 
   /* 3) C_loc = Rd*AP_loc, C_oth = Ro*AP_loc */
-  /* Always use scalable version since we are in the MPI scalable version */
-  PetscCall(MatMatMultNumeric_SeqAIJ_SeqAIJ_Scalable(ptap->Rd, AP_loc, ptap->C_loc));
-  PetscCall(MatMatMultNumeric_SeqAIJ_SeqAIJ_Scalable(ptap->Ro, AP_loc, ptap->C_oth));
+  /* Always use scalable version since we are in the MPI scalable version, threaded when selected with the options prefix of the product */
+  if (ptap->C_loc->ops->matmultnumeric == MatMatMultNumeric_SeqAIJ_SeqAIJ_Threaded) PetscCall(MatMatMultNumeric_SeqAIJ_SeqAIJ_Threaded(ptap->Rd, AP_loc, ptap->C_loc));
+  else PetscCall(MatMatMultNumeric_SeqAIJ_SeqAIJ_Scalable(ptap->Rd, AP_loc, ptap->C_loc));
+  if (ptap->C_oth->ops->matmultnumeric == MatMatMultNumeric_SeqAIJ_SeqAIJ_Threaded) PetscCall(MatMatMultNumeric_SeqAIJ_SeqAIJ_Threaded(ptap->Ro, AP_loc, ptap->C_oth));
+  else PetscCall(MatMatMultNumeric_SeqAIJ_SeqAIJ_Scalable(ptap->Ro, AP_loc, ptap->C_oth));
 
   C_loc = ptap->C_loc;
   C_oth = ptap->C_oth;
@@ -7,6 +7,7 @@
 #include <petscblaslapack.h>
 #include <petscbt.h>
 #include <petsc/private/kernels/blocktranspose.h>
+#include <petsc/private/viewerimpl.h>
 
 /* defines MatSetValues_Seq_Hash(), MatAssemblyEnd_Seq_Hash(), MatSetUp_Seq_Hash() */
 #define TYPE AIJ
@@ -469,6 +470,7 @@ PetscErrorCode MatSetValues_SeqAIJ(Mat A, PetscInt m, const PetscInt im[], Petsc
       }
       low = i + 1;
       A->nonzerostate++;
+      MatSeqAIJMarkDirtyRow_Private(a, row, N + 1);
     noinsert:;
     }
     ailen[row] = nrow;
@@ -716,7 +718,19 @@ static PetscErrorCode MatView_SeqAIJ_ASCII(Mat A, PetscViewer viewer)
   }
 
   PetscCall(PetscViewerGetFormat(viewer, &format));
-  if (format == PETSC_VIEWER_ASCII_FACTOR_INFO || format == PETSC_VIEWER_ASCII_INFO || format == PETSC_VIEWER_ASCII_INFO_DETAIL) PetscFunctionReturn(PETSC_SUCCESS);
+  if (format == PETSC_VIEWER_ASCII_FACTOR_INFO || format == PETSC_VIEWER_ASCII_INFO || format == PETSC_VIEWER_ASCII_INFO_DETAIL) {
+    if (format != PETSC_VIEWER_ASCII_FACTOR_INFO && a->solvelevels[0].nlevels) {
+      PetscCall(PetscViewerASCIIPrintf(viewer, "level scheduled triangular solves\n"));
+      PetscCall(PetscViewerASCIIPushTab(viewer));
+      PetscCall(MatSolveLevelsView_Private(&a->solvelevels[0], "L", viewer));
+      PetscCall(MatSolveLevelsView_Private(&a->solvelevels[1], "U", viewer));
+      PetscCall(MatSolveLevelsView_Private(&a->solvelevels[2], "U^T", viewer));
+      PetscCall(MatSolveLevelsView_Private(&a->solvelevels[3], "L^T", viewer));
+      PetscCall(PetscViewerASCIIPopTab(viewer));
+    }
+    if (format != PETSC_VIEWER_ASCII_FACTOR_INFO) PetscCall(MatSORColorsView_Private(&a->sorcolors, viewer));
+    PetscFunctionReturn(PETSC_SUCCESS);
+  }
 
   /* trigger copy to CPU if needed */
   PetscCall(MatSeqAIJGetArrayRead(A, &av));
@@ -1089,6 +1103,83 @@ PetscErrorCode MatView_SeqAIJ(Mat A, PetscViewer viewer)
   else if (isbinary) PetscCall(MatView_SeqAIJ_Binary(A, viewer));
   else if (isdraw) PetscCall(MatView_SeqAIJ_Draw(A, viewer));
   PetscCall(MatView_SeqAIJ_Inode(A, viewer));
+  PetscCall(MatView_SeqAIJAuto_Private(A, viewer));
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
+
+/*
+  Starts recording the rows given new nonzeros after this assembly, up to m/16 of them, beyond which compacting all the rows is cheaper
+*/
+static PetscErrorCode MatSeqAIJResetDirtyRows_Private(Mat A)
+{
+  Mat_SeqAIJ *a = (Mat_SeqAIJ *)A->data;
+
+  PetscFunctionBegin;
+  if (!a->dirtyrows && A->rmap->n >= 16) {
+    a->maxdirtyrows = A->rmap->n / 16;
+    PetscCall(PetscMalloc2(a->maxdirtyrows, &a->dirtyrows, a->maxdirtyrows, &a->dirtylen));
+  }
+  a->ndirtyrows = 0;
+  a->dirtystate = A->nonzerostate;
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
+
+/*
+  Compacts the rows recorded by MatSeqAIJMarkDirtyRow_Private() since the last assembly, all the other rows are still compact. The entries
+  between two dirty rows are moved at once, and only the dirty rows are searched for their diagonal entry; the row offsets and diagonal
+  positions of the other rows are shifted by the growth of the dirty rows before them.
+*/
+static PetscErrorCode MatAssemblyEnd_SeqAIJ_DirtyRows(Mat A, PetscInt *unused, PetscInt *nrows)
+{
+  Mat_SeqAIJ *a = (Mat_SeqAIJ *)A->data;
+  PetscInt    m = A->rmap->n, nd = 0, *rows = a->dirtyrows, *len = a->dirtylen;
+  PetscInt   *ai = a->i, *aj = a->j, *ailen = a->ilen, *imax = a->imax, *diag = a->diag, fshift = 0, growth = 0;
+  MatScalar  *aa = a->a;
+
+  PetscFunctionBegin;
+  /* sort the dirty rows, the smallest length recorded for a row is its length at the last assembly */
+  PetscCall(PetscSortIntWithArray(a->ndirtyrows, rows, len));
+  for (PetscInt k = 0; k < a->ndirtyrows; k++) {
+    if (nd && rows[nd - 1] == rows[k]) len[nd - 1] = PetscMin(len[nd - 1], len[k]);
+    else {
+      rows[nd]  = rows[k];
+      len[nd++] = len[k];
+    }
+  }
+  for (PetscInt k = 0; k < nd; k++) {
+    PetscInt r = rows[k], end = k + 1 < nd ? rows[k + 1] : m, start;
+
+    /* move the dirty row, then the compact rows up to the next dirty row, back by the amount of empty slots before them */
+    if (fshift) {
+      PetscCall(PetscArraymove(aj + ai[r] - fshift, aj + ai[r], ailen[r]));
+      PetscCall(PetscArraymove(aa + ai[r] - fshift, aa + ai[r], ailen[r]));
+    }
+    start = ai[r] - fshift;
+    fshift += imax[r] - ailen[r];
+    if (fshift && end > r + 1) {
+      PetscCall(PetscArraymove(aj + ai[r + 1] - fshift, aj + ai[r + 1], ai[end] - ai[r + 1]));
+      PetscCall(PetscArraymove(aa + ai[r + 1] - fshift, aa + ai[r + 1], ai[end] - ai[r + 1]));
+    }
+    ai[r] = start;
+    imax[r] = ailen[r];
+    if (!len[k]) a->nonzerorowcnt++;
+    a->rmax = PetscMax(a->rmax, ailen[r]);
+    diag[r] = start + ailen[r];
+    for (PetscInt j = start; j < start + ailen[r]; j++) {
+      if (aj[j] == r) {
+        diag[r] = j;
+        break;
+      }
+    }
+    growth += ailen[r] - len[k];
+    for (PetscInt i = r + 1; i < end; i++) {
+      ai[i] -= fshift;
+      diag[i] += growth;
+    }
+  }
+  ai[m] -= fshift;
+  *unused = fshift;
+  *nrows  = nd;
   PetscFunctionReturn(PETSC_SUCCESS);
 }
 
@@ -1096,7 +1187,7 @@ PetscErrorCode MatAssemblyEnd_SeqAIJ(Mat A, MatAssemblyType mode)
 {
   Mat_SeqAIJ *a      = (Mat_SeqAIJ *)A->data;
   PetscInt    fshift = 0, i, *ai = a->i, *aj = a->j, *imax = a->imax;
-  PetscInt    m = A->rmap->n, *ip, N, *ailen = a->ilen, rmax = 0, n;
+  PetscInt    m = A->rmap->n, *ip, N, *ailen = a->ilen, rmax = 0, n, ndirty = 0;
   MatScalar  *aa    = a->a, *ap;
   PetscReal   ratio = 0.6;
 
@@ -1106,36 +1197,45 @@ PetscErrorCode MatAssemblyEnd_SeqAIJ(Mat A, MatAssemblyType mode)
   if (A->was_assembled && A->ass_nonzerostate == A->nonzerostate) {
     /* we need to respect users asking to use or not the inodes routine in between matrix assemblies */
     PetscCall(MatAssemblyEnd_SeqAIJ_Inode(A, mode));
+    PetscCall(MatSeqAIJResetDirtyRows_Private(A));
     PetscFunctionReturn(PETSC_SUCCESS);
   }
 
-  if (m) rmax = ailen[0]; /* determine row with most nonzeros */
-  for (i = 1; i < m; i++) {
-    /* move each row back by the amount of empty slots (fshift) before it*/
-    fshift += imax[i - 1] - ailen[i - 1];
-    rmax = PetscMax(rmax, ailen[i]);
-    if (fshift) {
-      ip = aj + ai[i];
-      ap = aa + ai[i];
-      N  = ailen[i];
-      PetscCall(PetscArraymove(ip - fshift, ip, N));
-      if (!A->structure_only) PetscCall(PetscArraymove(ap - fshift, ap, N));
+  if (A->was_assembled && !A->structure_only && a->diag && a->ndirtyrows <= a->maxdirtyrows && A->nonzerostate == a->dirtystate) {
+    /* all the new nonzeros since the last assembly are in the recorded rows */
+    PetscCall(MatAssemblyEnd_SeqAIJ_DirtyRows(A, &fshift, &ndirty));
+    PetscCall(MatSeqAIJUpdateInodes_Private(A, ndirty, a->dirtyrows));
+    PetscCall(PetscInfo(A, "Compacted %" PetscInt_FMT " rows with new nonzeros\n", ndirty));
+    rmax = a->rmax;
+  } else {
+    if (m) rmax = ailen[0]; /* determine row with most nonzeros */
+    for (i = 1; i < m; i++) {
+      /* move each row back by the amount of empty slots (fshift) before it*/
+      fshift += imax[i - 1] - ailen[i - 1];
+      rmax = PetscMax(rmax, ailen[i]);
+      if (fshift) {
+        ip = aj + ai[i];
+        ap = aa + ai[i];
+        N  = ailen[i];
+        PetscCall(PetscArraymove(ip - fshift, ip, N));
+        if (!A->structure_only) PetscCall(PetscArraymove(ap - fshift, ap, N));
+      }
+      ai[i] = ai[i - 1] + ailen[i - 1];
     }
-    ai[i] = ai[i - 1] + ailen[i - 1];
-  }
-  if (m) {
-    fshift += imax[m - 1] - ailen[m - 1];
-    ai[m] = ai[m - 1] + ailen[m - 1];
-  }
-  /* reset ilen and imax for each row */
-  a->nonzerorowcnt = 0;
-  if (A->structure_only) {
-    PetscCall(PetscFree(a->imax));
-    PetscCall(PetscFree(a->ilen));
-  } else { /* !A->structure_only */
-    for (i = 0; i < m; i++) {
-      ailen[i] = imax[i] = ai[i + 1] - ai[i];
-      a->nonzerorowcnt += ((ai[i + 1] - ai[i]) > 0);
+    if (m) {
+      fshift += imax[m - 1] - ailen[m - 1];
+      ai[m] = ai[m - 1] + ailen[m - 1];
+    }
+    /* reset ilen and imax for each row */
+    a->nonzerorowcnt = 0;
+    if (A->structure_only) {
+      PetscCall(PetscFree(a->imax));
+      PetscCall(PetscFree(a->ilen));
+    } else { /* !A->structure_only */
+      for (i = 0; i < m; i++) {
+        ailen[i] = imax[i] = ai[i + 1] - ai[i];
+        a->nonzerorowcnt += ((ai[i + 1] - ai[i]) > 0);
+      }
     }
   }
   a->nz = ai[m];
@@ -1160,6 +1260,7 @@ PetscErrorCode MatAssemblyEnd_SeqAIJ(Mat A, MatAssemblyType mode)
 
   if (!A->structure_only) PetscCall(MatCheckCompressedRow(A, a->nonzerorowcnt, &a->compressedrow, a->i, m, ratio));
   PetscCall(MatAssemblyEnd_SeqAIJ_Inode(A, mode));
+  if (!A->structure_only) PetscCall(MatSeqAIJResetDirtyRows_Private(A));
   PetscFunctionReturn(PETSC_SUCCESS);
 }
 
@@ -1227,9 +1328,12 @@ PetscErrorCode MatDestroy_SeqAIJ(Mat A)
   PetscCall(PetscFree(a->ipre));
   PetscCall(PetscFree3(a->idiag, a->mdiag, a->ssor_work));
   PetscCall(PetscFree(a->solve_work));
+  for (PetscInt k = 0; k < 4; k++) PetscCall(MatSolveLevelsReset_Private(&a->solvelevels[k]));
+  PetscCall(MatSORColorsReset_Private(&a->sorcolors));
   PetscCall(ISDestroy(&a->icol));
   PetscCall(PetscFree(a->saved_values));
   PetscCall(PetscFree2(a->compressedrow.i, a->compressedrow.rindex));
+  PetscCall(PetscFree2(a->dirtyrows, a->dirtylen));
   PetscCall(MatDestroy_SeqAIJ_Inode(A));
   PetscCall(PetscFree(A->data));
 
@@ -1250,6 +1354,13 @@ PetscErrorCode MatDestroy_SeqAIJ(Mat A)
   PetscCall(PetscObjectComposeFunction((PetscObject)A, "MatConvert_seqaij_seqbaij_C", NULL));
   PetscCall(PetscObjectComposeFunction((PetscObject)A, "MatConvert_seqaij_seqaijperm_C", NULL));
   PetscCall(PetscObjectComposeFunction((PetscObject)A, "MatConvert_seqaij_seqaijsell_C", NULL));
+  PetscCall(PetscObjectComposeFunction((PetscObject)A, "MatConvert_seqaij_seqaijomp_C", NULL));
+  PetscCall(PetscObjectComposeFunction((PetscObject)A, "MatConvert_seqaij_seqaijdelta_C", NULL));
+  PetscCall(PetscObjectComposeFunction((PetscObject)A, "MatConvert_seqaij_seqaijauto_C", NULL));
+  PetscCall(PetscObjectComposeFunction((PetscObject)A, "MatConvert_seqaij_seqaijmerge_C", NULL));
+#if !defined(PETSC_USE_COMPLEX)
+  PetscCall(PetscObjectComposeFunction((PetscObject)A, "MatConvert_seqaij_seqaijmixed_C", NULL));
+#endif
 #if defined(PETSC_HAVE_MKL_SPARSE)
   PetscCall(PetscObjectComposeFunction((PetscObject)A, "MatConvert_seqaij_seqaijmkl_C", NULL));
 #endif
@@ -1296,6 +1407,8 @@ PetscErrorCode MatDestroy_SeqAIJ(Mat A)
   /* these calls do not belong here: the subclasses Duplicate/Destroy are wrong */
   PetscCall(PetscObjectComposeFunction((PetscObject)A, "MatConvert_seqaijsell_seqaij_C", NULL));
   PetscCall(PetscObjectComposeFunction((PetscObject)A, "MatConvert_seqaijperm_seqaij_C", NULL));
+  PetscCall(PetscObjectComposeFunction((PetscObject)A, "MatConvert_seqaijauto_seqaij_C", NULL));
+  PetscCall(PetscObjectComposeFunction((PetscObject)A, "MatConvert_seqaijmerge_seqaij_C", NULL));
   PetscCall(PetscObjectComposeFunction((PetscObject)A, "MatConvert_seqaij_seqaijviennacl_C", NULL));
   PetscCall(PetscObjectComposeFunction((PetscObject)A, "MatProductSetFromOptions_seqaijviennacl_seqdense_C", NULL));
   PetscCall(PetscObjectComposeFunction((PetscObject)A, "MatProductSetFromOptions_seqaijviennacl_seqaij_C", NULL));
@@ -1522,6 +1635,44 @@ PetscErrorCode MatMult_SeqAIJ(Mat A, Vec xx, Vec yy)
   PetscFunctionReturn(PETSC_SUCCESS);
 }
 
+/* y = A x with (x,y), ||x|| and ||y|| accumulated row by row, for square A */
+PetscErrorCode MatMultDot_SeqAIJ(Mat A, Vec xx, Vec yy, PetscScalar *xdoty, PetscReal *xnorm, PetscReal *ynorm)
+{
+  Mat_SeqAIJ        *a = (Mat_SeqAIJ *)A->data;
+  PetscScalar       *y;
+  const PetscScalar *x;
+  const MatScalar   *aa, *a_a;
+  PetscInt           m = A->rmap->n;
+  const PetscInt    *aj, *ii = a->i;
+  PetscInt           n, i;
+  PetscScalar        sum, dot = 0.0;
+  PetscReal          xx2 = 0.0, yy2 = 0.0;
+
+  PetscFunctionBegin;
+  PetscCall(MatSeqAIJGetArrayRead(A, &a_a));
+  PetscCall(VecGetArrayRead(xx, &x));
+  PetscCall(VecGetArrayWrite(yy, &y));
+  for (i = 0; i < m; i++) {
+    n   = ii[i + 1] - ii[i];
+    aj  = a->j + ii[i];
+    aa  = a_a + ii[i];
+    sum = 0.0;
+    PetscSparseDensePlusDot(sum, x, aa, aj, n);
+    y[i] = sum;
+    dot += x[i] * PetscConj(sum);
+    xx2 += PetscRealPart(x[i] * PetscConj(x[i]));
+    yy2 += PetscRealPart(sum * PetscConj(sum));
+  }
+  PetscCall(PetscLogFlops(2.0 * a->nz - a->nonzerorowcnt + 6.0 * m));
+  PetscCall(VecRestoreArrayRead(xx, &x));
+  PetscCall(VecRestoreArrayWrite(yy, &y));
+  PetscCall(MatSeqAIJRestoreArrayRead(A, &a_a));
+  *xdoty = dot;
+  *xnorm = PetscSqrtReal(xx2);
+  *ynorm = PetscSqrtReal(yy2);
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
+
 // HACK!!!!! Used by src/mat/tests/ex170.c
 PETSC_EXTERN PetscErrorCode MatMultMax_SeqAIJ(Mat A, Vec xx, Vec yy)
 {
@@ -1884,7 +2035,7 @@ static PetscErrorCode MatInvertVariableBlockDiagonal_SeqAIJ(Mat A, PetscInt nblo
 /*
    Negative shift indicates do not generate an error if there is a zero diagonal, just invert it anyways
 */
-static PetscErrorCode MatInvertDiagonal_SeqAIJ(Mat A, PetscScalar omega, PetscScalar fshift)
+PetscErrorCode MatInvertDiagonal_SeqAIJ(Mat A, PetscScalar omega, PetscScalar fshift)
 {
   Mat_SeqAIJ      *a = (Mat_SeqAIJ *)A->data;
   PetscInt         i, *diag, m = A->rmap->n;
@@ -1926,6 +2077,120 @@ static PetscErrorCode MatInvertDiagonal_SeqAIJ(Mat A, PetscScalar omega, PetscSc
   PetscFunctionReturn(PETSC_SUCCESS);
 }
 
+/* one sweep of multicolor SOR, the rows of a color are relaxed concurrently and the colors in increasing or decreasing order */
+static inline void MatSORColorSweep_SeqAIJ_Private(const Mat_SORColors *sc, PetscBool backward, const PetscInt ai[], const PetscInt aj[], const PetscInt diag[], const MatScalar aa[], const PetscScalar idiag[], PetscReal omega, const PetscScalar b[], PetscScalar x[])
+{
+  PetscPragmaOMP(parallel)
+  for (PetscInt c = 0; c < sc->ncolors; c++) {
+    const PetscInt cc = backward ? sc->ncolors - 1 - c : c;
+
+    PetscPragmaOMP(for schedule(static))
+    for (PetscInt r = sc->ptr[cc]; r < sc->ptr[cc + 1]; r++) {
+      const PetscInt i   = sc->rows[r];
+      PetscScalar    sum = b[i];
+
+      for (PetscInt k = ai[i]; k < diag[i]; k++) sum -= aa[k] * x[aj[k]];
+      for (PetscInt k = diag[i] + 1; k < ai[i + 1]; k++) sum -= aa[k] * x[aj[k]];
+      x[i] = (1. - omega) * x[i] + sum * idiag[i]; /* omega in idiag */
+    }
+  }
+}
+
+/*
+   MatSOR_SeqAIJ_Multicolor - SOR of the matrix symmetrically permuted by the colors of a->sorcolors, so L and U are the entries whose
+   column has a smaller, respectively larger, color than the row
+*/
+static PetscErrorCode MatSOR_SeqAIJ_Multicolor(Mat A, Vec bb, PetscReal omega, MatSORType flag, PetscReal fshift, PetscInt its, Vec xx)
+{
+  Mat_SeqAIJ          *a  = (Mat_SeqAIJ *)A->data;
+  const Mat_SORColors *sc = &a->sorcolors;
+  const PetscInt       m = A->rmap->n, *ai = a->i, *aj = a->j, *diag, *color = sc->color;
+  const MatScalar     *aa, *idiag, *mdiag;
+  const PetscScalar   *b;
+  PetscScalar         *x, *t;
+
+  PetscFunctionBegin;
+  if (fshift != a->fshift || omega != a->omega) a->idiagvalid = PETSC_FALSE; /* must recompute idiag[] */
+  if (!a->idiagvalid) PetscCall(MatInvertDiagonal_SeqAIJ(A, omega, fshift));
+  a->fshift = fshift;
+  a->omega  = omega;
+
+  diag  = a->diag;
+  t     = a->ssor_work;
+  idiag = a->idiag;
+  mdiag = a->mdiag;
+
+  PetscCall(MatSeqAIJGetArrayRead(A, &aa));
+  PetscCall(VecGetArray(xx, &x));
+  PetscCall(VecGetArrayRead(bb, &b));
+  if (flag == SOR_APPLY_UPPER) {
+    /* apply (U + D/omega) to the vector */
+    PetscPragmaOMP(parallel for schedule(static))
+    for (PetscInt i = 0; i < m; i++) {
+      PetscScalar sum = b[i] * (fshift + mdiag[i]) / omega;
+
+      for (PetscInt k = ai[i]; k < ai[i + 1]; k++) {
+        if (color[aj[k]] > color[i]) sum += aa[k] * b[aj[k]];
+      }
+      x[i] = sum;
+    }
+    PetscCall(PetscLogFlops(a->nz));
+  } else if (flag & SOR_EISENSTAT) {
+    const PetscScalar scale = (2.0 / omega) - 1.0;
+
+    /*  x = (E + U)^{-1} b */
+    PetscPragmaOMP(parallel)
+    for (PetscInt c = sc->ncolors - 1; c >= 0; c--) {
+      PetscPragmaOMP(for schedule(static))
+      for (PetscInt r = sc->ptr[c]; r < sc->ptr[c + 1]; r++) {
+        const PetscInt i   = sc->rows[r];
+        PetscScalar    sum = b[i];
+
+        for (PetscInt k = ai[i]; k < ai[i + 1]; k++) {
+          if (color[aj[k]] > c) sum -= aa[k] * x[aj[k]];
+        }
+        x[i] = sum * idiag[i];
+      }
+    }
+    /*  t = b - (2*E - D)x */
+    for (PetscInt i = 0; i < m; i++) t[i] = b[i] - scale * aa[diag[i]] * x[i];
+    /*  t = (E + L)^{-1}t and x = x + t */
+    PetscPragmaOMP(parallel)
+    for (PetscInt c = 0; c < sc->ncolors; c++) {
+      PetscPragmaOMP(for schedule(static))
+      for (PetscInt r = sc->ptr[c]; r < sc->ptr[c + 1]; r++) {
+        const PetscInt i   = sc->rows[r];
+        PetscScalar    sum = t[i];
+
+        for (PetscInt k = ai[i]; k < ai[i + 1]; k++) {
+          if (color[aj[k]] < c) sum -= aa[k] * t[aj[k]];
+        }
+        t[i] = sum * idiag[i];
+        x[i] += t[i];
+      }
+    }
+    PetscCall(PetscLogFlops(6.0 * m - 1 + 2.0 * a->nz));
+  } else {
+    PetscCheck(flag != SOR_APPLY_LOWER, PETSC_COMM_SELF, PETSC_ERR_SUP, "SOR_APPLY_LOWER is not implemented");
+    /* with a zero initial guess the entries not yet relaxed do not contribute */
+    if (flag & SOR_ZERO_INITIAL_GUESS) PetscCall(PetscArrayzero(x, m));
+    while (its--) {
+      if (flag & SOR_FORWARD_SWEEP || flag & SOR_LOCAL_FORWARD_SWEEP) {
+        MatSORColorSweep_SeqAIJ_Private(sc, PETSC_FALSE, ai, aj, diag, aa, idiag, omega, b, x);
+        PetscCall(PetscLogFlops(2.0 * a->nz));
+      }
+      if (flag & SOR_BACKWARD_SWEEP || flag & SOR_LOCAL_BACKWARD_SWEEP) {
+        MatSORColorSweep_SeqAIJ_Private(sc, PETSC_TRUE, ai, aj, diag, aa, idiag, omega, b, x);
+        PetscCall(PetscLogFlops(2.0 * a->nz));
+      }
+    }
+  }
+  PetscCall(MatSeqAIJRestoreArrayRead(A, &aa));
+  PetscCall(VecRestoreArray(xx, &x));
+  PetscCall(VecRestoreArrayRead(bb, &b));
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
+
 PetscErrorCode MatSOR_SeqAIJ(Mat A, Vec bb, PetscReal omega, MatSORType flag, PetscReal fshift, PetscInt its, PetscInt lits, Vec xx)
 {
   Mat_SeqAIJ        *a = (Mat_SeqAIJ *)A->data;
@@ -1936,6 +2201,11 @@ PetscErrorCode MatSOR_SeqAIJ(Mat A, Vec bb, PetscReal omega, MatSORType flag, Pe
   const PetscInt    *idx, *diag;
 
   PetscFunctionBegin;
+  PetscCall(MatSORColorsSetUp_Private(A, m, a->i, a->j, &a->sorcolors));
+  if (a->sorcolors.ncolors) {
+    PetscCall(MatSOR_SeqAIJ_Multicolor(A, bb, omega, flag, fshift, its * lits, xx));
+    PetscFunctionReturn(PETSC_SUCCESS);
+  }
   if (a->inode.use && a->inode.checked && omega == 1.0 && fshift == 0.0) {
     PetscCall(MatSOR_SeqAIJ_Inode(A, bb, omega, flag, fshift, its, lits, xx));
     PetscFunctionReturn(PETSC_SUCCESS);
@@ -3620,7 +3890,8 @@ static struct _MatOps MatOps_Values = {MatSetValues_SeqAIJ,
                                        MatCreateGraph_Simple_AIJ,
                                        NULL,
                                        /*150*/ MatTransposeSymbolic_SeqAIJ,
-                                       MatEliminateZeros_SeqAIJ};
+                                       MatEliminateZeros_SeqAIJ,
+                                       MatMultDot_SeqAIJ};
 
 static PetscErrorCode MatSeqAIJSetColumnIndices_SeqAIJ(Mat mat, PetscInt *indices)
 {
@@ -4619,12 +4890,86 @@ PetscErrorCode MatSeqAIJGetMaxRowNonzeros(Mat A, PetscInt *nz)
   PetscFunctionReturn(PETSC_SUCCESS);
 }
 
+/*
+  MatSeqAIJCOOSetUpThreads_Private - Divides the nonzeros set by MatSetValuesCOO() among the OpenMP threads and allocates their values
+
+  Input Parameter:
+. nnz - number of nonzeros
+
+  Input/Output Parameters:
++ jmap - perm[jmap[i]..jmap[i+1]) are the COO entries of the i-th nonzero, possibly replaced by a copy
+- perm - permutation of the COO entries, of length jmap[nnz], possibly replaced by a copy
+
+  Output Parameters:
++ a        - the nonzero values, zeroed
+. nthreads - number of threads used by MatSeqAIJCOOSetValues_Private()
+- tstart   - thread t sets nonzeros tstart[t] to tstart[t+1]-1
+
+  Note:
+  The nonzeros are divided so that each thread has about the same number of nonzeros plus COO entries. With more than one thread jmap[]
+  and perm[] are copied, and a[] is zeroed, by the thread that later uses each part, so that on NUMA systems the pages end up on the memory
+  node of that thread.
+*/
+PetscErrorCode MatSeqAIJCOOSetUpThreads_Private(PetscCount nnz, PetscCount *jmap[], PetscCount *perm[], PetscScalar *a[], PetscInt *nthreads, PetscCount *tstart[])
+{
+  PetscInt     nt = 1;
+  PetscCount  *ts, *jm, *pm, work = nnz + (*jmap)[nnz];
+  PetscScalar *aa;
+
+  PetscFunctionBegin;
+#if defined(PETSC_HAVE_OPENMP)
+  nt = PetscMax(PetscNumOMPThreads, 1);
+  nt = (PetscInt)PetscMin((PetscCount)nt, work / 4096 + 1); /* do not thread small matrices */
+#endif
+  PetscCall(PetscMalloc1(nt + 1, &ts));
+  ts[0]  = 0;
+  ts[nt] = nnz;
+  for (PetscInt t = 1; t < nt; t++) { /* smallest i with i + jmap[i] >= t*work/nt, work is nondecreasing in i */
+    PetscCount lo = ts[t - 1], hi = nnz, target = (work * t) / nt;
+
+    while (lo < hi) {
+      PetscCount mid = lo + (hi - lo) / 2;
+
+      if (mid + (*jmap)[mid] < target) lo = mid + 1;
+      else hi = mid;
+    }
+    ts[t] = lo;
+  }
+  if (nt == 1) {
+    PetscCall(PetscCalloc1(nnz, &aa));
+  } else {
+    const PetscCount *jmap0 = *jmap, *perm0 = *perm;
+
+    PetscCall(PetscMalloc1(nnz + 1, &jm));
+    PetscCall(PetscMalloc1(jmap0[nnz], &pm));
+    PetscCall(PetscMalloc1(nnz, &aa));
+    PetscPragmaOMP(parallel for schedule(static, 1) num_threads((int)nt))
+    for (PetscInt t = 0; t < nt; t++) {
+      for (PetscCount i = ts[t]; i < ts[t + 1]; i++) {
+        jm[i] = jmap0[i];
+        aa[i] = 0.0;
+      }
+      for (PetscCount k = jmap0[ts[t]]; k < jmap0[ts[t + 1]]; k++) pm[k] = perm0[k];
+    }
+    jm[nnz] = jmap0[nnz];
+    PetscCall(PetscFree(*jmap));
+    PetscCall(PetscFree(*perm));
+    *jmap = jm;
+    *perm = pm;
+  }
+  *a        = aa;
+  *nthreads = nt;
+  *tstart   = ts;
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
+
 static PetscErrorCode MatCOOStructDestroy_SeqAIJ(void *data)
 {
   MatCOOStruct_SeqAIJ *coo = (MatCOOStruct_SeqAIJ *)data;
   PetscFunctionBegin;
   PetscCall(PetscFree(coo->perm));
   PetscCall(PetscFree(coo->jmap));
+  PetscCall(PetscFree(coo->tstart));
   PetscCall(PetscFree(coo));
   PetscFunctionReturn(PETSC_SUCCESS);
 }
@@ -4749,14 +5094,14 @@ PetscErrorCode MatSetPreallocationCOO_SeqAIJ(Mat mat, PetscCount coo_n, PetscInt
   }
 
   PetscCall(MatGetRootType_Private(mat, &rtype));
-  PetscCall(PetscCalloc1(nnz, &Aa)); /* Zero the matrix */
+  PetscCall(PetscMalloc1(1, &coo));
+  PetscCall(MatSeqAIJCOOSetUpThreads_Private(nnz, &jmap, &perm, &Aa, &coo->nthreads, &coo->tstart)); /* Zero the matrix */
   PetscCall(MatSetSeqAIJWithArrays_private(PETSC_COMM_SELF, M, N, Ai, Aj, Aa, rtype, mat));
 
   seqaij->singlemalloc = PETSC_FALSE;            /* Ai, Aj and Aa are not allocated in one big malloc */
   seqaij->free_a = seqaij->free_ij = PETSC_TRUE; /* Let newmat own Ai, Aj and Aa */
 
   // Put the COO struct in a container and then attach that to the matrix
-  PetscCall(PetscMalloc1(1, &coo));
   coo->nz   = nnz;
   coo->n    = coo_n;
   coo->Atot = coo_n - nneg; // Annz is seqaij->nz, so no need to record that again
@@ -4772,9 +5117,6 @@ PetscErrorCode MatSetPreallocationCOO_SeqAIJ(Mat mat, PetscCount coo_n, PetscInt
 
 static PetscErrorCode MatSetValuesCOO_SeqAIJ(Mat A, const PetscScalar v[], InsertMode imode)
 {
-  Mat_SeqAIJ          *aseq = (Mat_SeqAIJ *)A->data;
-  PetscCount           i, j, Annz = aseq->nz;
-  PetscCount          *perm, *jmap;
   PetscScalar         *Aa;
   PetscContainer       container;
   MatCOOStruct_SeqAIJ *coo;
@@ -4783,14 +5125,8 @@ static PetscErrorCode MatSetValuesCOO_SeqAIJ(Mat A, const PetscScalar v[], Inser
   PetscCall(PetscObjectQuery((PetscObject)A, "__PETSc_MatCOOStruct_Host", (PetscObject *)&container));
   PetscCheck(container, PETSC_COMM_SELF, PETSC_ERR_PLIB, "Not found MatCOOStruct on this matrix");
   PetscCall(PetscContainerGetPointer(container, (void **)&coo));
-  perm = coo->perm;
-  jmap = coo->jmap;
   PetscCall(MatSeqAIJGetArray(A, &Aa));
-  for (i = 0; i < Annz; i++) {
-    PetscScalar sum = 0.0;
-    for (j = jmap[i]; j < jmap[i + 1]; j++) sum += v[perm[j]];
-    Aa[i] = (imode == INSERT_VALUES ? 0.0 : Aa[i]) + sum;
-  }
+  MatSeqAIJCOOSetValues_Private(coo->nthreads, coo->tstart, coo->jmap, coo->perm, v, imode, Aa);
   PetscCall(MatSeqAIJRestoreArray(A, &Aa));
   PetscFunctionReturn(PETSC_SUCCESS);
 }
@@ -4852,6 +5188,13 @@ PETSC_EXTERN PetscErrorCode MatCreate_SeqAIJ(Mat B)
   PetscCall(PetscObjectComposeFunction((PetscObject)B, "MatConvert_seqaij_seqbaij_C", MatConvert_SeqAIJ_SeqBAIJ));
   PetscCall(PetscObjectComposeFunction((PetscObject)B, "MatConvert_seqaij_seqaijperm_C", MatConvert_SeqAIJ_SeqAIJPERM));
   PetscCall(PetscObjectComposeFunction((PetscObject)B, "MatConvert_seqaij_seqaijsell_C", MatConvert_SeqAIJ_SeqAIJSELL));
+  PetscCall(PetscObjectComposeFunction((PetscObject)B, "MatConvert_seqaij_seqaijomp_C", MatConvert_SeqAIJ_SeqAIJOMP));
+  PetscCall(PetscObjectComposeFunction((PetscObject)B, "MatConvert_seqaij_seqaijdelta_C", MatConvert_SeqAIJ_SeqAIJDelta));
+  PetscCall(PetscObjectComposeFunction((PetscObject)B, "MatConvert_seqaij_seqaijauto_C", MatConvert_SeqAIJ_SeqAIJAuto));
+  PetscCall(PetscObjectComposeFunction((PetscObject)B, "MatConvert_seqaij_seqaijmerge_C", MatConvert_SeqAIJ_SeqAIJMerge));
+#if !defined(PETSC_USE_COMPLEX)
+  PetscCall(PetscObjectComposeFunction((PetscObject)B, "MatConvert_seqaij_seqaijmixed_C", MatConvert_SeqAIJ_SeqAIJMixed));
+#endif
 #if defined(PETSC_HAVE_MKL_SPARSE)
   PetscCall(PetscObjectComposeFunction((PetscObject)B, "MatConvert_seqaij_seqaijmkl_C", MatConvert_SeqAIJ_SeqAIJMKL));
 #endif
@@ -5033,6 +5376,49 @@ PetscErrorCode MatLoad_SeqAIJ(Mat newMat, PetscViewer viewer)
   PetscFunctionReturn(PETSC_SUCCESS);
 }
 
+/*
+  Sets up the matrix with the row lengths read from the file and the column indices j in the file mapped with -viewer_binary_mmap,
+  the nonzero values are mapped too if they are aligned in the file. The row offsets are freed with the matrix through a composed container.
+*/
+static PetscErrorCode MatLoad_SeqAIJ_Binary_MMap(Mat mat, PetscViewer viewer, const PetscInt rowlens[], PetscInt j[])
+{
+  Mat_SeqAIJ    *a = (Mat_SeqAIJ *)mat->data;
+  PetscInt       m = mat->rmap->n, nz, *i;
+  PetscScalar   *aa;
+  PetscContainer container;
+
+  PetscFunctionBegin;
+  PetscCall(MatSeqXAIJFreeAIJ(mat, &a->a, &a->j, &a->i));
+  PetscCall(MatSeqAIJSetPreallocation_SeqAIJ(mat, MAT_SKIP_ALLOCATION, NULL));
+  if (!a->imax) PetscCall(PetscMalloc1(m, &a->imax));
+  if (!a->ilen) PetscCall(PetscMalloc1(m, &a->ilen));
+  PetscCall(PetscMalloc1(m + 1, &i));
+  i[0] = 0;
+  for (PetscInt r = 0; r < m; r++) {
+    a->imax[r] = a->ilen[r] = rowlens[r];
+    i[r + 1]                = i[r] + rowlens[r];
+  }
+  nz = i[m];
+  PetscCall(PetscContainerCreate(PETSC_COMM_SELF, &container));
+  PetscCall(PetscContainerSetPointer(container, i));
+  PetscCall(PetscContainerSetUserDestroy(container, PetscContainerUserDestroyDefault));
+  PetscCall(PetscObjectCompose((PetscObject)mat, "MatLoad_SeqAIJ_Binary_MMap_i", (PetscObject)container));
+  PetscCall(PetscContainerDestroy(&container));
+
+  PetscCall(PetscViewerBinaryReadMMap_Private(viewer, nz, PETSC_SCALAR, (void **)&aa, (PetscObject)mat));
+  a->free_a = aa ? PETSC_FALSE : PETSC_TRUE;
+  if (!aa) {
+    PetscCall(PetscMalloc1(nz, &aa));
+    PetscCall(PetscViewerBinaryRead(viewer, aa, nz, NULL, PETSC_SCALAR));
+  }
+  a->i            = i;
+  a->j            = j;
+  a->a            = aa;
+  a->singlemalloc = PETSC_FALSE;
+  a->free_ij      = PETSC_FALSE;
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
+
 PetscErrorCode MatLoad_SeqAIJ_Binary(Mat mat, PetscViewer viewer)
 {
   Mat_SeqAIJ *a = (Mat_SeqAIJ *)mat->data;
@@ -5072,6 +5458,19 @@ PetscErrorCode MatLoad_SeqAIJ_Binary(Mat mat, PetscViewer viewer)
   sum = 0;
   for (i = 0; i < M; i++) sum += rowlens[i];
   PetscCheck(sum == nz, PETSC_COMM_SELF, PETSC_ERR_FILE_UNEXPECTED, "Inconsistent matrix data in file: nonzeros = %" PetscInt_FMT ", sum-row-lengths = %" PetscInt_FMT, nz, sum);
+  /* use "j" and "a" in the file mapped with -viewer_binary_mmap */
+  if (!mat->structure_only) {
+    PetscInt *mj;
+
+    PetscCall(PetscViewerBinaryReadMMap_Private(viewer, nz, PETSC_INT, (void **)&mj, (PetscObject)mat));
+    if (mj) {
+      PetscCall(MatLoad_SeqAIJ_Binary_MMap(mat, viewer, rowlens, mj));
+      PetscCall(PetscFree(rowlens));
+      PetscCall(MatAssemblyBegin(mat, MAT_FINAL_ASSEMBLY));
+      PetscCall(MatAssemblyEnd(mat, MAT_FINAL_ASSEMBLY));
+      PetscFunctionReturn(PETSC_SUCCESS);
+    }
+  }
   /* preallocate and check sizes */
   PetscCall(MatSeqAIJSetPreallocation_SeqAIJ(mat, 0, rowlens));
   PetscCall(MatGetSize(mat, &rows, &cols));
@@ -5502,6 +5901,13 @@ PetscErrorCode MatSeqAIJRegisterAll(void)
   PetscCall(MatSeqAIJRegister(MATSEQAIJCRL, MatConvert_SeqAIJ_SeqAIJCRL));
   PetscCall(MatSeqAIJRegister(MATSEQAIJPERM, MatConvert_SeqAIJ_SeqAIJPERM));
   PetscCall(MatSeqAIJRegister(MATSEQAIJSELL, MatConvert_SeqAIJ_SeqAIJSELL));
+  PetscCall(MatSeqAIJRegister(MATSEQAIJOMP, MatConvert_SeqAIJ_SeqAIJOMP));
+  PetscCall(MatSeqAIJRegister(MATSEQAIJDELTA, MatConvert_SeqAIJ_SeqAIJDelta));
+  PetscCall(MatSeqAIJRegister(MATSEQAIJAUTO, MatConvert_SeqAIJ_SeqAIJAuto));
+  PetscCall(MatSeqAIJRegister(MATSEQAIJMERGE, MatConvert_SeqAIJ_SeqAIJMerge));
+#if !defined(PETSC_USE_COMPLEX)
+  PetscCall(MatSeqAIJRegister(MATSEQAIJMIXED, MatConvert_SeqAIJ_SeqAIJMixed));
+#endif
 #if defined(PETSC_HAVE_MKL_SPARSE)
   PetscCall(MatSeqAIJRegister(MATSEQAIJMKL, MatConvert_SeqAIJ_SeqAIJMKL));
 #endif
@@ -5622,6 +6028,7 @@ PETSC_EXTERN void matsetvaluesseqaij_(Mat *AA, PetscInt *mm, const PetscInt im[]
       rp[i] = col;
       ap[i] = value;
       A->nonzerostate++;
+      MatSeqAIJMarkDirtyRow_Private(a, row, N + 1);
     noinsert:;
       low = i + 1;
     }
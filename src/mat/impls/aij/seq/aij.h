@@ -69,6 +69,8 @@ typedef struct {
   PetscBool         free_diag; \
   datatype         *a;              /* nonzero elements */ \
   PetscScalar      *solve_work;     /* work space used in MatSolve */ \
+  Mat_SolveLevels   solvelevels[4]; /* level sets of the sweeps of MatSolve() and MatSolveTranspose() of a factor */ \
+  Mat_SORColors     sorcolors;      /* coloring of the rows for multicolor MatSOR() */ \
   IS                row, col, icol; /* index sets, used for reorderings */ \
   PetscBool         pivotinblocks;  /* pivot inside factorization of each diagonal block */ \
   Mat               parent;         /* set if this matrix was formed with MatDuplicate(...,MAT_SHARE_NONZERO_PATTERN,....); \
@@ -135,6 +137,7 @@ typedef struct {
 } Mat_SeqAIJ_Inode;
 
 PETSC_INTERN PetscErrorCode MatView_SeqAIJ_Inode(Mat, PetscViewer);
+PETSC_INTERN PetscErrorCode MatView_SeqAIJAuto_Private(Mat, PetscViewer);
 PETSC_INTERN PetscErrorCode MatAssemblyEnd_SeqAIJ_Inode(Mat, MatAssemblyType);
 PETSC_INTERN PetscErrorCode MatDestroy_SeqAIJ_Inode(Mat);
 PETSC_INTERN PetscErrorCode MatCreate_SeqAIJ_Inode(Mat);
@@ -161,16 +164,56 @@ typedef struct {
   PetscHMapIJV   ht;
   PetscInt      *dnz;
   struct _MatOps cops;
+
+  /* rows given new nonzeros since the last assembly, so that MatAssemblyEnd() only compacts those */
+  PetscInt        *dirtyrows, *dirtylen; /* the rows and their lengths at the last assembly */
+  PetscInt         ndirtyrows, maxdirtyrows;
+  PetscObjectState dirtystate; /* nonzero state of the matrix if all its new nonzeros were recorded */
 } Mat_SeqAIJ;
 
+/*
+  Records that a new nonzero was inserted into row, which had len nonzeros. Rows beyond the capacity are not recorded, MatAssemblyEnd()
+  then compacts all the rows.
+*/
+static inline void MatSeqAIJMarkDirtyRow_Private(Mat_SeqAIJ *a, PetscInt row, PetscInt len)
+{
+  a->dirtystate++;
+  if (a->ndirtyrows > a->maxdirtyrows) return;
+  if (a->ndirtyrows && a->dirtyrows[a->ndirtyrows - 1] == row) return;
+  if (a->ndirtyrows < a->maxdirtyrows) {
+    a->dirtyrows[a->ndirtyrows] = row;
+    a->dirtylen[a->ndirtyrows]  = len;
+  }
+  a->ndirtyrows++;
+}
+
 typedef struct {
-  PetscInt    nz;   /* nz of the matrix after assembly */
-  PetscCount  n;    /* Number of entries in MatSetPreallocationCOO() */
-  PetscCount  Atot; /* Total number of valid (i.e., w/ non-negative indices) entries in the COO array */
-  PetscCount *jmap; /* perm[jmap[i]..jmap[i+1]) give indices of entries in v[] associated with i-th nonzero of the matrix */
-  PetscCount *perm; /* The permutation array in sorting (i,j) by row and then by col */
+  PetscInt    nz;       /* nz of the matrix after assembly */
+  PetscCount  n;        /* Number of entries in MatSetPreallocationCOO() */
+  PetscCount  Atot;     /* Total number of valid (i.e., w/ non-negative indices) entries in the COO array */
+  PetscCount *jmap;     /* perm[jmap[i]..jmap[i+1]) give indices of entries in v[] associated with i-th nonzero of the matrix */
+  PetscCount *perm;     /* The permutation array in sorting (i,j) by row and then by col */
+  PetscInt    nthreads; /* Number of OpenMP threads used by MatSetValuesCOO() */
+  PetscCount *tstart;   /* Thread t sets nonzeros tstart[t] to tstart[t+1]-1 */
 } MatCOOStruct_SeqAIJ;
 
+/*
+  Sets a[i] (or adds to it with ADD_VALUES) the sum of v[perm[k]] for k in [jmap[i], jmap[i+1]), with the nonzeros divided among
+  nthreads OpenMP threads by tstart[] from MatSeqAIJCOOSetUpThreads_Private(). Every nonzero is written by exactly one thread.
+*/
+static inline void MatSeqAIJCOOSetValues_Private(PetscInt nthreads, const PetscCount tstart[], const PetscCount jmap[], const PetscCount perm[], const PetscScalar v[], InsertMode imode, PetscScalar a[])
+{
+  PetscPragmaOMP(parallel for schedule(static, 1) num_threads((int)nthreads) if (nthreads > 1))
+  for (PetscInt t = 0; t < nthreads; t++) {
+    for (PetscCount i = tstart[t]; i < tstart[t + 1]; i++) {
+      PetscScalar sum = 0.0; /* Do partial summation first to improve numerical stability */
+
+      for (PetscCount k = jmap[i]; k < jmap[i + 1]; k++) sum += v[perm[k]];
+      a[i] = (imode == INSERT_VALUES ? 0.0 : a[i]) + sum;
+    }
+  }
+}
+
 /*
   Frees the a, i, and j arrays from the XAIJ (AIJ, BAIJ, and SBAIJ) matrix types
 */
@@ -265,6 +308,7 @@ static inline PetscErrorCode MatSeqXAIJFreeAIJ(Mat AA, MatScalar **a, PetscInt *
 
 PETSC_INTERN PetscErrorCode MatSeqAIJSetPreallocation_SeqAIJ(Mat, PetscInt, const PetscInt *);
 PETSC_INTERN PetscErrorCode MatSetPreallocationCOO_SeqAIJ(Mat, PetscCount, PetscInt[], PetscInt[]);
+PETSC_INTERN PetscErrorCode MatSeqAIJCOOSetUpThreads_Private(PetscCount, PetscCount *[], PetscCount *[], PetscScalar *[], PetscInt *, PetscCount *[]);
 
 PETSC_INTERN PetscErrorCode MatILUFactorSymbolic_SeqAIJ(Mat, Mat, IS, IS, const MatFactorInfo *);
 PETSC_INTERN PetscErrorCode MatILUFactorSymbolic_SeqAIJ_ilu0(Mat, Mat, IS, IS, const MatFactorInfo *);
@@ -280,11 +324,13 @@ PETSC_INTERN PetscErrorCode MatMarkDiagonal_SeqAIJ(Mat);
 PETSC_INTERN PetscErrorCode MatFindZeroDiagonals_SeqAIJ_Private(Mat, PetscInt *, PetscInt **);
 
 PETSC_INTERN PetscErrorCode MatMult_SeqAIJ(Mat, Vec, Vec);
+PETSC_INTERN PetscErrorCode MatMultDot_SeqAIJ(Mat, Vec, Vec, PetscScalar *, PetscReal *, PetscReal *);
 PETSC_INTERN PetscErrorCode MatMult_SeqAIJ_Inode(Mat, Vec, Vec);
 PETSC_INTERN PetscErrorCode MatMultAdd_SeqAIJ(Mat, Vec, Vec, Vec);
 PETSC_INTERN PetscErrorCode MatMultAdd_SeqAIJ_Inode(Mat, Vec, Vec, Vec);
 PETSC_INTERN PetscErrorCode MatMultTranspose_SeqAIJ(Mat, Vec, Vec);
 PETSC_INTERN PetscErrorCode MatMultTransposeAdd_SeqAIJ(Mat, Vec, Vec, Vec);
+PETSC_INTERN PetscErrorCode MatInvertDiagonal_SeqAIJ(Mat, PetscScalar, PetscScalar);
 PETSC_INTERN PetscErrorCode MatSOR_SeqAIJ(Mat, Vec, PetscReal, MatSORType, PetscReal, PetscInt, PetscInt, Vec);
 PETSC_INTERN PetscErrorCode MatSOR_SeqAIJ_Inode(Mat, Vec, PetscReal, MatSORType, PetscReal, PetscInt, PetscInt, Vec);
 
@@ -312,6 +358,8 @@ PETSC_INTERN PetscErrorCode MatSolveTranspose_SeqAIJ(Mat, Vec, Vec);
 PETSC_INTERN PetscErrorCode MatSolveTransposeAdd_SeqAIJ_inplace(Mat, Vec, Vec, Vec);
 PETSC_INTERN PetscErrorCode MatSolveTransposeAdd_SeqAIJ(Mat, Vec, Vec, Vec);
 PETSC_INTERN PetscErrorCode MatMatSolve_SeqAIJ(Mat, Mat, Mat);
+PETSC_INTERN PetscErrorCode MatSeqAIJSolveLevelsSetUp_Private(Mat);
+PETSC_INTERN PetscErrorCode MatILUDTFactor_Private(Mat, PetscInt, PetscInt, const PetscInt[], const PetscInt[], const MatScalar[], const PetscInt[], const PetscInt[], const MatFactorInfo *, PetscInt[], PetscInt[], PetscInt **, MatScalar **, PetscInt[], PetscInt *);
 PETSC_INTERN PetscErrorCode MatEqual_SeqAIJ(Mat, Mat, PetscBool *);
 PETSC_INTERN PetscErrorCode MatFDColoringCreate_SeqXAIJ(Mat, ISColoring, MatFDColoring);
 PETSC_INTERN PetscErrorCode MatFDColoringSetUp_SeqXAIJ(Mat, ISColoring, MatFDColoring);
@@ -339,6 +387,7 @@ PETSC_INTERN PetscErrorCode MatMatMultSymbolic_SeqAIJ_SeqAIJ_Heap(Mat, Mat, Pets
 PETSC_INTERN PetscErrorCode MatMatMultSymbolic_SeqAIJ_SeqAIJ_BTHeap(Mat, Mat, PetscReal, Mat);
 PETSC_INTERN PetscErrorCode MatMatMultSymbolic_SeqAIJ_SeqAIJ_RowMerge(Mat, Mat, PetscReal, Mat);
 PETSC_INTERN PetscErrorCode MatMatMultSymbolic_SeqAIJ_SeqAIJ_LLCondensed(Mat, Mat, PetscReal, Mat);
+PETSC_INTERN PetscErrorCode MatMatMultSymbolic_SeqAIJ_SeqAIJ_Threaded(Mat, Mat, PetscReal, Mat);
 #if defined(PETSC_HAVE_HYPRE)
 PETSC_INTERN PetscErrorCode MatMatMultSymbolic_AIJ_AIJ_wHYPRE(Mat, Mat, PetscReal, Mat);
 #endif
@@ -348,10 +397,13 @@ PETSC_INTERN PetscErrorCode MatMatMultNumeric_SeqAIJ_SeqAIJ_Sorted(Mat, Mat, Mat
 
 PETSC_INTERN PetscErrorCode MatMatMultNumeric_SeqDense_SeqAIJ(Mat, Mat, Mat);
 PETSC_INTERN PetscErrorCode MatMatMultNumeric_SeqAIJ_SeqAIJ_Scalable(Mat, Mat, Mat);
+PETSC_INTERN PetscErrorCode MatMatMultNumeric_SeqAIJ_SeqAIJ_Threaded(Mat, Mat, Mat);
 
 PETSC_INTERN PetscErrorCode MatPtAPSymbolic_SeqAIJ_SeqAIJ_SparseAxpy(Mat, Mat, PetscReal, Mat);
 PETSC_INTERN PetscErrorCode MatPtAPNumeric_SeqAIJ_SeqAIJ(Mat, Mat, Mat);
 PETSC_INTERN PetscErrorCode MatPtAPNumeric_SeqAIJ_SeqAIJ_SparseAxpy(Mat, Mat, Mat);
+PETSC_INTERN PetscErrorCode MatPtAPSymbolic_SeqAIJ_SeqAIJ_Threaded(Mat, Mat, PetscReal, Mat);
+PETSC_INTERN PetscErrorCode MatPtAPNumeric_SeqAIJ_SeqAIJ_Threaded(Mat, Mat, Mat);
 
 PETSC_INTERN PetscErrorCode MatRARtSymbolic_SeqAIJ_SeqAIJ(Mat, Mat, PetscReal, Mat);
 PETSC_INTERN PetscErrorCode MatRARtSymbolic_SeqAIJ_SeqAIJ_matmattransposemult(Mat, Mat, PetscReal, Mat);
@@ -394,6 +446,7 @@ PETSC_INTERN PetscErrorCode MatSeqAIJInvalidateDiagonal(Mat);
 PETSC_INTERN PetscErrorCode MatSeqAIJInvalidateDiagonal_Inode(Mat);
 PETSC_INTERN PetscErrorCode MatSeqAIJCheckInode(Mat);
 PETSC_INTERN PetscErrorCode MatSeqAIJCheckInode_FactorLU(Mat);
+PETSC_INTERN PetscErrorCode MatSeqAIJUpdateInodes_Private(Mat, PetscInt, const PetscInt[]);
 
 PETSC_INTERN PetscErrorCode MatAXPYGetPreallocation_SeqAIJ(Mat, Mat, PetscInt *);
 
@@ -412,6 +465,13 @@ PETSC_INTERN PetscErrorCode MatConvert_AIJ_ScaLAPACK(Mat, MatType, MatReuse, Mat
 PETSC_INTERN PetscErrorCode MatConvert_AIJ_HYPRE(Mat, MatType, MatReuse, Mat *);
 PETSC_INTERN PetscErrorCode MatConvert_SeqAIJ_SeqAIJPERM(Mat, MatType, MatReuse, Mat *);
 PETSC_INTERN PetscErrorCode MatConvert_SeqAIJ_SeqAIJSELL(Mat, MatType, MatReuse, Mat *);
+PETSC_INTERN PetscErrorCode MatConvert_SeqAIJ_SeqAIJOMP(Mat, MatType, MatReuse, Mat *);
+PETSC_INTERN PetscErrorCode MatConvert_SeqAIJ_SeqAIJDelta(Mat, MatType, MatReuse, Mat *);
+PETSC_INTERN PetscErrorCode MatConvert_SeqAIJ_SeqAIJAuto(Mat, MatType, MatReuse, Mat *);
+PETSC_INTERN PetscErrorCode MatConvert_SeqAIJ_SeqAIJMerge(Mat, MatType, MatReuse, Mat *);
+#if !defined(PETSC_USE_COMPLEX)
+PETSC_INTERN PetscErrorCode MatConvert_SeqAIJ_SeqAIJMixed(Mat, MatType, MatReuse, Mat *);
+#endif
 PETSC_INTERN PetscErrorCode MatConvert_SeqAIJ_SeqAIJMKL(Mat, MatType, MatReuse, Mat *);
 PETSC_INTERN PetscErrorCode MatConvert_SeqAIJ_SeqAIJViennaCL(Mat, MatType, MatReuse, Mat *);
 PETSC_INTERN PetscErrorCode MatReorderForNonzeroDiagonal_SeqAIJ(Mat, PetscReal, IS, IS);
@@ -0,0 +1,367 @@
+/*
+  Defines the MATSEQAIJAUTO matrix class. A matrix of this class is a
+  MATSEQAIJ matrix that, the first time it is applied after assembly,
+  times MatMult() with each of a list of MATSEQAIJ subtypes and converts
+  itself in place to the fastest one. The choice is remembered for the
+  nonzero structure, so that matrices with the same structure assembled
+  later are converted without timing.
+*/
+
+#include <../src/mat/impls/aij/seq/aij.h>
+
+#define MATSEQAIJAUTO_MAX_CANDIDATES 16
+
+typedef struct {
+  PetscInt  ncandidates;
+  char     *candidates[MATSEQAIJAUTO_MAX_CANDIDATES];
+  PetscInt  its; /* number of timed products for each candidate */
+  PetscBool view;
+} Mat_SeqAIJAuto;
+
+/* The outcome of the selection, kept with the matrix for MatView() after it has been converted to the chosen type */
+typedef struct {
+  PetscInt       ncandidates; /* 0 if the choice was found in the cache */
+  char           candidates[MATSEQAIJAUTO_MAX_CANDIDATES][64];
+  PetscLogDouble times[MATSEQAIJAUTO_MAX_CANDIDATES];
+  char           choice[64];
+} MatSeqAIJAutoResult;
+
+/* Choices made so far, identified by a hash of the nonzero structure */
+typedef struct _n_MatSeqAIJAutoCache *MatSeqAIJAutoCache;
+struct _n_MatSeqAIJAutoCache {
+  PetscInt64         hash;
+  char               choice[64];
+  MatSeqAIJAutoCache next;
+};
+
+static MatSeqAIJAutoCache MatSeqAIJAutoCacheHead = NULL;
+static PetscBool          MatSeqAIJAutoTuning    = PETSC_FALSE; /* PETSC_TRUE while the candidate copies are created */
+
+static PetscErrorCode MatSeqAIJAutoCacheDestroy_Private(void)
+{
+  MatSeqAIJAutoCache next;
+
+  PetscFunctionBegin;
+  while (MatSeqAIJAutoCacheHead) {
+    next = MatSeqAIJAutoCacheHead->next;
+    PetscCall(PetscFree(MatSeqAIJAutoCacheHead));
+    MatSeqAIJAutoCacheHead = next;
+  }
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
+
+/* FNV-1a hash of the sizes, the row and column indices, and the candidate names */
+static PetscErrorCode MatSeqAIJAuto_HashStructure(Mat A, PetscInt64 *hash)
+{
+  Mat_SeqAIJ     *a     = (Mat_SeqAIJ *)A->data;
+  Mat_SeqAIJAuto *aauto = (Mat_SeqAIJAuto *)A->spptr;
+  PetscInt        m = A->rmap->n, nz = a->i[m];
+  uint64_t        h = 14695981039346656037ULL;
+
+#define MatSeqAIJAutoHashAdd(v) \
+  do { \
+    h ^= (uint64_t)(v); \
+    h *= 1099511628211ULL; \
+  } while (0)
+
+  PetscFunctionBegin;
+  MatSeqAIJAutoHashAdd(m);
+  MatSeqAIJAutoHashAdd(A->cmap->n);
+  MatSeqAIJAutoHashAdd(nz);
+  for (PetscInt i = 0; i <= m; i++) MatSeqAIJAutoHashAdd(a->i[i]);
+  for (PetscInt k = 0; k < nz; k++) MatSeqAIJAutoHashAdd(a->j[k]);
+  for (PetscInt c = 0; c < aauto->ncandidates; c++) {
+    for (const char *p = aauto->candidates[c]; *p; p++) MatSeqAIJAutoHashAdd(*p);
+    MatSeqAIJAutoHashAdd(',');
+  }
+  *hash = (PetscInt64)(h & 0x7fffffffffffffffULL);
+#undef MatSeqAIJAutoHashAdd
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
+
+PETSC_INTERN PetscErrorCode MatConvert_SeqAIJAuto_SeqAIJ(Mat A, MatType type, MatReuse reuse, Mat *newmat)
+{
+  /* This routine is only called to convert a MATSEQAIJAUTO to its base PETSc type, */
+  /* so we will ignore 'MatType type'. */
+  Mat             B = *newmat;
+  Mat_SeqAIJAuto *aauto;
+
+  PetscFunctionBegin;
+  if (reuse == MAT_INITIAL_MATRIX) PetscCall(MatDuplicate(A, MAT_COPY_VALUES, &B));
+  aauto = (Mat_SeqAIJAuto *)B->spptr;
+
+  /* Reset the original function pointers. */
+  B->ops->destroy = MatDestroy_SeqAIJ;
+  B->ops->mult    = MatMult_SeqAIJ;
+  B->ops->multadd = MatMultAdd_SeqAIJ;
+  B->ops->multdot = MatMultDot_SeqAIJ;
+
+  PetscCall(PetscObjectComposeFunction((PetscObject)B, "MatConvert_seqaijauto_seqaij_C", NULL));
+
+  for (PetscInt c = 0; c < aauto->ncandidates; c++) PetscCall(PetscFree(aauto->candidates[c]));
+  PetscCall(PetscFree(B->spptr));
+
+  /* Change the type of B to MATSEQAIJ. */
+  PetscCall(PetscObjectChangeTypeName((PetscObject)B, MATSEQAIJ));
+
+  *newmat = B;
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
+
+static PetscErrorCode MatDestroy_SeqAIJAuto(Mat A)
+{
+  Mat_SeqAIJAuto *aauto = (Mat_SeqAIJAuto *)A->spptr;
+
+  PetscFunctionBegin;
+  if (aauto) {
+    /* If MatHeaderMerge() was used then this SeqAIJAuto matrix will not have a spptr. */
+    for (PetscInt c = 0; c < aauto->ncandidates; c++) PetscCall(PetscFree(aauto->candidates[c]));
+    PetscCall(PetscFree(A->spptr));
+  }
+  PetscCall(PetscObjectChangeTypeName((PetscObject)A, MATSEQAIJ));
+  PetscCall(PetscObjectComposeFunction((PetscObject)A, "MatConvert_seqaijauto_seqaij_C", NULL));
+  PetscCall(MatDestroy_SeqAIJ(A));
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
+
+/* Times MatMult() with a copy of A of each candidate type, using w as the output */
+static PetscErrorCode MatSeqAIJAuto_Time(Mat A, Vec xx, Vec w, MatSeqAIJAutoResult *result)
+{
+  Mat_SeqAIJAuto *aauto = (Mat_SeqAIJAuto *)A->spptr;
+  PetscLogDouble  best  = PETSC_MAX_REAL, t0, t1;
+
+  PetscFunctionBegin;
+  result->ncandidates = aauto->ncandidates;
+  for (PetscInt c = 0; c < aauto->ncandidates; c++) {
+    Mat B;
+
+    /* make a MATSEQAIJ copy of A, ignoring -mat_seqaij_type seqaijauto, then convert it to the candidate type */
+    MatSeqAIJAutoTuning = PETSC_TRUE;
+    PetscCall(MatCreate(PETSC_COMM_SELF, &B));
+    PetscCall(MatSetSizes(B, A->rmap->n, A->cmap->n, A->rmap->n, A->cmap->n));
+    PetscCall(MatSetType(B, MATSEQAIJ));
+    MatSeqAIJAutoTuning = PETSC_FALSE;
+    PetscCall(MatDuplicateNoCreate_SeqAIJ(B, A, MAT_COPY_VALUES, PETSC_TRUE));
+    PetscCall(MatSeqAIJSetType(B, aauto->candidates[c]));
+
+    /* the vectors may be parallel when A is a block of a MATMPIAIJ, so call the method rather than MatMult() */
+    PetscUseTypeMethod(B, mult, xx, w); /* not timed, builds any auxiliary data of the candidate */
+    PetscCall(PetscTime(&t0));
+    for (PetscInt k = 0; k < aauto->its; k++) PetscUseTypeMethod(B, mult, xx, w);
+    PetscCall(PetscTime(&t1));
+    PetscCall(MatDestroy(&B));
+
+    PetscCall(PetscStrncpy(result->candidates[c], aauto->candidates[c], sizeof(result->candidates[c])));
+    result->times[c] = (t1 - t0) / aauto->its;
+    PetscCall(PetscInfo(A, "MatMult() with %s takes %g seconds\n", aauto->candidates[c], (double)result->times[c]));
+    if (result->times[c] < best) {
+      best = result->times[c];
+      PetscCall(PetscStrncpy(result->choice, aauto->candidates[c], sizeof(result->choice)));
+    }
+  }
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
+
+/* Selects the subtype for A, by lookup in the cache or by timing, and converts A to it */
+static PetscErrorCode MatSeqAIJAuto_Select(Mat A, Vec xx, Vec yy)
+{
+  PetscInt64           hash;
+  MatSeqAIJAutoCache   link;
+  MatSeqAIJAutoResult *result;
+  PetscContainer       container;
+  Vec                  w;
+
+  PetscFunctionBegin;
+  PetscCall(PetscLogEventBegin(MAT_Autotune, A, 0, 0, 0));
+  PetscCall(PetscNew(&result));
+  PetscCall(MatSeqAIJAuto_HashStructure(A, &hash));
+  for (link = MatSeqAIJAutoCacheHead; link; link = link->next) {
+    if (link->hash == hash) break;
+  }
+  if (link) {
+    PetscCall(PetscStrncpy(result->choice, link->choice, sizeof(result->choice)));
+    PetscCall(PetscInfo(A, "Using %s, chosen before for this nonzero structure\n", result->choice));
+  } else {
+    PetscCall(VecDuplicate(yy, &w));
+    PetscCall(MatSeqAIJAuto_Time(A, xx, w, result));
+    PetscCall(VecDestroy(&w));
+    if (!MatSeqAIJAutoCacheHead) PetscCall(PetscRegisterFinalize(MatSeqAIJAutoCacheDestroy_Private));
+    PetscCall(PetscNew(&link));
+    link->hash = hash;
+    PetscCall(PetscStrncpy(link->choice, result->choice, sizeof(link->choice)));
+    link->next             = MatSeqAIJAutoCacheHead;
+    MatSeqAIJAutoCacheHead = link;
+    PetscCall(PetscInfo(A, "Chose %s for this nonzero structure\n", result->choice));
+  }
+
+  /* keep the outcome with the matrix for MatView() */
+  PetscCall(PetscContainerCreate(PETSC_COMM_SELF, &container));
+  PetscCall(PetscContainerSetPointer(container, result));
+  PetscCall(PetscContainerSetUserDestroy(container, PetscContainerUserDestroyDefault));
+  PetscCall(PetscObjectCompose((PetscObject)A, "MatSeqAIJAutoResult", (PetscObject)container));
+  PetscCall(PetscContainerDestroy(&container));
+
+  PetscCall(MatConvert_SeqAIJAuto_SeqAIJ(A, MATSEQAIJ, MAT_INPLACE_MATRIX, &A));
+  PetscCall(MatSeqAIJSetType(A, result->choice));
+  PetscCall(PetscLogEventEnd(MAT_Autotune, A, 0, 0, 0));
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
+
+static PetscErrorCode MatMult_SeqAIJAuto(Mat A, Vec xx, Vec yy)
+{
+  PetscFunctionBegin;
+  PetscCall(MatSeqAIJAuto_Select(A, xx, yy));
+  PetscUseTypeMethod(A, mult, xx, yy);
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
+
+static PetscErrorCode MatMultAdd_SeqAIJAuto(Mat A, Vec xx, Vec yy, Vec zz)
+{
+  PetscFunctionBegin;
+  PetscCall(MatSeqAIJAuto_Select(A, xx, zz));
+  PetscUseTypeMethod(A, multadd, xx, yy, zz);
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
+
+/*
+   MatView_SeqAIJAuto_Private - Displays which subtype was chosen for a matrix created as a `MATSEQAIJAUTO`; called
+   by MatView_SeqAIJ() since the matrix has been converted to the chosen type.
+*/
+PetscErrorCode MatView_SeqAIJAuto_Private(Mat A, PetscViewer viewer)
+{
+  PetscContainer       container;
+  MatSeqAIJAutoResult *result;
+  PetscBool            iascii;
+  PetscViewerFormat    format;
+
+  PetscFunctionBegin;
+  PetscCall(PetscObjectTypeCompare((PetscObject)viewer, PETSCVIEWERASCII, &iascii));
+  if (!iascii) PetscFunctionReturn(PETSC_SUCCESS);
+  PetscCall(PetscViewerGetFormat(viewer, &format));
+  if (format != PETSC_VIEWER_ASCII_INFO && format != PETSC_VIEWER_ASCII_INFO_DETAIL) PetscFunctionReturn(PETSC_SUCCESS);
+  PetscCall(PetscObjectQuery((PetscObject)A, "MatSeqAIJAutoResult", (PetscObject *)&container));
+  if (!container) {
+    PetscBool isauto;
+
+    PetscCall(PetscObjectTypeCompare((PetscObject)A, MATSEQAIJAUTO, &isauto));
+    if (isauto) PetscCall(PetscViewerASCIIPrintf(viewer, "subtype will be selected at the first MatMult()\n"));
+    PetscFunctionReturn(PETSC_SUCCESS);
+  }
+  PetscCall(PetscContainerGetPointer(container, (void **)&result));
+  if (!result->ncandidates) {
+    PetscCall(PetscViewerASCIIPrintf(viewer, "subtype %s selected automatically, from a previous selection for the same nonzero structure\n", result->choice));
+  } else {
+    /* timings are only shown with the detailed format, since they vary from run to run */
+    if (format == PETSC_VIEWER_ASCII_INFO_DETAIL) {
+      PetscCall(PetscViewerASCIIPrintf(viewer, "subtype %s selected automatically, time per MatMult():", result->choice));
+      PetscCall(PetscViewerASCIIUseTabs(viewer, PETSC_FALSE));
+      for (PetscInt c = 0; c < result->ncandidates; c++) PetscCall(PetscViewerASCIIPrintf(viewer, " %s %g", result->candidates[c], (double)result->times[c]));
+    } else {
+      PetscCall(PetscViewerASCIIPrintf(viewer, "subtype %s selected automatically from:", result->choice));
+      PetscCall(PetscViewerASCIIUseTabs(viewer, PETSC_FALSE));
+      for (PetscInt c = 0; c < result->ncandidates; c++) PetscCall(PetscViewerASCIIPrintf(viewer, " %s", result->candidates[c]));
+    }
+    PetscCall(PetscViewerASCIIPrintf(viewer, "\n"));
+    PetscCall(PetscViewerASCIIUseTabs(viewer, PETSC_TRUE));
+  }
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
+
+/* MatConvert_SeqAIJ_SeqAIJAuto converts a SeqAIJ matrix into a
+ * SeqAIJAuto matrix.  This routine is called by the MatCreate_SeqAIJAuto()
+ * routine, but can also be used to convert an assembled SeqAIJ matrix
+ * into a SeqAIJAuto one. */
+PETSC_INTERN PetscErrorCode MatConvert_SeqAIJ_SeqAIJAuto(Mat A, MatType type, MatReuse reuse, Mat *newmat)
+{
+  Mat             B = *newmat;
+  Mat_SeqAIJAuto *aauto;
+  PetscBool       sametype, flg;
+  char           *candidates[MATSEQAIJAUTO_MAX_CANDIDATES];
+  PetscInt        ncandidates = MATSEQAIJAUTO_MAX_CANDIDATES;
+
+  PetscFunctionBegin;
+  if (MatSeqAIJAutoTuning) PetscFunctionReturn(PETSC_SUCCESS); /* the copies made to time the candidates remain MATSEQAIJ */
+  if (reuse == MAT_INITIAL_MATRIX) PetscCall(MatDuplicate(A, MAT_COPY_VALUES, &B));
+  PetscCall(PetscObjectTypeCompare((PetscObject)A, type, &sametype));
+  if (sametype) PetscFunctionReturn(PETSC_SUCCESS);
+
+  PetscCall(PetscNew(&aauto));
+  B->spptr = (void *)aauto;
+
+  /* Set function pointers for methods that we inherit from AIJ but override. */
+  B->ops->destroy = MatDestroy_SeqAIJAuto;
+  B->ops->mult    = MatMult_SeqAIJAuto;
+  B->ops->multadd = MatMultAdd_SeqAIJAuto;
+  B->ops->multdot = NULL;
+
+  aauto->its = 5;
+  PetscOptionsBegin(PetscObjectComm((PetscObject)B), ((PetscObject)B)->prefix, "AIJAUTO Options", "Mat");
+  PetscCall(PetscOptionsStringArray("-mat_aijauto_candidates", "MATSEQAIJ subtypes to choose from", "None", candidates, &ncandidates, &flg));
+  PetscCall(PetscOptionsInt("-mat_aijauto_its", "Number of timed products with each candidate", "None", aauto->its, &aauto->its, NULL));
+  PetscOptionsEnd();
+  PetscCheck(aauto->its > 0, PetscObjectComm((PetscObject)B), PETSC_ERR_ARG_OUTOFRANGE, "Number of timed products %" PetscInt_FMT " must be positive", aauto->its);
+  if (flg) {
+    PetscCheck(ncandidates > 0, PetscObjectComm((PetscObject)B), PETSC_ERR_ARG_WRONG, "-mat_aijauto_candidates needs at least one subtype");
+    for (PetscInt c = 0; c < ncandidates; c++) {
+      PetscErrorCode (*r)(Mat, MatType, MatReuse, Mat *);
+
+      PetscCall(PetscFunctionListFind(MatSeqAIJList, candidates[c], &r));
+      PetscCheck(r || !strcmp(candidates[c], MATSEQAIJ), PetscObjectComm((PetscObject)B), PETSC_ERR_ARG_UNKNOWN_TYPE, "Unknown MATSEQAIJ subtype %s", candidates[c]);
+      PetscCheck(strcmp(candidates[c], MATSEQAIJAUTO), PetscObjectComm((PetscObject)B), PETSC_ERR_ARG_WRONG, "%s cannot be one of its own candidates", MATSEQAIJAUTO);
+      aauto->candidates[c] = candidates[c];
+    }
+    aauto->ncandidates = ncandidates;
+  } else {
+    PetscCall(PetscStrallocpy(MATSEQAIJ, &aauto->candidates[aauto->ncandidates++]));
+    PetscCall(PetscStrallocpy(MATSEQAIJPERM, &aauto->candidates[aauto->ncandidates++]));
+    PetscCall(PetscStrallocpy(MATSEQAIJSELL, &aauto->candidates[aauto->ncandidates++]));
+    PetscCall(PetscStrallocpy(MATSEQAIJDELTA, &aauto->candidates[aauto->ncandidates++]));
+#if defined(PETSC_HAVE_OPENMP)
+    if (PetscNumOMPThreads > 1) {
+      PetscCall(PetscStrallocpy(MATSEQAIJOMP, &aauto->candidates[aauto->ncandidates++]));
+      PetscCall(PetscStrallocpy(MATSEQAIJMERGE, &aauto->candidates[aauto->ncandidates++]));
+    }
+#endif
+  }
+
+  PetscCall(PetscObjectComposeFunction((PetscObject)B, "MatConvert_seqaijauto_seqaij_C", MatConvert_SeqAIJAuto_SeqAIJ));
+
+  PetscCall(PetscObjectChangeTypeName((PetscObject)B, MATSEQAIJAUTO));
+  *newmat = B;
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
+
+/*MC
+   MATSEQAIJAUTO - MATSEQAIJAUTO = "seqaijauto" - A matrix type for sequential sparse matrices that selects the fastest
+   `MATSEQAIJ` subtype for `MatMult()` by timing the candidates.
+
+   Options Database Keys:
++  -mat_type seqaijauto - sets the matrix type to `MATSEQAIJAUTO` during a call to `MatSetFromOptions()`
+.  -mat_seqaij_type seqaijauto - makes all `MATSEQAIJ` matrices, including the diagonal and off-diagonal blocks of `MATMPIAIJ`, of this type
+.  -mat_aijauto_candidates <seqaij,seqaijperm,seqaijsell,seqaijdelta> - the subtypes to choose from
+-  -mat_aijauto_its <5> - the number of timed products with each candidate
+
+   Level: intermediate
+
+   Notes:
+   The first time `MatMult()` or `MatMultAdd()` is called, a copy of the matrix is made for each candidate subtype and
+   the time of its `MatMult()` with the given vector is measured. The matrix is then converted in place to the fastest
+   subtype, so it is no longer of type `MATSEQAIJAUTO`. The choice is stored with a hash of the nonzero structure;
+   a later `MATSEQAIJAUTO` matrix with the same structure, for example the Jacobian of the next nonlinear solve, is
+   converted to the same subtype without timing. `MATSEQAIJOMP` and `MATSEQAIJMERGE` are default candidates when
+   more than one OpenMP thread is used. `MATSEQAIJ` includes the I-node routines when the matrix has I-nodes.
+
+   The selection is shown by `MatView()` with the format `PETSC_VIEWER_ASCII_INFO`, the time of the
+   candidates with `PETSC_VIEWER_ASCII_INFO_DETAIL` and `-info`, and the time it took under the event MatAutotune in `-log_view`.
+
+   Since the selection is made by timing, it can differ from one run to the next when candidates perform similarly.
+
+.seealso: [](ch_matrices), `Mat`, `MATSEQAIJ`, `MATSEQAIJPERM`, `MATSEQAIJSELL`, `MATSEQAIJDELTA`, `MATSEQAIJOMP`, `MatSeqAIJSetType()`
+M*/
+PETSC_EXTERN PetscErrorCode MatCreate_SeqAIJAuto(Mat A)
+{
+  PetscFunctionBegin;
+  PetscCall(MatSetType(A, MATSEQAIJ));
+  PetscCall(MatConvert_SeqAIJ_SeqAIJAuto(A, MATSEQAIJAUTO, MAT_INPLACE_MATRIX, &A));
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
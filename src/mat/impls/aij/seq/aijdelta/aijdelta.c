@@ -0,0 +1,489 @@
+/*
+  Defines basic operations for the MATSEQAIJDELTA matrix class.
+  This class is derived from the MATSEQAIJ class and retains the
+  compressed row storage, but keeps an additional copy of the column
+  indices in compressed form: for each row the first column index (the base)
+  and, for every nonzero, the distance of its column from the base. The
+  distances are stored in 16-bit, 32-bit or full PetscInt words; the width is
+  chosen per block of rows at assembly. The sparse matrix-vector products and
+  SOR sweeps read the compressed indices, which reduces the memory traffic of
+  these bandwidth-bound kernels.
+*/
+
+#include <../src/mat/impls/aij/seq/aij.h>
+
+#define MATSEQAIJDELTA_BLOCK_SIZE 64 /* default number of rows per block sharing the same index width */
+
+typedef struct {
+  PetscObjectState nonzerostate; /* nonzero structure the compressed indices were built for */
+  PetscInt         bs;           /* number of rows in a block */
+  PetscInt         nblocks;
+  PetscInt        *base;   /* column index of the first nonzero in each row */
+  unsigned char   *width;  /* number of bytes used for each delta of the block: 2, 4 or sizeof(PetscInt) */
+  size_t          *offset; /* the deltas of block b start offset[b] bytes into idx[] */
+  unsigned char   *idx;    /* the packed deltas */
+  PetscInt         nblk[3]; /* number of blocks using each of the three index widths, for MatView() */
+} Mat_SeqAIJDelta;
+
+/*
+   Kernels for one block of rows rs <= i < re, whose deltas start at d. These are generated for each
+   type used to store the deltas; the column of the k-th nonzero of row i is base[i] + d[ai[i] - ai[rs] + k].
+*/
+#define MatSeqAIJDeltaKernels(T, suffix) \
+  static inline void MatMultAdd_SeqAIJDelta_##suffix(PetscInt rs, PetscInt re, const PetscInt *ai, const PetscInt *base, const T *d, const MatScalar *aa, const PetscScalar *x, const PetscScalar *y, PetscScalar *z) \
+  { \
+    for (PetscInt i = rs; i < re; i++) { \
+      const PetscInt     n   = ai[i + 1] - ai[i]; \
+      const T           *di  = d + (ai[i] - ai[rs]); \
+      const MatScalar   *v   = aa + ai[i]; \
+      const PetscScalar *xb  = x + base[i]; \
+      PetscScalar        sum = y ? y[i] : 0.0; \
+\
+      for (PetscInt k = 0; k < n; k++) sum += v[k] * xb[di[k]]; \
+      z[i] = sum; \
+    } \
+  } \
+\
+  /* sum -= A(i, ks:ke-1) x, where ks and ke are offsets into row i */ \
+  static inline PetscScalar MatRowMinusDot_SeqAIJDelta_##suffix(PetscScalar sum, PetscInt i, PetscInt ks, PetscInt ke, PetscInt rs, const PetscInt *ai, const PetscInt *base, const T *d, const MatScalar *aa, const PetscScalar *x) \
+  { \
+    const T           *di = d + (ai[i] - ai[rs]); \
+    const MatScalar   *v  = aa + ai[i]; \
+    const PetscScalar *xb = x + base[i]; \
+\
+    for (PetscInt k = ks; k < ke; k++) sum -= v[k] * xb[di[k]]; \
+    return sum; \
+  }
+
+MatSeqAIJDeltaKernels(uint16_t, 2)
+MatSeqAIJDeltaKernels(PetscInt32, 4)
+#if defined(PETSC_USE_64BIT_INDICES)
+MatSeqAIJDeltaKernels(PetscInt, 8)
+#endif
+
+/* Computes sum - A(i, ks:ke-1) x for a row of block b, dispatching on the width of its deltas */
+static inline PetscScalar MatRowMinusDot_SeqAIJDelta(Mat_SeqAIJDelta *delta, PetscScalar sum, PetscInt b, PetscInt i, PetscInt ks, PetscInt ke, const PetscInt *ai, const MatScalar *aa, const PetscScalar *x)
+{
+  const void    *d  = delta->idx + delta->offset[b];
+  const PetscInt rs = b * delta->bs;
+
+#if defined(PETSC_USE_64BIT_INDICES)
+  if (delta->width[b] == sizeof(PetscInt)) return MatRowMinusDot_SeqAIJDelta_8(sum, i, ks, ke, rs, ai, delta->base, (const PetscInt *)d, aa, x);
+#endif
+  if (delta->width[b] == 2) return MatRowMinusDot_SeqAIJDelta_2(sum, i, ks, ke, rs, ai, delta->base, (const uint16_t *)d, aa, x);
+  return MatRowMinusDot_SeqAIJDelta_4(sum, i, ks, ke, rs, ai, delta->base, (const PetscInt32 *)d, aa, x);
+}
+
+static PetscErrorCode MatSeqAIJDelta_Reset_Private(Mat_SeqAIJDelta *delta)
+{
+  PetscFunctionBegin;
+  PetscCall(PetscFree(delta->base));
+  PetscCall(PetscFree2(delta->width, delta->offset));
+  PetscCall(PetscFree(delta->idx));
+  delta->nblocks      = 0;
+  delta->nonzerostate = -1;
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
+
+/* Builds the compressed column indices from a->j, if the nonzero structure has changed since they were last built */
+static PetscErrorCode MatSeqAIJDelta_CreateIndices(Mat A)
+{
+  Mat_SeqAIJ      *a     = (Mat_SeqAIJ *)A->data;
+  Mat_SeqAIJDelta *delta = (Mat_SeqAIJDelta *)A->spptr;
+  PetscInt         m     = A->rmap->n, bs, nb;
+  const PetscInt  *ai = a->i, *aj = a->j;
+  PetscInt64       bytes = 0;
+
+  PetscFunctionBegin;
+  if (delta->nonzerostate == A->nonzerostate) PetscFunctionReturn(PETSC_SUCCESS); /* indices exist and match current nonzero structure */
+  PetscCall(MatSeqAIJDelta_Reset_Private(delta));
+  delta->nonzerostate = A->nonzerostate;
+  bs                  = delta->bs;
+  nb                  = (m + bs - 1) / bs;
+  delta->nblocks      = nb;
+  PetscCall(PetscArrayzero(delta->nblk, 3));
+  PetscCall(PetscMalloc1(m, &delta->base));
+  PetscCall(PetscMalloc2(nb, &delta->width, nb + 1, &delta->offset));
+
+  /* choose the narrowest width that can hold the largest column distance within each row of the block */
+  delta->offset[0] = 0;
+  for (PetscInt b = 0; b < nb; b++) {
+    const PetscInt rs = b * bs, re = PetscMin(rs + bs, m);
+    PetscInt64     range = 0;
+    size_t         w;
+
+    for (PetscInt i = rs; i < re; i++) {
+      delta->base[i] = ai[i + 1] > ai[i] ? aj[ai[i]] : 0;
+      if (ai[i + 1] > ai[i]) range = PetscMax(range, (PetscInt64)(aj[ai[i + 1] - 1] - aj[ai[i]]));
+    }
+    if (range <= UINT16_MAX) {
+      w = 2;
+      delta->nblk[0]++;
+    } else if (range <= PETSC_INT32_MAX) {
+      w = 4;
+      delta->nblk[1]++;
+    } else {
+      w = sizeof(PetscInt);
+      delta->nblk[2]++;
+    }
+    delta->width[b] = (unsigned char)w;
+    /* start every block on an 8 byte boundary */
+    delta->offset[b + 1] = delta->offset[b] + ((w * (size_t)(ai[re] - ai[rs]) + 7) / 8) * 8;
+  }
+  PetscCall(PetscMalloc1(delta->offset[nb], &delta->idx));
+
+  for (PetscInt b = 0; b < nb; b++) {
+    const PetscInt rs = b * bs, re = PetscMin(rs + bs, m);
+    void          *d  = delta->idx + delta->offset[b];
+
+    for (PetscInt i = rs; i < re; i++) {
+      for (PetscInt k = ai[i], l = ai[i] - ai[rs]; k < ai[i + 1]; k++, l++) {
+        const PetscInt dist = aj[k] - delta->base[i];
+
+        switch (delta->width[b]) {
+        case 2:
+          ((uint16_t *)d)[l] = (uint16_t)dist;
+          break;
+        case 4:
+          ((PetscInt32 *)d)[l] = (PetscInt32)dist;
+          break;
+        default:
+          ((PetscInt *)d)[l] = dist;
+        }
+      }
+    }
+  }
+  bytes = (PetscInt64)delta->offset[nb] + (PetscInt64)m * sizeof(PetscInt);
+  PetscCall(PetscInfo(A, "Compressed column indices of %" PetscInt_FMT " nonzeros into %" PetscInt64_FMT " bytes (%" PetscInt_FMT " 16-bit, %" PetscInt_FMT " 32-bit, %" PetscInt_FMT " full blocks)\n", ai[m], bytes, delta->nblk[0], delta->nblk[1], delta->nblk[2]));
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
+
+PETSC_INTERN PetscErrorCode MatConvert_SeqAIJDelta_SeqAIJ(Mat A, MatType type, MatReuse reuse, Mat *newmat)
+{
+  /* This routine is only called to convert a MATSEQAIJDELTA to its base PETSc type, */
+  /* so we will ignore 'MatType type'. */
+  Mat              B = *newmat;
+  Mat_SeqAIJDelta *delta;
+
+  PetscFunctionBegin;
+  if (reuse == MAT_INITIAL_MATRIX) PetscCall(MatDuplicate(A, MAT_COPY_VALUES, &B));
+  delta = (Mat_SeqAIJDelta *)B->spptr;
+
+  /* Reset the original function pointers. */
+  B->ops->assemblyend = MatAssemblyEnd_SeqAIJ;
+  B->ops->destroy     = MatDestroy_SeqAIJ;
+  B->ops->duplicate   = MatDuplicate_SeqAIJ;
+  B->ops->view        = MatView_SeqAIJ;
+  B->ops->mult        = MatMult_SeqAIJ;
+  B->ops->multadd     = MatMultAdd_SeqAIJ;
+  B->ops->multdot     = MatMultDot_SeqAIJ;
+  B->ops->sor         = MatSOR_SeqAIJ;
+
+  PetscCall(PetscObjectComposeFunction((PetscObject)B, "MatConvert_seqaijdelta_seqaij_C", NULL));
+
+  PetscCall(MatSeqAIJDelta_Reset_Private(delta));
+  PetscCall(PetscFree(B->spptr));
+
+  /* Change the type of B to MATSEQAIJ. */
+  PetscCall(PetscObjectChangeTypeName((PetscObject)B, MATSEQAIJ));
+
+  *newmat = B;
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
+
+static PetscErrorCode MatDestroy_SeqAIJDelta(Mat A)
+{
+  Mat_SeqAIJDelta *delta = (Mat_SeqAIJDelta *)A->spptr;
+
+  PetscFunctionBegin;
+  if (delta) {
+    /* If MatHeaderMerge() was used then this SeqAIJDelta matrix will not have a spptr. */
+    PetscCall(MatSeqAIJDelta_Reset_Private(delta));
+    PetscCall(PetscFree(A->spptr));
+  }
+  PetscCall(PetscObjectChangeTypeName((PetscObject)A, MATSEQAIJ));
+  PetscCall(PetscObjectComposeFunction((PetscObject)A, "MatConvert_seqaijdelta_seqaij_C", NULL));
+  PetscCall(MatDestroy_SeqAIJ(A));
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
+
+static PetscErrorCode MatDuplicate_SeqAIJDelta(Mat A, MatDuplicateOption op, Mat *M)
+{
+  Mat_SeqAIJDelta *delta = (Mat_SeqAIJDelta *)A->spptr;
+
+  PetscFunctionBegin;
+  /* MatDuplicate_SeqAIJ() creates a matrix of the same type; its compressed indices are built when first needed */
+  PetscCall(MatDuplicate_SeqAIJ(A, op, M));
+  ((Mat_SeqAIJDelta *)(*M)->spptr)->bs = delta->bs;
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
+
+static PetscErrorCode MatAssemblyEnd_SeqAIJDelta(Mat A, MatAssemblyType mode)
+{
+  Mat_SeqAIJ *a = (Mat_SeqAIJ *)A->data;
+
+  PetscFunctionBegin;
+  if (mode == MAT_FLUSH_ASSEMBLY) PetscFunctionReturn(PETSC_SUCCESS);
+
+  /* the inode kernels read a->j, so they are not used for this class */
+  a->inode.use = PETSC_FALSE;
+  PetscCall(MatAssemblyEnd_SeqAIJ(A, mode));
+  PetscCall(MatSeqAIJDelta_CreateIndices(A));
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
+
+static PetscErrorCode MatView_SeqAIJDelta(Mat A, PetscViewer viewer)
+{
+  Mat_SeqAIJDelta  *delta = (Mat_SeqAIJDelta *)A->spptr;
+  PetscBool         iascii;
+  PetscViewerFormat format;
+
+  PetscFunctionBegin;
+  PetscCall(MatView_SeqAIJ(A, viewer));
+  PetscCall(PetscObjectTypeCompare((PetscObject)viewer, PETSCVIEWERASCII, &iascii));
+  if (!iascii || delta->nonzerostate != A->nonzerostate) PetscFunctionReturn(PETSC_SUCCESS);
+  PetscCall(PetscViewerGetFormat(viewer, &format));
+  if (format == PETSC_VIEWER_ASCII_INFO || format == PETSC_VIEWER_ASCII_INFO_DETAIL) {
+    PetscCall(PetscViewerASCIIPrintf(viewer, "compressed column indices: %" PetscInt_FMT " blocks of %" PetscInt_FMT " rows, %" PetscInt_FMT " with 16-bit, %" PetscInt_FMT " with 32-bit and %" PetscInt_FMT " with full indices\n", delta->nblocks, delta->bs, delta->nblk[0], delta->nblk[1], delta->nblk[2]));
+  }
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
+
+/* computes z = y + A*x, or z = A*x if y is NULL */
+static PetscErrorCode MatMultAdd_SeqAIJDelta_Private(Mat A, Vec xx, Vec yy, Vec zz)
+{
+  Mat_SeqAIJ        *a     = (Mat_SeqAIJ *)A->data;
+  Mat_SeqAIJDelta   *delta = (Mat_SeqAIJDelta *)A->spptr;
+  const PetscScalar *x;
+  PetscScalar       *y = NULL, *z;
+  const MatScalar   *aa;
+  PetscInt           m = A->rmap->n, bs;
+
+  PetscFunctionBegin;
+  PetscCall(MatSeqAIJDelta_CreateIndices(A));
+  bs = delta->bs;
+  PetscCall(MatSeqAIJGetArrayRead(A, &aa));
+  PetscCall(VecGetArrayRead(xx, &x));
+  if (yy) {
+    PetscCall(VecGetArrayPair(yy, zz, &y, &z));
+  } else {
+    PetscCall(VecGetArrayWrite(zz, &z));
+  }
+  for (PetscInt b = 0; b < delta->nblocks; b++) {
+    const PetscInt rs = b * bs, re = PetscMin(rs + bs, m);
+    const void    *d  = delta->idx + delta->offset[b];
+
+    if (delta->width[b] == 2) MatMultAdd_SeqAIJDelta_2(rs, re, a->i, delta->base, (const uint16_t *)d, aa, x, y, z);
+#if defined(PETSC_USE_64BIT_INDICES)
+    else if (delta->width[b] == sizeof(PetscInt)) MatMultAdd_SeqAIJDelta_8(rs, re, a->i, delta->base, (const PetscInt *)d, aa, x, y, z);
+#endif
+    else MatMultAdd_SeqAIJDelta_4(rs, re, a->i, delta->base, (const PetscInt32 *)d, aa, x, y, z);
+  }
+  PetscCall(MatSeqAIJRestoreArrayRead(A, &aa));
+  PetscCall(VecRestoreArrayRead(xx, &x));
+  if (yy) {
+    PetscCall(VecRestoreArrayPair(yy, zz, &y, &z));
+    PetscCall(PetscLogFlops(2.0 * a->nz));
+  } else {
+    PetscCall(VecRestoreArrayWrite(zz, &z));
+    PetscCall(PetscLogFlops(2.0 * a->nz - a->nonzerorowcnt));
+  }
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
+
+static PetscErrorCode MatMult_SeqAIJDelta(Mat A, Vec xx, Vec yy)
+{
+  PetscFunctionBegin;
+  PetscCall(MatMultAdd_SeqAIJDelta_Private(A, xx, NULL, yy));
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
+
+static PetscErrorCode MatMultAdd_SeqAIJDelta(Mat A, Vec xx, Vec yy, Vec zz)
+{
+  PetscFunctionBegin;
+  PetscCall(MatMultAdd_SeqAIJDelta_Private(A, xx, yy, zz));
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
+
+/*
+   Follows MatSOR_SeqAIJ() but reads the compressed column indices. The Eisenstat variants and SOR_APPLY_UPPER
+   are handed to MatSOR_SeqAIJ().
+*/
+static PetscErrorCode MatSOR_SeqAIJDelta(Mat A, Vec bb, PetscReal omega, MatSORType flag, PetscReal fshift, PetscInt its, PetscInt lits, Vec xx)
+{
+  Mat_SeqAIJ        *a     = (Mat_SeqAIJ *)A->data;
+  Mat_SeqAIJDelta   *delta = (Mat_SeqAIJDelta *)A->spptr;
+  PetscScalar       *x, sum, *t;
+  const MatScalar   *idiag, *mdiag, *aa;
+  const PetscScalar *b, *xb;
+  PetscInt           m = A->rmap->n, bs, i, nd, nr;
+  const PetscInt    *ai = a->i, *diag;
+
+  PetscFunctionBegin;
+  if (flag == SOR_APPLY_UPPER || flag == SOR_APPLY_LOWER || (flag & SOR_EISENSTAT)) {
+    PetscCall(MatSOR_SeqAIJ(A, bb, omega, flag, fshift, its, lits, xx));
+    PetscFunctionReturn(PETSC_SUCCESS);
+  }
+  PetscCall(MatSeqAIJDelta_CreateIndices(A));
+  bs  = delta->bs;
+  its = its * lits;
+
+  if (fshift != a->fshift || omega != a->omega) a->idiagvalid = PETSC_FALSE; /* must recompute idiag[] */
+  if (!a->idiagvalid) PetscCall(MatInvertDiagonal_SeqAIJ(A, omega, fshift));
+  a->fshift = fshift;
+  a->omega  = omega;
+
+  diag  = a->diag;
+  t     = a->ssor_work;
+  idiag = a->idiag;
+  mdiag = a->mdiag;
+
+  PetscCall(MatSeqAIJGetArrayRead(A, &aa));
+  PetscCall(VecGetArray(xx, &x));
+  PetscCall(VecGetArrayRead(bb, &b));
+  /* We count flops by assuming the upper triangular and lower triangular parts have the same number of nonzeros */
+  if (flag & SOR_ZERO_INITIAL_GUESS) {
+    if (flag & SOR_FORWARD_SWEEP || flag & SOR_LOCAL_FORWARD_SWEEP) {
+      for (i = 0; i < m; i++) {
+        nd   = diag[i] - ai[i];
+        sum  = MatRowMinusDot_SeqAIJDelta(delta, b[i], i / bs, i, 0, nd, ai, aa, x);
+        t[i] = sum;
+        x[i] = sum * idiag[i];
+      }
+      xb = t;
+      PetscCall(PetscLogFlops(a->nz));
+    } else xb = b;
+    if (flag & SOR_BACKWARD_SWEEP || flag & SOR_LOCAL_BACKWARD_SWEEP) {
+      for (i = m - 1; i >= 0; i--) {
+        nd  = diag[i] - ai[i];
+        nr  = ai[i + 1] - ai[i];
+        sum = MatRowMinusDot_SeqAIJDelta(delta, xb[i], i / bs, i, nd + 1, nr, ai, aa, x);
+        if (xb == b) {
+          x[i] = sum * idiag[i];
+        } else {
+          x[i] = (1 - omega) * x[i] + sum * idiag[i]; /* omega in idiag */
+        }
+      }
+      PetscCall(PetscLogFlops(a->nz)); /* assumes 1/2 in upper */
+    }
+    its--;
+  }
+  while (its--) {
+    if (flag & SOR_FORWARD_SWEEP || flag & SOR_LOCAL_FORWARD_SWEEP) {
+      for (i = 0; i < m; i++) {
+        nd   = diag[i] - ai[i];
+        nr   = ai[i + 1] - ai[i];
+        sum  = MatRowMinusDot_SeqAIJDelta(delta, b[i], i / bs, i, 0, nd, ai, aa, x);
+        t[i] = sum; /* save application of the lower-triangular part */
+        sum  = MatRowMinusDot_SeqAIJDelta(delta, sum, i / bs, i, nd + 1, nr, ai, aa, x);
+        x[i] = (1. - omega) * x[i] + sum * idiag[i]; /* omega in idiag */
+      }
+      xb = t;
+      PetscCall(PetscLogFlops(2.0 * a->nz));
+    } else xb = b;
+    if (flag & SOR_BACKWARD_SWEEP || flag & SOR_LOCAL_BACKWARD_SWEEP) {
+      for (i = m - 1; i >= 0; i--) {
+        nd = diag[i] - ai[i];
+        nr = ai[i + 1] - ai[i];
+        if (xb == b) {
+          /* whole matrix (no checkpointing available) */
+          sum  = MatRowMinusDot_SeqAIJDelta(delta, b[i], i / bs, i, 0, nr, ai, aa, x);
+          x[i] = (1. - omega) * x[i] + (sum + mdiag[i] * x[i]) * idiag[i];
+        } else { /* lower-triangular part has been saved, so only apply upper-triangular */
+          sum  = MatRowMinusDot_SeqAIJDelta(delta, xb[i], i / bs, i, nd + 1, nr, ai, aa, x);
+          x[i] = (1. - omega) * x[i] + sum * idiag[i]; /* omega in idiag */
+        }
+      }
+      if (xb == b) {
+        PetscCall(PetscLogFlops(2.0 * a->nz));
+      } else {
+        PetscCall(PetscLogFlops(a->nz)); /* assumes 1/2 in upper */
+      }
+    }
+  }
+  PetscCall(MatSeqAIJRestoreArrayRead(A, &aa));
+  PetscCall(VecRestoreArray(xx, &x));
+  PetscCall(VecRestoreArrayRead(bb, &b));
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
+
+/* MatConvert_SeqAIJ_SeqAIJDelta converts a SeqAIJ matrix into a
+ * SeqAIJDelta matrix.  This routine is called by the MatCreate_SeqAIJDelta()
+ * routine, but can also be used to convert an assembled SeqAIJ matrix
+ * into a SeqAIJDelta one. */
+PETSC_INTERN PetscErrorCode MatConvert_SeqAIJ_SeqAIJDelta(Mat A, MatType type, MatReuse reuse, Mat *newmat)
+{
+  Mat              B = *newmat;
+  Mat_SeqAIJ      *b;
+  Mat_SeqAIJDelta *delta;
+  PetscBool        sametype;
+
+  PetscFunctionBegin;
+  if (reuse == MAT_INITIAL_MATRIX) PetscCall(MatDuplicate(A, MAT_COPY_VALUES, &B));
+  PetscCall(PetscObjectTypeCompare((PetscObject)A, type, &sametype));
+  if (sametype) PetscFunctionReturn(PETSC_SUCCESS);
+
+  PetscCall(PetscNew(&delta));
+  b        = (Mat_SeqAIJ *)B->data;
+  B->spptr = (void *)delta;
+
+  /* The inode routines read a->j; this is also done in MatAssemblyEnd_SeqAIJDelta() */
+  b->inode.use = PETSC_FALSE;
+
+  /* Set function pointers for methods that we inherit from AIJ but override. */
+  B->ops->duplicate   = MatDuplicate_SeqAIJDelta;
+  B->ops->assemblyend = MatAssemblyEnd_SeqAIJDelta;
+  B->ops->destroy     = MatDestroy_SeqAIJDelta;
+  B->ops->view        = MatView_SeqAIJDelta;
+  B->ops->mult        = MatMult_SeqAIJDelta;
+  B->ops->multadd     = MatMultAdd_SeqAIJDelta;
+  B->ops->multdot     = NULL;
+  B->ops->sor         = MatSOR_SeqAIJDelta;
+
+  delta->nonzerostate = -1; /* this will trigger the generation of the compressed indices the first time through MatAssembly() */
+  delta->bs           = MATSEQAIJDELTA_BLOCK_SIZE;
+  PetscOptionsBegin(PetscObjectComm((PetscObject)B), ((PetscObject)B)->prefix, "AIJDELTA Options", "Mat");
+  PetscCall(PetscOptionsInt("-mat_aijdelta_block_size", "Number of rows sharing the same index width", "None", delta->bs, &delta->bs, NULL));
+  PetscOptionsEnd();
+  PetscCheck(delta->bs > 0, PetscObjectComm((PetscObject)B), PETSC_ERR_ARG_OUTOFRANGE, "Block size %" PetscInt_FMT " must be positive", delta->bs);
+
+  /* If A has already been assembled, build the compressed indices. */
+  if (A->assembled) PetscCall(MatSeqAIJDelta_CreateIndices(B));
+
+  PetscCall(PetscObjectComposeFunction((PetscObject)B, "MatConvert_seqaijdelta_seqaij_C", MatConvert_SeqAIJDelta_SeqAIJ));
+
+  PetscCall(PetscObjectChangeTypeName((PetscObject)B, MATSEQAIJDELTA));
+  *newmat = B;
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
+
+/*MC
+   MATSEQAIJDELTA - MATSEQAIJDELTA = "seqaijdelta" - A matrix type to be used for sequential sparse matrices whose
+   products with vectors read compressed column indices.
+
+   Options Database Keys:
++  -mat_type seqaijdelta          - sets the matrix type to `MATSEQAIJDELTA` during a call to `MatSetFromOptions()`
+.  -mat_seqaij_type seqaijdelta   - makes all `MATSEQAIJ` matrices, including the diagonal and off-diagonal blocks of `MATMPIAIJ`, of this type
+-  -mat_aijdelta_block_size <64>  - number of consecutive rows that use the same index width
+
+   Level: intermediate
+
+   Notes:
+   This type inherits from `MATSEQAIJ`. At assembly it stores, in addition to the `MATSEQAIJ` data, the first column index
+   of each row and, for each nonzero, the distance of its column from the first column of its row. For each block of rows
+   the distances are stored with the smallest of 16 bits, 32 bits, or `PetscInt` that can represent them all.
+   `MatMult()`, `MatMultAdd()` and `MatSOR()` use these compressed indices, so that for matrices whose rows span a limited
+   range of columns, such as those from discretizations on reasonably ordered meshes, less index data is moved
+   from memory. This is most useful with 64-bit indices.
+
+   The Eisenstat variants of `MatSOR()` and all other operations use the `MATSEQAIJ` data.
+
+.seealso: [](ch_matrices), `Mat`, `MATSEQAIJ`, `MATSEQAIJPERM`, `MATSEQAIJSELL`, `MatSeqAIJSetType()`
+M*/
+PETSC_EXTERN PetscErrorCode MatCreate_SeqAIJDelta(Mat A)
+{
+  PetscFunctionBegin;
+  PetscCall(MatSetType(A, MATSEQAIJ));
+  PetscCall(MatConvert_SeqAIJ_SeqAIJDelta(A, MATSEQAIJDELTA, MAT_INPLACE_MATRIX, &A));
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
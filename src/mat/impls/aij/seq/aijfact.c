@@ -2,6 +2,7 @@
 #include <../src/mat/impls/sbaij/seq/sbaij.h>
 #include <petscbt.h>
 #include <../src/mat/utils/freespace.h>
+#include <petsc/private/kernels/blockinvert.h>
 
 /*
       Computes an ordering to get most of the large numerical values in the lower triangular part of the matrix
@@ -609,6 +610,7 @@ PetscErrorCode MatLUFactorNumeric_SeqAIJ(Mat B, Mat A, const MatFactorInfo *info
   C->ops->matsolve          = MatMatSolve_SeqAIJ;
   C->assembled              = PETSC_TRUE;
   C->preallocated           = PETSC_TRUE;
+  PetscCall(MatSeqAIJSolveLevelsSetUp_Private(C));
 
   PetscCall(PetscLogFlops(C->cmap->n));
 
@@ -1655,6 +1657,373 @@ PetscErrorCode MatILUFactorSymbolic_SeqAIJ_ilu0(Mat fact, Mat A, IS isrow, IS is
   PetscFunctionReturn(PETSC_SUCCESS);
 }
 
+/* binary heap of the positions of the L part of the working row of the threshold ILU, the smallest on top */
+static inline void MatILUDTHeapPush_Private(PetscInt heap[], PetscInt *nh, PetscInt q)
+{
+  PetscInt k = (*nh)++;
+
+  while (k > 0 && heap[(k - 1) / 2] > q) {
+    heap[k] = heap[(k - 1) / 2];
+    k       = (k - 1) / 2;
+  }
+  heap[k] = q;
+}
+
+static inline PetscInt MatILUDTHeapPop_Private(PetscInt heap[], PetscInt *nh)
+{
+  PetscInt top = heap[0], last = heap[--(*nh)], k = 0, c;
+
+  while ((c = 2 * k + 1) < *nh) {
+    if (c + 1 < *nh && heap[c + 1] < heap[c]) c++;
+    if (heap[c] >= last) break;
+    heap[k] = heap[c];
+    k       = c;
+  }
+  heap[k] = last;
+  return top;
+}
+
+static inline PetscReal MatILUDTBlockNorm_Private(PetscInt bs2, const MatScalar v[])
+{
+  PetscReal sum = 0.0;
+
+  for (PetscInt l = 0; l < bs2; l++) sum += PetscRealPart(v[l] * PetscConj(v[l]));
+  return PetscSqrtReal(sum);
+}
+
+/*
+  MatILUDTFactor_Private - Threshold ILU of a matrix of bs x bs blocks in compressed sparse row format, used by MATSEQAIJ (bs = 1) and MATSEQBAIJ
+
+  Input Parameters:
++ fact - the factor, only used for its error flags
+. n, bs, ai, aj, aa - the matrix, with n block rows
+. r, ic - the row permutation and the inverse column permutation
+- info - the drop tolerance dt, the number p of fill entries per row, and for bs = 1 the column pivoting tolerance dtcol
+
+  Output Parameters:
++ bi, bdiag - the row pointers of L and the locations of the diagonal of U, of length n + 1, see MatILUFactorSymbolic_SeqAIJ_ilu0()
+. bj, ba - the factors, allocated here with PetscMalloc1()
+. perm - if not NULL, the position of each column after column pivoting, used with dtcol > 0
+- reallocs - the number of times the storage of the factors was enlarged
+
+  Notes:
+  Each row is computed in a dense working row, with its nonzeros tracked by a marker array: the positions of its L part are kept in a heap, so that
+  the pivot rows are eliminated in increasing order, and the fill they create is added as it appears. Multipliers and entries of U whose norm is
+  at most dt times the norm of the row of the matrix are dropped, then only the largest nzl + p entries of L and nzu + p entries of U are kept,
+  where nzl and nzu are the number of entries of the row of the matrix in the L and U parts.
+
+  The factors are stored with L from the front and U from the back of the storage, as in the other factorizations, which is enlarged when
+  they meet and compacted at the end. With dtcol > 0 the diagonal entry of a row is exchanged with its largest entry in U when it is smaller
+  than dtcol times it, as in ILUTP. Zero pivots are replaced by (1.e-4 + dt) times the norm of the row.
+*/
+PetscErrorCode MatILUDTFactor_Private(Mat fact, PetscInt n, PetscInt bs, const PetscInt ai[], const PetscInt aj[], const MatScalar aa[], const PetscInt r[], const PetscInt ic[], const MatFactorInfo *info, PetscInt bi[], PetscInt bdiag[], PetscInt **bj, MatScalar **ba, PetscInt perm[], PetscInt *reallocs)
+{
+  const PetscInt bs2 = bs * bs;
+  PetscReal      dt = info->dt < 0.0 ? 0.005 : info->dt, dtcol = perm && bs == 1 && info->dtcol > 0.0 ? info->dtcol : 0.0;
+  PetscInt       p = (PetscInt)info->dtcount, cap, rmax = 0, nzero = 0, *mark, *heap, *ju, *lj, *idx, *cperm = NULL, *iperm = NULL, *pivots = NULL;
+  PetscInt      *j;
+  MatScalar     *v, *w, *lv, *mwork = NULL, *vwork = NULL;
+  PetscReal     *nrm;
+  PetscBool      allowzeropivot = PetscNot(fact->erroriffailure), zeropivotdetected;
+  PetscLogDouble flops          = 0.0;
+
+  PetscFunctionBegin;
+  *reallocs = 0;
+  for (PetscInt i = 0; i < n; i++) rmax = PetscMax(rmax, ai[i + 1] - ai[i]);
+  if (p < 0) p = (PetscInt)(1.5 * rmax);
+  cap = PetscMax(PetscRealIntMultTruncate(info->fill, ai[n]), ai[n]) + 1;
+  PetscCall(PetscMalloc1(cap, &j));
+  PetscCall(PetscMalloc1(cap * bs2, &v));
+  PetscCall(PetscCalloc2(n * bs2, &w, n, &mark));
+  PetscCall(PetscMalloc5(n, &heap, n, &ju, n, &lj, n, &idx, n, &nrm));
+  PetscCall(PetscMalloc1(n * bs2, &lv));
+  if (bs > 1) PetscCall(PetscMalloc3(bs2, &mwork, bs, &vwork, bs, &pivots));
+  if (dtcol > 0.0) {
+    PetscCall(PetscMalloc2(n, &cperm, n, &iperm));
+    for (PetscInt i = 0; i < n; i++) cperm[i] = iperm[i] = i;
+  }
+
+  bi[0]    = 0;
+  bdiag[0] = cap - 1;
+  for (PetscInt i = 0; i < n; i++) {
+    const PetscInt row = r[i];
+    PetscInt       nl = 0, nu = 0, nh = 0, nzl = 0, nzu = 0, nk = 0, cd = cperm ? cperm[i] : i, need;
+    PetscReal      tnorm = 0.0, droptol;
+
+    PetscCheck(ai[row + 1] > ai[row], PETSC_COMM_SELF, PETSC_ERR_MAT_LU_ZRPVT, "Empty row in matrix: row in original ordering %" PetscInt_FMT " in permuted ordering %" PetscInt_FMT, row, i);
+    /* load the row of the matrix into the working row */
+    for (PetscInt k = ai[row]; k < ai[row + 1]; k++) {
+      PetscInt c = ic[aj[k]], q = iperm ? iperm[c] : c;
+
+      PetscCall(PetscArraycpy(w + c * bs2, aa + k * bs2, bs2));
+      for (PetscInt l = 0; l < bs2; l++) tnorm += PetscRealPart(aa[k * bs2 + l] * PetscConj(aa[k * bs2 + l]));
+      mark[c] = 1;
+      if (q < i) {
+        MatILUDTHeapPush_Private(heap, &nh, q);
+        nzl++;
+      } else {
+        ju[nu++] = c;
+        if (q > i) nzu++;
+      }
+    }
+    tnorm   = PetscSqrtReal(tnorm);
+    droptol = dt * tnorm;
+
+    /* eliminate with the pivot rows in increasing order, the fill in U(q,:) only has positions larger than q */
+    while (nh) {
+      PetscInt   q = MatILUDTHeapPop_Private(heap, &nh), c = cperm ? cperm[q] : q;
+      MatScalar *t = w + c * bs2;
+
+      mark[c] = 0;
+      if (bs == 1) t[0] *= v[bdiag[q]];
+      else PetscKernel_A_gets_A_times_B(bs, t, v + bs2 * bdiag[q], mwork);
+      if (MatILUDTBlockNorm_Private(bs2, t) > droptol) {
+        lj[nl] = q;
+        PetscCall(PetscArraycpy(lv + nl * bs2, t, bs2));
+        nl++;
+        for (PetscInt k = bdiag[q + 1] + 1; k < bdiag[q]; k++) {
+          PetscInt c2 = j[k];
+
+          if (!mark[c2]) {
+            PetscInt q2 = iperm ? iperm[c2] : c2;
+
+            mark[c2] = 1;
+            if (q2 < i) MatILUDTHeapPush_Private(heap, &nh, q2);
+            else ju[nu++] = c2;
+          }
+          if (bs == 1) w[c2] -= t[0] * v[k];
+          else PetscKernel_A_gets_A_minus_B_times_C(bs, w + c2 * bs2, lv + (nl - 1) * bs2, v + k * bs2);
+        }
+        flops += (2.0 * (bdiag[q] - bdiag[q + 1] - 1) + 1) * bs2 * bs;
+      }
+      PetscCall(PetscArrayzero(t, bs2));
+    }
+
+    /* drop the small entries of L and keep the largest nzl + p */
+    for (PetscInt k = 0; k < nl; k++) idx[k] = k;
+    if (nl > nzl + p) {
+      for (PetscInt k = 0; k < nl; k++) nrm[k] = MatILUDTBlockNorm_Private(bs2, lv + k * bs2);
+      PetscCall(PetscSortSplitReal(nzl + p, nl, nrm, idx));
+      nl = nzl + p;
+      PetscCall(PetscSortInt(nl, idx));
+    }
+
+    /* drop the small entries of U, except the diagonal, and keep the largest nzu + p */
+    for (PetscInt k = 0; k < nu; k++) {
+      PetscInt c = ju[k];
+
+      if (c == cd) continue;
+      nrm[nk] = MatILUDTBlockNorm_Private(bs2, w + c * bs2);
+      if (nrm[nk] <= droptol) {
+        mark[c] = 0;
+        PetscCall(PetscArrayzero(w + c * bs2, bs2));
+      } else ju[nk++] = c;
+    }
+    if (nk > nzu + p) {
+      PetscCall(PetscSortSplitReal(nzu + p, nk, nrm, ju));
+      for (PetscInt k = nzu + p; k < nk; k++) {
+        mark[ju[k]] = 0;
+        PetscCall(PetscArrayzero(w + ju[k] * bs2, bs2));
+      }
+      nk = nzu + p;
+    }
+
+    /* column pivoting: exchange the diagonal with the largest entry of U if it is too small */
+    if (dtcol > 0.0 && nk) {
+      PetscInt kmax = 0;
+
+      for (PetscInt k = 1; k < nk; k++)
+        if (PetscAbsScalar(w[ju[k]]) > PetscAbsScalar(w[ju[kmax]])) kmax = k;
+      if (dtcol * PetscAbsScalar(w[ju[kmax]]) > (mark[cd] ? PetscAbsScalar(w[cd]) : 0.0)) {
+        PetscInt cn = ju[kmax], qn = iperm[cn];
+
+        if (mark[cd] && w[cd] != 0.0) ju[kmax] = cd;
+        else {
+          mark[cd] = 0;
+          w[cd]    = 0.0;
+          ju[kmax] = ju[--nk];
+        }
+        cperm[qn] = cd;
+        iperm[cd] = qn;
+        cperm[i]  = cn;
+        iperm[cn] = i;
+        cd        = cn;
+      }
+    }
+
+    /* enlarge the storage if L and U would overlap */
+    need = nl + nk + 1;
+    if (bi[i] + need > bdiag[i] + 1) {
+      PetscInt   ncap = PetscMax(2 * cap, cap + need), shift = ncap - cap, *nj;
+      MatScalar *nv;
+
+      PetscCall(PetscMalloc1(ncap, &nj));
+      PetscCall(PetscMalloc1(ncap * bs2, &nv));
+      PetscCall(PetscArraycpy(nj, j, bi[i]));
+      PetscCall(PetscArraycpy(nv, v, bi[i] * bs2));
+      PetscCall(PetscArraycpy(nj + bdiag[i] + 1 + shift, j + bdiag[i] + 1, cap - bdiag[i] - 1));
+      PetscCall(PetscArraycpy(nv + (bdiag[i] + 1 + shift) * bs2, v + (bdiag[i] + 1) * bs2, (cap - bdiag[i] - 1) * bs2));
+      PetscCall(PetscFree(j));
+      PetscCall(PetscFree(v));
+      for (PetscInt k = 0; k <= i; k++) bdiag[k] += shift;
+      j   = nj;
+      v   = nv;
+      cap = ncap;
+      (*reallocs)++;
+    }
+
+    /* store the row */
+    for (PetscInt k = 0; k < nl; k++) {
+      j[bi[i] + k] = lj[idx[k]];
+      PetscCall(PetscArraycpy(v + (bi[i] + k) * bs2, lv + idx[k] * bs2, bs2));
+    }
+    bi[i + 1]    = bi[i] + nl;
+    bdiag[i + 1] = bdiag[i] - nk - 1;
+    for (PetscInt k = 0; k < nk; k++) {
+      j[bdiag[i + 1] + 1 + k] = ju[k];
+      PetscCall(PetscArraycpy(v + (bdiag[i + 1] + 1 + k) * bs2, w + ju[k] * bs2, bs2));
+      mark[ju[k]] = 0;
+      PetscCall(PetscArrayzero(w + ju[k] * bs2, bs2));
+    }
+    j[bdiag[i]] = i;
+    if (bs == 1) {
+      MatScalar d = mark[cd] ? w[cd] : 0.0;
+
+      if (d == 0.0) {
+        d = (1.e-4 + dt) * tnorm;
+        nzero++;
+      }
+      v[bdiag[i]] = 1.0 / d; /* invert the diagonal entries for simpler triangular solves */
+    } else {
+      if (mark[cd]) PetscCall(PetscArraycpy(v + bdiag[i] * bs2, w + cd * bs2, bs2));
+      else PetscCall(PetscArrayzero(v + bdiag[i] * bs2, bs2));
+      PetscCall(PetscKernel_A_gets_inverse_A(bs, v + bdiag[i] * bs2, pivots, vwork, allowzeropivot, &zeropivotdetected));
+      if (zeropivotdetected) fact->factorerrortype = MAT_FACTOR_NUMERIC_ZEROPIVOT;
+    }
+    mark[cd] = 0;
+    PetscCall(PetscArrayzero(w + cd * bs2, bs2));
+  }
+
+  /* close the gap between L and U, and number the columns of U by their positions, in increasing order */
+  if (n) {
+    PetscInt shift = bdiag[n] + 1 - bi[n];
+
+    PetscCall(PetscArraymove(j + bi[n], j + bdiag[n] + 1, cap - bdiag[n] - 1));
+    PetscCall(PetscArraymove(v + bi[n] * bs2, v + (bdiag[n] + 1) * bs2, (cap - bdiag[n] - 1) * bs2));
+    for (PetscInt k = 0; k <= n; k++) bdiag[k] -= shift;
+  } else bdiag[0] = -1;
+  for (PetscInt i = 0; i < n; i++) {
+    PetscInt *uj = j + bdiag[i + 1] + 1, nz = bdiag[i] - bdiag[i + 1] - 1;
+
+    if (iperm)
+      for (PetscInt k = 0; k < nz; k++) uj[k] = iperm[uj[k]];
+    if (bs == 1) PetscCall(PetscSortIntWithScalarArray(nz, uj, v + bdiag[i + 1] + 1));
+    else PetscCall(PetscSortIntWithDataArray(nz, uj, v + (bdiag[i + 1] + 1) * bs2, bs2 * sizeof(MatScalar), mwork));
+  }
+  if (perm) {
+    for (PetscInt i = 0; i < n; i++) perm[i] = cperm ? cperm[i] : i;
+  }
+  if (nzero) PetscCall(PetscInfo(fact, "Replaced %" PetscInt_FMT " zero pivots\n", nzero));
+
+  PetscCall(PetscFree2(w, mark));
+  PetscCall(PetscFree5(heap, ju, lj, idx, nrm));
+  PetscCall(PetscFree(lv));
+  PetscCall(PetscFree3(mwork, vwork, pivots));
+  PetscCall(PetscFree2(cperm, iperm));
+  PetscCall(PetscLogFlops(flops));
+  *bj = j;
+  *ba = v;
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
+
+static PetscErrorCode MatILUDTFactorNumeric_SeqAIJ(Mat fact, Mat A, const MatFactorInfo *info)
+{
+  Mat_SeqAIJ     *a = (Mat_SeqAIJ *)A->data, *b = (Mat_SeqAIJ *)fact->data;
+  const PetscInt *r, *ic;
+  PetscInt        n = A->rmap->n, *perm = NULL, reallocs;
+  PetscBool       row_identity, col_identity;
+
+  PetscFunctionBegin;
+  PetscCall(PetscFree(b->a));
+  PetscCall(PetscFree(b->j));
+  PetscCall(ISGetIndices(b->row, &r));
+  PetscCall(ISGetIndices(b->icol, &ic));
+  if (info->dtcol > 0.0) PetscCall(PetscMalloc1(n, &perm));
+  PetscCall(MatILUDTFactor_Private(fact, n, 1, a->i, a->j, a->a, r, ic, info, b->i, b->diag, &b->j, &b->a, perm, &reallocs));
+  b->maxnz = b->nz = b->diag[0] + 1;
+
+  /* column pivoting changes the column permutation used by the solves, the inverse of the original one is kept in b->icol */
+  if (perm) {
+    PetscInt *col;
+
+    PetscCall(PetscMalloc1(n, &col));
+    for (PetscInt k = 0; k < n; k++) col[ic[k]] = k;
+    for (PetscInt k = 0; k < n; k++) perm[k] = col[perm[k]];
+    PetscCall(PetscFree(col));
+    PetscCall(ISDestroy(&b->col));
+    PetscCall(ISCreateGeneral(PETSC_COMM_SELF, n, perm, PETSC_OWN_POINTER, &b->col));
+  }
+  PetscCall(ISRestoreIndices(b->row, &r));
+  PetscCall(ISRestoreIndices(b->icol, &ic));
+
+  fact->info.factor_mallocs    = reallocs;
+  fact->info.fill_ratio_needed = ((PetscReal)b->nz) / ((PetscReal)PetscMax(a->nz, 1));
+  PetscCall(PetscInfo(A, "Reallocs %" PetscInt_FMT " Fill ratio:given %g needed %g\n", reallocs, (double)info->fill, (double)fact->info.fill_ratio_needed));
+
+  PetscCall(ISIdentity(b->row, &row_identity));
+  PetscCall(ISIdentity(b->col, &col_identity));
+  if (row_identity && col_identity) fact->ops->solve = MatSolve_SeqAIJ_NaturalOrdering;
+  else fact->ops->solve = MatSolve_SeqAIJ;
+  fact->ops->solveadd          = MatSolveAdd_SeqAIJ;
+  fact->ops->solvetranspose    = MatSolveTranspose_SeqAIJ;
+  fact->ops->solvetransposeadd = MatSolveTransposeAdd_SeqAIJ;
+  fact->ops->matsolve          = MatMatSolve_SeqAIJ;
+  fact->assembled              = PETSC_TRUE;
+  fact->preallocated           = PETSC_TRUE;
+  PetscCall(MatSeqAIJSolveLevelsSetUp_Private(fact));
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
+
+/*
+  The threshold ILU, used by MatILUFactorSymbolic_SeqAIJ() when a drop tolerance is set with PCFactorSetDropTolerance(). The nonzero structure of
+  the factors depends on the values of the matrix, so it is computed by each numerical factorization.
+*/
+static PetscErrorCode MatILUDTFactorSymbolic_SeqAIJ(Mat fact, Mat A, IS isrow, IS iscol, const MatFactorInfo *info)
+{
+  Mat_SeqAIJ *b;
+  PetscInt    n = A->rmap->n;
+  IS          isicol;
+
+  PetscFunctionBegin;
+  PetscCall(ISInvertPermutation(iscol, PETSC_DECIDE, &isicol));
+  PetscCall(MatSeqAIJSetPreallocation_SeqAIJ(fact, MAT_SKIP_ALLOCATION, NULL));
+  b = (Mat_SeqAIJ *)fact->data;
+
+  b->free_a       = PETSC_TRUE;
+  b->free_ij      = PETSC_TRUE;
+  b->singlemalloc = PETSC_FALSE;
+
+  PetscCall(PetscMalloc1(n + 1, &b->i));
+  PetscCall(PetscMalloc1(n + 1, &b->diag));
+  b->a    = NULL;
+  b->j    = NULL;
+  b->ilen = NULL;
+  b->imax = NULL;
+  b->row  = isrow;
+  b->col  = iscol;
+  PetscCall(PetscObjectReference((PetscObject)isrow));
+  PetscCall(PetscObjectReference((PetscObject)iscol));
+  b->icol = isicol;
+  PetscCall(PetscMalloc1(n + 1, &b->solve_work));
+  b->maxnz = b->nz = 0;
+
+  fact->info.factor_mallocs    = 0;
+  fact->info.fill_ratio_given  = info->fill;
+  fact->info.fill_ratio_needed = 0.0;
+  fact->ops->lufactornumeric   = MatILUDTFactorNumeric_SeqAIJ;
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
+
 PetscErrorCode MatILUFactorSymbolic_SeqAIJ(Mat fact, Mat A, IS isrow, IS iscol, const MatFactorInfo *info)
 {
   Mat_SeqAIJ        *a = (Mat_SeqAIJ *)A->data, *b;
@@ -1674,6 +2043,10 @@ PetscErrorCode MatILUFactorSymbolic_SeqAIJ(Mat fact, Mat A, IS isrow, IS iscol,
 
   PetscFunctionBegin;
   PetscCheck(A->rmap->n == A->cmap->n, PETSC_COMM_SELF, PETSC_ERR_ARG_WRONG, "Must be square matrix, rows %" PetscInt_FMT " columns %" PetscInt_FMT, A->rmap->n, A->cmap->n);
+  if (info->usedt) {
+    PetscCall(MatILUDTFactorSymbolic_SeqAIJ(fact, A, isrow, iscol, info));
+    PetscFunctionReturn(PETSC_SUCCESS);
+  }
   PetscCall(MatMissingDiagonal(A, &missing, &i));
   PetscCheck(!missing, PETSC_COMM_SELF, PETSC_ERR_ARG_WRONGSTATE, "Matrix is missing diagonal entry %" PetscInt_FMT, i);
 
@@ -2158,6 +2531,7 @@ PetscErrorCode MatCholeskyFactorNumeric_SeqAIJ(Mat B, Mat A, const MatFactorInfo
 
   C->assembled    = PETSC_TRUE;
   C->preallocated = PETSC_TRUE;
+  PetscCall(MatSeqSBAIJSolveLevelsSetUp_Private(C));
 
   PetscCall(PetscLogFlops(C->rmap->n));
 
@@ -3200,350 +3574,155 @@ PetscErrorCode MatSolve_SeqAIJ(Mat A, Vec bb, Vec xx)
   PetscFunctionReturn(PETSC_SUCCESS);
 }
 
-#if 0
-// unused
 /*
-    This will get a new name and become a variant of MatILUFactor_SeqAIJ() there is no longer separate functions in the matrix function table for dt factors
+   Triangular solves that process the rows of each level of the factor concurrently, the level sets of the
+   sweeps are in a->solvelevels[]: forward and backward sweep of MatSolve() followed by those of MatSolveTranspose()
 */
-static PetscErrorCode MatILUDTFactor_SeqAIJ(Mat A, IS isrow, IS iscol, const MatFactorInfo *info, Mat *fact)
+static PetscErrorCode MatSolve_SeqAIJ_Levels(Mat A, Vec bb, Vec xx)
 {
-  Mat             B = *fact;
-  Mat_SeqAIJ     *a = (Mat_SeqAIJ *)A->data, *b;
-  IS              isicol;
-  const PetscInt *r, *ic;
-  PetscInt        i, n = A->rmap->n, *ai = a->i, *aj = a->j, *ajtmp, *adiag;
-  PetscInt       *bi, *bj, *bdiag, *bdiag_rev;
-  PetscInt        row, nzi, nzi_bl, nzi_bu, *im, nzi_al, nzi_au;
-  PetscInt        nlnk, *lnk;
-  PetscBT         lnkbt;
-  PetscBool       row_identity, icol_identity;
-  MatScalar      *aatmp, *pv, *batmp, *ba, *rtmp, *pc, multiplier, *vtmp, diag_tmp;
-  const PetscInt *ics;
-  PetscInt        j, nz, *pj, *bjtmp, k, ncut, *jtmp;
-  PetscReal       dt = info->dt, shift = info->shiftamount;
-  PetscInt        dtcount = (PetscInt)info->dtcount, nnz_max;
-  PetscBool       missing;
+  Mat_SeqAIJ            *a     = (Mat_SeqAIJ *)A->data;
+  const Mat_SolveLevels *lower = &a->solvelevels[0], *upper = &a->solvelevels[1];
+  const PetscInt         n = A->rmap->n, *ai = a->i, *aj = a->j, *adiag = a->diag;
+  const PetscInt        *r, *c;
+  PetscScalar           *x, *tmp = a->solve_work;
+  const PetscScalar     *b;
+  const MatScalar       *aa = a->a;
 
   PetscFunctionBegin;
-  if (dt == (PetscReal)PETSC_DEFAULT) dt = 0.005;
-  if (dtcount == PETSC_DEFAULT) dtcount = (PetscInt)(1.5 * a->rmax);
-
-  /* symbolic factorization, can be reused */
-  PetscCall(MatMissingDiagonal(A, &missing, &i));
-  PetscCheck(!missing, PETSC_COMM_SELF, PETSC_ERR_ARG_WRONGSTATE, "Matrix is missing diagonal entry %" PetscInt_FMT, i);
-  adiag = a->diag;
-
-  PetscCall(ISInvertPermutation(iscol, PETSC_DECIDE, &isicol));
-
-  /* bdiag is location of diagonal in factor */
-  PetscCall(PetscMalloc1(n + 1, &bdiag));     /* becomes b->diag */
-  PetscCall(PetscMalloc1(n + 1, &bdiag_rev)); /* temporary */
-
-  /* allocate row pointers bi */
-  PetscCall(PetscMalloc1(2 * n + 2, &bi));
-
-  /* allocate bj and ba; max num of nonzero entries is (ai[n]+2*n*dtcount+2) */
-  if (dtcount > n - 1) dtcount = n - 1; /* diagonal is excluded */
-  nnz_max = ai[n] + 2 * n * dtcount + 2;
-
-  PetscCall(PetscMalloc1(nnz_max + 1, &bj));
-  PetscCall(PetscMalloc1(nnz_max + 1, &ba));
-
-  /* put together the new matrix */
-  PetscCall(MatSeqAIJSetPreallocation_SeqAIJ(B, MAT_SKIP_ALLOCATION, NULL));
-  b = (Mat_SeqAIJ *)B->data;
-
-  b->free_a       = PETSC_TRUE;
-  b->free_ij      = PETSC_TRUE;
-  b->singlemalloc = PETSC_FALSE;
-
-  b->a    = ba;
-  b->j    = bj;
-  b->i    = bi;
-  b->diag = bdiag;
-  b->ilen = NULL;
-  b->imax = NULL;
-  b->row  = isrow;
-  b->col  = iscol;
-  PetscCall(PetscObjectReference((PetscObject)isrow));
-  PetscCall(PetscObjectReference((PetscObject)iscol));
-  b->icol = isicol;
-
-  PetscCall(PetscMalloc1(n + 1, &b->solve_work));
-  b->maxnz = nnz_max;
-
-  B->factortype            = MAT_FACTOR_ILUDT;
-  B->info.factor_mallocs   = 0;
-  B->info.fill_ratio_given = ((PetscReal)nnz_max) / ((PetscReal)ai[n]);
-  /*  end of symbolic factorization */
-
-  PetscCall(ISGetIndices(isrow, &r));
-  PetscCall(ISGetIndices(isicol, &ic));
-  ics = ic;
-
-  /* linked list for storing column indices of the active row */
-  nlnk = n + 1;
-  PetscCall(PetscLLCreate(n, n, nlnk, lnk, lnkbt));
-
-  /* im: used by PetscLLAddSortedLU(); jtmp: working array for column indices of active row */
-  PetscCall(PetscMalloc2(n, &im, n, &jtmp));
-  /* rtmp, vtmp: working arrays for sparse and contiguous row entries of active row */
-  PetscCall(PetscMalloc2(n, &rtmp, n, &vtmp));
-  PetscCall(PetscArrayzero(rtmp, n));
-
-  bi[0]         = 0;
-  bdiag[0]      = nnz_max - 1; /* location of diag[0] in factor B */
-  bdiag_rev[n]  = bdiag[0];
-  bi[2 * n + 1] = bdiag[0] + 1; /* endof bj and ba array */
-  for (i = 0; i < n; i++) {
-    /* copy initial fill into linked list */
-    nzi = ai[r[i] + 1] - ai[r[i]];
-    PetscCheck(nzi, PETSC_COMM_SELF, PETSC_ERR_MAT_LU_ZRPVT, "Empty row in matrix: row in original ordering %" PetscInt_FMT " in permuted ordering %" PetscInt_FMT, r[i], i);
-    nzi_al = adiag[r[i]] - ai[r[i]];
-    nzi_au = ai[r[i] + 1] - adiag[r[i]] - 1;
-    ajtmp  = aj + ai[r[i]];
-    PetscCall(PetscLLAddPerm(nzi, ajtmp, ic, n, &nlnk, lnk, lnkbt));
-
-    /* load in initial (unfactored row) */
-    aatmp = a->a + ai[r[i]];
-    for (j = 0; j < nzi; j++) rtmp[ics[*ajtmp++]] = *aatmp++;
-
-    /* add pivot rows into linked list */
-    row = lnk[n];
-    while (row < i) {
-      nzi_bl = bi[row + 1] - bi[row] + 1;
-      bjtmp  = bj + bdiag[row + 1] + 1; /* points to 1st column next to the diagonal in U */
-      PetscCall(PetscLLAddSortedLU(bjtmp, row, &nlnk, lnk, lnkbt, i, nzi_bl, im));
-      nzi += nlnk;
-      row = lnk[row];
-    }
-
-    /* copy data from lnk into jtmp, then initialize lnk */
-    PetscCall(PetscLLClean(n, n, nzi, lnk, jtmp, lnkbt));
+  if (!n) PetscFunctionReturn(PETSC_SUCCESS);
+  PetscCall(VecGetArrayRead(bb, &b));
+  PetscCall(VecGetArrayWrite(xx, &x));
+  PetscCall(ISGetIndices(a->row, &r));
+  PetscCall(ISGetIndices(a->col, &c));
 
-    /* numerical factorization */
-    bjtmp = jtmp;
-    row   = *bjtmp++; /* 1st pivot row */
-    while (row < i) {
-      pc         = rtmp + row;
-      pv         = ba + bdiag[row]; /* 1./(diag of the pivot row) */
-      multiplier = (*pc) * (*pv);
-      *pc        = multiplier;
-      if (PetscAbsScalar(*pc) > dt) { /* apply tolerance dropping rule */
-        pj = bj + bdiag[row + 1] + 1; /* point to 1st entry of U(row,:) */
-        pv = ba + bdiag[row + 1] + 1;
-        nz = bdiag[row] - bdiag[row + 1] - 1; /* num of entries in U(row,:), excluding diagonal */
-        for (j = 0; j < nz; j++) rtmp[*pj++] -= multiplier * (*pv++);
-        PetscCall(PetscLogFlops(1 + 2.0 * nz));
+  PetscPragmaOMP(parallel)
+  {
+    /* forward solve the lower triangular */
+    for (PetscInt l = 0; l < lower->nlevels; l++) {
+      PetscPragmaOMP(for schedule(static))
+      for (PetscInt t = lower->ptr[l]; t < lower->ptr[l + 1]; t++) {
+        const PetscInt   i = lower->rows[t], nz = ai[i + 1] - ai[i];
+        const PetscInt  *vi = aj + ai[i];
+        const MatScalar *v  = aa + ai[i];
+        PetscScalar      sum = b[r[i]];
+
+        PetscSparseDenseMinusDot(sum, tmp, v, vi, nz);
+        tmp[i] = sum;
       }
-      row = *bjtmp++;
     }
 
-    /* copy sparse rtmp into contiguous vtmp; separate L and U part */
-    diag_tmp = rtmp[i]; /* save diagonal value - may not needed?? */
-    nzi_bl   = 0;
-    j        = 0;
-    while (jtmp[j] < i) { /* Note: jtmp is sorted */
-      vtmp[j]       = rtmp[jtmp[j]];
-      rtmp[jtmp[j]] = 0.0;
-      nzi_bl++;
-      j++;
-    }
-    nzi_bu = nzi - nzi_bl - 1;
-    while (j < nzi) {
-      vtmp[j]       = rtmp[jtmp[j]];
-      rtmp[jtmp[j]] = 0.0;
-      j++;
-    }
-
-    bjtmp = bj + bi[i];
-    batmp = ba + bi[i];
-    /* apply level dropping rule to L part */
-    ncut = nzi_al + dtcount;
-    if (ncut < nzi_bl) {
-      PetscCall(PetscSortSplit(ncut, nzi_bl, vtmp, jtmp));
-      PetscCall(PetscSortIntWithScalarArray(ncut, jtmp, vtmp));
-    } else {
-      ncut = nzi_bl;
-    }
-    for (j = 0; j < ncut; j++) {
-      bjtmp[j] = jtmp[j];
-      batmp[j] = vtmp[j];
-    }
-    bi[i + 1] = bi[i] + ncut;
-    nzi       = ncut + 1;
-
-    /* apply level dropping rule to U part */
-    ncut = nzi_au + dtcount;
-    if (ncut < nzi_bu) {
-      PetscCall(PetscSortSplit(ncut, nzi_bu, vtmp + nzi_bl + 1, jtmp + nzi_bl + 1));
-      PetscCall(PetscSortIntWithScalarArray(ncut, jtmp + nzi_bl + 1, vtmp + nzi_bl + 1));
-    } else {
-      ncut = nzi_bu;
-    }
-    nzi += ncut;
-
-    /* mark bdiagonal */
-    bdiag[i + 1]         = bdiag[i] - (ncut + 1);
-    bdiag_rev[n - i - 1] = bdiag[i + 1];
-    bi[2 * n - i]        = bi[2 * n - i + 1] - (ncut + 1);
-    bjtmp                = bj + bdiag[i];
-    batmp                = ba + bdiag[i];
-    *bjtmp               = i;
-    *batmp               = diag_tmp; /* rtmp[i]; */
-    if (*batmp == 0.0) *batmp = dt + shift;
-    *batmp = 1.0 / (*batmp); /* invert diagonal entries for simpler triangular solves */
-
-    bjtmp = bj + bdiag[i + 1] + 1;
-    batmp = ba + bdiag[i + 1] + 1;
-    for (k = 0; k < ncut; k++) {
-      bjtmp[k] = jtmp[nzi_bl + 1 + k];
-      batmp[k] = vtmp[nzi_bl + 1 + k];
+    /* backward solve the upper triangular */
+    for (PetscInt l = 0; l < upper->nlevels; l++) {
+      PetscPragmaOMP(for schedule(static))
+      for (PetscInt t = upper->ptr[l]; t < upper->ptr[l + 1]; t++) {
+        const PetscInt   i = upper->rows[t], nz = adiag[i] - adiag[i + 1] - 1;
+        const PetscInt  *vi = aj + adiag[i + 1] + 1;
+        const MatScalar *v  = aa + adiag[i + 1] + 1;
+        PetscScalar      sum = tmp[i];
+
+        PetscSparseDenseMinusDot(sum, tmp, v, vi, nz);
+        x[c[i]] = tmp[i] = sum * aa[adiag[i]];
+      }
     }
-
-    im[i] = nzi; /* used by PetscLLAddSortedLU() */
-  }              /* for (i=0; i<n; i++) */
-  PetscCheck(bi[n] < bdiag[n], PETSC_COMM_SELF, PETSC_ERR_ARG_SIZ, "end of L array %" PetscInt_FMT " cannot >= the beginning of U array %" PetscInt_FMT, bi[n], bdiag[n]);
-
-  PetscCall(ISRestoreIndices(isrow, &r));
-  PetscCall(ISRestoreIndices(isicol, &ic));
-
-  PetscCall(PetscLLDestroy(lnk, lnkbt));
-  PetscCall(PetscFree2(im, jtmp));
-  PetscCall(PetscFree2(rtmp, vtmp));
-  PetscCall(PetscFree(bdiag_rev));
-
-  PetscCall(PetscLogFlops(B->cmap->n));
-  b->maxnz = b->nz = bi[n] + bdiag[0] - bdiag[n];
-
-  PetscCall(ISIdentity(isrow, &row_identity));
-  PetscCall(ISIdentity(isicol, &icol_identity));
-  if (row_identity && icol_identity) {
-    B->ops->solve = MatSolve_SeqAIJ_NaturalOrdering;
-  } else {
-    B->ops->solve = MatSolve_SeqAIJ;
   }
 
-  B->ops->solveadd          = NULL;
-  B->ops->solvetranspose    = NULL;
-  B->ops->solvetransposeadd = NULL;
-  B->ops->matsolve          = NULL;
-  B->assembled              = PETSC_TRUE;
-  B->preallocated           = PETSC_TRUE;
+  PetscCall(ISRestoreIndices(a->row, &r));
+  PetscCall(ISRestoreIndices(a->col, &c));
+  PetscCall(VecRestoreArrayRead(bb, &b));
+  PetscCall(VecRestoreArrayWrite(xx, &x));
+  PetscCall(PetscLogFlops(2.0 * a->nz - A->cmap->n));
   PetscFunctionReturn(PETSC_SUCCESS);
 }
 
-/* a wrapper of MatILUDTFactor_SeqAIJ() */
-/*
-    This will get a new name and become a variant of MatILUFactor_SeqAIJ() there is no longer separate functions in the matrix function table for dt factors
-*/
-
-static PetscErrorCode MatILUDTFactorSymbolic_SeqAIJ(Mat fact, Mat A, IS row, IS col, const MatFactorInfo *info)
+static PetscErrorCode MatSeqAIJSolveLevelsUpper_Private(Mat A, PetscBool transpose, Mat_SolveLevels *lev)
 {
+  Mat_SeqAIJ *a = (Mat_SeqAIJ *)A->data;
+  PetscInt    n = A->rmap->n, *ub, *ue;
+
   PetscFunctionBegin;
-  PetscCall(MatILUDTFactor_SeqAIJ(A, row, col, info, &fact));
+  PetscCall(PetscMalloc2(n, &ub, n, &ue));
+  for (PetscInt i = 0; i < n; i++) {
+    ub[i] = a->diag[i + 1] + 1;
+    ue[i] = a->diag[i];
+  }
+  PetscCall(MatSolveLevelsCreate_Private(n, ub, ue, a->j, transpose ? PETSC_FALSE : PETSC_TRUE, transpose, lev));
+  PetscCall(PetscFree2(ub, ue));
   PetscFunctionReturn(PETSC_SUCCESS);
 }
 
-/*
-   same as MatLUFactorNumeric_SeqAIJ(), except using contiguous array matrix factors
-   - intend to replace existing MatLUFactorNumeric_SeqAIJ()
-*/
-/*
-    This will get a new name and become a variant of MatILUFactor_SeqAIJ() there is no longer separate functions in the matrix function table for dt factors
-*/
-
-static PetscErrorCode MatILUDTFactorNumeric_SeqAIJ(Mat fact, Mat A, const MatFactorInfo *info)
+static PetscErrorCode MatSolveTranspose_SeqAIJ_Levels(Mat A, Vec bb, Vec xx)
 {
-  Mat             C = fact;
-  Mat_SeqAIJ     *a = (Mat_SeqAIJ *)A->data, *b = (Mat_SeqAIJ *)C->data;
-  IS              isrow = b->row, isicol = b->icol;
-  const PetscInt *r, *ic, *ics;
-  PetscInt        i, j, k, n = A->rmap->n, *ai = a->i, *aj = a->j, *bi = b->i, *bj = b->j;
-  PetscInt       *ajtmp, *bjtmp, nz, nzl, nzu, row, *bdiag = b->diag, *pj;
-  MatScalar      *rtmp, *pc, multiplier, *v, *pv, *aa = a->a;
-  PetscReal       dt = info->dt, shift = info->shiftamount;
-  PetscBool       row_identity, col_identity;
+  Mat_SeqAIJ            *a     = (Mat_SeqAIJ *)A->data;
+  const Mat_SolveLevels *upper = &a->solvelevels[2], *lower = &a->solvelevels[3];
+  const PetscInt         n = A->rmap->n, *adiag = a->diag;
+  const PetscInt        *r, *c;
+  PetscScalar           *x, *tmp = a->solve_work;
+  const PetscScalar     *b;
+  const MatScalar       *aa = a->a;
 
   PetscFunctionBegin;
-  PetscCall(ISGetIndices(isrow, &r));
-  PetscCall(ISGetIndices(isicol, &ic));
-  PetscCall(PetscMalloc1(n + 1, &rtmp));
-  ics = ic;
+  if (!n) PetscFunctionReturn(PETSC_SUCCESS);
+  if (!upper->nlevels) {
+    PetscCall(MatSeqAIJSolveLevelsUpper_Private(A, PETSC_TRUE, &a->solvelevels[2]));
+    PetscCall(MatSolveLevelsCreate_Private(n, a->i, a->i + 1, a->j, PETSC_TRUE, PETSC_TRUE, &a->solvelevels[3]));
+  }
+  PetscCall(VecGetArrayRead(bb, &b));
+  PetscCall(VecGetArrayWrite(xx, &x));
+  PetscCall(ISGetIndices(a->row, &r));
+  PetscCall(ISGetIndices(a->col, &c));
 
-  for (i = 0; i < n; i++) {
-    /* initialize rtmp array */
-    nzl   = bi[i + 1] - bi[i]; /* num of nonzeros in L(i,:) */
-    bjtmp = bj + bi[i];
-    for (j = 0; j < nzl; j++) rtmp[*bjtmp++] = 0.0;
-    rtmp[i] = 0.0;
-    nzu     = bdiag[i] - bdiag[i + 1]; /* num of nonzeros in U(i,:) */
-    bjtmp   = bj + bdiag[i + 1] + 1;
-    for (j = 0; j < nzu; j++) rtmp[*bjtmp++] = 0.0;
-
-    /* load in initial unfactored row of A */
-    nz    = ai[r[i] + 1] - ai[r[i]];
-    ajtmp = aj + ai[r[i]];
-    v     = aa + ai[r[i]];
-    for (j = 0; j < nz; j++) rtmp[ics[*ajtmp++]] = v[j];
-
-    /* numerical factorization */
-    bjtmp = bj + bi[i];        /* point to 1st entry of L(i,:) */
-    nzl   = bi[i + 1] - bi[i]; /* num of entries in L(i,:) */
-    k     = 0;
-    while (k < nzl) {
-      row        = *bjtmp++;
-      pc         = rtmp + row;
-      pv         = b->a + bdiag[row]; /* 1./(diag of the pivot row) */
-      multiplier = (*pc) * (*pv);
-      *pc        = multiplier;
-      if (PetscAbsScalar(multiplier) > dt) {
-        pj = bj + bdiag[row + 1] + 1; /* point to 1st entry of U(row,:) */
-        pv = b->a + bdiag[row + 1] + 1;
-        nz = bdiag[row] - bdiag[row + 1] - 1; /* num of entries in U(row,:), excluding diagonal */
-        for (j = 0; j < nz; j++) rtmp[*pj++] -= multiplier * (*pv++);
-        PetscCall(PetscLogFlops(1 + 2.0 * nz));
+  PetscPragmaOMP(parallel)
+  {
+    /* forward solve the U^T */
+    for (PetscInt l = 0; l < upper->nlevels; l++) {
+      PetscPragmaOMP(for schedule(static))
+      for (PetscInt t = upper->ptr[l]; t < upper->ptr[l + 1]; t++) {
+        const PetscInt i = upper->rows[t];
+        PetscScalar    sum = b[c[i]];
+
+        for (PetscInt k = upper->i[i]; k < upper->i[i + 1]; k++) sum -= aa[upper->idx[k]] * tmp[upper->j[k]];
+        tmp[i] = sum * aa[adiag[i]];
       }
-      k++;
     }
 
-    /* finished row so stick it into b->a */
-    /* L-part */
-    pv  = b->a + bi[i];
-    pj  = bj + bi[i];
-    nzl = bi[i + 1] - bi[i];
-    for (j = 0; j < nzl; j++) pv[j] = rtmp[pj[j]];
-
-    /* diagonal: invert diagonal entries for simpler triangular solves */
-    if (rtmp[i] == 0.0) rtmp[i] = dt + shift;
-    b->a[bdiag[i]] = 1.0 / rtmp[i];
+    /* backward solve the L^T */
+    for (PetscInt l = 0; l < lower->nlevels; l++) {
+      PetscPragmaOMP(for schedule(static))
+      for (PetscInt t = lower->ptr[l]; t < lower->ptr[l + 1]; t++) {
+        const PetscInt i = lower->rows[t];
+        PetscScalar    sum = tmp[i];
 
-    /* U-part */
-    pv  = b->a + bdiag[i + 1] + 1;
-    pj  = bj + bdiag[i + 1] + 1;
-    nzu = bdiag[i] - bdiag[i + 1] - 1;
-    for (j = 0; j < nzu; j++) pv[j] = rtmp[pj[j]];
+        for (PetscInt k = lower->i[i]; k < lower->i[i + 1]; k++) sum -= aa[lower->idx[k]] * tmp[lower->j[k]];
+        x[r[i]] = tmp[i] = sum;
+      }
+    }
   }
 
-  PetscCall(PetscFree(rtmp));
-  PetscCall(ISRestoreIndices(isicol, &ic));
-  PetscCall(ISRestoreIndices(isrow, &r));
+  PetscCall(ISRestoreIndices(a->row, &r));
+  PetscCall(ISRestoreIndices(a->col, &c));
+  PetscCall(VecRestoreArrayRead(bb, &b));
+  PetscCall(VecRestoreArrayWrite(xx, &x));
+  PetscCall(PetscLogFlops(2.0 * a->nz - A->cmap->n));
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
 
-  PetscCall(ISIdentity(isrow, &row_identity));
-  PetscCall(ISIdentity(isicol, &col_identity));
-  if (row_identity && col_identity) {
-    C->ops->solve = MatSolve_SeqAIJ_NaturalOrdering;
-  } else {
-    C->ops->solve = MatSolve_SeqAIJ;
-  }
-  C->ops->solveadd          = NULL;
-  C->ops->solvetranspose    = NULL;
-  C->ops->solvetransposeadd = NULL;
-  C->ops->matsolve          = NULL;
-  C->assembled              = PETSC_TRUE;
-  C->preallocated           = PETSC_TRUE;
+/*
+   MatSeqAIJSolveLevelsSetUp_Private - Computes the level sets of the triangular solves of a numerically factored matrix
+   and switches MatSolve() and MatSolveTranspose() to the level scheduled versions. The level sets of MatSolveTranspose()
+   need the transposed structure of the factors and are only computed on its first use.
+*/
+PetscErrorCode MatSeqAIJSolveLevelsSetUp_Private(Mat C)
+{
+  Mat_SeqAIJ *b = (Mat_SeqAIJ *)C->data;
+  PetscBool   use;
 
-  PetscCall(PetscLogFlops(C->cmap->n));
+  PetscFunctionBegin;
+  for (PetscInt k = 0; k < 4; k++) PetscCall(MatSolveLevelsReset_Private(&b->solvelevels[k]));
+  PetscCall(MatSolveLevelsUse_Private(C, &use));
+  if (!use) PetscFunctionReturn(PETSC_SUCCESS);
+  PetscCall(MatSolveLevelsCreate_Private(C->rmap->n, b->i, b->i + 1, b->j, PETSC_FALSE, PETSC_FALSE, &b->solvelevels[0]));
+  PetscCall(MatSeqAIJSolveLevelsUpper_Private(C, PETSC_FALSE, &b->solvelevels[1]));
+  C->ops->solve          = MatSolve_SeqAIJ_Levels;
+  C->ops->solvetranspose = MatSolveTranspose_SeqAIJ_Levels;
   PetscFunctionReturn(PETSC_SUCCESS);
 }
-#endif
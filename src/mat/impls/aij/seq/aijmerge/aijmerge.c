@@ -0,0 +1,345 @@
+/*
+  Defines basic operations for the MATSEQAIJMERGE matrix class.
+  This class is derived from the MATSEQAIJ class and retains the
+  compressed row storage, but computes the sparse matrix-vector products
+  with a merge-path decomposition: the rows and the nonzeros are merged
+  into a single list of work items that is cut into tiles of equal length,
+  so a tile may start or end in the middle of a row. Each tile is processed
+  by one thread; the partial sum of a row that is cut by the end of a tile
+  is carried over and added to the result after all tiles are done.
+  Long rows are therefore split between threads, and matrices whose row
+  lengths vary by orders of magnitude are still evenly balanced.
+*/
+
+#include <../src/mat/impls/aij/seq/aij.h>
+
+typedef struct {
+  PetscObjectState nonzerostate; /* nonzero structure for which the tiles were computed */
+  PetscInt         nthreads;     /* number of threads used in the products */
+  PetscInt         ntilesopt;    /* number of tiles requested by the user, 0 to use one tile per thread */
+  PetscInt         ntiles;       /* number of tiles */
+  PetscInt        *trow;         /* tile t starts at row trow[t], at the nonzero tnz[t] of the matrix */
+  PetscInt        *tnz;
+  PetscScalar     *carry;        /* partial sum of row trow[t+1] computed by tile t */
+} Mat_SeqAIJMerge;
+
+static PetscErrorCode MatSeqAIJMergeGetNumThreads_Private(PetscInt *nthreads)
+{
+  PetscFunctionBegin;
+#if defined(PETSC_HAVE_OPENMP)
+  *nthreads = PetscMax(PetscNumOMPThreads, 1);
+#else
+  *nthreads = 1;
+#endif
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
+
+/*
+   Cuts the merged list of the m row ends and the nz nonzeros into tiles of (nearly) the same length. The start of
+   each tile is found with a binary search along the diagonal of the merge grid, so that
+   a->i[trow[t]] <= tnz[t] <= a->i[trow[t]+1], i.e. every row before trow[t] is complete.
+*/
+static PetscErrorCode MatSeqAIJMerge_CreateTiles(Mat A)
+{
+  Mat_SeqAIJ      *a     = (Mat_SeqAIJ *)A->data;
+  Mat_SeqAIJMerge *merge = (Mat_SeqAIJMerge *)A->spptr;
+  PetscInt         m     = A->rmap->n, nthreads, ntiles, nz, t, lo, hi, mid, nsplit = 0;
+  PetscInt64       d;
+
+  PetscFunctionBegin;
+  PetscCall(MatSeqAIJMergeGetNumThreads_Private(&nthreads));
+  ntiles = merge->ntilesopt > 0 ? merge->ntilesopt : nthreads;
+  if (merge->nonzerostate == A->nonzerostate && merge->trow && merge->nthreads == nthreads && merge->ntiles == ntiles) PetscFunctionReturn(PETSC_SUCCESS); /* tiles exist and match current nonzero structure */
+  merge->nonzerostate = A->nonzerostate;
+  merge->nthreads     = nthreads;
+  merge->ntiles       = ntiles;
+  PetscCall(PetscFree3(merge->trow, merge->tnz, merge->carry));
+  PetscCall(PetscMalloc3(ntiles + 1, &merge->trow, ntiles + 1, &merge->tnz, ntiles, &merge->carry));
+
+  nz                     = m ? a->i[m] : 0;
+  merge->trow[0]         = 0;
+  merge->tnz[0]          = 0;
+  merge->trow[ntiles]    = m;
+  merge->tnz[ntiles]     = nz;
+  for (t = 1; t < ntiles; t++) {
+    /* the t-th split point is on the diagonal trow + tnz = d of the merge grid */
+    d  = ((PetscInt64)(m + nz) * t) / ntiles;
+    lo = (PetscInt)PetscMax(d - nz, 0);
+    hi = (PetscInt)PetscMin(d, m);
+    while (lo < hi) {
+      mid = lo + (hi - lo) / 2;
+      if (a->i[mid + 1] <= d - mid - 1) lo = mid + 1;
+      else hi = mid;
+    }
+    merge->trow[t] = lo;
+    merge->tnz[t]  = (PetscInt)(d - lo);
+    if (lo < m && merge->tnz[t] > a->i[lo]) nsplit++;
+  }
+  PetscCall(PetscInfo(A, "Cut %" PetscInt_FMT " rows with %" PetscInt_FMT " nonzeros into %" PetscInt_FMT " tiles for %" PetscInt_FMT " threads, %" PetscInt_FMT " rows are split between tiles\n", m, nz, ntiles, nthreads, nsplit));
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
+
+static PetscErrorCode MatSeqAIJMerge_Destroy_Private(Mat_SeqAIJMerge *merge)
+{
+  PetscFunctionBegin;
+  PetscCall(PetscFree3(merge->trow, merge->tnz, merge->carry));
+  merge->ntiles       = 0;
+  merge->nonzerostate = -1;
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
+
+PETSC_INTERN PetscErrorCode MatConvert_SeqAIJMerge_SeqAIJ(Mat A, MatType type, MatReuse reuse, Mat *newmat)
+{
+  /* This routine is only called to convert a MATSEQAIJMERGE to its base PETSc type, */
+  /* so we will ignore 'MatType type'. */
+  Mat              B = *newmat;
+  Mat_SeqAIJMerge *merge;
+
+  PetscFunctionBegin;
+  if (reuse == MAT_INITIAL_MATRIX) PetscCall(MatDuplicate(A, MAT_COPY_VALUES, &B));
+  merge = (Mat_SeqAIJMerge *)B->spptr;
+
+  /* Reset the original function pointers. */
+  B->ops->assemblyend = MatAssemblyEnd_SeqAIJ;
+  B->ops->destroy     = MatDestroy_SeqAIJ;
+  B->ops->duplicate   = MatDuplicate_SeqAIJ;
+  B->ops->view        = MatView_SeqAIJ;
+  B->ops->mult        = MatMult_SeqAIJ;
+  B->ops->multadd     = MatMultAdd_SeqAIJ;
+  B->ops->multdot     = MatMultDot_SeqAIJ;
+
+  PetscCall(PetscObjectComposeFunction((PetscObject)B, "MatConvert_seqaijmerge_seqaij_C", NULL));
+
+  PetscCall(MatSeqAIJMerge_Destroy_Private(merge));
+  PetscCall(PetscFree(B->spptr));
+
+  /* Change the type of B to MATSEQAIJ. */
+  PetscCall(PetscObjectChangeTypeName((PetscObject)B, MATSEQAIJ));
+
+  *newmat = B;
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
+
+static PetscErrorCode MatDestroy_SeqAIJMerge(Mat A)
+{
+  Mat_SeqAIJMerge *merge = (Mat_SeqAIJMerge *)A->spptr;
+
+  PetscFunctionBegin;
+  if (merge) {
+    /* If MatHeaderMerge() was used then this SeqAIJMerge matrix will not have a spptr. */
+    PetscCall(MatSeqAIJMerge_Destroy_Private(merge));
+    PetscCall(PetscFree(A->spptr));
+  }
+  PetscCall(PetscObjectChangeTypeName((PetscObject)A, MATSEQAIJ));
+  PetscCall(PetscObjectComposeFunction((PetscObject)A, "MatConvert_seqaijmerge_seqaij_C", NULL));
+  PetscCall(MatDestroy_SeqAIJ(A));
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
+
+static PetscErrorCode MatDuplicate_SeqAIJMerge(Mat A, MatDuplicateOption op, Mat *M)
+{
+  Mat_SeqAIJMerge *merge = (Mat_SeqAIJMerge *)A->spptr;
+  Mat_SeqAIJMerge *merge_dest;
+
+  PetscFunctionBegin;
+  /* MatDuplicate_SeqAIJ() creates a matrix of the same type; its tiles are computed when they are first needed */
+  PetscCall(MatDuplicate_SeqAIJ(A, op, M));
+  merge_dest            = (Mat_SeqAIJMerge *)(*M)->spptr;
+  merge_dest->ntilesopt = merge->ntilesopt;
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
+
+static PetscErrorCode MatAssemblyEnd_SeqAIJMerge(Mat A, MatAssemblyType mode)
+{
+  Mat_SeqAIJ *a = (Mat_SeqAIJ *)A->data;
+
+  PetscFunctionBegin;
+  if (mode == MAT_FLUSH_ASSEMBLY) PetscFunctionReturn(PETSC_SUCCESS);
+
+  /* the inode kernels are sequential, so they are not used for this class */
+  a->inode.use = PETSC_FALSE;
+  PetscCall(MatAssemblyEnd_SeqAIJ(A, mode));
+  PetscCall(MatSeqAIJMerge_CreateTiles(A));
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
+
+static PetscErrorCode MatView_SeqAIJMerge(Mat A, PetscViewer viewer)
+{
+  Mat_SeqAIJ       *a     = (Mat_SeqAIJ *)A->data;
+  Mat_SeqAIJMerge  *merge = (Mat_SeqAIJMerge *)A->spptr;
+  PetscBool         iascii;
+  PetscViewerFormat format;
+
+  PetscFunctionBegin;
+  PetscCall(MatView_SeqAIJ(A, viewer));
+  PetscCall(PetscObjectTypeCompare((PetscObject)viewer, PETSCVIEWERASCII, &iascii));
+  if (!iascii || !merge->trow) PetscFunctionReturn(PETSC_SUCCESS);
+  PetscCall(PetscViewerGetFormat(viewer, &format));
+  if (format == PETSC_VIEWER_ASCII_INFO || format == PETSC_VIEWER_ASCII_INFO_DETAIL) {
+    PetscInt nsplit = 0, rowmax = 0;
+
+    for (PetscInt t = 1; t < merge->ntiles; t++) {
+      if (merge->trow[t] < A->rmap->n && merge->tnz[t] > a->i[merge->trow[t]]) nsplit++;
+    }
+    for (PetscInt i = 0; i < A->rmap->n; i++) rowmax = PetscMax(rowmax, a->i[i + 1] - a->i[i]);
+    PetscCall(PetscViewerASCIIPrintf(viewer, "merge-path products with %" PetscInt_FMT " tiles on %" PetscInt_FMT " threads, %" PetscInt_FMT " rows split between tiles, longest row %" PetscInt_FMT "\n", merge->ntiles, merge->nthreads, nsplit, rowmax));
+  }
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
+
+/* computes z = y + A*x, or z = A*x if y is NULL, one tile of the merge path per iteration */
+static PetscErrorCode MatMultAdd_SeqAIJMerge_Private(Mat A, Vec xx, Vec yy, Vec zz)
+{
+  Mat_SeqAIJ        *a     = (Mat_SeqAIJ *)A->data;
+  Mat_SeqAIJMerge   *merge = (Mat_SeqAIJMerge *)A->spptr;
+  const PetscScalar *x;
+  PetscScalar       *y = NULL, *z, *carry;
+  const MatScalar   *aa;
+  const PetscInt    *ai, *aj, *trow, *tnz;
+  PetscInt           ntiles, m = A->rmap->n;
+
+  PetscFunctionBegin;
+  PetscCall(MatSeqAIJMerge_CreateTiles(A));
+  ntiles = merge->ntiles;
+  trow   = merge->trow;
+  tnz    = merge->tnz;
+  carry  = merge->carry;
+  ai     = a->i;
+  aj     = a->j;
+  PetscCall(MatSeqAIJGetArrayRead(A, &aa));
+  PetscCall(VecGetArrayRead(xx, &x));
+  if (yy) {
+    PetscCall(VecGetArrayPair(yy, zz, &y, &z));
+  } else {
+    PetscCall(VecGetArrayWrite(zz, &z));
+  }
+  PetscPragmaOMP(parallel for schedule(static) num_threads((int)merge->nthreads))
+  for (PetscInt t = 0; t < ntiles; t++) {
+    PetscInt    k = tnz[t], kend = tnz[t + 1];
+    PetscScalar sum;
+
+    /* the rows that end in this tile; the first one may have been started by the previous tiles */
+    for (PetscInt i = trow[t]; i < trow[t + 1]; i++) {
+      sum = y ? y[i] : 0.0;
+      for (; k < ai[i + 1]; k++) sum += aa[k] * x[aj[k]];
+      z[i] = sum;
+    }
+    /* the beginning of the row that is continued by the next tiles */
+    sum = 0.0;
+    for (; k < kend; k++) sum += aa[k] * x[aj[k]];
+    carry[t] = sum;
+  }
+  /* the carries are added in tile order, since several tiles can end in the same row */
+  for (PetscInt t = 0; t < ntiles - 1; t++) {
+    if (trow[t + 1] < m) z[trow[t + 1]] += carry[t];
+  }
+  PetscCall(MatSeqAIJRestoreArrayRead(A, &aa));
+  PetscCall(VecRestoreArrayRead(xx, &x));
+  if (yy) {
+    PetscCall(VecRestoreArrayPair(yy, zz, &y, &z));
+    PetscCall(PetscLogFlops(2.0 * a->nz));
+  } else {
+    PetscCall(VecRestoreArrayWrite(zz, &z));
+    PetscCall(PetscLogFlops(2.0 * a->nz - a->nonzerorowcnt));
+  }
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
+
+static PetscErrorCode MatMult_SeqAIJMerge(Mat A, Vec xx, Vec yy)
+{
+  PetscFunctionBegin;
+  PetscCall(MatMultAdd_SeqAIJMerge_Private(A, xx, NULL, yy));
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
+
+static PetscErrorCode MatMultAdd_SeqAIJMerge(Mat A, Vec xx, Vec yy, Vec zz)
+{
+  PetscFunctionBegin;
+  PetscCall(MatMultAdd_SeqAIJMerge_Private(A, xx, yy, zz));
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
+
+/* MatConvert_SeqAIJ_SeqAIJMerge converts a SeqAIJ matrix into a
+ * SeqAIJMerge matrix.  This routine is called by the MatCreate_SeqAIJMerge()
+ * routine, but can also be used to convert an assembled SeqAIJ matrix
+ * into a SeqAIJMerge one. With MAT_INPLACE_MATRIX the matrix arrays are kept,
+ * while MAT_INITIAL_MATRIX converts a copy of A made with MatDuplicate(). */
+PETSC_INTERN PetscErrorCode MatConvert_SeqAIJ_SeqAIJMerge(Mat A, MatType type, MatReuse reuse, Mat *newmat)
+{
+  Mat              B = *newmat;
+  Mat_SeqAIJ      *b;
+  Mat_SeqAIJMerge *merge;
+  PetscBool        sametype;
+
+  PetscFunctionBegin;
+  if (reuse == MAT_INITIAL_MATRIX) PetscCall(MatDuplicate(A, MAT_COPY_VALUES, &B));
+  PetscCall(PetscObjectTypeCompare((PetscObject)A, type, &sametype));
+  if (sametype) PetscFunctionReturn(PETSC_SUCCESS);
+
+  PetscCall(PetscNew(&merge));
+  b        = (Mat_SeqAIJ *)B->data;
+  B->spptr = (void *)merge;
+
+  /* The inode routines are sequential; this is also done in MatAssemblyEnd_SeqAIJMerge() */
+  b->inode.use = PETSC_FALSE;
+
+  /* Set function pointers for methods that we inherit from AIJ but override. */
+  B->ops->duplicate   = MatDuplicate_SeqAIJMerge;
+  B->ops->assemblyend = MatAssemblyEnd_SeqAIJMerge;
+  B->ops->destroy     = MatDestroy_SeqAIJMerge;
+  B->ops->view        = MatView_SeqAIJMerge;
+  B->ops->mult        = MatMult_SeqAIJMerge;
+  B->ops->multadd     = MatMultAdd_SeqAIJMerge;
+  B->ops->multdot     = NULL;
+
+  merge->nonzerostate = -1; /* this will trigger the computation of the tiles the first time through MatAssembly() */
+  PetscOptionsBegin(PetscObjectComm((PetscObject)B), ((PetscObject)B)->prefix, "AIJMERGE Options", "Mat");
+  PetscCall(PetscOptionsInt("-mat_aijmerge_tiles", "Number of tiles the merge path is cut into, 0 for one per thread", "None", merge->ntilesopt, &merge->ntilesopt, NULL));
+  PetscOptionsEnd();
+  PetscCheck(merge->ntilesopt >= 0, PetscObjectComm((PetscObject)B), PETSC_ERR_ARG_OUTOFRANGE, "Number of tiles %" PetscInt_FMT " cannot be negative", merge->ntilesopt);
+
+  /* If A has already been assembled, compute the tiles. */
+  if (A->assembled) PetscCall(MatSeqAIJMerge_CreateTiles(B));
+
+  PetscCall(PetscObjectComposeFunction((PetscObject)B, "MatConvert_seqaijmerge_seqaij_C", MatConvert_SeqAIJMerge_SeqAIJ));
+
+  PetscCall(PetscObjectChangeTypeName((PetscObject)B, MATSEQAIJMERGE));
+  *newmat = B;
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
+
+/*MC
+   MATSEQAIJMERGE - MATSEQAIJMERGE = "seqaijmerge" - A matrix type to be used for sequential sparse matrices with very
+   irregular row lengths, whose products with vectors are computed with a merge-path decomposition.
+
+   Options Database Keys:
++  -mat_type seqaijmerge        - sets the matrix type to `MATSEQAIJMERGE` during a call to `MatSetFromOptions()`
+.  -mat_seqaij_type seqaijmerge - makes all `MATSEQAIJ` matrices, including the diagonal and off-diagonal blocks of `MATMPIAIJ`, of this type
+-  -mat_aijmerge_tiles <n>      - number of tiles the work is cut into, the default is one per OpenMP thread
+
+   Level: intermediate
+
+   Notes:
+   This type inherits from `MATSEQAIJ` and uses its storage; converting from `MATSEQAIJ` with `MAT_INPLACE_MATRIX`, as
+   `MatSetType()` and `-mat_seqaij_type` do, does not copy the matrix arrays, while `MAT_INITIAL_MATRIX` converts a copy
+   of the matrix. `MatMult()` and `MatMultAdd()` view the row ends and the nonzeros of the matrix as one list of work items
+   and cut it into tiles of equal length, so a single long row may be shared by several tiles. The partial sums of rows
+   that cross the end of a tile are added to the result after all tiles are processed. The tiles are computed once per
+   nonzero structure in `MatAssemblyEnd()`.
+
+   Compared to `MATSEQAIJOMP`, which divides whole rows among the threads, this type keeps the threads balanced when
+   a few rows hold a large fraction of the nonzeros, at the price of a small sequential fix-up per tile.
+
+   The tiles are processed by OpenMP threads when PETSc was configured with `--with-openmp`; the number of threads is
+   set with `-omp_num_threads` or the environmental variable `OMP_NUM_THREADS`. `MatMultTranspose()` is inherited from
+   `MATSEQAIJ`.
+
+.seealso: [](ch_matrices), `Mat`, `MATSEQAIJ`, `MATSEQAIJOMP`, `MATSEQAIJSELL`, `MatSeqAIJSetType()`
+M*/
+PETSC_EXTERN PetscErrorCode MatCreate_SeqAIJMerge(Mat A)
+{
+  PetscFunctionBegin;
+  PetscCall(MatSetType(A, MATSEQAIJ));
+  PetscCall(MatConvert_SeqAIJ_SeqAIJMerge(A, MATSEQAIJMERGE, MAT_INPLACE_MATRIX, &A));
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
@@ -0,0 +1,283 @@
+/*
+  Defines basic operations for the MATSEQAIJMIXED matrix class.
+  This class is derived from the MATSEQAIJ class and retains the
+  compressed row storage, but keeps a single precision copy of the
+  nonzero values that is used in the sparse matrix-vector products.
+  The vectors and all arithmetic remain in PetscScalar precision; each
+  matrix entry is converted to PetscScalar as it is read, so these products
+  move half the value data from memory.
+*/
+
+#include <../src/mat/impls/aij/seq/aij.h>
+
+typedef struct {
+  PetscObjectState state; /* state of the matrix when the single precision values were copied */
+  float           *af;    /* single precision copy of a->a */
+  PetscInt         naf;   /* length of af */
+} Mat_SeqAIJMixed;
+
+/* Copies a->a into the single precision array, if the values have changed since they were last copied */
+static PetscErrorCode MatSeqAIJMixed_CopyValues(Mat A)
+{
+  Mat_SeqAIJ      *a     = (Mat_SeqAIJ *)A->data;
+  Mat_SeqAIJMixed *mixed = (Mat_SeqAIJMixed *)A->spptr;
+  PetscObjectState state;
+  const MatScalar *aa;
+  PetscInt         nz = a->i[A->rmap->n];
+
+  PetscFunctionBegin;
+  PetscCall(PetscObjectStateGet((PetscObject)A, &state));
+  if (mixed->state == state) PetscFunctionReturn(PETSC_SUCCESS);
+  if (mixed->naf < nz) {
+    PetscCall(PetscFree(mixed->af));
+    PetscCall(PetscMalloc1(nz, &mixed->af));
+    mixed->naf = nz;
+  }
+  PetscCall(MatSeqAIJGetArrayRead(A, &aa));
+  for (PetscInt k = 0; k < nz; k++) mixed->af[k] = (float)aa[k];
+  PetscCall(MatSeqAIJRestoreArrayRead(A, &aa));
+  mixed->state = state;
+  PetscCall(PetscInfo(A, "Copied %" PetscInt_FMT " nonzero values to single precision\n", nz));
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
+
+PETSC_INTERN PetscErrorCode MatConvert_SeqAIJMixed_SeqAIJ(Mat A, MatType type, MatReuse reuse, Mat *newmat)
+{
+  /* This routine is only called to convert a MATSEQAIJMIXED to its base PETSc type, */
+  /* so we will ignore 'MatType type'. */
+  Mat              B = *newmat;
+  Mat_SeqAIJMixed *mixed;
+
+  PetscFunctionBegin;
+  if (reuse == MAT_INITIAL_MATRIX) PetscCall(MatDuplicate(A, MAT_COPY_VALUES, &B));
+  mixed = (Mat_SeqAIJMixed *)B->spptr;
+
+  /* Reset the original function pointers. */
+  B->ops->assemblyend      = MatAssemblyEnd_SeqAIJ;
+  B->ops->destroy          = MatDestroy_SeqAIJ;
+  B->ops->mult             = MatMult_SeqAIJ;
+  B->ops->multadd          = MatMultAdd_SeqAIJ;
+  B->ops->multdot          = MatMultDot_SeqAIJ;
+  B->ops->multtranspose    = MatMultTranspose_SeqAIJ;
+  B->ops->multtransposeadd = MatMultTransposeAdd_SeqAIJ;
+
+  PetscCall(PetscObjectComposeFunction((PetscObject)B, "MatConvert_seqaijmixed_seqaij_C", NULL));
+
+  PetscCall(PetscFree(mixed->af));
+  PetscCall(PetscFree(B->spptr));
+
+  /* Change the type of B to MATSEQAIJ. */
+  PetscCall(PetscObjectChangeTypeName((PetscObject)B, MATSEQAIJ));
+
+  *newmat = B;
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
+
+static PetscErrorCode MatDestroy_SeqAIJMixed(Mat A)
+{
+  Mat_SeqAIJMixed *mixed = (Mat_SeqAIJMixed *)A->spptr;
+
+  PetscFunctionBegin;
+  if (mixed) {
+    /* If MatHeaderMerge() was used then this SeqAIJMixed matrix will not have a spptr. */
+    PetscCall(PetscFree(mixed->af));
+    PetscCall(PetscFree(A->spptr));
+  }
+  PetscCall(PetscObjectChangeTypeName((PetscObject)A, MATSEQAIJ));
+  PetscCall(PetscObjectComposeFunction((PetscObject)A, "MatConvert_seqaijmixed_seqaij_C", NULL));
+  PetscCall(MatDestroy_SeqAIJ(A));
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
+
+static PetscErrorCode MatAssemblyEnd_SeqAIJMixed(Mat A, MatAssemblyType mode)
+{
+  Mat_SeqAIJ *a = (Mat_SeqAIJ *)A->data;
+
+  PetscFunctionBegin;
+  if (mode == MAT_FLUSH_ASSEMBLY) PetscFunctionReturn(PETSC_SUCCESS);
+
+  /* the inode kernels read a->a, so they are not used for this class */
+  a->inode.use = PETSC_FALSE;
+  PetscCall(MatAssemblyEnd_SeqAIJ(A, mode));
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
+
+/* computes z = y + A*x, or z = A*x if y is NULL */
+static PetscErrorCode MatMultAdd_SeqAIJMixed_Private(Mat A, Vec xx, Vec yy, Vec zz)
+{
+  Mat_SeqAIJ        *a     = (Mat_SeqAIJ *)A->data;
+  Mat_SeqAIJMixed   *mixed = (Mat_SeqAIJMixed *)A->spptr;
+  const PetscScalar *x;
+  PetscScalar       *y = NULL, *z;
+  const float       *af;
+  const PetscInt    *aj, *ii, *ridx = NULL;
+  PetscInt           m = A->rmap->n, n, i, j, r;
+  PetscScalar        sum;
+  PetscBool          usecprow = a->compressedrow.use;
+
+  PetscFunctionBegin;
+  PetscCall(MatSeqAIJMixed_CopyValues(A));
+  PetscCall(VecGetArrayRead(xx, &x));
+  if (yy) {
+    PetscCall(VecGetArrayPair(yy, zz, &y, &z));
+  } else {
+    PetscCall(VecGetArrayWrite(zz, &z));
+  }
+  ii = a->i;
+  if (usecprow) { /* use compressed row format */
+    if (!yy) PetscCall(PetscArrayzero(z, m));
+    else if (zz != yy) PetscCall(PetscArraycpy(z, y, m));
+    m    = a->compressedrow.nrows;
+    ii   = a->compressedrow.i;
+    ridx = a->compressedrow.rindex;
+  }
+  for (i = 0; i < m; i++) {
+    r   = usecprow ? ridx[i] : i;
+    n   = ii[i + 1] - ii[i];
+    aj  = a->j + ii[i];
+    af  = mixed->af + ii[i];
+    sum = y ? y[r] : 0.0;
+    for (j = 0; j < n; j++) sum += (PetscScalar)af[j] * x[aj[j]];
+    z[r] = sum;
+  }
+  PetscCall(VecRestoreArrayRead(xx, &x));
+  if (yy) {
+    PetscCall(VecRestoreArrayPair(yy, zz, &y, &z));
+    PetscCall(PetscLogFlops(2.0 * a->nz));
+  } else {
+    PetscCall(VecRestoreArrayWrite(zz, &z));
+    PetscCall(PetscLogFlops(2.0 * a->nz - a->nonzerorowcnt));
+  }
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
+
+static PetscErrorCode MatMult_SeqAIJMixed(Mat A, Vec xx, Vec yy)
+{
+  PetscFunctionBegin;
+  PetscCall(MatMultAdd_SeqAIJMixed_Private(A, xx, NULL, yy));
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
+
+static PetscErrorCode MatMultAdd_SeqAIJMixed(Mat A, Vec xx, Vec yy, Vec zz)
+{
+  PetscFunctionBegin;
+  PetscCall(MatMultAdd_SeqAIJMixed_Private(A, xx, yy, zz));
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
+
+static PetscErrorCode MatMultTransposeAdd_SeqAIJMixed(Mat A, Vec xx, Vec zz, Vec yy)
+{
+  Mat_SeqAIJ        *a     = (Mat_SeqAIJ *)A->data;
+  Mat_SeqAIJMixed   *mixed = (Mat_SeqAIJMixed *)A->spptr;
+  const PetscScalar *x;
+  PetscScalar       *y, alpha;
+  const float       *af;
+  const PetscInt    *idx, *ii, *ridx = NULL;
+  PetscInt           m = A->rmap->n, n, i, j;
+  PetscBool          usecprow = a->compressedrow.use;
+
+  PetscFunctionBegin;
+  PetscCall(MatSeqAIJMixed_CopyValues(A));
+  if (zz != yy) PetscCall(VecCopy(zz, yy));
+  PetscCall(VecGetArrayRead(xx, &x));
+  PetscCall(VecGetArray(yy, &y));
+  if (usecprow) {
+    m    = a->compressedrow.nrows;
+    ii   = a->compressedrow.i;
+    ridx = a->compressedrow.rindex;
+  } else {
+    ii = a->i;
+  }
+  for (i = 0; i < m; i++) {
+    idx   = a->j + ii[i];
+    af    = mixed->af + ii[i];
+    n     = ii[i + 1] - ii[i];
+    alpha = usecprow ? x[ridx[i]] : x[i];
+    for (j = 0; j < n; j++) y[idx[j]] += alpha * (PetscScalar)af[j];
+  }
+  PetscCall(PetscLogFlops(2.0 * a->nz));
+  PetscCall(VecRestoreArrayRead(xx, &x));
+  PetscCall(VecRestoreArray(yy, &y));
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
+
+static PetscErrorCode MatMultTranspose_SeqAIJMixed(Mat A, Vec xx, Vec yy)
+{
+  PetscFunctionBegin;
+  PetscCall(VecSet(yy, 0.0));
+  PetscCall(MatMultTransposeAdd_SeqAIJMixed(A, xx, yy, yy));
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
+
+/* MatConvert_SeqAIJ_SeqAIJMixed converts a SeqAIJ matrix into a
+ * SeqAIJMixed matrix.  This routine is called by the MatCreate_SeqAIJMixed()
+ * routine, but can also be used to convert an assembled SeqAIJ matrix
+ * into a SeqAIJMixed one. */
+PETSC_INTERN PetscErrorCode MatConvert_SeqAIJ_SeqAIJMixed(Mat A, MatType type, MatReuse reuse, Mat *newmat)
+{
+  Mat              B = *newmat;
+  Mat_SeqAIJ      *b;
+  Mat_SeqAIJMixed *mixed;
+  PetscBool        sametype;
+
+  PetscFunctionBegin;
+  if (reuse == MAT_INITIAL_MATRIX) PetscCall(MatDuplicate(A, MAT_COPY_VALUES, &B));
+  PetscCall(PetscObjectTypeCompare((PetscObject)A, type, &sametype));
+  if (sametype) PetscFunctionReturn(PETSC_SUCCESS);
+
+  PetscCall(PetscNew(&mixed));
+  b            = (Mat_SeqAIJ *)B->data;
+  B->spptr     = (void *)mixed;
+  mixed->state = -1; /* the single precision values are copied the first time they are needed */
+
+  /* The inode routines read a->a; this is also done in MatAssemblyEnd_SeqAIJMixed() */
+  b->inode.use = PETSC_FALSE;
+
+  /* Set function pointers for methods that we inherit from AIJ but override. */
+  B->ops->assemblyend      = MatAssemblyEnd_SeqAIJMixed;
+  B->ops->destroy          = MatDestroy_SeqAIJMixed;
+  B->ops->mult             = MatMult_SeqAIJMixed;
+  B->ops->multadd          = MatMultAdd_SeqAIJMixed;
+  B->ops->multdot          = NULL;
+  B->ops->multtranspose    = MatMultTranspose_SeqAIJMixed;
+  B->ops->multtransposeadd = MatMultTransposeAdd_SeqAIJMixed;
+
+  PetscCall(PetscObjectComposeFunction((PetscObject)B, "MatConvert_seqaijmixed_seqaij_C", MatConvert_SeqAIJMixed_SeqAIJ));
+
+  PetscCall(PetscObjectChangeTypeName((PetscObject)B, MATSEQAIJMIXED));
+  *newmat = B;
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
+
+/*MC
+   MATSEQAIJMIXED - MATSEQAIJMIXED = "seqaijmixed" - A matrix type to be used for sequential sparse matrices whose
+   products with vectors use single precision matrix entries.
+
+   Options Database Keys:
++  -mat_type seqaijmixed - sets the matrix type to `MATSEQAIJMIXED` during a call to `MatSetFromOptions()`
+-  -mat_seqaij_type seqaijmixed - makes all `MATSEQAIJ` matrices, including the diagonal and off-diagonal blocks of `MATMPIAIJ`, of this type
+
+   Level: intermediate
+
+   Notes:
+   This type inherits from `MATSEQAIJ`. In addition to the `MATSEQAIJ` data it keeps a single precision copy of the
+   nonzero values, which is updated when the matrix changes. `MatMult()`, `MatMultAdd()`, `MatMultTranspose()`, and
+   `MatMultTransposeAdd()` read the single precision values and convert them to `PetscScalar` on the fly; the vectors
+   and the accumulation of the products keep full precision. All other operations, including factorizations, use the
+   `MATSEQAIJ` values.
+
+   This is intended for operators inside preconditioners where full precision of the matrix entries is not needed,
+   for example the smoothers of `PCMG` or the blocks of `PCBJACOBI`. Pass a `MATAIJMIXED` copy of the matrix,
+   obtained with `MatConvert()`, as the `Pmat` argument of `KSPSetOperators()`.
+
+   Only available for real scalars.
+
+.seealso: [](ch_matrices), `Mat`, `MATAIJMIXED`, `MATMPIAIJMIXED`, `MATSEQAIJ`, `MatConvert()`, `KSPSetOperators()`
+M*/
+PETSC_EXTERN PetscErrorCode MatCreate_SeqAIJMixed(Mat A)
+{
+  PetscFunctionBegin;
+  PetscCall(MatSetType(A, MATSEQAIJ));
+  PetscCall(MatConvert_SeqAIJ_SeqAIJMixed(A, MATSEQAIJMIXED, MAT_INPLACE_MATRIX, &A));
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
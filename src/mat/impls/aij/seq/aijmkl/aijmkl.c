@@ -45,6 +45,7 @@ PETSC_INTERN PetscErrorCode MatConvert_SeqAIJMKL_SeqAIJ(Mat A, MatType type, Mat
   B->ops->mult                    = MatMult_SeqAIJ;
   B->ops->multtranspose           = MatMultTranspose_SeqAIJ;
   B->ops->multadd                 = MatMultAdd_SeqAIJ;
+  B->ops->multdot                 = MatMultDot_SeqAIJ;
   B->ops->multtransposeadd        = MatMultTransposeAdd_SeqAIJ;
   B->ops->productsetfromoptions   = MatProductSetFromOptions_SeqAIJ;
   B->ops->matmultsymbolic         = MatMatMultSymbolic_SeqAIJ_SeqAIJ;
@@ -1044,6 +1045,7 @@ PETSC_INTERN PetscErrorCode MatConvert_SeqAIJ_SeqAIJMKL(Mat A, MatType type, Mat
   B->ops->mult             = MatMult_SeqAIJMKL_SpMV2;
   B->ops->multtranspose    = MatMultTranspose_SeqAIJMKL_SpMV2;
   B->ops->multadd          = MatMultAdd_SeqAIJMKL_SpMV2;
+  B->ops->multdot          = NULL;
   B->ops->multtransposeadd = MatMultTransposeAdd_SeqAIJMKL_SpMV2;
   #if defined(PETSC_HAVE_MKL_SPARSE_SP2M_FEATURE)
   B->ops->productsetfromoptions   = MatProductSetFromOptions_SeqAIJMKL;
@@ -1068,6 +1070,7 @@ PETSC_INTERN PetscErrorCode MatConvert_SeqAIJ_SeqAIJMKL(Mat A, MatType type, Mat
     B->ops->mult             = MatMult_SeqAIJMKL;
     B->ops->multtranspose    = MatMultTranspose_SeqAIJMKL;
     B->ops->multadd          = MatMultAdd_SeqAIJMKL;
+    B->ops->multdot          = NULL;
     B->ops->multtransposeadd = MatMultTransposeAdd_SeqAIJMKL;
   }
 #endif
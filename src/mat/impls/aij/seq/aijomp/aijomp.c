@@ -0,0 +1,435 @@
+/*
+  Defines basic operations for the MATSEQAIJOMP matrix class.
+  This class is derived from the MATSEQAIJ class and retains the
+  compressed row storage, but performs the sparse matrix-vector products
+  with OpenMP threads. The rows are divided among the threads into contiguous
+  chunks that contain (nearly) the same number of nonzeros; the partition is
+  computed once per nonzero structure, in MatAssemblyEnd().
+*/
+
+#include <../src/mat/impls/aij/seq/aij.h>
+
+typedef struct {
+  PetscObjectState nonzerostate; /* nonzero structure for which the row partition was computed */
+  PetscInt         nthreads;     /* number of threads used in the products */
+  PetscInt        *rstart;       /* thread t owns rows rstart[t] to rstart[t+1]-1 */
+  PetscBool        firsttouch;   /* place a->i, a->j and a->a in memory with the threads that use them */
+  PetscScalar     *work;         /* per-thread column accumulators used by MatMultTranspose() */
+  PetscInt         nwork;        /* length of work */
+} Mat_SeqAIJOMP;
+
+static PetscErrorCode MatSeqAIJOMPGetNumThreads_Private(PetscInt *nthreads)
+{
+  PetscFunctionBegin;
+#if defined(PETSC_HAVE_OPENMP)
+  *nthreads = PetscMax(PetscNumOMPThreads, 1);
+#else
+  *nthreads = 1;
+#endif
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
+
+/*
+   Copies the CSR arrays into freshly allocated memory, with each thread writing the part of the arrays it later
+   multiplies with, so that on NUMA systems the pages end up on the memory node closest to the thread using them.
+   Only done if the matrix owns its arrays.
+*/
+static PetscErrorCode MatSeqAIJOMP_FirstTouch(Mat A)
+{
+  Mat_SeqAIJ     *a       = (Mat_SeqAIJ *)A->data;
+  Mat_SeqAIJOMP  *aijomp  = (Mat_SeqAIJOMP *)A->spptr;
+  PetscInt        m       = A->rmap->n, nt = aijomp->nthreads;
+  const PetscInt *rstart  = aijomp->rstart;
+  PetscInt       *ai, *aj;
+  MatScalar      *aa;
+
+  PetscFunctionBegin;
+  if (A->structure_only || !a->free_a || !a->free_ij || !a->maxnz) PetscFunctionReturn(PETSC_SUCCESS);
+  PetscCall(PetscMalloc1(m + 1, &ai));
+  PetscCall(PetscMalloc1(a->maxnz, &aj));
+  PetscCall(PetscMalloc1(a->maxnz, &aa));
+  PetscPragmaOMP(parallel for schedule(static, 1) num_threads((int)nt))
+  for (PetscInt t = 0; t < nt; t++) {
+    const PetscInt rs = rstart[t], re = rstart[t + 1], js = a->i[rs], je = (t == nt - 1) ? a->maxnz : a->i[re];
+
+    for (PetscInt i = rs; i < re; i++) ai[i] = a->i[i];
+    for (PetscInt j = js; j < je; j++) {
+      aj[j] = a->j[j];
+      aa[j] = a->a[j];
+    }
+  }
+  ai[m] = a->i[m];
+  PetscCall(MatSeqXAIJFreeAIJ(A, &a->a, &a->j, &a->i));
+  a->i            = ai;
+  a->j            = aj;
+  a->a            = aa;
+  a->singlemalloc = PETSC_FALSE;
+  a->free_a       = PETSC_TRUE;
+  a->free_ij      = PETSC_TRUE;
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
+
+/* Divides the rows into contiguous chunks with (nearly) the same number of nonzeros */
+static PetscErrorCode MatSeqAIJOMP_CreatePartition(Mat A)
+{
+  Mat_SeqAIJ    *a      = (Mat_SeqAIJ *)A->data;
+  Mat_SeqAIJOMP *aijomp = (Mat_SeqAIJOMP *)A->spptr;
+  PetscInt       m      = A->rmap->n, nt, t, lo, hi, mid;
+  PetscInt64     nz, target;
+
+  PetscFunctionBegin;
+  if (aijomp->nonzerostate == A->nonzerostate && aijomp->rstart) PetscFunctionReturn(PETSC_SUCCESS); /* partition exists and matches current nonzero structure */
+  aijomp->nonzerostate = A->nonzerostate;
+  PetscCall(MatSeqAIJOMPGetNumThreads_Private(&aijomp->nthreads));
+  nt = aijomp->nthreads;
+  PetscCall(PetscFree(aijomp->rstart));
+  PetscCall(PetscMalloc1(nt + 1, &aijomp->rstart));
+
+  nz                 = m ? a->i[m] : 0;
+  aijomp->rstart[0]  = 0;
+  aijomp->rstart[nt] = m;
+  for (t = 1; t < nt; t++) {
+    /* find the first row that starts at or after the t-th nonzero split point */
+    target = (nz * t) / nt;
+    lo     = aijomp->rstart[t - 1];
+    hi     = m;
+    while (lo < hi) {
+      mid = lo + (hi - lo) / 2;
+      if (a->i[mid] < target) lo = mid + 1;
+      else hi = mid;
+    }
+    aijomp->rstart[t] = lo;
+  }
+  PetscCall(PetscInfo(A, "Partitioned %" PetscInt_FMT " rows with %" PetscInt64_FMT " nonzeros among %" PetscInt_FMT " threads\n", m, nz, nt));
+  if (aijomp->firsttouch && nt > 1) PetscCall(MatSeqAIJOMP_FirstTouch(A));
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
+
+static PetscErrorCode MatSeqAIJOMP_Destroy_Private(Mat_SeqAIJOMP *aijomp)
+{
+  PetscFunctionBegin;
+  PetscCall(PetscFree(aijomp->rstart));
+  PetscCall(PetscFree(aijomp->work));
+  aijomp->nwork        = 0;
+  aijomp->nonzerostate = -1;
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
+
+PETSC_INTERN PetscErrorCode MatConvert_SeqAIJOMP_SeqAIJ(Mat A, MatType type, MatReuse reuse, Mat *newmat)
+{
+  /* This routine is only called to convert a MATSEQAIJOMP to its base PETSc type, */
+  /* so we will ignore 'MatType type'. */
+  Mat            B = *newmat;
+  Mat_SeqAIJOMP *aijomp;
+
+  PetscFunctionBegin;
+  if (reuse == MAT_INITIAL_MATRIX) PetscCall(MatDuplicate(A, MAT_COPY_VALUES, &B));
+  aijomp = (Mat_SeqAIJOMP *)B->spptr;
+
+  /* Reset the original function pointers. */
+  B->ops->assemblyend      = MatAssemblyEnd_SeqAIJ;
+  B->ops->destroy          = MatDestroy_SeqAIJ;
+  B->ops->duplicate        = MatDuplicate_SeqAIJ;
+  B->ops->view             = MatView_SeqAIJ;
+  B->ops->mult             = MatMult_SeqAIJ;
+  B->ops->multadd          = MatMultAdd_SeqAIJ;
+  B->ops->multdot          = MatMultDot_SeqAIJ;
+  B->ops->multtranspose    = MatMultTranspose_SeqAIJ;
+  B->ops->multtransposeadd = MatMultTransposeAdd_SeqAIJ;
+
+  PetscCall(PetscObjectComposeFunction((PetscObject)B, "MatConvert_seqaijomp_seqaij_C", NULL));
+
+  PetscCall(MatSeqAIJOMP_Destroy_Private(aijomp));
+  PetscCall(PetscFree(B->spptr));
+
+  /* Change the type of B to MATSEQAIJ. */
+  PetscCall(PetscObjectChangeTypeName((PetscObject)B, MATSEQAIJ));
+
+  *newmat = B;
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
+
+static PetscErrorCode MatDestroy_SeqAIJOMP(Mat A)
+{
+  Mat_SeqAIJOMP *aijomp = (Mat_SeqAIJOMP *)A->spptr;
+
+  PetscFunctionBegin;
+  if (aijomp) {
+    /* If MatHeaderMerge() was used then this SeqAIJOMP matrix will not have a spptr. */
+    PetscCall(MatSeqAIJOMP_Destroy_Private(aijomp));
+    PetscCall(PetscFree(A->spptr));
+  }
+  PetscCall(PetscObjectChangeTypeName((PetscObject)A, MATSEQAIJ));
+  PetscCall(PetscObjectComposeFunction((PetscObject)A, "MatConvert_seqaijomp_seqaij_C", NULL));
+  PetscCall(MatDestroy_SeqAIJ(A));
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
+
+static PetscErrorCode MatDuplicate_SeqAIJOMP(Mat A, MatDuplicateOption op, Mat *M)
+{
+  Mat_SeqAIJOMP *aijomp = (Mat_SeqAIJOMP *)A->spptr;
+  Mat_SeqAIJOMP *aijomp_dest;
+
+  PetscFunctionBegin;
+  /* MatDuplicate_SeqAIJ() creates a matrix of the same type; its partition is computed when it is first needed */
+  PetscCall(MatDuplicate_SeqAIJ(A, op, M));
+  aijomp_dest             = (Mat_SeqAIJOMP *)(*M)->spptr;
+  aijomp_dest->firsttouch = aijomp->firsttouch;
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
+
+static PetscErrorCode MatAssemblyEnd_SeqAIJOMP(Mat A, MatAssemblyType mode)
+{
+  Mat_SeqAIJ *a = (Mat_SeqAIJ *)A->data;
+
+  PetscFunctionBegin;
+  if (mode == MAT_FLUSH_ASSEMBLY) PetscFunctionReturn(PETSC_SUCCESS);
+
+  /* the inode kernels are sequential, so they are not used for this class */
+  a->inode.use = PETSC_FALSE;
+  PetscCall(MatAssemblyEnd_SeqAIJ(A, mode));
+  PetscCall(MatSeqAIJOMP_CreatePartition(A));
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
+
+static PetscErrorCode MatView_SeqAIJOMP(Mat A, PetscViewer viewer)
+{
+  Mat_SeqAIJ       *a      = (Mat_SeqAIJ *)A->data;
+  Mat_SeqAIJOMP    *aijomp = (Mat_SeqAIJOMP *)A->spptr;
+  PetscBool         iascii;
+  PetscViewerFormat format;
+
+  PetscFunctionBegin;
+  PetscCall(MatView_SeqAIJ(A, viewer));
+  PetscCall(PetscObjectTypeCompare((PetscObject)viewer, PETSCVIEWERASCII, &iascii));
+  if (!iascii || !aijomp->rstart) PetscFunctionReturn(PETSC_SUCCESS);
+  PetscCall(PetscViewerGetFormat(viewer, &format));
+  if (format == PETSC_VIEWER_ASCII_INFO || format == PETSC_VIEWER_ASCII_INFO_DETAIL) {
+    PetscInt nzmin = PETSC_MAX_INT, nzmax = 0;
+
+    for (PetscInt t = 0; t < aijomp->nthreads; t++) {
+      PetscInt nz = a->i[aijomp->rstart[t + 1]] - a->i[aijomp->rstart[t]];
+
+      nzmin = PetscMin(nzmin, nz);
+      nzmax = PetscMax(nzmax, nz);
+    }
+    PetscCall(PetscViewerASCIIPrintf(viewer, "using %" PetscInt_FMT " threads, nonzeros per thread: min %" PetscInt_FMT " max %" PetscInt_FMT "%s\n", aijomp->nthreads, nzmin, nzmax, aijomp->firsttouch ? ", first-touch placement" : ""));
+  }
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
+
+/* computes z = y + A*x, or z = A*x if y is NULL, on the rows of each thread */
+static PetscErrorCode MatMultAdd_SeqAIJOMP_Private(Mat A, Vec xx, Vec yy, Vec zz)
+{
+  Mat_SeqAIJ        *a      = (Mat_SeqAIJ *)A->data;
+  Mat_SeqAIJOMP     *aijomp = (Mat_SeqAIJOMP *)A->spptr;
+  const PetscScalar *x;
+  PetscScalar       *y = NULL, *z;
+  const MatScalar   *aa;
+  const PetscInt    *ai, *aj, *rstart;
+  PetscInt           nt;
+
+  PetscFunctionBegin;
+  PetscCall(MatSeqAIJOMP_CreatePartition(A));
+  nt     = aijomp->nthreads;
+  rstart = aijomp->rstart;
+  ai     = a->i;
+  aj     = a->j;
+  PetscCall(MatSeqAIJGetArrayRead(A, &aa));
+  PetscCall(VecGetArrayRead(xx, &x));
+  if (yy) {
+    PetscCall(VecGetArrayPair(yy, zz, &y, &z));
+  } else {
+    PetscCall(VecGetArrayWrite(zz, &z));
+  }
+  PetscPragmaOMP(parallel for schedule(static, 1) num_threads((int)nt))
+  for (PetscInt t = 0; t < nt; t++) {
+    for (PetscInt i = rstart[t]; i < rstart[t + 1]; i++) {
+      const PetscInt   n   = ai[i + 1] - ai[i];
+      const PetscInt  *idx = aj + ai[i];
+      const MatScalar *v   = aa + ai[i];
+      PetscScalar      sum = y ? y[i] : 0.0;
+
+      PetscSparseDensePlusDot(sum, x, v, idx, n);
+      z[i] = sum;
+    }
+  }
+  PetscCall(MatSeqAIJRestoreArrayRead(A, &aa));
+  PetscCall(VecRestoreArrayRead(xx, &x));
+  if (yy) {
+    PetscCall(VecRestoreArrayPair(yy, zz, &y, &z));
+    PetscCall(PetscLogFlops(2.0 * a->nz));
+  } else {
+    PetscCall(VecRestoreArrayWrite(zz, &z));
+    PetscCall(PetscLogFlops(2.0 * a->nz - a->nonzerorowcnt));
+  }
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
+
+static PetscErrorCode MatMult_SeqAIJOMP(Mat A, Vec xx, Vec yy)
+{
+  PetscFunctionBegin;
+  PetscCall(MatMultAdd_SeqAIJOMP_Private(A, xx, NULL, yy));
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
+
+static PetscErrorCode MatMultAdd_SeqAIJOMP(Mat A, Vec xx, Vec yy, Vec zz)
+{
+  PetscFunctionBegin;
+  PetscCall(MatMultAdd_SeqAIJOMP_Private(A, xx, yy, zz));
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
+
+/*
+   Each thread accumulates the transpose product of its rows into a private copy of the result, the copies
+   are then summed with the columns divided among the threads.
+*/
+static PetscErrorCode MatMultTransposeAdd_SeqAIJOMP(Mat A, Vec xx, Vec yy, Vec zz)
+{
+  Mat_SeqAIJ        *a      = (Mat_SeqAIJ *)A->data;
+  Mat_SeqAIJOMP     *aijomp = (Mat_SeqAIJOMP *)A->spptr;
+  const PetscScalar *x;
+  PetscScalar       *z, *work;
+  const MatScalar   *aa;
+  const PetscInt    *ai, *aj, *rstart;
+  PetscInt           nt, n = A->cmap->n;
+
+  PetscFunctionBegin;
+  PetscCall(MatSeqAIJOMP_CreatePartition(A));
+  nt = aijomp->nthreads;
+  if (nt == 1) {
+    PetscCall(MatMultTransposeAdd_SeqAIJ(A, xx, yy, zz));
+    PetscFunctionReturn(PETSC_SUCCESS);
+  }
+  if (aijomp->nwork < nt * n) {
+    PetscCall(PetscFree(aijomp->work));
+    PetscCall(PetscMalloc1(nt * n, &aijomp->work));
+    aijomp->nwork = nt * n;
+  }
+  rstart = aijomp->rstart;
+  work   = aijomp->work;
+  ai     = a->i;
+  aj     = a->j;
+  if (yy != zz) PetscCall(VecCopy(yy, zz));
+  PetscCall(MatSeqAIJGetArrayRead(A, &aa));
+  PetscCall(VecGetArrayRead(xx, &x));
+  PetscCall(VecGetArray(zz, &z));
+  PetscPragmaOMP(parallel num_threads((int)nt))
+  {
+    PetscPragmaOMP(for schedule(static, 1))
+    for (PetscInt t = 0; t < nt; t++) {
+      PetscScalar *w = work + t * n;
+
+      for (PetscInt j = 0; j < n; j++) w[j] = 0.0;
+      for (PetscInt i = rstart[t]; i < rstart[t + 1]; i++) {
+        const PetscInt    nz    = ai[i + 1] - ai[i];
+        const PetscInt   *idx   = aj + ai[i];
+        const MatScalar  *v     = aa + ai[i];
+        const PetscScalar alpha = x[i];
+
+        for (PetscInt j = 0; j < nz; j++) w[idx[j]] += alpha * v[j];
+      }
+    }
+    PetscPragmaOMP(for schedule(static))
+    for (PetscInt j = 0; j < n; j++) {
+      PetscScalar sum = z[j];
+
+      for (PetscInt t = 0; t < nt; t++) sum += work[t * n + j];
+      z[j] = sum;
+    }
+  }
+  PetscCall(PetscLogFlops(2.0 * a->nz + (PetscLogDouble)nt * n));
+  PetscCall(MatSeqAIJRestoreArrayRead(A, &aa));
+  PetscCall(VecRestoreArrayRead(xx, &x));
+  PetscCall(VecRestoreArray(zz, &z));
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
+
+static PetscErrorCode MatMultTranspose_SeqAIJOMP(Mat A, Vec xx, Vec yy)
+{
+  PetscFunctionBegin;
+  PetscCall(VecSet(yy, 0.0));
+  PetscCall(MatMultTransposeAdd_SeqAIJOMP(A, xx, yy, yy));
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
+
+/* MatConvert_SeqAIJ_SeqAIJOMP converts a SeqAIJ matrix into a
+ * SeqAIJOMP matrix.  This routine is called by the MatCreate_SeqAIJOMP()
+ * routine, but can also be used to convert an assembled SeqAIJ matrix
+ * into a SeqAIJOMP one. */
+PETSC_INTERN PetscErrorCode MatConvert_SeqAIJ_SeqAIJOMP(Mat A, MatType type, MatReuse reuse, Mat *newmat)
+{
+  Mat            B = *newmat;
+  Mat_SeqAIJ    *b;
+  Mat_SeqAIJOMP *aijomp;
+  PetscBool      sametype;
+
+  PetscFunctionBegin;
+  if (reuse == MAT_INITIAL_MATRIX) PetscCall(MatDuplicate(A, MAT_COPY_VALUES, &B));
+  PetscCall(PetscObjectTypeCompare((PetscObject)A, type, &sametype));
+  if (sametype) PetscFunctionReturn(PETSC_SUCCESS);
+
+  PetscCall(PetscNew(&aijomp));
+  b        = (Mat_SeqAIJ *)B->data;
+  B->spptr = (void *)aijomp;
+
+  /* The inode routines are sequential; this is also done in MatAssemblyEnd_SeqAIJOMP() */
+  b->inode.use = PETSC_FALSE;
+
+  /* Set function pointers for methods that we inherit from AIJ but override. */
+  B->ops->duplicate        = MatDuplicate_SeqAIJOMP;
+  B->ops->assemblyend      = MatAssemblyEnd_SeqAIJOMP;
+  B->ops->destroy          = MatDestroy_SeqAIJOMP;
+  B->ops->view             = MatView_SeqAIJOMP;
+  B->ops->mult             = MatMult_SeqAIJOMP;
+  B->ops->multadd          = MatMultAdd_SeqAIJOMP;
+  B->ops->multdot          = NULL;
+  B->ops->multtranspose    = MatMultTranspose_SeqAIJOMP;
+  B->ops->multtransposeadd = MatMultTransposeAdd_SeqAIJOMP;
+
+  aijomp->nonzerostate = -1; /* this will trigger the computation of the partition the first time through MatAssembly() */
+  PetscOptionsBegin(PetscObjectComm((PetscObject)B), ((PetscObject)B)->prefix, "AIJOMP Options", "Mat");
+  PetscCall(PetscOptionsBool("-mat_aijomp_first_touch", "Place the matrix arrays in memory with the threads that use them", "None", aijomp->firsttouch, &aijomp->firsttouch, NULL));
+  PetscOptionsEnd();
+
+  /* If A has already been assembled, compute the partition. */
+  if (A->assembled) PetscCall(MatSeqAIJOMP_CreatePartition(B));
+
+  PetscCall(PetscObjectComposeFunction((PetscObject)B, "MatConvert_seqaijomp_seqaij_C", MatConvert_SeqAIJOMP_SeqAIJ));
+
+  PetscCall(PetscObjectChangeTypeName((PetscObject)B, MATSEQAIJOMP));
+  *newmat = B;
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
+
+/*MC
+   MATSEQAIJOMP - MATSEQAIJOMP = "seqaijomp" - A matrix type to be used for sequential sparse matrices whose
+   products with vectors are computed with OpenMP threads.
+
+   Options Database Keys:
++  -mat_type seqaijomp         - sets the matrix type to `MATSEQAIJOMP` during a call to `MatSetFromOptions()`
+.  -mat_seqaij_type seqaijomp  - makes all `MATSEQAIJ` matrices, including the diagonal and off-diagonal blocks of `MATMPIAIJ`, of this type
+-  -mat_aijomp_first_touch     - copy the matrix arrays at assembly so that each page is first touched by the thread that multiplies with it
+
+   Level: intermediate
+
+   Notes:
+   This type inherits from `MATSEQAIJ` and shares its storage. `MatMult()`, `MatMultAdd()`, `MatMultTranspose()` and
+   `MatMultTransposeAdd()` divide the rows among the threads into contiguous chunks with (nearly) the same number of
+   nonzeros. The partition is computed once per nonzero structure in `MatAssemblyEnd()`.
+
+   The number of threads is set with `-omp_num_threads` or the environmental variable `OMP_NUM_THREADS`. If PETSc was
+   not configured with `--with-openmp` the products are computed sequentially.
+
+   `MatMultTranspose()` uses a private copy of the result per thread, so it requires the number of threads times the
+   number of columns of additional memory.
+
+.seealso: [](ch_matrices), `Mat`, `MATSEQAIJ`, `MATSEQAIJPERM`, `MATSEQAIJSELL`, `MatSeqAIJSetType()`
+M*/
+PETSC_EXTERN PetscErrorCode MatCreate_SeqAIJOMP(Mat A)
+{
+  PetscFunctionBegin;
+  PetscCall(MatSetType(A, MATSEQAIJ));
+  PetscCall(MatConvert_SeqAIJ_SeqAIJOMP(A, MATSEQAIJOMP, MAT_INPLACE_MATRIX, &A));
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
@@ -75,6 +75,7 @@ PETSC_INTERN PetscErrorCode MatConvert_SeqAIJPERM_SeqAIJ(Mat A, MatType type, Ma
   B->ops->duplicate   = MatDuplicate_SeqAIJ;
   B->ops->mult        = MatMult_SeqAIJ;
   B->ops->multadd     = MatMultAdd_SeqAIJ;
+  B->ops->multdot     = MatMultDot_SeqAIJ;
 
   PetscCall(PetscObjectComposeFunction((PetscObject)B, "MatConvert_seqaijperm_seqaij_C", NULL));
 
@@ -616,6 +617,7 @@ PETSC_INTERN PetscErrorCode MatConvert_SeqAIJ_SeqAIJPERM(Mat A, MatType type, Ma
   B->ops->destroy     = MatDestroy_SeqAIJPERM;
   B->ops->mult        = MatMult_SeqAIJPERM;
   B->ops->multadd     = MatMultAdd_SeqAIJPERM;
+  B->ops->multdot     = NULL;
 
   aijperm->nonzerostate = -1; /* this will trigger the generation of the permutation information the first time through MatAssembly()*/
   /* If A has already been assembled, compute the permutation. */
@@ -31,6 +31,7 @@ PETSC_INTERN PetscErrorCode MatConvert_SeqAIJSELL_SeqAIJ(Mat A, MatType type, Ma
   B->ops->mult             = MatMult_SeqAIJ;
   B->ops->multtranspose    = MatMultTranspose_SeqAIJ;
   B->ops->multadd          = MatMultAdd_SeqAIJ;
+  B->ops->multdot          = MatMultDot_SeqAIJ;
   B->ops->multtransposeadd = MatMultTransposeAdd_SeqAIJ;
   B->ops->sor              = MatSOR_SeqAIJ;
 
@@ -157,6 +158,16 @@ static PetscErrorCode MatMult_SeqAIJSELL(Mat A, Vec xx, Vec yy)
   PetscFunctionReturn(PETSC_SUCCESS);
 }
 
+static PetscErrorCode MatMultDot_SeqAIJSELL(Mat A, Vec xx, Vec yy, PetscScalar *xdoty, PetscReal *xnorm, PetscReal *ynorm)
+{
+  Mat_SeqAIJSELL *aijsell = (Mat_SeqAIJSELL *)A->spptr;
+
+  PetscFunctionBegin;
+  PetscCall(MatSeqAIJSELL_build_shadow(A));
+  PetscCall(MatMultDot_SeqSELL(aijsell->S, xx, yy, xdoty, xnorm, ynorm));
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
+
 static PetscErrorCode MatMultTranspose_SeqAIJSELL(Mat A, Vec xx, Vec yy)
 {
   Mat_SeqAIJSELL *aijsell = (Mat_SeqAIJSELL *)A->spptr;
@@ -244,6 +255,7 @@ PETSC_INTERN PetscErrorCode MatConvert_SeqAIJ_SeqAIJSELL(Mat A, MatType type, Ma
   B->ops->mult             = MatMult_SeqAIJSELL;
   B->ops->multtranspose    = MatMultTranspose_SeqAIJSELL;
   B->ops->multadd          = MatMultAdd_SeqAIJSELL;
+  B->ops->multdot          = MatMultDot_SeqAIJSELL;
   B->ops->multtransposeadd = MatMultTransposeAdd_SeqAIJSELL;
   B->ops->sor              = MatSOR_SeqAIJSELL;
 
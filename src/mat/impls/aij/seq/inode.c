@@ -1949,6 +1949,7 @@ PetscErrorCode MatLUFactorNumeric_SeqAIJ_Inode(Mat B, Mat A, const MatFactorInfo
   C->ops->matsolve          = MatMatSolve_SeqAIJ;
   C->assembled              = PETSC_TRUE;
   C->preallocated           = PETSC_TRUE;
+  PetscCall(MatSeqAIJSolveLevelsSetUp_Private(C));
 
   PetscCall(PetscLogFlops(C->cmap->n));
 
@@ -2841,13 +2842,12 @@ PetscErrorCode MatSOR_SeqAIJ_Inode(Mat A, Vec bb, PetscReal omega, MatSORType fl
   PetscCheck(fshift == 0.0, PETSC_COMM_SELF, PETSC_ERR_SUP, "No support for fshift != 0.0; use -mat_no_inode");
 
   if (!a->inode.ibdiagvalid) {
-    if (!a->inode.ibdiag) {
-      /* calculate space needed for diagonal blocks */
-      for (i = 0; i < m; i++) cnt += sizes[i] * sizes[i];
-      a->inode.bdiagsize = cnt;
-
-      PetscCall(PetscMalloc3(cnt, &a->inode.ibdiag, cnt, &a->inode.bdiag, A->rmap->n, &a->inode.ssor_work));
-    }
+    /* calculate space needed for diagonal blocks, the inodes may have changed since they were last inverted */
+    for (i = 0; i < m; i++) cnt += sizes[i] * sizes[i];
+    if (a->inode.ibdiag && cnt > a->inode.bdiagsize) PetscCall(PetscFree3(a->inode.ibdiag, a->inode.bdiag, a->inode.ssor_work));
+    if (!a->inode.ibdiag) PetscCall(PetscMalloc3(cnt, &a->inode.ibdiag, cnt, &a->inode.bdiag, A->rmap->n, &a->inode.ssor_work));
+    /* the backward sweeps start from the end of the used part */
+    a->inode.bdiagsize = cnt;
 
     /* copy over the diagonal blocks and invert them */
     ibdiag = a->inode.ibdiag;
@@ -4196,6 +4196,17 @@ static PetscErrorCode MatMultDiagonalBlock_SeqAIJ_Inode(Mat A, Vec bb, Vec xx)
 
   PetscFunctionBegin;
   PetscCheck(a->inode.size, PETSC_COMM_SELF, PETSC_ERR_COR, "Missing Inode Structure");
+  if (a->sorcolors.ncolors) { /* multicolor MatSOR() relaxes single rows, so its diagonal blocks are the diagonal entries */
+    const PetscInt n = A->rmap->n;
+
+    PetscCall(VecGetArray(xx, &x));
+    PetscCall(VecGetArrayRead(bb, &b));
+    for (i = 0; i < n; i++) x[i] = b[i] * a->mdiag[i];
+    PetscCall(VecRestoreArray(xx, &x));
+    PetscCall(VecRestoreArrayRead(bb, &b));
+    PetscCall(PetscLogFlops(n));
+    PetscFunctionReturn(PETSC_SUCCESS);
+  }
   PetscCall(VecGetArray(xx, &x));
   PetscCall(VecGetArrayRead(bb, &b));
   cnt = 0;
@@ -4357,6 +4368,52 @@ PetscErrorCode MatSeqAIJCheckInode(Mat A)
   PetscFunctionReturn(PETSC_SUCCESS);
 }
 
+/*
+   Updates the inodes after only the sorted rows[] got new nonzeros, so that MatSeqAIJCheckInode() does not compare all the rows again.
+   An inode starting at row i of size sz is kept if none of the rows i to i + sz is dirty, the inodes around dirty rows are found again.
+*/
+PetscErrorCode MatSeqAIJUpdateInodes_Private(Mat A, PetscInt nrows, const PetscInt rows[])
+{
+  Mat_SeqAIJ     *a = (Mat_SeqAIJ *)A->data;
+  PetscInt        i = 0, j, k = 0, d = 0, start = 0, m = A->rmap->n, nzx, nzy, node_count = 0, blk_size, *ns;
+  PetscBool       flag;
+  const PetscInt *idx, *idy, *ii = a->i, *old = a->inode.size;
+
+  PetscFunctionBegin;
+  if (!a->inode.use || !a->inode.checked || !old || A->nonzerostate == a->inode.mat_nonzerostate) PetscFunctionReturn(PETSC_SUCCESS);
+  PetscCall(PetscMalloc1(m + 1, &ns));
+  while (i < m) {
+    while (k < a->inode.node_count && start < i) start += old[k++];
+    if (k < a->inode.node_count && start == i) {
+      while (d < nrows && rows[d] < i) d++;
+      if (d == nrows || rows[d] > i + old[k]) {
+        ns[node_count++] = old[k];
+        i += old[k];
+        continue;
+      }
+    }
+    nzx = ii[i + 1] - ii[i];
+    idx = a->j + ii[i];
+    for (j = i + 1, idy = idx, blk_size = 1; j < m && blk_size < a->inode.limit; ++j, ++blk_size) {
+      nzy = ii[j + 1] - ii[j];
+      if (nzy != nzx) break;
+      idy += nzx;
+      PetscCall(PetscArraycmp(idx, idy, nzx, &flag));
+      if (!flag) break;
+    }
+    ns[node_count++] = blk_size;
+    i                = j;
+  }
+  if (node_count > .8 * m) a->inode.checked = PETSC_FALSE; /* let MatSeqAIJCheckInode() stop using inodes */
+  else {
+    PetscCall(PetscArraycpy(a->inode.size, ns, node_count));
+    a->inode.node_count       = node_count;
+    a->inode.mat_nonzerostate = A->nonzerostate;
+  }
+  PetscCall(PetscFree(ns));
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
+
 PetscErrorCode MatDuplicate_SeqAIJ_Inode(Mat A, MatDuplicateOption cpvalues, Mat *C)
 {
   Mat         B = *C;
@@ -1411,6 +1411,7 @@ static PetscErrorCode MatSetOps_SeqAIJKokkos(Mat A)
   A->ops->productsetfromoptions     = MatProductSetFromOptions_SeqAIJKokkos;
   A->ops->mult                      = MatMult_SeqAIJKokkos;
   A->ops->multadd                   = MatMultAdd_SeqAIJKokkos;
+  A->ops->multdot                   = NULL;
   A->ops->multtranspose             = MatMultTranspose_SeqAIJKokkos;
   A->ops->multtransposeadd          = MatMultTransposeAdd_SeqAIJKokkos;
   A->ops->multhermitiantranspose    = MatMultHermitianTranspose_SeqAIJKokkos;
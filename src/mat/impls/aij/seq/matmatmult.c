@@ -137,6 +137,13 @@ PetscErrorCode MatMatMultSymbolic_SeqAIJ_SeqAIJ(Mat A, Mat B, PetscReal fill, Ma
     PetscFunctionReturn(PETSC_SUCCESS);
   }
 
+  /* threaded */
+  PetscCall(PetscStrcmp(alg, "threaded", &flg));
+  if (flg) {
+    PetscCall(MatMatMultSymbolic_SeqAIJ_SeqAIJ_Threaded(A, B, fill, C));
+    PetscFunctionReturn(PETSC_SUCCESS);
+  }
+
 #if defined(PETSC_HAVE_HYPRE)
   PetscCall(PetscStrcmp(alg, "hypre", &flg));
   if (flg) {
@@ -1210,6 +1217,283 @@ PetscErrorCode MatMatMultSymbolic_SeqAIJ_SeqAIJ_Sorted(Mat A, Mat B, PetscReal f
   PetscFunctionReturn(PETSC_SUCCESS);
 }
 
+/*
+   The "threaded" algorithm: rows of C = A*B are divided among the OpenMP threads into contiguous chunks with
+   (nearly) the same number of multiply-adds. The symbolic phase gathers the column indices of the rows of B
+   contributing to each row of C in a buffer per thread, as long as the largest number of multiply-adds of a row,
+   sorts them and drops the duplicates, first to count the nonzeros of each row, then, after a prefix sum forming the
+   row offsets of C, to fill in its column indices. As in the scalable algorithm, the numeric phase merges the sorted
+   rows of B into the sorted row of C, so no work array depends on the number of columns of B.
+*/
+typedef struct {
+  PetscInt         nthreads;
+  PetscInt        *rstart; /* thread t computes rows rstart[t] to rstart[t+1]-1 of C */
+  PetscObjectState astate, bstate;
+} MatMatMultThreaded;
+
+static PetscErrorCode MatMatMultThreadedDestroy_Private(void *ctx)
+{
+  MatMatMultThreaded *mmt = (MatMatMultThreaded *)ctx;
+
+  PetscFunctionBegin;
+  PetscCall(PetscFree(mmt->rstart));
+  PetscCall(PetscFree(mmt));
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
+
+/* Divides the rows of A*B among nt threads so that each gets (nearly) the same number of multiply-adds, and optionally gives
+   the largest number of multiply-adds of a row plus one */
+static PetscErrorCode MatMatMultThreadedPartition_Private(Mat A, Mat B, PetscInt nt, PetscInt rstart[], PetscInt *maxrow)
+{
+  Mat_SeqAIJ     *a = (Mat_SeqAIJ *)A->data, *b = (Mat_SeqAIJ *)B->data;
+  const PetscInt *ai = a->i, *aj = a->j, *bi = b->i;
+  PetscInt        am = A->rmap->N, t, lo, hi, mid;
+  PetscInt64     *work, target;
+
+  PetscFunctionBegin;
+  if (maxrow) *maxrow = 1;
+  PetscCall(PetscMalloc1(am + 1, &work));
+  work[0] = 0;
+  for (PetscInt i = 0; i < am; i++) {
+    PetscInt64 w = 1;
+
+    for (PetscInt j = ai[i]; j < ai[i + 1]; j++) w += bi[aj[j] + 1] - bi[aj[j]];
+    work[i + 1] = work[i] + w;
+    if (maxrow) *maxrow = PetscMax(*maxrow, (PetscInt)w);
+  }
+  rstart[0]  = 0;
+  rstart[nt] = am;
+  for (t = 1; t < nt; t++) {
+    target = (work[am] * t) / nt;
+    lo     = rstart[t - 1];
+    hi     = am;
+    while (lo < hi) {
+      mid = lo + (hi - lo) / 2;
+      if (work[mid] < target) lo = mid + 1;
+      else hi = mid;
+    }
+    rstart[t] = lo;
+  }
+  PetscCall(PetscFree(work));
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
+
+static PetscErrorCode MatMatMultThreadedGetNumThreads_Private(PetscInt *nt)
+{
+  PetscFunctionBegin;
+#if defined(PETSC_HAVE_OPENMP)
+  *nt = PetscMax(PetscNumOMPThreads, 1);
+#else
+  *nt = 1;
+#endif
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
+
+static inline void MatMatMultThreadedSiftDown_Private(PetscInt x[], PetscInt j, PetscInt end)
+{
+  PetscInt k, v = x[j];
+
+  for (; (k = 2 * j + 1) < end; j = k) {
+    if (k + 1 < end && x[k + 1] > x[k]) k++;
+    if (x[k] <= v) break;
+    x[j] = x[k];
+  }
+  x[j] = v;
+}
+
+/* sorts the column indices of one row of C; it does not call PETSc functions, so it can be used inside OpenMP regions */
+static inline void MatMatMultThreadedSortRow_Private(PetscInt n, PetscInt x[])
+{
+  PetscInt i, j, v;
+
+  if (n < 32) {
+    for (i = 1; i < n; i++) {
+      v = x[i];
+      for (j = i; j > 0 && x[j - 1] > v; j--) x[j] = x[j - 1];
+      x[j] = v;
+    }
+    return;
+  }
+  /* heap sort */
+  for (i = n / 2 - 1; i >= 0; i--) MatMatMultThreadedSiftDown_Private(x, i, n);
+  for (i = n - 1; i > 0; i--) {
+    v    = x[0];
+    x[0] = x[i];
+    x[i] = v;
+    MatMatMultThreadedSiftDown_Private(x, 0, i);
+  }
+}
+
+/* The sorted column indices of row i of A*B, plus the diagonal if diag, into crow. buf has room for all the multiply-adds of the row
+   plus one; it does not call PETSc functions, so it can be used inside OpenMP regions */
+static inline PetscInt MatMatMultThreadedRow_Private(PetscInt i, const PetscInt ai[], const PetscInt aj[], const PetscInt bi[], const PetscInt bj[], PetscBool diag, PetscInt bn, PetscInt buf[], PetscInt crow[])
+{
+  PetscInt n = 0, cnzi = 0;
+
+  for (PetscInt j = ai[i]; j < ai[i + 1]; j++)
+    for (PetscInt k = bi[aj[j]]; k < bi[aj[j] + 1]; k++) buf[n++] = bj[k];
+  if (diag && i < bn) buf[n++] = i;
+  MatMatMultThreadedSortRow_Private(n, buf);
+  for (PetscInt k = 0; k < n; k++) {
+    if (cnzi && buf[k] == buf[k - 1]) continue;
+    if (crow) crow[cnzi] = buf[k];
+    cnzi++;
+  }
+  return cnzi;
+}
+
+PetscErrorCode MatMatMultSymbolic_SeqAIJ_SeqAIJ_Threaded(Mat A, Mat B, PetscReal fill, Mat C)
+{
+  Mat_SeqAIJ     *a = (Mat_SeqAIJ *)A->data, *b = (Mat_SeqAIJ *)B->data, *c;
+  const PetscInt *ai = a->i, *bi = b->i, *aj = a->j, *bj = b->j;
+  PetscInt       *ci, *cj, *buf, *rstart, nt, maxrow;
+  PetscInt        am = A->rmap->N, bn = B->cmap->N, bm = B->rmap->N;
+  MatScalar      *ca;
+  PetscReal       afill;
+  PetscBool       diag = C->force_diagonals;
+
+  PetscFunctionBegin;
+  PetscCall(MatMatMultThreadedGetNumThreads_Private(&nt));
+  PetscCall(PetscMalloc1(nt + 1, &rstart));
+  PetscCall(MatMatMultThreadedPartition_Private(A, B, nt, rstart, &maxrow));
+  PetscCall(PetscMalloc1(am + 1, &ci));
+  PetscCall(PetscMalloc1(nt * maxrow, &buf));
+
+  /* count the nonzeros of each row of C */
+  PetscPragmaOMP(parallel for schedule(static, 1) num_threads((int)nt))
+  for (PetscInt t = 0; t < nt; t++) {
+    for (PetscInt i = rstart[t]; i < rstart[t + 1]; i++) ci[i + 1] = MatMatMultThreadedRow_Private(i, ai, aj, bi, bj, diag, bn, buf + t * maxrow, NULL);
+  }
+
+  /* row offsets of C */
+  ci[0] = 0;
+  for (PetscInt i = 0; i < am; i++) ci[i + 1] += ci[i];
+  PetscCall(PetscMalloc1(ci[am] + 1, &cj));
+
+  /* fill in the column indices of each row of C */
+  PetscPragmaOMP(parallel for schedule(static, 1) num_threads((int)nt))
+  for (PetscInt t = 0; t < nt; t++) {
+    for (PetscInt i = rstart[t]; i < rstart[t + 1]; i++) (void)MatMatMultThreadedRow_Private(i, ai, aj, bi, bj, diag, bn, buf + t * maxrow, cj + ci[i]);
+  }
+  PetscCall(PetscFree(buf));
+  PetscCall(PetscFree(rstart));
+
+  /* Allocate space for ca */
+  PetscCall(PetscCalloc1(ci[am] + 1, &ca));
+
+  /* put together the new symbolic matrix */
+  PetscCall(MatSetSeqAIJWithArrays_private(PetscObjectComm((PetscObject)A), am, bn, ci, cj, ca, ((PetscObject)A)->type_name, C));
+  PetscCall(MatSetBlockSizesFromMats(C, A, B));
+
+  /* MatCreateSeqAIJWithArrays flags matrix so PETSc doesn't free the user's arrays. */
+  /* These are PETSc arrays, so change flags so arrays can be deleted by PETSc */
+  c          = (Mat_SeqAIJ *)(C->data);
+  c->free_a  = PETSC_TRUE;
+  c->free_ij = PETSC_TRUE;
+  c->nonew   = 0;
+
+  C->ops->matmultnumeric = MatMatMultNumeric_SeqAIJ_SeqAIJ_Threaded;
+
+  /* set MatInfo */
+  afill = (PetscReal)ci[am] / PetscMax(ai[am] + bi[bm], 1) + 1.e-5;
+  if (afill < 1.0) afill = 1.0;
+  C->info.mallocs           = 0;
+  C->info.fill_ratio_given  = fill;
+  C->info.fill_ratio_needed = afill;
+
+#if defined(PETSC_USE_INFO)
+  if (ci[am]) {
+    PetscCall(PetscInfo(C, "Threaded symbolic product with %" PetscInt_FMT " threads; Fill ratio: given %g needed %g.\n", nt, (double)fill, (double)afill));
+    PetscCall(PetscInfo(C, "Use MatMatMult(A,B,MatReuse,%g,&C) for best performance.;\n", (double)afill));
+  } else {
+    PetscCall(PetscInfo(C, "Empty matrix product\n"));
+  }
+#endif
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
+
+/*
+   Works with the nonzero structure of C from any of the symbolic algorithms, as long as the column indices of each
+   row are sorted and contain the nonzeros of A*B. Nonzeros of A*B outside of the structure of C are counted and
+   reported as an error.
+*/
+PetscErrorCode MatMatMultNumeric_SeqAIJ_SeqAIJ_Threaded(Mat A, Mat B, Mat C)
+{
+  Mat_SeqAIJ         *a = (Mat_SeqAIJ *)A->data, *b = (Mat_SeqAIJ *)B->data, *c = (Mat_SeqAIJ *)C->data;
+  const PetscInt     *ai = a->i, *aj = a->j, *bi = b->i, *bj = b->j, *ci = c->i, *cj = c->j, *rstart;
+  PetscInt            cm = C->rmap->N, nt, nmissed = 0;
+  PetscScalar        *ca;
+  const PetscScalar  *aa, *ba;
+  PetscLogDouble      flops = 0.0;
+  PetscContainer      cmmt;
+  MatMatMultThreaded *mmt;
+
+  PetscFunctionBegin;
+  PetscCall(MatSeqAIJGetArrayRead(A, &aa));
+  PetscCall(MatSeqAIJGetArrayRead(B, &ba));
+  if (!c->a) { /* the symbolic phase did not allocate ca */
+    PetscCall(PetscMalloc1(ci[cm] + 1, &ca));
+    c->a      = ca;
+    c->free_a = PETSC_TRUE;
+  } else ca = c->a;
+
+  /* the partition is kept with C, it is recomputed if A or B changed */
+  PetscCall(PetscObjectQuery((PetscObject)C, "__PETSc__ab_threaded", (PetscObject *)&cmmt));
+  if (!cmmt) {
+    PetscCall(PetscNew(&mmt));
+    PetscCall(PetscContainerCreate(PETSC_COMM_SELF, &cmmt));
+    PetscCall(PetscContainerSetPointer(cmmt, mmt));
+    PetscCall(PetscContainerSetUserDestroy(cmmt, MatMatMultThreadedDestroy_Private));
+    PetscCall(PetscObjectCompose((PetscObject)C, "__PETSc__ab_threaded", (PetscObject)cmmt));
+    PetscCall(PetscObjectDereference((PetscObject)cmmt));
+  }
+  PetscCall(PetscContainerGetPointer(cmmt, (void **)&mmt));
+  PetscCall(MatMatMultThreadedGetNumThreads_Private(&nt));
+  if (!mmt->rstart || mmt->nthreads != nt || mmt->astate != A->nonzerostate || mmt->bstate != B->nonzerostate) {
+    PetscCall(PetscFree(mmt->rstart));
+    PetscCall(PetscMalloc1(nt + 1, &mmt->rstart));
+    PetscCall(MatMatMultThreadedPartition_Private(A, B, nt, mmt->rstart, NULL));
+    mmt->nthreads = nt;
+    mmt->astate   = A->nonzerostate;
+    mmt->bstate   = B->nonzerostate;
+  }
+  rstart = mmt->rstart;
+
+  PetscPragmaOMP(parallel for schedule(static, 1) num_threads((int)nt) reduction(+:flops,nmissed))
+  for (PetscInt t = 0; t < nt; t++) {
+    for (PetscInt i = rstart[t]; i < rstart[t + 1]; i++) {
+      const PetscInt cnzi  = ci[i + 1] - ci[i], *crow = cj + ci[i];
+      PetscScalar   *carow = ca + ci[i];
+
+      for (PetscInt k = 0; k < cnzi; k++) carow[k] = 0.0;
+      /* Build the ith row in C by summing over nonzero columns in A, the rows of B corresponding to nonzeros of A,
+         with a sparse axpy merging the sorted row of B into the sorted row of C */
+      for (PetscInt j = ai[i]; j < ai[i + 1]; j++) {
+        const PetscInt     brow  = aj[j], bnzi = bi[brow + 1] - bi[brow];
+        const PetscInt    *bjj   = bj + bi[brow];
+        const PetscScalar *baj   = ba + bi[brow], valtmp = aa[j];
+        PetscInt           nextb = 0;
+
+        for (PetscInt k = 0; k < cnzi && nextb < bnzi; k++) {
+          if (crow[k] == bjj[nextb]) carow[k] += valtmp * baj[nextb++];
+        }
+        nmissed += bnzi - nextb;
+        flops += 2 * bnzi;
+      }
+    }
+  }
+  PetscCheck(!nmissed, PETSC_COMM_SELF, PETSC_ERR_ARG_INCOMP, "The nonzero structure of C does not contain that of A*B, %" PetscInt_FMT " nonzeros are missing", nmissed);
+#if defined(PETSC_HAVE_DEVICE)
+  if (C->offloadmask != PETSC_OFFLOAD_UNALLOCATED) C->offloadmask = PETSC_OFFLOAD_CPU;
+#endif
+  PetscCall(MatAssemblyBegin(C, MAT_FINAL_ASSEMBLY));
+  PetscCall(MatAssemblyEnd(C, MAT_FINAL_ASSEMBLY));
+  PetscCall(PetscLogFlops(flops));
+  PetscCall(MatSeqAIJRestoreArrayRead(A, &aa));
+  PetscCall(MatSeqAIJRestoreArrayRead(B, &ba));
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
+
 static PetscErrorCode MatDestroy_SeqAIJ_MatMatMultTrans(void *data)
 {
   Mat_MatMatTransMult *abt = (Mat_MatMatTransMult *)data;
@@ -1991,11 +2275,11 @@ static PetscErrorCode MatProductSetFromOptions_SeqAIJ_AB(Mat C)
   PetscInt     alg     = 0; /* default algorithm */
   PetscBool    flg     = PETSC_FALSE;
 #if !defined(PETSC_HAVE_HYPRE)
-  const char *algTypes[7] = {"sorted", "scalable", "scalable_fast", "heap", "btheap", "llcondensed", "rowmerge"};
-  PetscInt    nalg        = 7;
-#else
-  const char *algTypes[8] = {"sorted", "scalable", "scalable_fast", "heap", "btheap", "llcondensed", "rowmerge", "hypre"};
+  const char *algTypes[8] = {"sorted", "scalable", "scalable_fast", "heap", "btheap", "llcondensed", "rowmerge", "threaded"};
   PetscInt    nalg        = 8;
+#else
+  const char *algTypes[9] = {"sorted", "scalable", "scalable_fast", "heap", "btheap", "llcondensed", "rowmerge", "threaded", "hypre"};
+  PetscInt    nalg        = 9;
 #endif
 
   PetscFunctionBegin;
@@ -2006,11 +2290,11 @@ static PetscErrorCode MatProductSetFromOptions_SeqAIJ_AB(Mat C)
   /* Get runtime option */
   if (product->api_user) {
     PetscOptionsBegin(PetscObjectComm((PetscObject)C), ((PetscObject)C)->prefix, "MatMatMult", "Mat");
-    PetscCall(PetscOptionsEList("-matmatmult_via", "Algorithmic approach", "MatMatMult", algTypes, nalg, algTypes[0], &alg, &flg));
+    PetscCall(PetscOptionsEList("-matmatmult_via", "Algorithmic approach", "MatMatMult", algTypes, nalg, algTypes[alg], &alg, &flg));
     PetscOptionsEnd();
   } else {
     PetscOptionsBegin(PetscObjectComm((PetscObject)C), ((PetscObject)C)->prefix, "MatProduct_AB", "Mat");
-    PetscCall(PetscOptionsEList("-mat_product_algorithm", "Algorithmic approach", "MatProduct_AB", algTypes, nalg, algTypes[0], &alg, &flg));
+    PetscCall(PetscOptionsEList("-mat_product_algorithm", "Algorithmic approach", "MatProduct_AB", algTypes, nalg, algTypes[alg], &alg, &flg));
     PetscOptionsEnd();
   }
   if (flg) PetscCall(MatProductSetAlgorithm(C, (MatProductAlgorithm)algTypes[alg]));
@@ -2084,11 +2368,11 @@ static PetscErrorCode MatProductSetFromOptions_SeqAIJ_PtAP(Mat C)
   PetscBool    flg     = PETSC_FALSE;
   PetscInt     alg     = 0; /* default algorithm -- alg=1 should be default!!! */
 #if !defined(PETSC_HAVE_HYPRE)
-  const char *algTypes[2] = {"scalable", "rap"};
-  PetscInt    nalg        = 2;
-#else
-  const char *algTypes[3] = {"scalable", "rap", "hypre"};
+  const char *algTypes[3] = {"scalable", "rap", "threaded"};
   PetscInt    nalg        = 3;
+#else
+  const char *algTypes[4] = {"scalable", "rap", "threaded", "hypre"};
+  PetscInt    nalg        = 4;
 #endif
 
   PetscFunctionBegin;
@@ -2099,11 +2383,11 @@ static PetscErrorCode MatProductSetFromOptions_SeqAIJ_PtAP(Mat C)
   /* Get runtime option */
   if (product->api_user) {
     PetscOptionsBegin(PetscObjectComm((PetscObject)C), ((PetscObject)C)->prefix, "MatPtAP", "Mat");
-    PetscCall(PetscOptionsEList("-matptap_via", "Algorithmic approach", "MatPtAP", algTypes, nalg, algTypes[0], &alg, &flg));
+    PetscCall(PetscOptionsEList("-matptap_via", "Algorithmic approach", "MatPtAP", algTypes, nalg, algTypes[alg], &alg, &flg));
     PetscOptionsEnd();
   } else {
     PetscOptionsBegin(PetscObjectComm((PetscObject)C), ((PetscObject)C)->prefix, "MatProduct_PtAP", "Mat");
-    PetscCall(PetscOptionsEList("-mat_product_algorithm", "Algorithmic approach", "MatProduct_PtAP", algTypes, nalg, algTypes[0], &alg, &flg));
+    PetscCall(PetscOptionsEList("-mat_product_algorithm", "Algorithmic approach", "MatProduct_PtAP", algTypes, nalg, algTypes[alg], &alg, &flg));
     PetscOptionsEnd();
   }
   if (flg) PetscCall(MatProductSetAlgorithm(C, (MatProductAlgorithm)algTypes[alg]));
@@ -49,6 +49,14 @@ PetscErrorCode MatProductSymbolic_PtAP_SeqAIJ_SeqAIJ(Mat C)
     PetscFunctionReturn(PETSC_SUCCESS);
   }
 
+  /* "threaded" */
+  PetscCall(PetscStrcmp(alg, "threaded", &flg));
+  if (flg) {
+    PetscCall(MatPtAPSymbolic_SeqAIJ_SeqAIJ_Threaded(A, P, fill, C));
+    C->ops->productnumeric = MatProductNumeric_PtAP;
+    PetscFunctionReturn(PETSC_SUCCESS);
+  }
+
   /* hypre */
 #if defined(PETSC_HAVE_HYPRE)
   PetscCall(PetscStrcmp(alg, "hypre", &flg));
@@ -291,3 +299,57 @@ PetscErrorCode MatPtAPNumeric_SeqAIJ_SeqAIJ(Mat A, Mat P, Mat C)
   C->product->data = atb;
   PetscFunctionReturn(PETSC_SUCCESS);
 }
+
+/*
+   The "threaded" algorithm computes C = Pt*(A*P) with two threaded sparse products, see MatMatMultSymbolic_SeqAIJ_SeqAIJ_Threaded(),
+   so both the symbolic and the numeric phases are row-parallel. The explicit transpose of P and the product A*P are kept
+   for the numeric phase.
+*/
+typedef struct {
+  Mat Pt; /* transpose of P */
+  Mat AP; /* A*P */
+} Mat_PtAPThreaded;
+
+static PetscErrorCode MatDestroy_SeqAIJ_PtAPThreaded(void *data)
+{
+  Mat_PtAPThreaded *ptap = (Mat_PtAPThreaded *)data;
+
+  PetscFunctionBegin;
+  PetscCall(MatDestroy(&ptap->Pt));
+  PetscCall(MatDestroy(&ptap->AP));
+  PetscCall(PetscFree(ptap));
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
+
+PetscErrorCode MatPtAPSymbolic_SeqAIJ_SeqAIJ_Threaded(Mat A, Mat P, PetscReal fill, Mat C)
+{
+  Mat_PtAPThreaded *ptap;
+
+  PetscFunctionBegin;
+  MatCheckProduct(C, 4);
+  PetscCheck(!C->product->data, PetscObjectComm((PetscObject)C), PETSC_ERR_PLIB, "Extra product struct not empty");
+  PetscCall(PetscNew(&ptap));
+  PetscCall(MatTranspose(P, MAT_INITIAL_MATRIX, &ptap->Pt));
+  PetscCall(MatCreate(PETSC_COMM_SELF, &ptap->AP));
+  PetscCall(MatMatMultSymbolic_SeqAIJ_SeqAIJ_Threaded(A, P, fill, ptap->AP));
+  PetscCall(MatMatMultSymbolic_SeqAIJ_SeqAIJ_Threaded(ptap->Pt, ptap->AP, fill, C));
+
+  C->product->data    = ptap;
+  C->product->destroy = MatDestroy_SeqAIJ_PtAPThreaded;
+  C->ops->ptapnumeric = MatPtAPNumeric_SeqAIJ_SeqAIJ_Threaded;
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
+
+PetscErrorCode MatPtAPNumeric_SeqAIJ_SeqAIJ_Threaded(Mat A, Mat P, Mat C)
+{
+  Mat_PtAPThreaded *ptap;
+
+  PetscFunctionBegin;
+  MatCheckProduct(C, 3);
+  ptap = (Mat_PtAPThreaded *)C->product->data;
+  PetscCheck(ptap, PetscObjectComm((PetscObject)C), PETSC_ERR_PLIB, "Missing data structure");
+  PetscCall(MatTranspose(P, MAT_REUSE_MATRIX, &ptap->Pt));
+  PetscCall(MatMatMultNumeric_SeqAIJ_SeqAIJ_Threaded(A, P, ptap->AP));
+  PetscCall(MatMatMultNumeric_SeqAIJ_SeqAIJ_Threaded(ptap->Pt, ptap->AP, C));
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
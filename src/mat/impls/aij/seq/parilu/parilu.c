@@ -0,0 +1,532 @@
+#include <../src/mat/impls/aij/seq/aij.h>
+#include <../src/mat/impls/sbaij/seq/sbaij.h>
+
+/*MC
+  MATSOLVERPARILU - "parilu" - Provides ILU(0) and ICC(0) computed with the fine-grained parallel fixed-point iteration of Chow and Patel
+
+  Works with `MATSEQAIJ` matrices
+
+  Options Database Keys:
++ -mat_parilu_sweeps <3>       - number of fixed-point sweeps used to compute the factors
+. -mat_parilu_solve_sweeps <0> - number of Jacobi sweeps used to approximate the triangular solves, 0 means exact triangular solves
+- -mat_parilu_warm_start       - start the sweeps of a new numerical factorization from the factors of the previous one
+
+  Level: intermediate
+
+  Notes:
+  Each entry of the factors is an unknown of the nonlinear equations (L U)_ij = a_ij, for ICC(0) (L L^T)_ij = a_ij, on the nonzero
+  pattern of the matrix. A sweep updates all the entries concurrently from the previous values, using OpenMP threads, so the cost of
+  the numerical factorization is a few sparse products and it scales with the number of threads. The sweeps converge to the factors
+  of `PCILU` and `PCICC` with no fill, with a few sweeps usually giving a preconditioner of similar quality.
+
+  With `-mat_parilu_solve_sweeps` k > 0 the triangular solves are replaced by k Jacobi sweeps with each triangular factor, so applying
+  the preconditioner is also a sequence of parallel sparse products. `MatSolveTranspose()` is then not available for ILU(0).
+
+  Since the nonzero pattern of the factors does not change, `-mat_parilu_warm_start` makes the factorizations of a sequence of
+  slowly changing matrices, for example the Jacobians of a Newton iteration, start close to the new factors.
+
+  Only the natural ordering is supported and no shift of zero or negative pivots is applied.
+
+  Use with `-pc_type ilu -pc_factor_mat_solver_type parilu` or `-pc_type icc -pc_factor_mat_solver_type parilu`.
+
+  References:
+. * - E. Chow and A. Patel, Fine-grained parallel incomplete LU factorization, SIAM J. Sci. Comput. 37 (2015)
+
+.seealso: [](ch_matrices), `Mat`, `PCILU`, `PCICC`, `PCFactorSetMatSolverType()`, `MatSolverType`, `MATSOLVERPETSC`
+M*/
+
+typedef struct {
+  PetscInt     sweeps;      /* fixed-point sweeps of the factorization */
+  PetscInt     solvesweeps; /* Jacobi sweeps of the triangular solves, 0 for exact solves */
+  PetscBool    warmstart;   /* start from the previous factors */
+  PetscBool    factored;    /* x[cur] holds the factors of a previous numerical factorization */
+  PetscInt    *ci, *cj;     /* the strictly upper triangular part of the factor by columns */
+  PetscInt    *cidx;        /* location of each of its entries in the values of the factor */
+  MatScalar   *x[2];        /* the iterates of the sweeps, in the layout of the values of the factor */
+  PetscInt     cur;
+  PetscScalar *work; /* work space of the Jacobi triangular solves */
+  PetscErrorCode (*destroy)(Mat);
+  PetscErrorCode (*view)(Mat, PetscViewer);
+} Mat_ParILU;
+
+static PetscErrorCode MatParILUReset_Private(Mat_ParILU *pl)
+{
+  PetscFunctionBegin;
+  PetscCall(PetscFree3(pl->ci, pl->cj, pl->cidx));
+  PetscCall(PetscFree2(pl->x[0], pl->x[1]));
+  PetscCall(PetscFree(pl->work));
+  pl->factored = PETSC_FALSE;
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
+
+static PetscErrorCode MatDestroy_ParILU(Mat B)
+{
+  Mat_ParILU *pl = (Mat_ParILU *)B->spptr;
+
+  PetscFunctionBegin;
+  B->ops->destroy = pl->destroy;
+  PetscCall(MatParILUReset_Private(pl));
+  PetscCall(PetscFree(B->spptr));
+  PetscCall(PetscObjectComposeFunction((PetscObject)B, "MatFactorGetSolverType_C", NULL));
+  PetscCall((*B->ops->destroy)(B));
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
+
+static PetscErrorCode MatView_ParILU(Mat B, PetscViewer viewer)
+{
+  Mat_ParILU       *pl = (Mat_ParILU *)B->spptr;
+  PetscBool         iascii;
+  PetscViewerFormat format;
+
+  PetscFunctionBegin;
+  PetscCall((*pl->view)(B, viewer));
+  PetscCall(PetscObjectTypeCompare((PetscObject)viewer, PETSCVIEWERASCII, &iascii));
+  if (!iascii) PetscFunctionReturn(PETSC_SUCCESS);
+  PetscCall(PetscViewerGetFormat(viewer, &format));
+  if (format == PETSC_VIEWER_ASCII_INFO || format == PETSC_VIEWER_ASCII_INFO_DETAIL) {
+    PetscCall(PetscViewerASCIIPrintf(viewer, "factors computed with %" PetscInt_FMT " fixed-point sweeps%s\n", pl->sweeps, pl->warmstart ? " from the previous factors" : ""));
+    if (pl->solvesweeps) PetscCall(PetscViewerASCIIPrintf(viewer, "triangular solves approximated with %" PetscInt_FMT " Jacobi sweeps\n", pl->solvesweeps));
+  }
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
+
+static PetscErrorCode MatParILUSetFromOptions_Private(Mat B, Mat_ParILU *pl)
+{
+  PetscFunctionBegin;
+  PetscObjectOptionsBegin((PetscObject)B);
+  PetscCall(PetscOptionsInt("-mat_parilu_sweeps", "Number of fixed-point sweeps of the factorization", "MATSOLVERPARILU", pl->sweeps, &pl->sweeps, NULL));
+  PetscCall(PetscOptionsInt("-mat_parilu_solve_sweeps", "Number of Jacobi sweeps of the triangular solves, 0 for exact solves", "MATSOLVERPARILU", pl->solvesweeps, &pl->solvesweeps, NULL));
+  PetscCall(PetscOptionsBool("-mat_parilu_warm_start", "Start the sweeps from the previous factors", "MATSOLVERPARILU", pl->warmstart, &pl->warmstart, NULL));
+  PetscOptionsEnd();
+  PetscCheck(pl->sweeps >= 0, PetscObjectComm((PetscObject)B), PETSC_ERR_ARG_OUTOFRANGE, "Number of sweeps %" PetscInt_FMT " cannot be negative", pl->sweeps);
+  PetscCheck(pl->solvesweeps >= 0, PetscObjectComm((PetscObject)B), PETSC_ERR_ARG_OUTOFRANGE, "Number of solve sweeps %" PetscInt_FMT " cannot be negative", pl->solvesweeps);
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
+
+/*
+  Stores the strictly upper triangular entries of the factor by columns, the entries of row r are j[bi[r]] to j[ei[r]-1].
+  The rows of each column are sorted since the rows are visited in increasing order.
+*/
+static PetscErrorCode MatParILUSetUpColumns_Private(Mat_ParILU *pl, PetscInt n, const PetscInt bi[], const PetscInt ei[], const PetscInt j[], PetscInt nz)
+{
+  PetscInt *fill, cnz = 0;
+
+  PetscFunctionBegin;
+  PetscCall(MatParILUReset_Private(pl));
+  for (PetscInt r = 0; r < n; r++) cnz += ei[r] - bi[r];
+  PetscCall(PetscMalloc3(n + 1, &pl->ci, cnz, &pl->cj, cnz, &pl->cidx));
+  PetscCall(PetscArrayzero(pl->ci, n + 1));
+  for (PetscInt r = 0; r < n; r++) {
+    for (PetscInt k = bi[r]; k < ei[r]; k++) pl->ci[j[k] + 1]++;
+  }
+  for (PetscInt r = 0; r < n; r++) pl->ci[r + 1] += pl->ci[r];
+  PetscCall(PetscMalloc1(n, &fill));
+  PetscCall(PetscArraycpy(fill, pl->ci, n));
+  for (PetscInt r = 0; r < n; r++) {
+    for (PetscInt k = bi[r]; k < ei[r]; k++) {
+      PetscInt c = j[k];
+
+      pl->cj[fill[c]]     = r;
+      pl->cidx[fill[c]++] = k;
+    }
+  }
+  PetscCall(PetscFree(fill));
+  PetscCall(PetscMalloc2(nz, &pl->x[0], nz, &pl->x[1]));
+  PetscCall(PetscMalloc1(2 * n, &pl->work));
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
+
+/* sum over k < kmax of x[ls] * x[cidx[cs]] with bj[ls] == cj[cs] == k, for a sorted row ls..le-1 and a sorted column cs..ce-1 */
+static inline PetscScalar MatParILURowColumnDot_Private(const MatScalar x[], const PetscInt bj[], PetscInt ls, PetscInt le, const PetscInt cj[], const PetscInt cidx[], PetscInt cs, PetscInt ce, PetscInt kmax)
+{
+  PetscScalar sum = 0.0;
+
+  while (ls < le && cs < ce) {
+    PetscInt kl = bj[ls], kc = cj[cs];
+
+    if (kl >= kmax || kc >= kmax) break;
+    if (kl == kc) sum += x[ls++] * x[cidx[cs++]];
+    else if (kl < kc) ls++;
+    else cs++;
+  }
+  return sum;
+}
+
+/* the same for two sorted columns */
+static inline PetscScalar MatParILUColumnColumnDot_Private(const MatScalar x[], const PetscInt cj[], const PetscInt cidx[], PetscInt s1, PetscInt e1, PetscInt s2, PetscInt e2, PetscInt kmax)
+{
+  PetscScalar sum = 0.0;
+
+  while (s1 < e1 && s2 < e2) {
+    PetscInt k1 = cj[s1], k2 = cj[s2];
+
+    if (k1 >= kmax || k2 >= kmax) break;
+    if (k1 == k2) sum += x[cidx[s1++]] * x[cidx[s2++]];
+    else if (k1 < k2) s1++;
+    else s2++;
+  }
+  return sum;
+}
+
+static PetscErrorCode MatSolve_SeqAIJ_ParILU(Mat B, Vec bb, Vec xx)
+{
+  Mat_SeqAIJ        *b  = (Mat_SeqAIJ *)B->data;
+  Mat_ParILU        *pl = (Mat_ParILU *)B->spptr;
+  const PetscInt     n = B->rmap->n, *bi = b->i, *bj = b->j, *bdiag = b->diag;
+  const MatScalar   *ba = b->a;
+  const PetscScalar *rhs;
+  PetscScalar       *x, *y = pl->work, *z = pl->work + n, *t;
+
+  PetscFunctionBegin;
+  PetscCall(VecGetArrayRead(bb, &rhs));
+  PetscCall(VecGetArrayWrite(xx, &x));
+
+  /* Jacobi sweeps with the unit lower triangular L, from y = rhs */
+  PetscCall(PetscArraycpy(y, rhs, n));
+  for (PetscInt s = 0; s < pl->solvesweeps; s++) {
+    PetscPragmaOMP(parallel for schedule(static))
+    for (PetscInt i = 0; i < n; i++) {
+      PetscScalar sum = rhs[i];
+
+      for (PetscInt k = bi[i]; k < bi[i + 1]; k++) sum -= ba[k] * y[bj[k]];
+      z[i] = sum;
+    }
+    t = y;
+    y = z;
+    z = t;
+  }
+
+  /* Jacobi sweeps with U, from x = D^{-1} y; z and x alternate and the last sweep writes x */
+  t = (pl->solvesweeps % 2) ? z : x;
+  for (PetscInt i = 0; i < n; i++) t[i] = y[i] * ba[bdiag[i]];
+  for (PetscInt s = 0; s < pl->solvesweeps; s++) {
+    PetscScalar *from = t, *to = (t == x) ? z : x;
+
+    PetscPragmaOMP(parallel for schedule(static))
+    for (PetscInt i = 0; i < n; i++) {
+      PetscScalar sum = y[i];
+
+      for (PetscInt k = bdiag[i + 1] + 1; k < bdiag[i]; k++) sum -= ba[k] * from[bj[k]];
+      to[i] = sum * ba[bdiag[i]];
+    }
+    t = to;
+  }
+
+  PetscCall(VecRestoreArrayRead(bb, &rhs));
+  PetscCall(VecRestoreArrayWrite(xx, &x));
+  PetscCall(PetscLogFlops(pl->solvesweeps * (2.0 * b->nz - B->cmap->n)));
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
+
+static PetscErrorCode MatSolve_SeqSBAIJ_ParILU(Mat B, Vec bb, Vec xx)
+{
+  Mat_SeqSBAIJ      *b  = (Mat_SeqSBAIJ *)B->data;
+  Mat_ParILU        *pl = (Mat_ParILU *)B->spptr;
+  const PetscInt     n = B->rmap->n, *bi = b->i, *bj = b->j, *bdiag = b->diag, *ci = pl->ci, *cj = pl->cj, *cidx = pl->cidx;
+  const MatScalar   *ba = b->a;
+  const PetscScalar *rhs;
+  PetscScalar       *x, *y = pl->work, *z = pl->work + n, *t;
+
+  PetscFunctionBegin;
+  PetscCall(VecGetArrayRead(bb, &rhs));
+  PetscCall(VecGetArrayWrite(xx, &x));
+
+  /* Jacobi sweeps with U^T, the factor stores -U */
+  PetscCall(PetscArraycpy(y, rhs, n));
+  for (PetscInt s = 0; s < pl->solvesweeps; s++) {
+    PetscPragmaOMP(parallel for schedule(static))
+    for (PetscInt i = 0; i < n; i++) {
+      PetscScalar sum = rhs[i];
+
+      for (PetscInt k = ci[i]; k < ci[i + 1]; k++) sum += ba[cidx[k]] * y[cj[k]];
+      z[i] = sum;
+    }
+    t = y;
+    y = z;
+    z = t;
+  }
+  for (PetscInt i = 0; i < n; i++) y[i] *= ba[bdiag[i]];
+
+  /* Jacobi sweeps with U, z and x alternate and the last sweep writes x */
+  t = (pl->solvesweeps % 2) ? z : x;
+  PetscCall(PetscArraycpy(t, y, n));
+  for (PetscInt s = 0; s < pl->solvesweeps; s++) {
+    PetscScalar *from = t, *to = (t == x) ? z : x;
+
+    PetscPragmaOMP(parallel for schedule(static))
+    for (PetscInt i = 0; i < n; i++) {
+      PetscScalar sum = y[i];
+
+      for (PetscInt k = bi[i]; k < bdiag[i]; k++) sum += ba[k] * from[bj[k]];
+      to[i] = sum;
+    }
+    t = to;
+  }
+
+  PetscCall(VecRestoreArrayRead(bb, &rhs));
+  PetscCall(VecRestoreArrayWrite(xx, &x));
+  PetscCall(PetscLogFlops(pl->solvesweeps * (4.0 * b->nz - 3.0 * n)));
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
+
+static PetscErrorCode MatParILUCheckPivot_Private(Mat B, Mat A, const MatFactorInfo *info, PetscInt row, PetscScalar pv)
+{
+  PetscFunctionBegin;
+  if (PetscAbsScalar(pv) <= info->zeropivot || PetscIsNanScalar(pv)) {
+    PetscCheck(!A->erroriffailure, PETSC_COMM_SELF, PETSC_ERR_MAT_LU_ZRPVT, "Zero pivot row %" PetscInt_FMT " value %g tolerance %g", row, (double)PetscAbsScalar(pv), (double)info->zeropivot);
+    PetscCall(PetscInfo(A, "Detected zero pivot in factorization in row %" PetscInt_FMT " value %g tolerance %g\n", row, (double)PetscAbsScalar(pv), (double)info->zeropivot));
+    B->factorerrortype             = MAT_FACTOR_NUMERIC_ZEROPIVOT;
+    B->factorerror_zeropivot_value = PetscAbsScalar(pv);
+    B->factorerror_zeropivot_row   = row;
+  }
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
+
+/*
+  The ILU(0) factor uses the layout of MatILUFactorSymbolic_SeqAIJ_ilu0(): the entries of row i of L are at bi[i] to bi[i+1]-1, those
+  of row i of U at bdiag[i+1]+1 to bdiag[i]-1 and U(i,i) at bdiag[i], in the same order as the entries of row i of A. The sweeps keep
+  U(i,i) itself, it is inverted once they are done.
+*/
+static PetscErrorCode MatLUFactorNumeric_SeqAIJ_ParILU(Mat B, Mat A, const MatFactorInfo *info)
+{
+  Mat_SeqAIJ      *a = (Mat_SeqAIJ *)A->data, *b = (Mat_SeqAIJ *)B->data;
+  Mat_ParILU      *pl = (Mat_ParILU *)B->spptr;
+  const PetscInt   n = A->rmap->n, *ai = a->i, *adiag = a->diag, *bi = b->i, *bj = b->j, *bdiag = b->diag;
+  const PetscInt  *ci = pl->ci, *cj = pl->cj, *cidx = pl->cidx;
+  const MatScalar *aa;
+  MatScalar       *x;
+
+  PetscFunctionBegin;
+  PetscCall(MatSeqAIJGetArrayRead(A, &aa));
+  if (!pl->warmstart || !pl->factored) {
+    x = pl->x[pl->cur];
+    for (PetscInt i = 0; i < n; i++) {
+      const PetscInt nl = adiag[i] - ai[i], nu = ai[i + 1] - adiag[i] - 1;
+
+      for (PetscInt k = 0; k < nl; k++) x[bi[i] + k] = aa[ai[i] + k] / aa[adiag[bj[bi[i] + k]]];
+      for (PetscInt k = 0; k < nu; k++) x[bdiag[i + 1] + 1 + k] = aa[adiag[i] + 1 + k];
+      x[bdiag[i]] = aa[adiag[i]];
+    }
+  }
+  for (PetscInt s = 0; s < pl->sweeps; s++) {
+    const MatScalar *xo = pl->x[pl->cur];
+    MatScalar       *xn = pl->x[1 - pl->cur];
+
+    PetscPragmaOMP(parallel for schedule(dynamic, 64))
+    for (PetscInt i = 0; i < n; i++) {
+      const PetscInt ls = bi[i], le = bi[i + 1], nl = adiag[i] - ai[i];
+
+      /* L(i,j) = (A(i,j) - sum_{k<j} L(i,k) U(k,j)) / U(j,j) */
+      for (PetscInt k = 0; k < nl; k++) {
+        const PetscInt j = bj[ls + k];
+
+        xn[ls + k] = (aa[ai[i] + k] - MatParILURowColumnDot_Private(xo, bj, ls, le, cj, cidx, ci[j], ci[j + 1], j)) / xo[bdiag[j]];
+      }
+      /* U(i,j) = A(i,j) - sum_{k<i} L(i,k) U(k,j) for j >= i */
+      for (PetscInt k = bdiag[i + 1] + 1, ka = adiag[i] + 1; k < bdiag[i]; k++, ka++) {
+        const PetscInt j = bj[k];
+
+        xn[k] = aa[ka] - MatParILURowColumnDot_Private(xo, bj, ls, le, cj, cidx, ci[j], ci[j + 1], i);
+      }
+      xn[bdiag[i]] = aa[adiag[i]] - MatParILURowColumnDot_Private(xo, bj, ls, le, cj, cidx, ci[i], ci[i + 1], i);
+    }
+    pl->cur = 1 - pl->cur;
+  }
+  PetscCall(MatSeqAIJRestoreArrayRead(A, &aa));
+  pl->factored = PETSC_TRUE;
+
+  x = pl->x[pl->cur];
+  PetscCall(PetscArraycpy(b->a, x, bdiag[0] + 1));
+  B->factorerrortype = MAT_FACTOR_NOERROR;
+  for (PetscInt i = 0; i < n; i++) {
+    PetscCall(MatParILUCheckPivot_Private(B, A, info, i, x[bdiag[i]]));
+    if (B->factorerrortype) break;
+    b->a[bdiag[i]] = 1.0 / x[bdiag[i]];
+  }
+
+  if (pl->solvesweeps) {
+    B->ops->solve          = MatSolve_SeqAIJ_ParILU;
+    B->ops->solvetranspose = NULL;
+  } else {
+    B->ops->solve          = MatSolve_SeqAIJ_NaturalOrdering;
+    B->ops->solvetranspose = MatSolveTranspose_SeqAIJ;
+  }
+  B->ops->solveadd          = NULL;
+  B->ops->solvetransposeadd = NULL;
+  B->ops->matsolve          = NULL;
+  B->assembled              = PETSC_TRUE;
+  B->preallocated           = PETSC_TRUE;
+  if (!pl->solvesweeps) PetscCall(MatSeqAIJSolveLevelsSetUp_Private(B));
+  PetscCall(PetscLogFlops(pl->sweeps * 2.0 * b->nz));
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
+
+static PetscErrorCode MatILUFactorSymbolic_SeqAIJ_ParILU(Mat B, Mat A, IS isrow, IS iscol, const MatFactorInfo *info)
+{
+  Mat_ParILU *pl = (Mat_ParILU *)B->spptr;
+  Mat_SeqAIJ *b;
+  PetscBool   rowidentity, colidentity, missing;
+  PetscInt    d;
+
+  PetscFunctionBegin;
+  PetscCheck(!info->levels, PETSC_COMM_SELF, PETSC_ERR_SUP, "MATSOLVERPARILU only provides ILU(0)");
+  PetscCall(ISIdentity(isrow, &rowidentity));
+  PetscCall(ISIdentity(iscol, &colidentity));
+  PetscCheck(rowidentity && colidentity, PETSC_COMM_SELF, PETSC_ERR_SUP, "MATSOLVERPARILU only supports the natural ordering");
+  PetscCall(MatMissingDiagonal(A, &missing, &d));
+  PetscCheck(!missing, PETSC_COMM_SELF, PETSC_ERR_ARG_WRONGSTATE, "Matrix is missing diagonal entry %" PetscInt_FMT, d);
+  PetscCall(MatParILUSetFromOptions_Private(B, pl));
+
+  PetscCall(MatILUFactorSymbolic_SeqAIJ_ilu0(B, A, isrow, iscol, info));
+  b = (Mat_SeqAIJ *)B->data;
+  {
+    const PetscInt n = A->rmap->n;
+    PetscInt      *ub, *ue;
+
+    PetscCall(PetscMalloc2(n, &ub, n, &ue));
+    for (PetscInt i = 0; i < n; i++) {
+      ub[i] = b->diag[i + 1] + 1;
+      ue[i] = b->diag[i];
+    }
+    PetscCall(MatParILUSetUpColumns_Private(pl, n, ub, ue, b->j, b->diag[0] + 1));
+    PetscCall(PetscFree2(ub, ue));
+  }
+  B->ops->lufactornumeric = MatLUFactorNumeric_SeqAIJ_ParILU;
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
+
+/*
+  The ICC(0) factor uses the layout of MatICCFactorSymbolic_SeqAIJ(): the entries of row i of U are at bi[i] to bdiag[i]-1 and the
+  diagonal at bdiag[i], the factorization is A = U^T D U with -U and D^{-1} stored. The sweeps compute R = D^{1/2} U, with A = R^T R.
+*/
+static PetscErrorCode MatCholeskyFactorNumeric_SeqAIJ_ParILU(Mat B, Mat A, const MatFactorInfo *info)
+{
+  Mat_SeqAIJ      *a = (Mat_SeqAIJ *)A->data;
+  Mat_SeqSBAIJ    *b = (Mat_SeqSBAIJ *)B->data;
+  Mat_ParILU      *pl = (Mat_ParILU *)B->spptr;
+  const PetscInt   n = A->rmap->n, *adiag = a->diag, *bi = b->i, *bj = b->j, *bdiag = b->diag;
+  const PetscInt  *ci = pl->ci, *cj = pl->cj, *cidx = pl->cidx;
+  const MatScalar *aa;
+  MatScalar       *x;
+
+  PetscFunctionBegin;
+  PetscCall(MatSeqAIJGetArrayRead(A, &aa));
+  if (!pl->warmstart || !pl->factored) {
+    x = pl->x[pl->cur];
+    for (PetscInt i = 0; i < n; i++) {
+      const PetscScalar r = PetscSqrtScalar(aa[adiag[i]]);
+
+      for (PetscInt k = bi[i], ka = adiag[i] + 1; k < bdiag[i]; k++, ka++) x[k] = aa[ka] / r;
+      x[bdiag[i]] = r;
+    }
+  }
+  for (PetscInt s = 0; s < pl->sweeps; s++) {
+    const MatScalar *xo = pl->x[pl->cur];
+    MatScalar       *xn = pl->x[1 - pl->cur];
+
+    PetscPragmaOMP(parallel for schedule(dynamic, 64))
+    for (PetscInt i = 0; i < n; i++) {
+      PetscScalar d;
+
+      /* R(i,j) = (A(i,j) - sum_{k<i} R(k,i) R(k,j)) / R(i,i) for j > i */
+      for (PetscInt k = bi[i], ka = adiag[i] + 1; k < bdiag[i]; k++, ka++) {
+        const PetscInt j = bj[k];
+
+        xn[k] = (aa[ka] - MatParILUColumnColumnDot_Private(xo, cj, cidx, ci[i], ci[i + 1], ci[j], ci[j + 1], i)) / xo[bdiag[i]];
+      }
+      /* R(i,i) = sqrt(A(i,i) - sum_{k<i} R(k,i)^2) */
+      d            = aa[adiag[i]] - MatParILUColumnColumnDot_Private(xo, cj, cidx, ci[i], ci[i + 1], ci[i], ci[i + 1], i);
+      xn[bdiag[i]] = PetscSqrtReal(PetscAbsScalar(d));
+    }
+    pl->cur = 1 - pl->cur;
+  }
+  PetscCall(MatSeqAIJRestoreArrayRead(A, &aa));
+  pl->factored = PETSC_TRUE;
+
+  x                  = pl->x[pl->cur];
+  B->factorerrortype = MAT_FACTOR_NOERROR;
+  for (PetscInt i = 0; i < n; i++) {
+    const PetscScalar r = x[bdiag[i]];
+
+    PetscCall(MatParILUCheckPivot_Private(B, A, info, i, r));
+    if (B->factorerrortype) break;
+    for (PetscInt k = bi[i]; k < bdiag[i]; k++) b->a[k] = -x[k] / r;
+    b->a[bdiag[i]] = 1.0 / (r * r);
+  }
+
+  if (pl->solvesweeps) {
+    B->ops->solve          = MatSolve_SeqSBAIJ_ParILU;
+    B->ops->solvetranspose = MatSolve_SeqSBAIJ_ParILU;
+  } else {
+    B->ops->solve          = MatSolve_SeqSBAIJ_1_NaturalOrdering;
+    B->ops->solvetranspose = MatSolve_SeqSBAIJ_1_NaturalOrdering;
+  }
+  B->ops->forwardsolve  = NULL;
+  B->ops->backwardsolve = NULL;
+  B->ops->matsolve      = NULL;
+  B->assembled          = PETSC_TRUE;
+  B->preallocated       = PETSC_TRUE;
+  if (!pl->solvesweeps) PetscCall(MatSeqSBAIJSolveLevelsSetUp_Private(B));
+  PetscCall(PetscLogFlops(pl->sweeps * 2.0 * b->nz));
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
+
+static PetscErrorCode MatICCFactorSymbolic_SeqAIJ_ParILU(Mat B, Mat A, IS perm, const MatFactorInfo *info)
+{
+  Mat_ParILU   *pl = (Mat_ParILU *)B->spptr;
+  Mat_SeqSBAIJ *b;
+  PetscBool     identity;
+
+  PetscFunctionBegin;
+  PetscCheck(!info->levels, PETSC_COMM_SELF, PETSC_ERR_SUP, "MATSOLVERPARILU only provides ICC(0)");
+  PetscCall(ISIdentity(perm, &identity));
+  PetscCheck(identity, PETSC_COMM_SELF, PETSC_ERR_SUP, "MATSOLVERPARILU only supports the natural ordering");
+  PetscCall(MatParILUSetFromOptions_Private(B, pl));
+
+  PetscCall(MatICCFactorSymbolic_SeqAIJ(B, A, perm, info));
+  b = (Mat_SeqSBAIJ *)B->data;
+  PetscCall(MatParILUSetUpColumns_Private(pl, A->rmap->n, b->i, b->diag, b->j, b->i[A->rmap->n]));
+  B->ops->choleskyfactornumeric = MatCholeskyFactorNumeric_SeqAIJ_ParILU;
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
+
+static PetscErrorCode MatFactorGetSolverType_seqaij_parilu(Mat A, MatSolverType *type)
+{
+  PetscFunctionBegin;
+  *type = MATSOLVERPARILU;
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
+
+PETSC_INTERN PetscErrorCode MatGetFactor_seqaij_parilu(Mat A, MatFactorType ftype, Mat *B)
+{
+  PetscInt    n = A->rmap->n;
+  Mat_ParILU *pl;
+
+  PetscFunctionBegin;
+  PetscCall(MatCreate(PetscObjectComm((PetscObject)A), B));
+  PetscCall(MatSetSizes(*B, n, n, n, n));
+  if (ftype == MAT_FACTOR_ILU) {
+    PetscCall(MatSetType(*B, MATSEQAIJ));
+    (*B)->ops->ilufactorsymbolic = MatILUFactorSymbolic_SeqAIJ_ParILU;
+  } else if (ftype == MAT_FACTOR_ICC) {
+    PetscCall(MatSetType(*B, MATSEQSBAIJ));
+    PetscCall(MatSeqSBAIJSetPreallocation(*B, 1, MAT_SKIP_ALLOCATION, NULL));
+    (*B)->ops->iccfactorsymbolic = MatICCFactorSymbolic_SeqAIJ_ParILU;
+  } else SETERRQ(PETSC_COMM_SELF, PETSC_ERR_SUP, "Factor type not supported");
+  (*B)->factortype = ftype;
+
+  PetscCall(PetscNew(&pl));
+  pl->sweeps           = 3;
+  pl->destroy          = (*B)->ops->destroy;
+  pl->view             = (*B)->ops->view;
+  (*B)->spptr          = pl;
+  (*B)->ops->destroy   = MatDestroy_ParILU;
+  (*B)->ops->view      = MatView_ParILU;
+  (*B)->canuseordering = PETSC_TRUE;
+  PetscCall(PetscStrallocpy(MATORDERINGNATURAL, (char **)&(*B)->preferredordering[ftype]));
+
+  PetscCall(PetscFree((*B)->solvertype));
+  PetscCall(PetscStrallocpy(MATSOLVERPARILU, &(*B)->solvertype));
+  PetscCall(PetscObjectComposeFunction((PetscObject)*B, "MatFactorGetSolverType_C", MatFactorGetSolverType_seqaij_parilu));
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
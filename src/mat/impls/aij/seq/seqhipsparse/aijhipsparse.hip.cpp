@@ -3419,6 +3419,7 @@ static PetscErrorCode MatBindToCPU_SeqAIJHIPSPARSE(Mat A, PetscBool flg)
     A->ops->zeroentries               = MatZeroEntries_SeqAIJ;
     A->ops->mult                      = MatMult_SeqAIJ;
     A->ops->multadd                   = MatMultAdd_SeqAIJ;
+    A->ops->multdot                   = MatMultDot_SeqAIJ;
     A->ops->multtranspose             = MatMultTranspose_SeqAIJ;
     A->ops->multtransposeadd          = MatMultTransposeAdd_SeqAIJ;
     A->ops->multhermitiantranspose    = NULL;
@@ -3437,6 +3438,7 @@ static PetscErrorCode MatBindToCPU_SeqAIJHIPSPARSE(Mat A, PetscBool flg)
     A->ops->zeroentries               = MatZeroEntries_SeqAIJHIPSPARSE;
     A->ops->mult                      = MatMult_SeqAIJHIPSPARSE;
     A->ops->multadd                   = MatMultAdd_SeqAIJHIPSPARSE;
+    A->ops->multdot                   = NULL;
     A->ops->multtranspose             = MatMultTranspose_SeqAIJHIPSPARSE;
     A->ops->multtransposeadd          = MatMultTransposeAdd_SeqAIJHIPSPARSE;
     A->ops->multhermitiantranspose    = MatMultHermitianTranspose_SeqAIJHIPSPARSE;
@@ -422,12 +422,14 @@ static PetscErrorCode MatBindToCPU_SeqAIJViennaCL(Mat A, PetscBool flg)
     PetscCall(MatViennaCLCopyFromGPU(A, (const ViennaCLAIJMatrix *)NULL));
     A->ops->mult        = MatMult_SeqAIJ;
     A->ops->multadd     = MatMultAdd_SeqAIJ;
+    A->ops->multdot     = MatMultDot_SeqAIJ;
     A->ops->assemblyend = MatAssemblyEnd_SeqAIJ;
     A->ops->duplicate   = MatDuplicate_SeqAIJ;
     PetscCall(PetscMemzero(a->ops, sizeof(Mat_SeqAIJOps)));
   } else {
     A->ops->mult        = MatMult_SeqAIJViennaCL;
     A->ops->multadd     = MatMultAdd_SeqAIJViennaCL;
+    A->ops->multdot     = NULL;
     A->ops->assemblyend = MatAssemblyEnd_SeqAIJViennaCL;
     A->ops->destroy     = MatDestroy_SeqAIJViennaCL;
     A->ops->duplicate   = MatDuplicate_SeqAIJViennaCL;
@@ -0,0 +1,765 @@
+#include <../src/mat/impls/aij/seq/aij.h>
+#include <../src/mat/impls/sbaij/seq/sbaij.h>
+#include <petscblaslapack.h>
+
+/*MC
+  MATSOLVERSUPERNODAL - "supernodal" - Provides a native supernodal sparse LU and Cholesky factorization
+
+  Works with `MATSEQAIJ` matrices, and `MATSEQSBAIJ` matrices with block size 1 for Cholesky
+
+  Level: intermediate
+
+  Notes:
+  The columns of the factors with the same nonzero structure below their diagonal block are grouped into supernodes, found from
+  the elimination tree of the ordered matrix, postordered, with small supernodes merged with their parent when this adds few
+  explicit zeros. Each supernode is stored as a dense panel, so the numerical factorization is done with dense BLAS-3 kernels: the
+  diagonal block of each supernode is factored with LAPACK, the panel below it with triangular solves, and its update of the later
+  supernodes is computed with matrix-matrix products. `MatSolve()` and `MatMatSolve()` are blocked triangular solves over the
+  supernodes.
+
+  The structure of the LU factors is that of the Cholesky factor of A + A^T. Rows are only exchanged within the diagonal block of
+  each supernode, by the partial pivoting of LAPACK, so matrices that need pivoting across supernodes, for example with zero
+  diagonal entries, should use an external package. No shifts are applied to zero pivots. In complex arithmetic the Cholesky
+  factorization is for Hermitian matrices. `MatSolveTranspose()` is only available for Cholesky in real arithmetic.
+
+  The default ordering is `MATORDERINGND`, other orderings such as `MATORDERINGQMD` can be selected with `-pc_factor_mat_ordering_type`.
+
+  Use with `-pc_type lu -pc_factor_mat_solver_type supernodal` or `-pc_type cholesky -pc_factor_mat_solver_type supernodal`.
+
+.seealso: [](ch_matrices), `Mat`, `PCLU`, `PCCHOLESKY`, `PCFactorSetMatSolverType()`, `MatSolverType`, `MATSOLVERPETSC`
+M*/
+
+typedef struct {
+  PetscBool     cholesky;
+  PetscInt      nsuper;
+  PetscInt     *sstart;       /* the columns of supernode s are sstart[s] to sstart[s+1]-1 */
+  PetscInt     *snode;        /* supernode of each column */
+  PetscInt     *sptr, *sind;  /* rows below the diagonal block of supernode s, sorted, are sind[sptr[s]] to sind[sptr[s+1]-1] */
+  PetscCount   *lptr, *uptr;  /* offsets in val of the L panel and, for LU, of the U panel of each supernode */
+  PetscScalar  *val;          /* the factors */
+  PetscCount    nval;
+  PetscCount   *amap;         /* location in val of each nonzero of the matrix, -1 for those not used */
+  PetscInt      nz;           /* number of nonzeros of the matrix at the symbolic factorization */
+  PetscInt     *rperm, *cperm; /* row and column k of the ordered matrix are row rperm[k] and column cperm[k] of the matrix */
+  PetscInt     *rinv;          /* inverse of rperm, used to apply the Hermitian symmetry */
+  PetscBLASInt *ipiv;          /* LU: the row exchanges within the diagonal block of each supernode */
+  PetscInt      maxnb, maxnc;  /* largest number of rows below the diagonal block and of columns of a supernode */
+  PetscInt     *rel;           /* relative positions of rows in a target supernode */
+  PetscScalar  *work;          /* update of the numerical factorization */
+  PetscScalar  *rhs;           /* the ordered right-hand sides of the solves */
+  PetscInt      nrhs;
+} Mat_Supernodal;
+
+static PetscErrorCode MatDestroy_Supernodal(Mat F)
+{
+  Mat_Supernodal *sn = (Mat_Supernodal *)F->data;
+
+  PetscFunctionBegin;
+  PetscCall(PetscFree3(sn->sstart, sn->snode, sn->sptr));
+  PetscCall(PetscFree(sn->sind));
+  PetscCall(PetscFree2(sn->lptr, sn->uptr));
+  PetscCall(PetscFree(sn->val));
+  PetscCall(PetscFree(sn->amap));
+  PetscCall(PetscFree3(sn->rperm, sn->cperm, sn->rinv));
+  PetscCall(PetscFree(sn->ipiv));
+  PetscCall(PetscFree2(sn->rel, sn->work));
+  PetscCall(PetscFree(sn->rhs));
+  PetscCall(PetscObjectComposeFunction((PetscObject)F, "MatFactorGetSolverType_C", NULL));
+  PetscCall(PetscFree(F->data));
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
+
+static PetscErrorCode MatView_Supernodal(Mat F, PetscViewer viewer)
+{
+  Mat_Supernodal   *sn = (Mat_Supernodal *)F->data;
+  PetscBool         iascii;
+  PetscViewerFormat format;
+
+  PetscFunctionBegin;
+  PetscCall(PetscObjectTypeCompare((PetscObject)viewer, PETSCVIEWERASCII, &iascii));
+  if (!iascii) PetscFunctionReturn(PETSC_SUCCESS);
+  PetscCall(PetscViewerGetFormat(viewer, &format));
+  if (format == PETSC_VIEWER_ASCII_INFO || format == PETSC_VIEWER_ASCII_INFO_DETAIL) {
+    PetscCall(PetscViewerASCIIPrintf(viewer, "supernodal %s factorization with %" PetscInt_FMT " supernodes of up to %" PetscInt_FMT " columns\n", sn->cholesky ? "Cholesky" : "LU", sn->nsuper, sn->maxnc));
+    PetscCall(PetscViewerASCIIPrintf(viewer, "entries stored in the factors %" PetscCount_FMT "\n", sn->nval));
+  }
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
+
+static PetscErrorCode MatGetInfo_Supernodal(Mat F, MatInfoType flag, MatInfo *info)
+{
+  Mat_Supernodal *sn = (Mat_Supernodal *)F->data;
+
+  PetscFunctionBegin;
+  PetscCall(PetscMemzero(info, sizeof(MatInfo)));
+  info->block_size   = 1.0;
+  info->nz_allocated = (PetscLogDouble)sn->nval;
+  info->nz_used      = (PetscLogDouble)sn->nval;
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
+
+/*
+  The symmetric adjacency graph, without the diagonal, of the nonzeros of the ordered matrix and of its transpose, with upper only
+  those of the upper triangle of the matrix
+*/
+static PetscErrorCode MatSupernodalGraph_Private(PetscInt n, const PetscInt ai[], const PetscInt aj[], PetscBool upper, const PetscInt rinv[], const PetscInt cinv[], PetscInt **gi, PetscInt **gj)
+{
+  PetscInt *cnt;
+
+  PetscFunctionBegin;
+  PetscCall(PetscCalloc1(n + 1, gi));
+  for (PetscInt i = 0; i < n; i++) {
+    for (PetscInt k = ai[i]; k < ai[i + 1]; k++) {
+      PetscInt p = rinv[i], q = cinv[aj[k]];
+
+      if (p == q || (upper && aj[k] < i)) continue;
+      (*gi)[p + 1]++;
+      (*gi)[q + 1]++;
+    }
+  }
+  for (PetscInt i = 0; i < n; i++) (*gi)[i + 1] += (*gi)[i];
+  PetscCall(PetscMalloc1((*gi)[n], gj));
+  PetscCall(PetscMalloc1(n, &cnt));
+  PetscCall(PetscArraycpy(cnt, *gi, n));
+  for (PetscInt i = 0; i < n; i++) {
+    for (PetscInt k = ai[i]; k < ai[i + 1]; k++) {
+      PetscInt p = rinv[i], q = cinv[aj[k]];
+
+      if (p == q || (upper && aj[k] < i)) continue;
+      (*gj)[cnt[p]++] = q;
+      (*gj)[cnt[q]++] = p;
+    }
+  }
+  PetscCall(PetscFree(cnt));
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
+
+/* the elimination tree of the graph with the algorithm of Liu, parent[k] is -1 for the roots */
+static PetscErrorCode MatSupernodalEtree_Private(PetscInt n, const PetscInt gi[], const PetscInt gj[], PetscInt parent[], PetscInt ancestor[])
+{
+  PetscFunctionBegin;
+  for (PetscInt k = 0; k < n; k++) {
+    parent[k]   = -1;
+    ancestor[k] = -1;
+    for (PetscInt l = gi[k]; l < gi[k + 1]; l++) {
+      PetscInt i = gj[l];
+
+      while (i != -1 && i < k) {
+        PetscInt next = ancestor[i];
+
+        ancestor[i] = k;
+        if (next == -1) parent[i] = k;
+        i = next;
+      }
+    }
+  }
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
+
+/* post[k] is the k-th node of a depth-first postorder of the tree */
+static PetscErrorCode MatSupernodalPostorder_Private(PetscInt n, const PetscInt parent[], PetscInt post[])
+{
+  PetscInt *head, *next, *stack, k = 0;
+
+  PetscFunctionBegin;
+  PetscCall(PetscMalloc3(n, &head, n, &next, n, &stack));
+  for (PetscInt j = 0; j < n; j++) head[j] = -1;
+  for (PetscInt j = n - 1; j >= 0; j--) {
+    if (parent[j] == -1) continue;
+    next[j]         = head[parent[j]];
+    head[parent[j]] = j;
+  }
+  for (PetscInt j = 0; j < n; j++) {
+    PetscInt top = 0;
+
+    if (parent[j] != -1) continue;
+    stack[0] = j;
+    while (top >= 0) {
+      PetscInt p = stack[top], c = head[p];
+
+      if (c == -1) {
+        top--;
+        post[k++] = p;
+      } else {
+        head[p]      = next[c];
+        stack[++top] = c;
+      }
+    }
+  }
+  PetscCall(PetscFree3(head, next, stack));
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
+
+/* whether a supernode of nc columns whose dense storage has the fraction z of explicit zeros is accepted, as in CHOLMOD */
+static inline PetscBool MatSupernodalRelax_Private(PetscInt nc, PetscReal z)
+{
+  return (PetscBool)(nc <= 4 || (nc <= 16 && z < 0.8) || (nc <= 48 && z < 0.1) || z < 0.05);
+}
+
+/*
+  The symbolic factorization, shared by LU and Cholesky: ai, aj is the nonzero structure of the matrix, of which only the upper
+  triangle is used for Cholesky, and rp, cp its row and column ordering, which is completed by a postorder of the elimination tree.
+*/
+static PetscErrorCode MatSupernodalSymbolic_Private(Mat F, PetscInt n, const PetscInt ai[], const PetscInt aj[], const PetscInt rp[], const PetscInt cp[])
+{
+  Mat_Supernodal *sn = (Mat_Supernodal *)F->data;
+  PetscInt       *rinv, *cinv, *gi, *gj, *parent, *work, *post, *count, *nchild, *fstart, *head, *next, *mark, *sstart, *snode;
+  PetscInt        nf = 0, ns = 0, gc = 0, gr = 0;
+  PetscReal       gz = 0.0;
+
+  PetscFunctionBegin;
+  /* postorder the elimination tree of the ordered matrix, which keeps its fill and makes its supernodes contiguous */
+  PetscCall(PetscMalloc3(n, &sn->rperm, n, &sn->cperm, n, &sn->rinv));
+  PetscCall(PetscMalloc5(n, &cinv, n, &parent, n, &work, n, &post, n, &count));
+  rinv = sn->rinv;
+  for (PetscInt k = 0; k < n; k++) {
+    rinv[rp[k]] = k;
+    cinv[cp[k]] = k;
+  }
+  PetscCall(MatSupernodalGraph_Private(n, ai, aj, sn->cholesky, rinv, cinv, &gi, &gj));
+  PetscCall(MatSupernodalEtree_Private(n, gi, gj, parent, work));
+  PetscCall(MatSupernodalPostorder_Private(n, parent, post));
+  PetscCall(PetscFree(gi));
+  PetscCall(PetscFree(gj));
+  for (PetscInt k = 0; k < n; k++) {
+    sn->rperm[k] = rp[post[k]];
+    sn->cperm[k] = cp[post[k]];
+  }
+  for (PetscInt k = 0; k < n; k++) {
+    rinv[sn->rperm[k]] = k;
+    cinv[sn->cperm[k]] = k;
+  }
+  PetscCall(MatSupernodalGraph_Private(n, ai, aj, sn->cholesky, rinv, cinv, &gi, &gj));
+  PetscCall(MatSupernodalEtree_Private(n, gi, gj, parent, work));
+
+  /* the number of nonzeros of each column of the factor, from the row subtrees of the elimination tree */
+  for (PetscInt k = 0; k < n; k++) {
+    count[k] = 1;
+    work[k]  = -1;
+  }
+  for (PetscInt i = 0; i < n; i++) {
+    work[i] = i;
+    for (PetscInt l = gi[i]; l < gi[i + 1]; l++) {
+      for (PetscInt j = gj[l]; j < i && work[j] != i; j = parent[j]) {
+        count[j]++;
+        work[j] = i;
+      }
+    }
+  }
+
+  /* the fundamental supernodes, merged in postorder with the following supernode when it is their parent and few zeros are added */
+  PetscCall(PetscMalloc3(n + 1, &fstart, n, &nchild, n, &mark));
+  PetscCall(PetscArrayzero(nchild, n));
+  for (PetscInt k = 0; k < n; k++)
+    if (parent[k] != -1) nchild[parent[k]]++;
+  for (PetscInt k = 0; k < n; k++) {
+    if (k && parent[k - 1] == k && count[k - 1] == count[k] + 1 && nchild[k] == 1) continue;
+    fstart[nf++] = k;
+  }
+  fstart[nf] = n;
+  PetscCall(PetscMalloc3(nf + 1, &sstart, n, &snode, nf + 1, &sn->sptr));
+  for (PetscInt s = 0; s < nf; s++) {
+    PetscInt  nc = fstart[s + 1] - fstart[s], nr = count[fstart[s]], p = s ? parent[fstart[s] - 1] : -1;
+    PetscReal nnz = 0.0;
+
+    for (PetscInt k = fstart[s]; k < fstart[s + 1]; k++) nnz += count[k];
+    if (p >= fstart[s] && p < fstart[s + 1]) {
+      /* the group of supernodes ending at column fstart[s] - 1 has its parent in s, the merged supernode has its rows */
+      PetscInt  mc = gc + nc, mr = gc + nr;
+      PetscReal mdense = (PetscReal)mc * mr - 0.5 * mc * (mc - 1), mz = mdense - nnz - ((PetscReal)gc * gr - 0.5 * gc * (gc - 1) - gz);
+
+      if (MatSupernodalRelax_Private(mc, mz / mdense)) {
+        gc = mc;
+        gr = mr;
+        gz = mz;
+        continue;
+      }
+    }
+    if (ns) nchild[ns - 1] = gr;
+    sstart[ns++] = fstart[s];
+    gc           = nc;
+    gr           = nr;
+    gz           = 0.0;
+  }
+  if (ns) nchild[ns - 1] = gr; /* the number of rows of each supernode */
+  sstart[ns] = n;
+  for (PetscInt s = 0; s < ns; s++) {
+    for (PetscInt k = sstart[s]; k < sstart[s + 1]; k++) snode[k] = s;
+  }
+
+  /* the rows below the diagonal block of each supernode: those of its columns in the graph and of its children supernodes */
+  PetscCall(PetscMalloc2(ns, &head, ns, &next));
+  for (PetscInt s = 0; s < ns; s++) head[s] = -1;
+  for (PetscInt s = ns - 1; s >= 0; s--) {
+    PetscInt p = parent[sstart[s + 1] - 1];
+
+    if (p == -1) continue;
+    next[s]         = head[snode[p]];
+    head[snode[p]] = s;
+  }
+  sn->sptr[0] = 0;
+  for (PetscInt s = 0; s < ns; s++) sn->sptr[s + 1] = sn->sptr[s] + nchild[s] - (sstart[s + 1] - sstart[s]);
+  PetscCall(PetscMalloc1(sn->sptr[ns], &sn->sind));
+  for (PetscInt k = 0; k < n; k++) mark[k] = -1;
+  for (PetscInt s = 0; s < ns; s++) {
+    PetscInt l = sstart[s + 1], cnt = sn->sptr[s], *ind = sn->sind;
+
+    for (PetscInt k = sstart[s]; k < l; k++) {
+      for (PetscInt g = gi[k]; g < gi[k + 1]; g++) {
+        if (gj[g] < l || mark[gj[g]] == s) continue;
+        mark[gj[g]] = s;
+        ind[cnt++]  = gj[g];
+      }
+    }
+    for (PetscInt c = head[s]; c != -1; c = next[c]) {
+      for (PetscInt g = sn->sptr[c]; g < sn->sptr[c + 1]; g++) {
+        if (ind[g] < l || mark[ind[g]] == s) continue;
+        mark[ind[g]] = s;
+        ind[cnt++]   = ind[g];
+      }
+    }
+    PetscCheck(cnt == sn->sptr[s + 1], PETSC_COMM_SELF, PETSC_ERR_PLIB, "Supernode %" PetscInt_FMT " has %" PetscInt_FMT " rows instead of %" PetscInt_FMT, s, cnt - sn->sptr[s], sn->sptr[s + 1] - sn->sptr[s]);
+    PetscCall(PetscSortInt(cnt - sn->sptr[s], ind + sn->sptr[s]));
+  }
+  PetscCall(PetscFree2(head, next));
+  PetscCall(PetscFree3(fstart, nchild, mark));
+  PetscCall(PetscFree(gi));
+  PetscCall(PetscFree(gj));
+
+  /* the layout of the dense panels, the L panel of a supernode with nc columns and nb rows below them has nc + nb rows and for LU
+     the U panel stores the transpose of the nc x nb block right of the diagonal block */
+  PetscCall(PetscMalloc2(ns, &sn->lptr, ns, &sn->uptr));
+  sn->nval  = 0;
+  sn->maxnb = 0;
+  sn->maxnc = 0;
+  for (PetscInt s = 0; s < ns; s++) {
+    PetscInt nc = sstart[s + 1] - sstart[s], nb = sn->sptr[s + 1] - sn->sptr[s];
+
+    sn->lptr[s] = sn->nval;
+    sn->nval += (PetscCount)(nc + nb) * nc;
+    sn->uptr[s] = sn->nval;
+    if (!sn->cholesky) sn->nval += (PetscCount)nb * nc;
+    sn->maxnb = PetscMax(sn->maxnb, nb);
+    sn->maxnc = PetscMax(sn->maxnc, nc);
+  }
+  PetscCall(PetscMalloc1(sn->nval, &sn->val));
+  PetscCall(PetscMalloc2(sn->maxnb, &sn->rel, (PetscCount)sn->maxnb * sn->maxnb, &sn->work));
+  if (!sn->cholesky) PetscCall(PetscMalloc1(n, &sn->ipiv));
+
+  /* the location in the panels of each nonzero of the matrix */
+  sn->nz = ai[n];
+  PetscCall(PetscMalloc1(sn->nz, &sn->amap));
+  for (PetscInt i = 0; i < n; i++) {
+    for (PetscInt k = ai[i]; k < ai[i + 1]; k++) {
+      PetscInt p = rinv[i], q = cinv[aj[k]], r, c, t, pos;
+
+      sn->amap[k] = -1;
+      if (sn->cholesky && aj[k] < i) continue;
+      /* the entries of the diagonal blocks and below them are in the L panels, the others in the U panels */
+      r = p;
+      c = q;
+      if (sn->cholesky && p < q) {
+        r = q;
+        c = p;
+      }
+      t = snode[c];
+      if (r >= sstart[t]) {
+        if (r < sstart[t + 1]) pos = r - sstart[t];
+        else {
+          PetscCall(PetscFindInt(r, sn->sptr[t + 1] - sn->sptr[t], sn->sind + sn->sptr[t], &pos));
+          pos += sstart[t + 1] - sstart[t];
+        }
+        sn->amap[k] = sn->lptr[t] + pos + (PetscCount)(c - sstart[t]) * (sn->sptr[t + 1] - sn->sptr[t] + sstart[t + 1] - sstart[t]);
+      } else {
+        t = snode[r];
+        PetscCall(PetscFindInt(c, sn->sptr[t + 1] - sn->sptr[t], sn->sind + sn->sptr[t], &pos));
+        sn->amap[k] = sn->uptr[t] + pos + (PetscCount)(r - sstart[t]) * (sn->sptr[t + 1] - sn->sptr[t]);
+      }
+    }
+  }
+  sn->nsuper = ns;
+  sn->sstart = sstart;
+  sn->snode  = snode;
+  PetscCall(PetscFree5(cinv, parent, work, post, count));
+  PetscCall(PetscInfo(F, "%" PetscInt_FMT " supernodes of up to %" PetscInt_FMT " columns, %" PetscCount_FMT " entries in the factors\n", ns, sn->maxnc, sn->nval));
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
+
+static PetscErrorCode MatSupernodalZeroPivot_Private(Mat F, Mat A, PetscInt row, PetscReal pv, PetscReal tol)
+{
+  PetscFunctionBegin;
+  PetscCheck(!A->erroriffailure, PETSC_COMM_SELF, PETSC_ERR_MAT_LU_ZRPVT, "Zero pivot row %" PetscInt_FMT " value %g tolerance %g", row, (double)pv, (double)tol);
+  PetscCall(PetscInfo(A, "Detected zero pivot in factorization in row %" PetscInt_FMT " value %g tolerance %g\n", row, (double)pv, (double)tol));
+  F->factorerrortype             = MAT_FACTOR_NUMERIC_ZEROPIVOT;
+  F->factorerror_zeropivot_value = pv;
+  F->factorerror_zeropivot_row   = row;
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
+
+/*
+  Right-looking supernodal factorization: each supernode, once all the updates of the previous ones were subtracted from its panels,
+  is factored and then subtracts its own update, a product of its panels, from the supernodes of the rows below its diagonal block.
+  The rows of a supernode form contiguous groups of columns of the later supernodes, so the update is computed group by group.
+*/
+static PetscErrorCode MatSupernodalNumeric_Private(Mat F, Mat A, const PetscInt ai[], const PetscInt aj[], const MatScalar aa[], const MatFactorInfo *info)
+{
+  Mat_Supernodal   *sn = (Mat_Supernodal *)F->data;
+  const PetscInt    n  = A->rmap->n, *sstart = sn->sstart, *snode = sn->snode, *sptr = sn->sptr, *sind = sn->sind, *rinv = sn->rinv;
+  const PetscScalar one = 1.0, zero = 0.0;
+  PetscScalar      *val = sn->val, *W = sn->work;
+  PetscLogDouble    flops = 0.0;
+
+  PetscFunctionBegin;
+  PetscCheck(ai[n] == sn->nz, PETSC_COMM_SELF, PETSC_ERR_ARG_WRONGSTATE, "The nonzero structure of the matrix changed since the symbolic factorization");
+  F->factorerrortype = MAT_FACTOR_NOERROR;
+  PetscCall(PetscArrayzero(val, sn->nval));
+  for (PetscInt i = 0; i < n; i++) {
+    for (PetscInt k = ai[i]; k < ai[i + 1]; k++) {
+      if (sn->amap[k] < 0) continue;
+      /* the Cholesky factor is computed from the lower triangle of the ordered matrix */
+      val[sn->amap[k]] = (sn->cholesky && rinv[i] < rinv[aj[k]]) ? PetscConj(aa[k]) : aa[k];
+    }
+  }
+
+  for (PetscInt s = 0; s < sn->nsuper; s++) {
+    const PetscInt f = sstart[s], *ind = sind + sptr[s];
+    PetscInt       nc = sstart[s + 1] - f, nb = sptr[s + 1] - sptr[s];
+    PetscScalar   *L = val + sn->lptr[s], *U = sn->cholesky ? L + nc : val + sn->uptr[s];
+    PetscBLASInt   bnc, bnb, bnr, ldu, binfo = 0;
+
+    PetscCall(PetscBLASIntCast(nc, &bnc));
+    PetscCall(PetscBLASIntCast(nb, &bnb));
+    PetscCall(PetscBLASIntCast(nc + nb, &bnr));
+    ldu = sn->cholesky ? bnr : PetscMax(bnb, 1);
+    /* factor the diagonal block and solve with it for the panels below and right of it */
+    if (sn->cholesky) {
+      PetscCallBLAS("LAPACKpotrf", LAPACKpotrf_("L", &bnc, L, &bnr, &binfo));
+      if (binfo > 0) {
+        PetscCall(MatSupernodalZeroPivot_Private(F, A, f + binfo - 1, PetscAbsScalar(L[(binfo - 1) * (nc + nb + 1)]), info->zeropivot));
+        break;
+      }
+      if (nb) PetscCallBLAS("BLAStrsm", BLAStrsm_("R", "L", "C", "N", &bnb, &bnc, &one, L, &bnr, L + nc, &bnr));
+      flops += nc * (PetscLogDouble)nc * nc / 3.0 + (PetscLogDouble)nb * nc * nc;
+    } else {
+      PetscBLASInt *ipiv = sn->ipiv + f;
+
+      PetscCallBLAS("LAPACKgetrf", LAPACKgetrf_(&bnc, &bnc, L, &bnr, ipiv, &binfo));
+      for (PetscInt k = 0; k < nc; k++) {
+        PetscReal pv = PetscAbsScalar(L[k * (nc + nb + 1)]);
+
+        if (pv <= info->zeropivot) {
+          PetscCall(MatSupernodalZeroPivot_Private(F, A, f + k, pv, info->zeropivot));
+          break;
+        }
+      }
+      if (F->factorerrortype) break;
+      /* the exchanged rows of the diagonal block are columns of the transposed U panel */
+      for (PetscInt k = 0; k < nc && nb; k++) {
+        if (ipiv[k] - 1 == k) continue;
+        for (PetscInt r = 0; r < nb; r++) {
+          PetscScalar t = U[r + k * nb];
+
+          U[r + k * nb]                = U[r + (ipiv[k] - 1) * nb];
+          U[r + (ipiv[k] - 1) * nb] = t;
+        }
+      }
+      if (nb) {
+        PetscCallBLAS("BLAStrsm", BLAStrsm_("R", "U", "N", "N", &bnb, &bnc, &one, L, &bnr, L + nc, &bnr));
+        PetscCallBLAS("BLAStrsm", BLAStrsm_("R", "L", "T", "U", &bnb, &bnc, &one, L, &bnr, U, &ldu));
+      }
+      flops += 2.0 * nc * (PetscLogDouble)nc * nc / 3.0 + 2.0 * nb * (PetscLogDouble)nc * nc;
+    }
+
+    /* subtract the update from the supernode t of each group ind[jb] to ind[je-1] of rows in the columns of t */
+    for (PetscInt jb = 0, je; jb < nb; jb = je) {
+      const PetscInt t = snode[ind[jb]], ft = sstart[t], nct = sstart[t + 1] - ft, nbt = sptr[t + 1] - sptr[t], *indt = sind + sptr[t];
+      const PetscInt m1 = nb - jb;
+      PetscScalar   *Lt = val + sn->lptr[t], *Ut = val + sn->uptr[t];
+      PetscInt       n1;
+      PetscBLASInt   bm1, bn1, bm2;
+
+      for (je = jb + 1; je < nb && ind[je] < ft + nct; je++);
+      n1 = je - jb;
+      /* the positions of the rows ind[jb] to ind[nb-1] in the panels of t, whose rows contain them */
+      for (PetscInt k = jb, q = 0; k < nb; k++) {
+        if (k < je) sn->rel[k - jb] = ind[k] - ft;
+        else {
+          while (indt[q] < ind[k]) q++;
+          sn->rel[k - jb] = nct + q;
+        }
+      }
+      PetscCall(PetscBLASIntCast(m1, &bm1));
+      PetscCall(PetscBLASIntCast(n1, &bn1));
+      /* W = L(rows jb:nb) U(jb:je) is subtracted from the columns of t, only its lower triangle for Cholesky */
+      PetscCallBLAS("BLASgemm", BLASgemm_("N", sn->cholesky ? "C" : "T", &bm1, &bn1, &bnc, &one, L + nc + jb, &bnr, U + jb, &ldu, &zero, W, &bm1));
+      for (PetscInt jj = 0; jj < n1; jj++) {
+        PetscScalar *Ltc = Lt + (PetscCount)(ind[jb + jj] - ft) * (nct + nbt);
+
+        for (PetscInt ii = sn->cholesky ? jj : 0; ii < m1; ii++) Ltc[sn->rel[ii]] -= W[ii + jj * m1];
+      }
+      flops += 2.0 * m1 * n1 * nc;
+      if (!sn->cholesky && je < nb) {
+        /* W = U(je:nb)^T L(rows jb:je)^T is the transpose of the update of the rows of t right of its diagonal block */
+        PetscCall(PetscBLASIntCast(nb - je, &bm2));
+        PetscCallBLAS("BLASgemm", BLASgemm_("N", "T", &bm2, &bn1, &bnc, &one, U + je, &ldu, L + nc + jb, &bnr, &zero, W, &bm2));
+        for (PetscInt jj = 0; jj < n1; jj++) {
+          PetscScalar *Utc = Ut + (PetscCount)(ind[jb + jj] - ft) * nbt - nct;
+
+          for (PetscInt ii = 0; ii < nb - je; ii++) Utc[sn->rel[n1 + ii]] -= W[ii + jj * (nb - je)];
+        }
+        flops += 2.0 * (nb - je) * n1 * nc;
+      }
+    }
+  }
+  PetscCall(PetscLogFlops(flops));
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
+
+/*
+  Solves with the factors for nrhs right-hand sides: the ordered right-hand sides are solved in place supernode by supernode, with a
+  triangular solve with the diagonal block and a product with the panel below or right of it.
+*/
+static PetscErrorCode MatSupernodalSolve_Private(Mat F, PetscInt nrhs, const PetscScalar *b, PetscInt ldb, PetscScalar *x, PetscInt ldx)
+{
+  Mat_Supernodal   *sn = (Mat_Supernodal *)F->data;
+  const PetscInt    n = F->rmap->n, *sstart = sn->sstart, *sptr = sn->sptr, *sind = sn->sind;
+  const PetscScalar one = 1.0, mone = -1.0, zero = 0.0;
+  PetscScalar      *X, *T;
+  PetscBLASInt      bn, bnrhs;
+
+  PetscFunctionBegin;
+  if (nrhs > sn->nrhs) {
+    PetscCall(PetscFree(sn->rhs));
+    PetscCall(PetscMalloc1((PetscCount)(n + sn->maxnb) * nrhs, &sn->rhs));
+    sn->nrhs = nrhs;
+  }
+  X = sn->rhs;
+  T = sn->rhs + (PetscCount)n * nrhs;
+  PetscCall(PetscBLASIntCast(n, &bn));
+  PetscCall(PetscBLASIntCast(nrhs, &bnrhs));
+  for (PetscInt c = 0; c < nrhs; c++) {
+    for (PetscInt k = 0; k < n; k++) X[k + c * n] = b[sn->rperm[k] + c * ldb];
+  }
+
+  for (PetscInt s = 0; s < sn->nsuper; s++) {
+    const PetscInt f = sstart[s], nc = sstart[s + 1] - f, nb = sptr[s + 1] - sptr[s], *ind = sind + sptr[s];
+    PetscScalar   *L = sn->val + sn->lptr[s], *Xs = X + f;
+    PetscBLASInt   bnc, bnb, bnr;
+
+    PetscCall(PetscBLASIntCast(nc, &bnc));
+    PetscCall(PetscBLASIntCast(nb, &bnb));
+    PetscCall(PetscBLASIntCast(nc + nb, &bnr));
+    if (!sn->cholesky) {
+      for (PetscInt k = 0; k < nc; k++) {
+        PetscInt p = sn->ipiv[f + k] - 1;
+
+        if (p == k) continue;
+        for (PetscInt c = 0; c < nrhs; c++) {
+          PetscScalar t = Xs[k + c * n];
+
+          Xs[k + c * n] = Xs[p + c * n];
+          Xs[p + c * n] = t;
+        }
+      }
+    }
+    PetscCallBLAS("BLAStrsm", BLAStrsm_("L", "L", "N", sn->cholesky ? "N" : "U", &bnc, &bnrhs, &one, L, &bnr, Xs, &bn));
+    if (!nb) continue;
+    PetscCallBLAS("BLASgemm", BLASgemm_("N", "N", &bnb, &bnrhs, &bnc, &one, L + nc, &bnr, Xs, &bn, &zero, T, &bnb));
+    for (PetscInt c = 0; c < nrhs; c++) {
+      for (PetscInt k = 0; k < nb; k++) X[ind[k] + c * n] -= T[k + c * nb];
+    }
+  }
+
+  for (PetscInt s = sn->nsuper - 1; s >= 0; s--) {
+    const PetscInt f = sstart[s], nc = sstart[s + 1] - f, nb = sptr[s + 1] - sptr[s], *ind = sind + sptr[s];
+    PetscScalar   *L = sn->val + sn->lptr[s], *U = sn->cholesky ? L + nc : sn->val + sn->uptr[s], *Xs = X + f;
+    PetscBLASInt   bnc, bnb, bnr, ldu;
+
+    PetscCall(PetscBLASIntCast(nc, &bnc));
+    PetscCall(PetscBLASIntCast(nb, &bnb));
+    PetscCall(PetscBLASIntCast(nc + nb, &bnr));
+    ldu = sn->cholesky ? bnr : bnb;
+    if (nb) {
+      for (PetscInt c = 0; c < nrhs; c++) {
+        for (PetscInt k = 0; k < nb; k++) T[k + c * nb] = X[ind[k] + c * n];
+      }
+      PetscCallBLAS("BLASgemm", BLASgemm_(sn->cholesky ? "C" : "T", "N", &bnc, &bnrhs, &bnb, &mone, U, &ldu, T, &bnb, &one, Xs, &bn));
+    }
+    PetscCallBLAS("BLAStrsm", BLAStrsm_("L", sn->cholesky ? "L" : "U", sn->cholesky ? "C" : "N", "N", &bnc, &bnrhs, &one, L, &bnr, Xs, &bn));
+  }
+
+  for (PetscInt c = 0; c < nrhs; c++) {
+    for (PetscInt k = 0; k < n; k++) x[sn->cperm[k] + c * ldx] = X[k + c * n];
+  }
+  PetscCall(PetscLogFlops(nrhs * (sn->cholesky ? 4.0 : 2.0) * (PetscLogDouble)sn->nval));
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
+
+static PetscErrorCode MatSolve_Supernodal(Mat F, Vec b, Vec x)
+{
+  const PetscScalar *barray;
+  PetscScalar       *xarray;
+
+  PetscFunctionBegin;
+  PetscCall(VecGetArrayRead(b, &barray));
+  PetscCall(VecGetArrayWrite(x, &xarray));
+  PetscCall(MatSupernodalSolve_Private(F, 1, barray, F->rmap->n, xarray, F->rmap->n));
+  PetscCall(VecRestoreArrayRead(b, &barray));
+  PetscCall(VecRestoreArrayWrite(x, &xarray));
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
+
+static PetscErrorCode MatMatSolve_Supernodal(Mat F, Mat B, Mat X)
+{
+  const PetscScalar *barray;
+  PetscScalar       *xarray;
+  PetscInt           ldb, ldx, nrhs;
+  PetscBool          flg;
+
+  PetscFunctionBegin;
+  PetscCall(PetscObjectTypeCompareAny((PetscObject)B, &flg, MATSEQDENSE, MATMPIDENSE, NULL));
+  PetscCheck(flg, PetscObjectComm((PetscObject)B), PETSC_ERR_ARG_WRONG, "Matrix B must be MATDENSE matrix");
+  PetscCall(PetscObjectTypeCompareAny((PetscObject)X, &flg, MATSEQDENSE, MATMPIDENSE, NULL));
+  PetscCheck(flg, PetscObjectComm((PetscObject)X), PETSC_ERR_ARG_WRONG, "Matrix X must be MATDENSE matrix");
+  PetscCall(MatGetSize(B, NULL, &nrhs));
+  PetscCall(MatDenseGetLDA(B, &ldb));
+  PetscCall(MatDenseGetLDA(X, &ldx));
+  PetscCall(MatDenseGetArrayRead(B, &barray));
+  PetscCall(MatDenseGetArrayWrite(X, &xarray));
+  PetscCall(MatSupernodalSolve_Private(F, nrhs, barray, ldb, xarray, ldx));
+  PetscCall(MatDenseRestoreArrayRead(B, &barray));
+  PetscCall(MatDenseRestoreArrayWrite(X, &xarray));
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
+
+static PetscErrorCode MatSupernodalSetSolveOps_Private(Mat F)
+{
+  Mat_Supernodal *sn = (Mat_Supernodal *)F->data;
+
+  PetscFunctionBegin;
+  F->ops->solve    = MatSolve_Supernodal;
+  F->ops->matsolve = MatMatSolve_Supernodal;
+  if (sn->cholesky && !PetscDefined(USE_COMPLEX)) F->ops->solvetranspose = MatSolve_Supernodal;
+  F->assembled    = PETSC_TRUE;
+  F->preallocated = PETSC_TRUE;
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
+
+static PetscErrorCode MatLUFactorNumeric_Supernodal(Mat F, Mat A, const MatFactorInfo *info)
+{
+  Mat_SeqAIJ      *a = (Mat_SeqAIJ *)A->data;
+  const MatScalar *aa;
+
+  PetscFunctionBegin;
+  PetscCall(MatSeqAIJGetArrayRead(A, &aa));
+  PetscCall(MatSupernodalNumeric_Private(F, A, a->i, a->j, aa, info));
+  PetscCall(MatSeqAIJRestoreArrayRead(A, &aa));
+  PetscCall(MatSupernodalSetSolveOps_Private(F));
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
+
+static PetscErrorCode MatCholeskyFactorNumeric_Supernodal(Mat F, Mat A, const MatFactorInfo *info)
+{
+  PetscBool sbaij;
+
+  PetscFunctionBegin;
+  PetscCall(PetscObjectTypeCompare((PetscObject)A, MATSEQSBAIJ, &sbaij));
+  if (sbaij) {
+    Mat_SeqSBAIJ *a = (Mat_SeqSBAIJ *)A->data;
+
+    PetscCall(MatSupernodalNumeric_Private(F, A, a->i, a->j, a->a, info));
+  } else {
+    Mat_SeqAIJ      *a = (Mat_SeqAIJ *)A->data;
+    const MatScalar *aa;
+
+    PetscCall(MatSeqAIJGetArrayRead(A, &aa));
+    PetscCall(MatSupernodalNumeric_Private(F, A, a->i, a->j, aa, info));
+    PetscCall(MatSeqAIJRestoreArrayRead(A, &aa));
+  }
+  PetscCall(MatSupernodalSetSolveOps_Private(F));
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
+
+static PetscErrorCode MatLUFactorSymbolic_Supernodal(Mat F, Mat A, IS r, IS c, const MatFactorInfo *info)
+{
+  Mat_SeqAIJ     *a = (Mat_SeqAIJ *)A->data;
+  const PetscInt *rp, *cp;
+
+  PetscFunctionBegin;
+  PetscCall(ISGetIndices(r, &rp));
+  PetscCall(ISGetIndices(c, &cp));
+  PetscCall(MatSupernodalSymbolic_Private(F, A->rmap->n, a->i, a->j, rp, cp));
+  PetscCall(ISRestoreIndices(r, &rp));
+  PetscCall(ISRestoreIndices(c, &cp));
+  F->ops->lufactornumeric = MatLUFactorNumeric_Supernodal;
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
+
+static PetscErrorCode MatCholeskyFactorSymbolic_Supernodal(Mat F, Mat A, IS perm, const MatFactorInfo *info)
+{
+  const PetscInt *pp;
+  PetscBool       sbaij;
+
+  PetscFunctionBegin;
+  PetscCall(PetscObjectTypeCompare((PetscObject)A, MATSEQSBAIJ, &sbaij));
+  PetscCall(ISGetIndices(perm, &pp));
+  if (sbaij) {
+    Mat_SeqSBAIJ *a = (Mat_SeqSBAIJ *)A->data;
+
+    PetscCall(MatSupernodalSymbolic_Private(F, A->rmap->n, a->i, a->j, pp, pp));
+  } else {
+    Mat_SeqAIJ *a = (Mat_SeqAIJ *)A->data;
+
+    PetscCall(MatSupernodalSymbolic_Private(F, A->rmap->n, a->i, a->j, pp, pp));
+  }
+  PetscCall(ISRestoreIndices(perm, &pp));
+  F->ops->choleskyfactornumeric = MatCholeskyFactorNumeric_Supernodal;
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
+
+static PetscErrorCode MatFactorGetSolverType_supernodal(Mat A, MatSolverType *type)
+{
+  PetscFunctionBegin;
+  *type = MATSOLVERSUPERNODAL;
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
+
+PETSC_INTERN PetscErrorCode MatGetFactor_seqaij_supernodal(Mat A, MatFactorType ftype, Mat *F)
+{
+  Mat             B;
+  Mat_Supernodal *sn;
+  PetscInt        n = A->rmap->n;
+
+  PetscFunctionBegin;
+  PetscCheck(ftype == MAT_FACTOR_LU || ftype == MAT_FACTOR_CHOLESKY, PETSC_COMM_SELF, PETSC_ERR_SUP, "Factor type not supported");
+  PetscCall(MatCreate(PetscObjectComm((PetscObject)A), &B));
+  PetscCall(MatSetSizes(B, n, n, n, n));
+  PetscCall(PetscStrallocpy("supernodal", &((PetscObject)B)->type_name));
+  PetscCall(MatSetUp(B));
+
+  PetscCall(PetscNew(&sn));
+  sn->cholesky                     = (PetscBool)(ftype == MAT_FACTOR_CHOLESKY);
+  B->data                          = sn;
+  B->ops->getinfo                  = MatGetInfo_Supernodal;
+  B->ops->destroy                  = MatDestroy_Supernodal;
+  B->ops->view                     = MatView_Supernodal;
+  B->ops->lufactorsymbolic         = MatLUFactorSymbolic_Supernodal;
+  B->ops->choleskyfactorsymbolic   = MatCholeskyFactorSymbolic_Supernodal;
+  B->factortype                    = ftype;
+  B->canuseordering                = PETSC_TRUE;
+  PetscCall(PetscStrallocpy(MATORDERINGND, (char **)&B->preferredordering[ftype]));
+
+  PetscCall(PetscFree(B->solvertype));
+  PetscCall(PetscStrallocpy(MATSOLVERSUPERNODAL, &B->solvertype));
+  PetscCall(PetscObjectComposeFunction((PetscObject)B, "MatFactorGetSolverType_C", MatFactorGetSolverType_supernodal));
+  *F = B;
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
+
+PETSC_INTERN PetscErrorCode MatGetFactor_seqsbaij_supernodal(Mat A, MatFactorType ftype, Mat *F)
+{
+  PetscFunctionBegin;
+  PetscCheck(A->rmap->bs == 1, PETSC_COMM_SELF, PETSC_ERR_SUP, "MATSOLVERSUPERNODAL requires block size 1 for MATSEQSBAIJ, not %" PetscInt_FMT, A->rmap->bs);
+  PetscCall(MatGetFactor_seqaij_supernodal(A, ftype, F));
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
@@ -213,6 +213,159 @@ static PetscErrorCode MatInvertBlockDiagonal_SeqBAIJ(Mat A, const PetscScalar **
   PetscFunctionReturn(PETSC_SUCCESS);
 }
 
+/* s = s - sum of A(i,j) y(j) over the blocks of block row i whose column has a color in [cmin, cmax] */
+static inline void MatSORColorRowUpdate_SeqBAIJ_Private(PetscInt bs, PetscInt i, const PetscInt ai[], const PetscInt aj[], const MatScalar aa[], const PetscInt color[], PetscInt cmin, PetscInt cmax, const PetscScalar y[], PetscScalar s[])
+{
+  const PetscInt bs2 = bs * bs;
+
+  for (PetscInt k = ai[i]; k < ai[i + 1]; k++) {
+    const PetscInt     cj = color[aj[k]];
+    const MatScalar   *v  = aa + bs2 * k;
+    const PetscScalar *yj = y + bs * aj[k];
+
+    if (cj < cmin || cj > cmax) continue;
+    for (PetscInt q = 0; q < bs; q++) {
+      for (PetscInt p = 0; p < bs; p++) s[p] -= v[p + q * bs] * yj[q];
+    }
+  }
+}
+
+/* x = (1 - omega) x + omega D^{-1} s for the block row i */
+static inline void MatSORColorRowRelax_SeqBAIJ_Private(PetscInt bs, const MatScalar idiag[], PetscReal omega, const PetscScalar s[], PetscScalar x[])
+{
+  for (PetscInt p = 0; p < bs; p++) {
+    PetscScalar sum = 0.0;
+
+    for (PetscInt q = 0; q < bs; q++) sum += idiag[p + q * bs] * s[q];
+    x[p] = (1. - omega) * x[p] + omega * sum;
+  }
+}
+
+/* one sweep of multicolor block SOR, the block rows of a color are relaxed concurrently; work holds a residual for each block row */
+static inline void MatSORColorSweep_SeqBAIJ_Private(const Mat_SORColors *sc, PetscBool backward, PetscInt bs, const PetscInt ai[], const PetscInt aj[], const MatScalar aa[], const MatScalar idiag[], PetscReal omega, const PetscScalar b[], PetscScalar x[], PetscScalar work[])
+{
+  PetscPragmaOMP(parallel)
+  for (PetscInt c = 0; c < sc->ncolors; c++) {
+    const PetscInt cc = backward ? sc->ncolors - 1 - c : c;
+
+    PetscPragmaOMP(for schedule(static))
+    for (PetscInt r = sc->ptr[cc]; r < sc->ptr[cc + 1]; r++) {
+      const PetscInt i = sc->rows[r];
+      PetscScalar   *s = work + bs * i;
+
+      for (PetscInt p = 0; p < bs; p++) s[p] = b[bs * i + p];
+      /* all blocks except the diagonal one, which is the only block of color cc */
+      MatSORColorRowUpdate_SeqBAIJ_Private(bs, i, ai, aj, aa, sc->color, 0, cc - 1, x, s);
+      MatSORColorRowUpdate_SeqBAIJ_Private(bs, i, ai, aj, aa, sc->color, cc + 1, sc->ncolors - 1, x, s);
+      MatSORColorRowRelax_SeqBAIJ_Private(bs, idiag + bs * bs * i, omega, s, x + bs * i);
+    }
+  }
+}
+
+/*
+   MatSOR_SeqBAIJ_Multicolor - block SOR of the matrix symmetrically permuted by the colors of a->sorcolors, so L and U are the blocks
+   whose block column has a smaller, respectively larger, color than the block row
+*/
+static PetscErrorCode MatSOR_SeqBAIJ_Multicolor(Mat A, Vec bb, PetscReal omega, MatSORType flag, PetscReal fshift, PetscInt its, Vec xx)
+{
+  Mat_SeqBAIJ         *a  = (Mat_SeqBAIJ *)A->data;
+  const Mat_SORColors *sc = &a->sorcolors;
+  const PetscInt       m = a->mbs, bs = A->rmap->bs, bs2 = bs * bs, nc = sc->ncolors, *ai = a->i, *aj = a->j, *diag = a->diag, *color = sc->color;
+  const MatScalar     *aa = a->a, *idiag;
+  const PetscScalar   *b;
+  PetscScalar         *x, *work, *t;
+  PetscInt             k;
+
+  PetscFunctionBegin;
+  PetscCheck(!fshift, PETSC_COMM_SELF, PETSC_ERR_SUP, "No support for diagonal shift");
+  PetscCheck(flag != SOR_APPLY_LOWER, PETSC_COMM_SELF, PETSC_ERR_SUP, "SOR_APPLY_LOWER is not implemented");
+  if (!a->idiagvalid) PetscCall(MatInvertBlockDiagonal(A, NULL));
+  idiag = a->idiag;
+  k     = PetscMax(A->rmap->n, A->cmap->n);
+  if (!a->mult_work) PetscCall(PetscMalloc1(k + 1, &a->mult_work));
+  if (!a->sor_workt) PetscCall(PetscMalloc1(k, &a->sor_workt));
+  work = a->mult_work;
+  t    = a->sor_workt;
+
+  PetscCall(VecGetArray(xx, &x));
+  PetscCall(VecGetArrayRead(bb, &b));
+  if (flag == SOR_APPLY_UPPER) {
+    /* apply (U + D/omega) to the vector */
+    PetscPragmaOMP(parallel for schedule(static))
+    for (PetscInt i = 0; i < m; i++) {
+      const MatScalar *d = aa + bs2 * diag[i];
+      PetscScalar     *s = work + bs * i;
+
+      /* s = -(D/omega) b - U b, then x = -s */
+      for (PetscInt p = 0; p < bs; p++) {
+        s[p] = 0.0;
+        for (PetscInt q = 0; q < bs; q++) s[p] -= d[p + q * bs] * b[bs * i + q] / omega;
+      }
+      MatSORColorRowUpdate_SeqBAIJ_Private(bs, i, ai, aj, aa, color, color[i] + 1, nc - 1, b, s);
+      for (PetscInt p = 0; p < bs; p++) x[bs * i + p] = -s[p];
+    }
+    PetscCall(PetscLogFlops(a->nz * bs2));
+  } else if (flag & SOR_EISENSTAT) {
+    const PetscScalar scale = (2.0 / omega) - 1.0;
+
+    /*  x = (E + U)^{-1} b */
+    PetscCall(PetscArrayzero(x, bs * m));
+    PetscPragmaOMP(parallel)
+    for (PetscInt c = nc - 1; c >= 0; c--) {
+      PetscPragmaOMP(for schedule(static))
+      for (PetscInt r = sc->ptr[c]; r < sc->ptr[c + 1]; r++) {
+        const PetscInt i = sc->rows[r];
+        PetscScalar   *s = work + bs * i;
+
+        for (PetscInt p = 0; p < bs; p++) s[p] = b[bs * i + p];
+        MatSORColorRowUpdate_SeqBAIJ_Private(bs, i, ai, aj, aa, color, c + 1, nc - 1, x, s);
+        MatSORColorRowRelax_SeqBAIJ_Private(bs, idiag + bs2 * i, omega, s, x + bs * i);
+      }
+    }
+    /*  t = b - (2*E - D)x */
+    for (PetscInt i = 0; i < m; i++) {
+      const MatScalar *d = aa + bs2 * diag[i];
+
+      for (PetscInt p = 0; p < bs; p++) {
+        t[bs * i + p] = b[bs * i + p];
+        for (PetscInt q = 0; q < bs; q++) t[bs * i + p] -= scale * d[p + q * bs] * x[bs * i + q];
+      }
+    }
+    /*  t = (E + L)^{-1}t and x = x + t */
+    PetscPragmaOMP(parallel)
+    for (PetscInt c = 0; c < nc; c++) {
+      PetscPragmaOMP(for schedule(static))
+      for (PetscInt r = sc->ptr[c]; r < sc->ptr[c + 1]; r++) {
+        const PetscInt i = sc->rows[r];
+        PetscScalar   *s = work + bs * i;
+
+        for (PetscInt p = 0; p < bs; p++) s[p] = t[bs * i + p];
+        MatSORColorRowUpdate_SeqBAIJ_Private(bs, i, ai, aj, aa, color, 0, c - 1, t, s);
+        for (PetscInt p = 0; p < bs; p++) t[bs * i + p] = 0.0;
+        MatSORColorRowRelax_SeqBAIJ_Private(bs, idiag + bs2 * i, omega, s, t + bs * i);
+        for (PetscInt p = 0; p < bs; p++) x[bs * i + p] += t[bs * i + p];
+      }
+    }
+    PetscCall(PetscLogFlops(2.0 * a->nz * bs2 + 2.0 * m * bs2));
+  } else {
+    /* with a zero initial guess the entries not yet relaxed do not contribute */
+    if (flag & SOR_ZERO_INITIAL_GUESS) PetscCall(PetscArrayzero(x, bs * m));
+    while (its--) {
+      if (flag & SOR_FORWARD_SWEEP || flag & SOR_LOCAL_FORWARD_SWEEP) {
+        MatSORColorSweep_SeqBAIJ_Private(sc, PETSC_FALSE, bs, ai, aj, aa, idiag, omega, b, x, work);
+        PetscCall(PetscLogFlops(2.0 * a->nz * bs2));
+      }
+      if (flag & SOR_BACKWARD_SWEEP || flag & SOR_LOCAL_BACKWARD_SWEEP) {
+        MatSORColorSweep_SeqBAIJ_Private(sc, PETSC_TRUE, bs, ai, aj, aa, idiag, omega, b, x, work);
+        PetscCall(PetscLogFlops(2.0 * a->nz * bs2));
+      }
+    }
+  }
+  PetscCall(VecRestoreArray(xx, &x));
+  PetscCall(VecRestoreArrayRead(bb, &b));
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
+
 static PetscErrorCode MatSOR_SeqBAIJ(Mat A, Vec bb, PetscReal omega, MatSORType flag, PetscReal fshift, PetscInt its, PetscInt lits, Vec xx)
 {
   Mat_SeqBAIJ       *a = (Mat_SeqBAIJ *)A->data;
@@ -225,6 +378,11 @@ static PetscErrorCode MatSOR_SeqBAIJ(Mat A, Vec bb, PetscReal omega, MatSORType
 
   PetscFunctionBegin;
   its = its * lits;
+  PetscCall(MatSORColorsSetUp_Private(A, m, ai, aj, &a->sorcolors));
+  if (a->sorcolors.ncolors) {
+    PetscCall(MatSOR_SeqBAIJ_Multicolor(A, bb, omega, flag, fshift, its, xx));
+    PetscFunctionReturn(PETSC_SUCCESS);
+  }
   PetscCheck(!(flag & SOR_EISENSTAT), PETSC_COMM_SELF, PETSC_ERR_SUP, "No support yet for Eisenstat");
   PetscCheck(its > 0, PETSC_COMM_SELF, PETSC_ERR_ARG_WRONG, "Relaxation requires global its %" PetscInt_FMT " and local its %" PetscInt_FMT " both positive", its, lits);
   PetscCheck(!fshift, PETSC_COMM_SELF, PETSC_ERR_SUP, "No support for diagonal shift");
@@ -1574,6 +1732,7 @@ PetscErrorCode MatDestroy_SeqBAIJ(Mat A)
   PetscCall(PetscFree(a->mult_work));
   PetscCall(PetscFree(a->sor_workt));
   PetscCall(PetscFree(a->sor_work));
+  PetscCall(MatSORColorsReset_Private(&a->sorcolors));
   PetscCall(ISDestroy(&a->icol));
   PetscCall(PetscFree(a->saved_values));
   PetscCall(PetscFree2(a->compressedrow.i, a->compressedrow.rindex));
@@ -1868,6 +2027,7 @@ static PetscErrorCode MatView_SeqBAIJ_ASCII(Mat A, PetscViewer viewer)
   PetscCall(PetscViewerGetFormat(viewer, &format));
   if (format == PETSC_VIEWER_ASCII_INFO || format == PETSC_VIEWER_ASCII_INFO_DETAIL) {
     PetscCall(PetscViewerASCIIPrintf(viewer, "  block size is %" PetscInt_FMT "\n", bs));
+    PetscCall(MatSORColorsView_Private(&a->sorcolors, viewer));
   } else if (format == PETSC_VIEWER_ASCII_MATLAB) {
     const char *matname;
     Mat         aij;
@@ -3122,7 +3282,8 @@ static struct _MatOps MatOps_Values = {MatSetValues_SeqBAIJ,
                                        NULL,
                                        NULL,
                                        /*150*/ NULL,
-                                       MatEliminateZeros_SeqBAIJ};
+                                       MatEliminateZeros_SeqBAIJ,
+                                       MatMultDot_SeqBAIJ};
 
 static PetscErrorCode MatStoreValues_SeqBAIJ(Mat mat)
 {
@@ -2031,6 +2031,48 @@ PetscErrorCode MatMult_SeqBAIJ_N(Mat A, Vec xx, Vec zz)
   PetscFunctionReturn(PETSC_SUCCESS);
 }
 
+/* y = A x with (x,y), ||x|| and ||y|| accumulated block row by block row, for square A */
+PetscErrorCode MatMultDot_SeqBAIJ(Mat A, Vec xx, Vec yy, PetscScalar *xdoty, PetscReal *xnorm, PetscReal *ynorm)
+{
+  Mat_SeqBAIJ       *a = (Mat_SeqBAIJ *)A->data;
+  PetscScalar       *y, *z, dot = 0.0;
+  const PetscScalar *x, *xb;
+  const MatScalar   *v  = a->a;
+  const PetscInt    *ii = a->i, *idx = a->j;
+  PetscInt           mbs = a->mbs, bs = A->rmap->bs, bs2 = a->bs2;
+  PetscReal          xx2 = 0.0, yy2 = 0.0;
+
+  PetscFunctionBegin;
+  PetscCall(VecGetArrayRead(xx, &x));
+  PetscCall(VecGetArrayWrite(yy, &y));
+  for (PetscInt i = 0; i < mbs; i++) {
+    z = y + bs * i;
+    for (PetscInt r = 0; r < bs; r++) z[r] = 0.0;
+    for (PetscInt j = ii[i]; j < ii[i + 1]; j++) {
+      xb = x + bs * idx[j];
+      /* the blocks are stored by columns */
+      for (PetscInt c = 0; c < bs; c++) {
+        for (PetscInt r = 0; r < bs; r++) z[r] += v[c * bs + r] * xb[c];
+      }
+      v += bs2;
+    }
+    for (PetscInt r = 0; r < bs; r++) {
+      const PetscScalar xr = x[bs * i + r];
+
+      dot += xr * PetscConj(z[r]);
+      xx2 += PetscRealPart(xr * PetscConj(xr));
+      yy2 += PetscRealPart(z[r] * PetscConj(z[r]));
+    }
+  }
+  PetscCall(VecRestoreArrayRead(xx, &x));
+  PetscCall(VecRestoreArrayWrite(yy, &y));
+  PetscCall(PetscLogFlops(2.0 * a->nz * bs2 - bs * a->nonzerorowcnt + 6.0 * A->rmap->n));
+  *xdoty = dot;
+  *xnorm = PetscSqrtReal(xx2);
+  *ynorm = PetscSqrtReal(yy2);
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
+
 PetscErrorCode MatMultAdd_SeqBAIJ_1(Mat A, Vec xx, Vec yy, Vec zz)
 {
   Mat_SeqBAIJ       *a = (Mat_SeqBAIJ *)A->data;
@@ -307,6 +307,79 @@ static PetscErrorCode MatILUFactorSymbolic_SeqBAIJ_ilu0(Mat fact, Mat A, IS isro
   PetscFunctionReturn(PETSC_SUCCESS);
 }
 
+static PetscErrorCode MatILUDTFactorNumeric_SeqBAIJ(Mat fact, Mat A, const MatFactorInfo *info)
+{
+  Mat_SeqBAIJ    *a = (Mat_SeqBAIJ *)A->data, *b = (Mat_SeqBAIJ *)fact->data;
+  const PetscInt *r, *ic;
+  PetscInt        reallocs;
+  PetscBool       row_identity, col_identity;
+
+  PetscFunctionBegin;
+  PetscCall(PetscFree(b->a));
+  PetscCall(PetscFree(b->j));
+  PetscCall(ISGetIndices(b->row, &r));
+  PetscCall(ISGetIndices(b->icol, &ic));
+  PetscCall(MatILUDTFactor_Private(fact, a->mbs, A->rmap->bs, a->i, a->j, a->a, r, ic, info, b->i, b->diag, &b->j, &b->a, NULL, &reallocs));
+  PetscCall(ISRestoreIndices(b->row, &r));
+  PetscCall(ISRestoreIndices(b->icol, &ic));
+  b->maxnz = b->nz = b->diag[0] + 1;
+
+  fact->info.factor_mallocs    = reallocs;
+  fact->info.fill_ratio_needed = ((PetscReal)b->nz) / ((PetscReal)PetscMax(a->nz, 1));
+  PetscCall(PetscInfo(A, "Reallocs %" PetscInt_FMT " Fill ratio:given %g needed %g\n", reallocs, (double)info->fill, (double)fact->info.fill_ratio_needed));
+
+  PetscCall(ISIdentity(b->row, &row_identity));
+  PetscCall(ISIdentity(b->icol, &col_identity));
+  if (row_identity && col_identity) fact->ops->solve = MatSolve_SeqBAIJ_N_NaturalOrdering;
+  else fact->ops->solve = MatSolve_SeqBAIJ_N;
+  fact->ops->solvetranspose = MatSolveTranspose_SeqBAIJ_N;
+  fact->assembled           = PETSC_TRUE;
+  fact->preallocated        = PETSC_TRUE;
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
+
+/*
+  The threshold ILU with blocks, used by MatILUFactorSymbolic_SeqBAIJ() when a drop tolerance is set with PCFactorSetDropTolerance(). The
+  blocks are dropped by their Frobenius norm, and there is no column pivoting. The nonzero structure of the factors is computed by each
+  numerical factorization.
+*/
+static PetscErrorCode MatILUDTFactorSymbolic_SeqBAIJ(Mat fact, Mat A, IS isrow, IS iscol, const MatFactorInfo *info)
+{
+  Mat_SeqBAIJ *b;
+  PetscInt     n = ((Mat_SeqBAIJ *)A->data)->mbs, bs = A->rmap->bs;
+  IS           isicol;
+
+  PetscFunctionBegin;
+  PetscCall(ISInvertPermutation(iscol, PETSC_DECIDE, &isicol));
+  PetscCall(MatSeqBAIJSetPreallocation(fact, bs, MAT_SKIP_ALLOCATION, NULL));
+  b               = (Mat_SeqBAIJ *)fact->data;
+  b->free_a       = PETSC_TRUE;
+  b->free_ij      = PETSC_TRUE;
+  b->singlemalloc = PETSC_FALSE;
+
+  PetscCall(PetscMalloc1(n + 1, &b->i));
+  PetscCall(PetscMalloc1(n + 1, &b->diag));
+  b->a         = NULL;
+  b->j         = NULL;
+  b->free_diag = PETSC_TRUE;
+  b->ilen      = NULL;
+  b->imax      = NULL;
+  b->row       = isrow;
+  b->col       = iscol;
+  PetscCall(PetscObjectReference((PetscObject)isrow));
+  PetscCall(PetscObjectReference((PetscObject)iscol));
+  b->icol = isicol;
+  PetscCall(PetscMalloc1(bs * n + bs, &b->solve_work));
+  b->maxnz = b->nz = 0;
+
+  fact->factortype             = MAT_FACTOR_ILU;
+  fact->info.factor_mallocs    = 0;
+  fact->info.fill_ratio_given  = info->fill;
+  fact->info.fill_ratio_needed = 0.0;
+  fact->ops->lufactornumeric   = MatILUDTFactorNumeric_SeqBAIJ;
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
+
 PetscErrorCode MatILUFactorSymbolic_SeqBAIJ(Mat fact, Mat A, IS isrow, IS iscol, const MatFactorInfo *info)
 {
   Mat_SeqBAIJ       *a = (Mat_SeqBAIJ *)A->data, *b;
@@ -331,6 +404,10 @@ PetscErrorCode MatILUFactorSymbolic_SeqBAIJ(Mat fact, Mat A, IS isrow, IS iscol,
   if (bs > 1) { /* check shifttype */
     PetscCheck(info->shifttype != (PetscReal)MAT_SHIFT_NONZERO && info->shifttype != (PetscReal)MAT_SHIFT_POSITIVE_DEFINITE, PETSC_COMM_SELF, PETSC_ERR_SUP, "Only MAT_SHIFT_NONE and MAT_SHIFT_INBLOCKS are supported for BAIJ matrix");
   }
+  if (info->usedt) {
+    PetscCall(MatILUDTFactorSymbolic_SeqBAIJ(fact, A, isrow, iscol, info));
+    PetscFunctionReturn(PETSC_SUCCESS);
+  }
 
   PetscCall(MatMissingDiagonal(A, &missing, &d));
   PetscCheck(!missing, PETSC_COMM_SELF, PETSC_ERR_ARG_WRONGSTATE, "Matrix is missing diagonal entry %" PetscInt_FMT, d);
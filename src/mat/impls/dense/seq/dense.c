@@ -8,6 +8,7 @@
 #include <../src/mat/impls/dense/mpi/mpidense.h>
 #include <petscblaslapack.h>
 #include <../src/mat/impls/aij/seq/aij.h>
+#include <petsc/private/viewerimpl.h>
 
 PetscErrorCode MatSeqDenseSymmetrize_Private(Mat A, PetscBool hermitian)
 {
@@ -1395,14 +1396,20 @@ PetscErrorCode MatLoad_Dense_Binary(Mat mat, PetscViewer viewer)
   PetscCall(MatDenseGetArray(mat, &v));
   PetscCall(MatDenseGetLDA(mat, &lda));
   if (nz == MATRIX_BINARY_FORMAT_DENSE) { /* matrix in file is dense format */
-    PetscInt nnz = m * N;
-    /* read in matrix values */
-    PetscCall(PetscMalloc1(nnz, &vwork));
-    PetscCall(PetscViewerBinaryReadAll(viewer, vwork, nnz, PETSC_DETERMINE, PETSC_DETERMINE, PETSC_SCALAR));
+    PetscInt     nnz = m * N;
+    PetscScalar *vmap;
+    /* read in matrix values, the file is row major so with -viewer_binary_mmap the values are only copied from the mapped file */
+    PetscCall(PetscViewerBinaryReadMMap_Private(viewer, nnz, PETSC_SCALAR, (void **)&vmap, NULL));
+    if (vmap) {
+      vwork = vmap;
+    } else {
+      PetscCall(PetscMalloc1(nnz, &vwork));
+      PetscCall(PetscViewerBinaryReadAll(viewer, vwork, nnz, PETSC_DETERMINE, PETSC_DETERMINE, PETSC_SCALAR));
+    }
     /* store values in column major order */
     for (j = 0; j < N; j++)
       for (i = 0; i < m; i++) v[i + lda * j] = vwork[i * N + j];
-    PetscCall(PetscFree(vwork));
+    if (!vmap) PetscCall(PetscFree(vwork));
   } else { /* matrix in file is sparse format */
     PetscInt nnz = 0, *rlens, *icols;
     /* read in row lengths */
@@ -3242,6 +3249,7 @@ static struct _MatOps MatOps_Values = {MatSetValues_SeqDense,
                                        NULL,
                                        NULL,
                                        /*150*/ NULL,
+                                       NULL,
                                        NULL};
 
 /*@C
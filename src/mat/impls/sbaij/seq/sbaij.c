@@ -194,6 +194,7 @@ PetscErrorCode MatDestroy_SeqSBAIJ(Mat A)
   PetscCall(PetscFree(a->inode.size));
   if (a->free_imax_ilen) PetscCall(PetscFree2(a->imax, a->ilen));
   PetscCall(PetscFree(a->solve_work));
+  for (PetscInt k = 0; k < 2; k++) PetscCall(MatSolveLevelsReset_Private(&a->solvelevels[k]));
   PetscCall(PetscFree(a->sor_work));
   PetscCall(PetscFree(a->solves_work));
   PetscCall(PetscFree(a->mult_work));
@@ -365,6 +366,13 @@ static PetscErrorCode MatView_SeqSBAIJ_ASCII(Mat A, PetscViewer viewer)
   PetscCall(PetscViewerGetFormat(viewer, &format));
   if (format == PETSC_VIEWER_ASCII_INFO || format == PETSC_VIEWER_ASCII_INFO_DETAIL) {
     PetscCall(PetscViewerASCIIPrintf(viewer, "  block size is %" PetscInt_FMT "\n", bs));
+    if (a->solvelevels[0].nlevels) {
+      PetscCall(PetscViewerASCIIPrintf(viewer, "level scheduled triangular solves\n"));
+      PetscCall(PetscViewerASCIIPushTab(viewer));
+      PetscCall(MatSolveLevelsView_Private(&a->solvelevels[0], "U^T", viewer));
+      PetscCall(MatSolveLevelsView_Private(&a->solvelevels[1], "U", viewer));
+      PetscCall(PetscViewerASCIIPopTab(viewer));
+    }
   } else if (format == PETSC_VIEWER_ASCII_MATLAB) {
     Mat aij;
 
@@ -1429,7 +1437,8 @@ static struct _MatOps MatOps_Values = {MatSetValues_SeqSBAIJ,
                                        NULL,
                                        NULL,
                                        /*150*/ NULL,
-                                       MatEliminateZeros_SeqSBAIJ};
+                                       MatEliminateZeros_SeqSBAIJ,
+                                       NULL};
 
 static PetscErrorCode MatStoreValues_SeqSBAIJ(Mat mat)
 {
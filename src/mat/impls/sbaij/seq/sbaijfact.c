@@ -1478,6 +1478,7 @@ PetscErrorCode MatCholeskyFactorNumeric_SeqSBAIJ_1_NaturalOrdering(Mat B, Mat A,
 
   B->assembled    = PETSC_TRUE;
   B->preallocated = PETSC_TRUE;
+  PetscCall(MatSeqSBAIJSolveLevelsSetUp_Private(B));
 
   PetscCall(PetscLogFlops(B->rmap->n));
 
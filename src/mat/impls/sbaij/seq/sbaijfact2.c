@@ -1714,6 +1714,81 @@ PetscErrorCode MatSolve_SeqSBAIJ_1(Mat A, Vec bb, Vec xx)
   PetscFunctionReturn(PETSC_SUCCESS);
 }
 
+/*
+   Level scheduled MatSolve() for the bs=1 factor U^T D U, a->solvelevels[0] and a->solvelevels[1] are the level sets of
+   the forward sweep with U^T and the backward sweep with U
+*/
+static PetscErrorCode MatSolve_SeqSBAIJ_1_Levels(Mat A, Vec bb, Vec xx)
+{
+  Mat_SeqSBAIJ          *a     = (Mat_SeqSBAIJ *)A->data;
+  const Mat_SolveLevels *lower = &a->solvelevels[0], *upper = &a->solvelevels[1];
+  const PetscInt         mbs = a->mbs, *ai = a->i, *aj = a->j, *adiag = a->diag;
+  const PetscInt        *rp;
+  const MatScalar       *aa = a->a;
+  const PetscScalar     *b;
+  PetscScalar           *x, *t = a->solve_work;
+
+  PetscFunctionBegin;
+  PetscCall(VecGetArrayRead(bb, &b));
+  PetscCall(VecGetArray(xx, &x));
+  PetscCall(ISGetIndices(a->row, &rp));
+
+  PetscPragmaOMP(parallel)
+  {
+    /* solve U^T*D*y = perm(b) by forward substitution */
+    for (PetscInt l = 0; l < lower->nlevels; l++) {
+      PetscPragmaOMP(for schedule(static))
+      for (PetscInt s = lower->ptr[l]; s < lower->ptr[l + 1]; s++) {
+        const PetscInt k  = lower->rows[s];
+        PetscScalar    xk = b[rp[k]];
+
+        for (PetscInt j = lower->i[k]; j < lower->i[k + 1]; j++) xk += aa[lower->idx[j]] * t[lower->j[j]];
+        t[k] = xk;
+      }
+    }
+    PetscPragmaOMP(for schedule(static))
+    for (PetscInt k = 0; k < mbs; k++) t[k] *= aa[adiag[k]]; /* aa[adiag[k]] = 1/D(k) */
+
+    /* solve U*perm(x) = y by back substitution */
+    for (PetscInt l = 0; l < upper->nlevels; l++) {
+      PetscPragmaOMP(for schedule(static))
+      for (PetscInt s = upper->ptr[l]; s < upper->ptr[l + 1]; s++) {
+        const PetscInt k  = upper->rows[s];
+        PetscScalar    xk = t[k];
+
+        for (PetscInt j = ai[k]; j < adiag[k]; j++) xk += aa[j] * t[aj[j]];
+        x[rp[k]] = t[k] = xk;
+      }
+    }
+  }
+
+  PetscCall(ISRestoreIndices(a->row, &rp));
+  PetscCall(VecRestoreArrayRead(bb, &b));
+  PetscCall(VecRestoreArray(xx, &x));
+  PetscCall(PetscLogFlops(4.0 * a->nz - 3.0 * mbs));
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
+
+/*
+   MatSeqSBAIJSolveLevelsSetUp_Private - Computes the level sets of the triangular solves of a numerically factored bs=1 matrix
+   and switches MatSolve() to the level scheduled version
+*/
+PetscErrorCode MatSeqSBAIJSolveLevelsSetUp_Private(Mat C)
+{
+  Mat_SeqSBAIJ *b = (Mat_SeqSBAIJ *)C->data;
+  PetscBool     use;
+
+  PetscFunctionBegin;
+  for (PetscInt k = 0; k < 2; k++) PetscCall(MatSolveLevelsReset_Private(&b->solvelevels[k]));
+  PetscCall(MatSolveLevelsUse_Private(C, &use));
+  if (!use || C->rmap->bs > 1) PetscFunctionReturn(PETSC_SUCCESS);
+  PetscCall(MatSolveLevelsCreate_Private(b->mbs, b->i, b->diag, b->j, PETSC_FALSE, PETSC_TRUE, &b->solvelevels[0]));
+  PetscCall(MatSolveLevelsCreate_Private(b->mbs, b->i, b->diag, b->j, PETSC_TRUE, PETSC_FALSE, &b->solvelevels[1]));
+  C->ops->solve          = MatSolve_SeqSBAIJ_1_Levels;
+  C->ops->solvetranspose = MatSolve_SeqSBAIJ_1_Levels;
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
+
 PetscErrorCode MatSolve_SeqSBAIJ_1_inplace(Mat A, Vec bb, Vec xx)
 {
   Mat_SeqSBAIJ      *a     = (Mat_SeqSBAIJ *)A->data;
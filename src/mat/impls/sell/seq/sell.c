@@ -529,6 +529,48 @@ PetscErrorCode MatMult_SeqSELL(Mat A, Vec xx, Vec yy)
   PetscFunctionReturn(PETSC_SUCCESS);
 }
 
+/* y = A x with (x,y), ||x|| and ||y|| accumulated slice by slice, for square A */
+PetscErrorCode MatMultDot_SeqSELL(Mat A, Vec xx, Vec yy, PetscScalar *xdoty, PetscReal *xnorm, PetscReal *ynorm)
+{
+  Mat_SeqSELL       *a = (Mat_SeqSELL *)A->data;
+  PetscScalar       *y, *sum, dot = 0.0;
+  const PetscScalar *x;
+  const MatScalar   *aval        = a->val;
+  const PetscInt    *acolidx     = a->colidx;
+  PetscInt           totalslices = a->totalslices, sliceheight = a->sliceheight, m = A->rmap->n;
+  PetscReal          xx2 = 0.0, yy2 = 0.0;
+
+  PetscFunctionBegin;
+  PetscCall(VecGetArrayRead(xx, &x));
+  PetscCall(VecGetArrayWrite(yy, &y));
+  PetscCall(PetscMalloc1(sliceheight, &sum));
+  for (PetscInt i = 0; i < totalslices; i++) { /* loop over slices */
+    PetscInt nrows = PetscMin(sliceheight, m - sliceheight * i); /* the last slice may have padding rows */
+
+    for (PetscInt j = 0; j < sliceheight; j++) {
+      sum[j] = 0.0;
+      for (PetscInt k = a->sliidx[i] + j; k < a->sliidx[i + 1]; k += sliceheight) sum[j] += aval[k] * x[acolidx[k]];
+    }
+    for (PetscInt j = 0; j < nrows; j++) {
+      const PetscInt    row = sliceheight * i + j;
+      const PetscScalar xr  = x[row];
+
+      y[row] = sum[j];
+      dot += xr * PetscConj(sum[j]);
+      xx2 += PetscRealPart(xr * PetscConj(xr));
+      yy2 += PetscRealPart(sum[j] * PetscConj(sum[j]));
+    }
+  }
+  PetscCall(PetscFree(sum));
+  PetscCall(PetscLogFlops(2.0 * a->nz - a->nonzerorowcnt + 6.0 * m));
+  PetscCall(VecRestoreArrayRead(xx, &x));
+  PetscCall(VecRestoreArrayWrite(yy, &y));
+  *xdoty = dot;
+  *xnorm = PetscSqrtReal(xx2);
+  *ynorm = PetscSqrtReal(yy2);
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
+
 #include <../src/mat/impls/aij/seq/ftn-kernels/fmultadd.h>
 PetscErrorCode MatMultAdd_SeqSELL(Mat A, Vec xx, Vec yy, Vec zz)
 {
@@ -1938,7 +1980,8 @@ static struct _MatOps MatOps_Values = {MatSetValues_SeqSELL,
                                        NULL,
                                        NULL,
                                        /*150*/ NULL,
-                                       NULL};
+                                       NULL,
+                                       MatMultDot_SeqSELL};
 
 static PetscErrorCode MatStoreValues_SeqSELL(Mat mat)
 {
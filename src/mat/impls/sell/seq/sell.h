@@ -190,6 +190,7 @@ static inline PetscErrorCode MatSeqXSELLFreeSELL(Mat AA, MatScalar **val, PetscI
 
 PETSC_INTERN PetscErrorCode MatSeqSELLSetPreallocation_SeqSELL(Mat, PetscInt, const PetscInt[]);
 PETSC_INTERN PetscErrorCode MatMult_SeqSELL(Mat, Vec, Vec);
+PETSC_INTERN PetscErrorCode MatMultDot_SeqSELL(Mat, Vec, Vec, PetscScalar *, PetscReal *, PetscReal *);
 PETSC_INTERN PetscErrorCode MatMultAdd_SeqSELL(Mat, Vec, Vec, Vec);
 PETSC_INTERN PetscErrorCode MatMultTranspose_SeqSELL(Mat, Vec, Vec);
 PETSC_INTERN PetscErrorCode MatMultTransposeAdd_SeqSELL(Mat, Vec, Vec, Vec);
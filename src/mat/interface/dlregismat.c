@@ -3,7 +3,7 @@
 */
 #include <petsc/private/matimpl.h>
 
-const char *MatOptions_Shifted[] = {"UNUSED_NONZERO_LOCATION_ERR", "ROW_ORIENTED", "NOT_A_VALID_OPTION", "SYMMETRIC", "STRUCTURALLY_SYMMETRIC", "FORCE_DIAGONAL_ENTRIES", "IGNORE_OFF_PROC_ENTRIES", "USE_HASH_TABLE", "KEEP_NONZERO_PATTERN", "IGNORE_ZERO_ENTRIES", "USE_INODES", "HERMITIAN", "SYMMETRY_ETERNAL", "NEW_NONZERO_LOCATION_ERR", "IGNORE_LOWER_TRIANGULAR", "ERROR_LOWER_TRIANGULAR", "GETROW_UPPERTRIANGULAR", "SPD", "NO_OFF_PROC_ZERO_ROWS", "NO_OFF_PROC_ENTRIES", "NEW_NONZERO_LOCATIONS", "NEW_NONZERO_ALLOCATION_ERR", "SUBSET_OFF_PROC_ENTRIES", "SUBMAT_SINGLEIS", "STRUCTURE_ONLY", "SORTED_FULL", "FORM_EXPLICIT_TRANSPOSE", "STRUCTURAL_SYMMETRY_ETERNAL", "SPD_ETERNAL", "MatOption", "MAT_", NULL};
+const char *MatOptions_Shifted[] = {"UNUSED_NONZERO_LOCATION_ERR", "ROW_ORIENTED", "NOT_A_VALID_OPTION", "SYMMETRIC", "STRUCTURALLY_SYMMETRIC", "FORCE_DIAGONAL_ENTRIES", "IGNORE_OFF_PROC_ENTRIES", "USE_HASH_TABLE", "KEEP_NONZERO_PATTERN", "IGNORE_ZERO_ENTRIES", "USE_INODES", "HERMITIAN", "SYMMETRY_ETERNAL", "NEW_NONZERO_LOCATION_ERR", "IGNORE_LOWER_TRIANGULAR", "ERROR_LOWER_TRIANGULAR", "GETROW_UPPERTRIANGULAR", "SPD", "NO_OFF_PROC_ZERO_ROWS", "NO_OFF_PROC_ENTRIES", "NEW_NONZERO_LOCATIONS", "NEW_NONZERO_ALLOCATION_ERR", "SUBSET_OFF_PROC_ENTRIES", "SUBMAT_SINGLEIS", "STRUCTURE_ONLY", "SORTED_FULL", "FORM_EXPLICIT_TRANSPOSE", "STRUCTURAL_SYMMETRY_ETERNAL", "SPD_ETERNAL", "THREADED_ASSEMBLY", "MatOption", "MAT_", NULL};
 const char *const *MatOptions                  = MatOptions_Shifted + 2;
 const char *const  MatFactorShiftTypes[]       = {"NONE", "NONZERO", "POSITIVE_DEFINITE", "INBLOCKS", "MatFactorShiftType", "PC_FACTOR_", NULL};
 const char *const  MatStructures[]             = {"DIFFERENT", "SUBSET", "SAME", "UNKNOWN", "MatStructure", "MAT_STRUCTURE_", NULL};
@@ -129,6 +129,9 @@ PETSC_INTERN PetscErrorCode MatGetFactor_seqdense_hip(Mat, MatFactorType, Mat *)
 #endif
 PETSC_INTERN PetscErrorCode MatGetFactor_constantdiagonal_petsc(Mat, MatFactorType, Mat *);
 PETSC_INTERN PetscErrorCode MatGetFactor_seqaij_bas(Mat, MatFactorType, Mat *);
+PETSC_INTERN PetscErrorCode MatGetFactor_seqaij_parilu(Mat, MatFactorType, Mat *);
+PETSC_INTERN PetscErrorCode MatGetFactor_seqaij_supernodal(Mat, MatFactorType, Mat *);
+PETSC_INTERN PetscErrorCode MatGetFactor_seqsbaij_supernodal(Mat, MatFactorType, Mat *);
 
 #include <petscbm.h>
 PETSC_INTERN PetscErrorCode PetscBenchCreate_HPL(PetscBench);
@@ -169,6 +172,7 @@ PetscErrorCode MatInitializePackage(void)
   PetscCall(MatSeqAIJRegisterAll());
   /* Register Events */
   PetscCall(PetscLogEventRegister("MatMult", MAT_CLASSID, &MAT_Mult));
+  PetscCall(PetscLogEventRegister("MatMultDot", MAT_CLASSID, &MAT_MultDot));
   PetscCall(PetscLogEventRegister("MatMultAdd", MAT_CLASSID, &MAT_MultAdd));
   PetscCall(PetscLogEventRegister("MatMultTranspose", MAT_CLASSID, &MAT_MultTranspose));
   PetscCall(PetscLogEventRegister("MatMultHermitian", MAT_CLASSID, &MAT_MultHermitianTranspose));
@@ -265,6 +269,7 @@ PetscErrorCode MatInitializePackage(void)
   PetscCall(PetscLogEventRegister("MatDenseCopyTo", MAT_CLASSID, &MAT_DenseCopyToGPU));
   PetscCall(PetscLogEventRegister("MatDenseCopyFrom", MAT_CLASSID, &MAT_DenseCopyFromGPU));
   PetscCall(PetscLogEventRegister("MatSetValBatch", MAT_CLASSID, &MAT_SetValuesBatch));
+  PetscCall(PetscLogEventRegister("MatAutotune", MAT_CLASSID, &MAT_Autotune));
 
   PetscCall(PetscLogEventRegister("MatColoringApply", MAT_COLORING_CLASSID, &MATCOLORING_Apply));
   PetscCall(PetscLogEventRegister("MatColoringComm", MAT_COLORING_CLASSID, &MATCOLORING_Comm));
@@ -284,6 +289,7 @@ PetscErrorCode MatInitializePackage(void)
   /* Mark non-collective events */
   PetscCall(PetscLogEventSetCollective(MAT_SetValues, PETSC_FALSE));
   PetscCall(PetscLogEventSetCollective(MAT_SetValuesBatch, PETSC_FALSE));
+  PetscCall(PetscLogEventSetCollective(MAT_Autotune, PETSC_FALSE));
   PetscCall(PetscLogEventSetCollective(MAT_GetRow, PETSC_FALSE));
   /* Turn off high traffic events by default */
   PetscCall(PetscLogEventSetActiveAll(MAT_SetValues, PETSC_FALSE));
@@ -371,6 +377,11 @@ PetscErrorCode MatInitializePackage(void)
 #endif
 
   PetscCall(MatSolverTypeRegister(MATSOLVERBAS, MATSEQAIJ, MAT_FACTOR_ICC, MatGetFactor_seqaij_bas));
+  PetscCall(MatSolverTypeRegister(MATSOLVERPARILU, MATSEQAIJ, MAT_FACTOR_ILU, MatGetFactor_seqaij_parilu));
+  PetscCall(MatSolverTypeRegister(MATSOLVERPARILU, MATSEQAIJ, MAT_FACTOR_ICC, MatGetFactor_seqaij_parilu));
+  PetscCall(MatSolverTypeRegister(MATSOLVERSUPERNODAL, MATSEQAIJ, MAT_FACTOR_LU, MatGetFactor_seqaij_supernodal));
+  PetscCall(MatSolverTypeRegister(MATSOLVERSUPERNODAL, MATSEQAIJ, MAT_FACTOR_CHOLESKY, MatGetFactor_seqaij_supernodal));
+  PetscCall(MatSolverTypeRegister(MATSOLVERSUPERNODAL, MATSEQSBAIJ, MAT_FACTOR_CHOLESKY, MatGetFactor_seqsbaij_supernodal));
 
   /*
      Register the external package factorization based solvers
@@ -40,6 +40,16 @@ PETSC_EXTERN PetscErrorCode MatCreate_MPIAIJPERM(Mat);
 PETSC_EXTERN PetscErrorCode MatCreate_SeqAIJSELL(Mat);
 PETSC_EXTERN PetscErrorCode MatCreate_MPIAIJSELL(Mat);
 
+PETSC_EXTERN PetscErrorCode MatCreate_SeqAIJOMP(Mat);
+PETSC_EXTERN PetscErrorCode MatCreate_SeqAIJDelta(Mat);
+PETSC_EXTERN PetscErrorCode MatCreate_SeqAIJAuto(Mat);
+PETSC_EXTERN PetscErrorCode MatCreate_SeqAIJMerge(Mat);
+
+#if !defined(PETSC_USE_COMPLEX)
+PETSC_EXTERN PetscErrorCode MatCreate_SeqAIJMixed(Mat);
+PETSC_EXTERN PetscErrorCode MatCreate_MPIAIJMixed(Mat);
+#endif
+
 #if defined(PETSC_HAVE_MKL_SPARSE)
 PETSC_EXTERN PetscErrorCode MatCreate_SeqAIJMKL(Mat);
 PETSC_EXTERN PetscErrorCode MatCreate_MPIAIJMKL(Mat);
@@ -152,6 +162,17 @@ PetscErrorCode MatRegisterAll(void)
   PetscCall(MatRegister(MATMPIAIJSELL, MatCreate_MPIAIJSELL));
   PetscCall(MatRegister(MATSEQAIJSELL, MatCreate_SeqAIJSELL));
 
+  PetscCall(MatRegister(MATSEQAIJOMP, MatCreate_SeqAIJOMP));
+  PetscCall(MatRegister(MATSEQAIJDELTA, MatCreate_SeqAIJDelta));
+  PetscCall(MatRegister(MATSEQAIJAUTO, MatCreate_SeqAIJAuto));
+  PetscCall(MatRegister(MATSEQAIJMERGE, MatCreate_SeqAIJMerge));
+
+#if !defined(PETSC_USE_COMPLEX)
+  PetscCall(MatRegisterRootName(MATAIJMIXED, MATSEQAIJMIXED, MATMPIAIJMIXED));
+  PetscCall(MatRegister(MATMPIAIJMIXED, MatCreate_MPIAIJMixed));
+  PetscCall(MatRegister(MATSEQAIJMIXED, MatCreate_SeqAIJMixed));
+#endif
+
 #if defined(PETSC_HAVE_MKL_SPARSE)
   PetscCall(MatRegisterRootName(MATAIJMKL, MATSEQAIJMKL, MATMPIAIJMKL));
   PetscCall(MatRegister(MATMPIAIJMKL, MatCreate_MPIAIJMKL));
@@ -14,7 +14,7 @@ PetscClassId MAT_COLORING_CLASSID;
 PetscClassId MAT_FDCOLORING_CLASSID;
 PetscClassId MAT_TRANSPOSECOLORING_CLASSID;
 
-PetscLogEvent MAT_Mult, MAT_MultAdd, MAT_MultTranspose;
+PetscLogEvent MAT_Mult, MAT_MultDot, MAT_MultAdd, MAT_MultTranspose;
 PetscLogEvent MAT_MultTransposeAdd, MAT_Solve, MAT_Solves, MAT_SolveAdd, MAT_SolveTranspose, MAT_MatSolve, MAT_MatTrSolve;
 PetscLogEvent MAT_SolveTransposeAdd, MAT_SOR, MAT_ForwardSolve, MAT_BackwardSolve, MAT_LUFactor, MAT_LUFactorSymbolic;
 PetscLogEvent MAT_LUFactorNumeric, MAT_CholeskyFactor, MAT_CholeskyFactorSymbolic, MAT_CholeskyFactorNumeric, MAT_ILUFactor;
@@ -37,6 +37,7 @@ PetscLogEvent MAT_CUSPARSECopyToGPU, MAT_CUSPARSECopyFromGPU, MAT_CUSPARSEGenera
 PetscLogEvent MAT_HIPSPARSECopyToGPU, MAT_HIPSPARSECopyFromGPU, MAT_HIPSPARSEGenerateTranspose, MAT_HIPSPARSESolveAnalysis;
 PetscLogEvent MAT_PreallCOO, MAT_SetVCOO;
 PetscLogEvent MAT_SetValuesBatch;
+PetscLogEvent MAT_Autotune;
 PetscLogEvent MAT_ViennaCLCopyToGPU;
 PetscLogEvent MAT_CUDACopyToGPU;
 PetscLogEvent MAT_DenseCopyToGPU, MAT_DenseCopyFromGPU;
@@ -1217,8 +1218,9 @@ PETSC_UNUSED static int TV_display_type(const struct _p_Mat *mat)
             or some related function before a call to `MatLoad()`
 - viewer - `PETSCVIEWERBINARY`/`PETSCVIEWERHDF5` file viewer
 
-  Options Database Key:
-. -matload_block_size <bs> - set block size
+  Options Database Keys:
++ -matload_block_size <bs>  - set block size
+- -matload_balance_nonzeros - for `MATMPIAIJ` with unset local sizes, distribute the rows to balance the nonzeros, see `MatLoadSetRowWeightFunction()`
 
   Level: beginner
 
@@ -1319,7 +1321,7 @@ $    save example.mat A b -v7.3
 
   See MATLAB Documentation on `save()`, <https://www.mathworks.com/help/matlab/ref/save.html#btox10b-1-version>
 
-.seealso: [](ch_matrices), `Mat`, `PetscViewerBinaryOpen()`, `PetscViewerSetType()`, `MatView()`, `VecLoad()`
+.seealso: [](ch_matrices), `Mat`, `PetscViewerBinaryOpen()`, `PetscViewerSetType()`, `MatView()`, `VecLoad()`, `MatLoadSetRowWeightFunction()`
  @*/
 PetscErrorCode MatLoad(Mat mat, PetscViewer viewer)
 {
@@ -1414,6 +1416,7 @@ PetscErrorCode MatDestroy(Mat *A)
   for (PetscInt i = 0; i < MAT_FACTOR_NUM_TYPES; i++) PetscCall(PetscFree((*A)->preferredordering[i]));
   if ((*A)->redundant && (*A)->redundant->matseq[0] == *A) (*A)->redundant->matseq[0] = NULL;
   PetscCall(MatDestroy_Redundant(&(*A)->redundant));
+  PetscCall(MatThreadedAssemblyDestroy_Private(&(*A)->threadedassembly));
   PetscCall(MatProductClear(*A));
   PetscCall(MatNullSpaceDestroy(&(*A)->nullsp));
   PetscCall(MatNullSpaceDestroy(&(*A)->transnullsp));
@@ -1505,6 +1508,10 @@ PetscErrorCode MatSetValues(Mat mat, PetscInt m, const PetscInt idxm[], PetscInt
     mat->was_assembled = PETSC_TRUE;
     mat->assembled     = PETSC_FALSE;
   }
+  if (mat->threadedassembly) { /* staged for the calling thread, without logging */
+    PetscCall(MatThreadedAssemblySetValues_Private(mat, m, idxm, n, idxn, v));
+    PetscFunctionReturn(PETSC_SUCCESS);
+  }
   PetscCall(PetscLogEventBegin(MAT_SetValues, mat, 0, 0, 0));
   PetscUseTypeMethod(mat, setvalues, m, idxm, n, idxn, v, addv);
   PetscCall(PetscLogEventEnd(MAT_SetValues, mat, 0, 0, 0));
@@ -2024,7 +2031,7 @@ PetscErrorCode MatSetValuesBlocked(Mat mat, PetscInt m, const PetscInt idxm[], P
     mat->assembled     = PETSC_FALSE;
   }
   PetscCall(PetscLogEventBegin(MAT_SetValues, mat, 0, 0, 0));
-  if (mat->ops->setvaluesblocked) {
+  if (mat->ops->setvaluesblocked && !mat->threadedassembly) {
     PetscUseTypeMethod(mat, setvaluesblocked, m, idxm, n, idxn, v, addv);
   } else {
     PetscInt buf[8192], *bufr = NULL, *bufc = NULL, *iidxm, *iidxn;
@@ -2400,7 +2407,7 @@ PetscErrorCode MatSetValuesLocal(Mat mat, PetscInt nrow, const PetscInt irow[],
     mat->assembled     = PETSC_FALSE;
   }
   PetscCall(PetscLogEventBegin(MAT_SetValues, mat, 0, 0, 0));
-  if (mat->ops->setvalueslocal) PetscUseTypeMethod(mat, setvalueslocal, nrow, irow, ncol, icol, y, addv);
+  if (mat->ops->setvalueslocal && !mat->threadedassembly) PetscUseTypeMethod(mat, setvalueslocal, nrow, irow, ncol, icol, y, addv);
   else {
     PetscInt        buf[8192], *bufr = NULL, *bufc = NULL;
     const PetscInt *irowm, *icolm;
@@ -2497,7 +2504,7 @@ PetscErrorCode MatSetValuesBlockedLocal(Mat mat, PetscInt nrow, const PetscInt i
     PetscCheck(cbs == icbs, PetscObjectComm((PetscObject)mat), PETSC_ERR_SUP, "Different col block sizes! mat %" PetscInt_FMT ", col l2g map %" PetscInt_FMT, cbs, icbs);
   }
   PetscCall(PetscLogEventBegin(MAT_SetValues, mat, 0, 0, 0));
-  if (mat->ops->setvaluesblockedlocal) PetscUseTypeMethod(mat, setvaluesblockedlocal, nrow, irow, ncol, icol, y, addv);
+  if (mat->ops->setvaluesblockedlocal && !mat->threadedassembly) PetscUseTypeMethod(mat, setvaluesblockedlocal, nrow, irow, ncol, icol, y, addv);
   else {
     PetscInt        buf[8192], *bufr = NULL, *bufc = NULL;
     const PetscInt *irowm, *icolm;
@@ -2582,7 +2589,7 @@ PetscErrorCode MatMultDiagonalBlock(Mat mat, Vec x, Vec y)
   The vectors `x` and `y` cannot be the same.  I.e., one cannot
   call `MatMult`(A,y,y).
 
-.seealso: [](ch_matrices), `Mat`, `MatMultTranspose()`, `MatMultAdd()`, `MatMultTransposeAdd()`
+.seealso: [](ch_matrices), `Mat`, `MatMultTranspose()`, `MatMultAdd()`, `MatMultTransposeAdd()`, `MatMultDot()`
 @*/
 PetscErrorCode MatMult(Mat mat, Vec x, Vec y)
 {
@@ -2612,6 +2619,86 @@ PetscErrorCode MatMult(Mat mat, Vec x, Vec y)
   PetscFunctionReturn(PETSC_SUCCESS);
 }
 
+/*@
+  MatMultDot - Computes the matrix-vector product, $y = Ax$, together with the inner product of `x` and `y` and the norms
+  of `x` and `y`, in a single pass over the vectors when the matrix type supports it.
+
+  Neighbor-wise Collective
+
+  Input Parameters:
++ mat - the matrix
+- x   - the vector to be multiplied
+
+  Output Parameters:
++ y     - the result
+. xdoty - the value of `VecDot()` of `x` and `y`, that is $y^H x$, or `NULL` if not needed
+. xnorm - the 2-norm of `x`, or `NULL` if not needed
+- ynorm - the 2-norm of `y`, or `NULL` if not needed
+
+  Level: advanced
+
+  Notes:
+  The vectors `x` and `y` cannot be the same.
+
+  The inner product and the norm of `x` require the rows and columns of `mat` to have the same parallel layout.
+
+  For `MATSEQAIJ`, `MATMPIAIJ`, `MATSEQBAIJ`, `MATSEQSELL`, and `MATSEQAIJSELL` the inner products are accumulated as the
+  entries of `y` are computed, which saves reading `x` and `y` again from memory. Other matrix types compute the product
+  with `MatMult()` and then the inner products with a single reduction. The results may differ from those of `VecDot()`
+  and `VecNorm()` in the last bits since the summation order differs.
+
+.seealso: [](ch_matrices), `Mat`, `MatMult()`, `VecDot()`, `VecNorm()`
+@*/
+PetscErrorCode MatMultDot(Mat mat, Vec x, Vec y, PetscScalar *xdoty, PetscReal *xnorm, PetscReal *ynorm)
+{
+  PetscScalar dot;
+  PetscReal   xn, yn;
+  PetscBool   same;
+
+  PetscFunctionBegin;
+  PetscValidHeaderSpecific(mat, MAT_CLASSID, 1);
+  PetscValidType(mat, 1);
+  PetscValidHeaderSpecific(x, VEC_CLASSID, 2);
+  VecCheckAssembled(x);
+  PetscValidHeaderSpecific(y, VEC_CLASSID, 3);
+  if (xdoty) PetscAssertPointer(xdoty, 4);
+  if (xnorm) PetscAssertPointer(xnorm, 5);
+  if (ynorm) PetscAssertPointer(ynorm, 6);
+  /* The two paths do not reduce the same way; comparing the layouts, which hold the ranges of all processes, makes every process take the same one */
+  PetscCall(PetscLayoutCompare(mat->rmap, mat->cmap, &same));
+  if (!mat->ops->multdot || !same) {
+    PetscCall(MatMult(mat, x, y));
+    if (xdoty) PetscCall(VecDotBegin(x, y, xdoty));
+    if (xnorm) PetscCall(VecNormBegin(x, NORM_2, xnorm));
+    if (ynorm) PetscCall(VecNormBegin(y, NORM_2, ynorm));
+    if (xdoty) PetscCall(VecDotEnd(x, y, xdoty));
+    if (xnorm) PetscCall(VecNormEnd(x, NORM_2, xnorm));
+    if (ynorm) PetscCall(VecNormEnd(y, NORM_2, ynorm));
+    PetscFunctionReturn(PETSC_SUCCESS);
+  }
+  PetscCheck(mat->assembled, PetscObjectComm((PetscObject)mat), PETSC_ERR_ARG_WRONGSTATE, "Not for unassembled matrix");
+  PetscCheck(!mat->factortype, PetscObjectComm((PetscObject)mat), PETSC_ERR_ARG_WRONGSTATE, "Not for factored matrix");
+  PetscCheck(x != y, PetscObjectComm((PetscObject)mat), PETSC_ERR_ARG_WRONGSTATE, "x and y must be different vectors");
+  PetscCheck(mat->cmap->N == x->map->N, PetscObjectComm((PetscObject)mat), PETSC_ERR_ARG_SIZ, "Mat mat,Vec x: global dim %" PetscInt_FMT " %" PetscInt_FMT, mat->cmap->N, x->map->N);
+  PetscCheck(mat->rmap->N == y->map->N, PetscObjectComm((PetscObject)mat), PETSC_ERR_ARG_SIZ, "Mat mat,Vec y: global dim %" PetscInt_FMT " %" PetscInt_FMT, mat->rmap->N, y->map->N);
+  PetscCheck(mat->cmap->n == x->map->n, PETSC_COMM_SELF, PETSC_ERR_ARG_SIZ, "Mat mat,Vec x: local dim %" PetscInt_FMT " %" PetscInt_FMT, mat->cmap->n, x->map->n);
+  PetscCheck(mat->rmap->n == y->map->n, PETSC_COMM_SELF, PETSC_ERR_ARG_SIZ, "Mat mat,Vec y: local dim %" PetscInt_FMT " %" PetscInt_FMT, mat->rmap->n, y->map->n);
+  PetscCall(VecSetErrorIfLocked(y, 3));
+  if (mat->erroriffailure) PetscCall(VecValidValues_Internal(x, 2, PETSC_TRUE));
+  MatCheckPreallocated(mat, 1);
+
+  PetscCall(VecLockReadPush(x));
+  PetscCall(PetscLogEventBegin(MAT_MultDot, mat, x, y, 0));
+  PetscUseTypeMethod(mat, multdot, x, y, &dot, &xn, &yn);
+  PetscCall(PetscLogEventEnd(MAT_MultDot, mat, x, y, 0));
+  if (mat->erroriffailure) PetscCall(VecValidValues_Internal(y, 3, PETSC_FALSE));
+  PetscCall(VecLockReadPop(x));
+  if (xdoty) *xdoty = dot;
+  if (xnorm) *xnorm = xn;
+  if (ynorm) *ynorm = yn;
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
+
 /*@
   MatMultTranspose - Computes matrix transpose times a vector $y = A^T * x$.
 
@@ -5704,6 +5791,7 @@ PetscErrorCode MatAssemblyBegin(Mat mat, MatAssemblyType type)
   PetscValidType(mat, 1);
   MatCheckPreallocated(mat, 1);
   PetscCheck(!mat->factortype, PetscObjectComm((PetscObject)mat), PETSC_ERR_ARG_WRONGSTATE, "Not for factored matrix.\nDid you forget to call MatSetUnfactored()?");
+  if (mat->threadedassembly) PetscCall(MatThreadedAssemblyMerge_Private(mat, type));
   if (mat->assembled) {
     mat->was_assembled = PETSC_TRUE;
     mat->assembled     = PETSC_FALSE;
@@ -5816,6 +5904,10 @@ PetscErrorCode MatAssemblyEnd(Mat mat, MatAssemblyType type)
       }
     }
     if (mat->nullsp && mat->checknullspaceonassembly) PetscCall(MatNullSpaceTest(mat->nullsp, mat, NULL));
+    if (mat->detectblocksize && mat->detectblocksizestate != mat->nonzerostate) {
+      mat->detectblocksizestate = mat->nonzerostate;
+      PetscCall(MatDetectBlockSize_Private(mat));
+    }
   }
   inassm--;
   PetscFunctionReturn(PETSC_SUCCESS);
@@ -5866,9 +5958,10 @@ PetscErrorCode MatAssemblyEnd(Mat mat, MatAssemblyType type)
 . `MAT_NO_OFF_PROC_ENTRIES`         - you know each process will only set values for its own rows, will generate an error if
         any process sets values for another process. This avoids all reductions in the MatAssembly routines and thus improves
         performance for very large process counts.
-- `MAT_SUBSET_OFF_PROC_ENTRIES`     - you know that the first assembly after setting this flag will set a superset
+. `MAT_SUBSET_OFF_PROC_ENTRIES`     - you know that the first assembly after setting this flag will set a superset
         of the off-process entries required for all subsequent assemblies. This avoids a rendezvous step in the MatAssembly
         functions, instead sending only neighbor messages.
+- `MAT_THREADED_ASSEMBLY`           - values are set concurrently by OpenMP threads, see below
 
   Level: intermediate
 
@@ -5932,6 +6025,13 @@ PetscErrorCode MatAssemblyEnd(Mat mat, MatAssemblyType type)
   single call to `MatSetValues()`, preallocation is perfect, row oriented, `INSERT_VALUES` is used. Common
   with finite difference schemes with non-periodic boundary conditions.
 
+  `MAT_THREADED_ASSEMBLY` - `MatSetValues()`, `MatSetValuesBlocked()`, `MatSetValuesLocal()`, and `MatSetValuesBlockedLocal()` can be
+  called concurrently from OpenMP threads. Each thread stages its entries in its own buffer and `MatAssemblyBegin()` merges them
+  with `MatSetPreallocationCOO()` and `MatSetValuesCOO()`, see `MatSetPreallocationCOO()` for the meaning of repeated entries.
+  The nonzero structure of the matrix is the one of the staged entries; when the same entries are staged in the same order
+  at the next assembly the COO preallocation is reused. Values are row oriented. Requires PETSc configured with `--with-threadsafety`
+  to insert from several threads, `MAT_FLUSH_ASSEMBLY` is not supported.
+
   Developer Note:
   `MAT_SYMMETRY_ETERNAL`, `MAT_STRUCTURAL_SYMMETRY_ETERNAL`, and `MAT_SPD_ETERNAL` are used by `MatAssemblyEnd()` and in other
   places where otherwise the value of `MAT_SYMMETRIC`, `MAT_STRUCTURALLY_SYMMETRIC` or `MAT_SPD` would need to be changed back
@@ -6019,6 +6119,10 @@ PetscErrorCode MatSetOption(Mat mat, MatOption op, PetscBool flg)
   case MAT_SORTED_FULL:
     mat->sortedfull = flg;
     break;
+  case MAT_THREADED_ASSEMBLY:
+    if (flg && !mat->threadedassembly) PetscCall(MatThreadedAssemblyCreate_Private(mat, &mat->threadedassembly));
+    else if (!flg) PetscCall(MatThreadedAssemblyDestroy_Private(&mat->threadedassembly));
+    PetscFunctionReturn(PETSC_SUCCESS);
   default:
     break;
   }
@@ -6083,6 +6187,9 @@ PetscErrorCode MatGetOption(Mat mat, MatOption op, PetscBool *flg)
   case MAT_STRUCTURAL_SYMMETRY_ETERNAL:
     *flg = mat->symmetry_eternal;
     break;
+  case MAT_THREADED_ASSEMBLY:
+    *flg = mat->threadedassembly ? PETSC_TRUE : PETSC_FALSE;
+    break;
   default:
     break;
   }
@@ -7458,6 +7565,12 @@ PetscErrorCode MatGetBlockSizes(Mat mat, PetscInt *rbs, PetscInt *cbs)
 + mat - the matrix
 - bs  - block size
 
+  Options Database Keys:
++ -mat_detect_block_size         - for `MATSEQAIJ` and `MATMPIAIJ` matrices without a block size, detect the largest block size of the nonzero structure in `MatAssemblyEnd()`,
+                                   or else inode-like variable blocks set with `MatSetVariableBlockSizes()`; use `-info` to see the detected structure
+- -mat_detect_block_size_convert - convert a matrix with a detected block size in place to `MATBAIJ`, or to `MATSBAIJ` if it is set symmetric or SPD with
+                                   `MAT_SYMMETRY_ETERNAL` or `MAT_SPD_ETERNAL`, to use the block kernels
+
   Level: intermediate
 
   Notes:
@@ -7467,6 +7580,9 @@ PetscErrorCode MatGetBlockSizes(Mat mat, PetscInt *rbs, PetscInt *cbs)
   For `MATAIJ` matrix format, this function can be called at a later stage, provided that the specified block size
   is compatible with the matrix local sizes.
 
+  After the conversion to `MATSBAIJ` by `-mat_detect_block_size_convert` the values set below the diagonal are ignored, which is why
+  it requires the symmetry to be declared eternal; a matrix that is only found symmetric is converted to `MATBAIJ`.
+
 .seealso: [](ch_matrices), `Mat`, `MATBAIJ`, `MATSBAIJ`, `MATAIJ`, `MatCreateSeqBAIJ()`, `MatCreateBAIJ()`, `MatGetBlockSize()`, `MatSetBlockSizes()`, `MatGetBlockSizes()`
 @*/
 PetscErrorCode MatSetBlockSize(Mat mat, PetscInt bs)
@@ -579,6 +579,13 @@ int main(int argc, char **argv)
        nsize: 1
        args: -m 5 -n 5 -o 5 -stencil 3d27point -matmatmult_via rowmerge
 
+ test:
+      suffix: threaded
+      nsize: 1
+      env: OMP_NUM_THREADS=2
+      args: -m 5 -n 5 -o 5 -stencil 3d27point -matmatmult_via threaded
+      output_file: output/ex226_2.out
+
  test:
       suffix: 3
       nsize: 4
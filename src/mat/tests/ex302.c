@@ -0,0 +1,102 @@
+static char help[] = "Tests MatMultDot() against MatMult(), VecDot() and VecNorm().\n\
+  -n <n> : number of grid points in each direction\n\n";
+
+#include <petscmat.h>
+
+int main(int argc, char **args)
+{
+  Mat         A;
+  Vec         x, y, z;
+  PetscInt    n = 7, N, Istart, Iend, bs = 1;
+  PetscScalar dot, xdoty;
+  PetscReal   xnorm, ynorm, xn, yn, err, tol = 100 * PETSC_MACHINE_EPSILON;
+  PetscRandom rand;
+
+  PetscFunctionBeginUser;
+  PetscCall(PetscInitialize(&argc, &args, (char *)0, help));
+  PetscCall(PetscOptionsGetInt(NULL, NULL, "-n", &n, NULL));
+  PetscCall(PetscOptionsGetInt(NULL, NULL, "-mat_block_size", &bs, NULL));
+  N = bs * n * n;
+
+  /* a nonsymmetric five point stencil, with bs unknowns per grid point coupled within each point */
+  PetscCall(MatCreate(PETSC_COMM_WORLD, &A));
+  PetscCall(MatSetSizes(A, PETSC_DECIDE, PETSC_DECIDE, N, N));
+  PetscCall(MatSetBlockSize(A, bs));
+  PetscCall(MatSetFromOptions(A));
+  PetscCall(MatSetUp(A));
+  PetscCall(MatGetOwnershipRange(A, &Istart, &Iend));
+  for (PetscInt row = Istart; row < Iend; row++) {
+    PetscInt    p = row / bs, c = row % bs, i = p / n, j = p % n;
+    PetscScalar v;
+
+    for (PetscInt c2 = 0; c2 < bs; c2++) {
+      v = (c2 == c) ? 4.0 : 0.5;
+      PetscCall(MatSetValue(A, row, bs * p + c2, v, INSERT_VALUES));
+    }
+    if (i > 0) PetscCall(MatSetValue(A, row, row - bs * n, -1.0, INSERT_VALUES));
+    if (i < n - 1) PetscCall(MatSetValue(A, row, row + bs * n, -1.5, INSERT_VALUES));
+    if (j > 0) PetscCall(MatSetValue(A, row, row - bs, -0.75, INSERT_VALUES));
+    if (j < n - 1) PetscCall(MatSetValue(A, row, row + bs, -1.25, INSERT_VALUES));
+  }
+  PetscCall(MatAssemblyBegin(A, MAT_FINAL_ASSEMBLY));
+  PetscCall(MatAssemblyEnd(A, MAT_FINAL_ASSEMBLY));
+
+  PetscCall(MatCreateVecs(A, &x, &y));
+  PetscCall(VecDuplicate(y, &z));
+  PetscCall(PetscRandomCreate(PETSC_COMM_WORLD, &rand));
+  PetscCall(PetscRandomSetFromOptions(rand));
+  PetscCall(VecSetRandom(x, rand));
+
+  PetscCall(MatMult(A, x, z));
+  PetscCall(VecDot(x, z, &dot));
+  PetscCall(VecNorm(x, NORM_2, &xn));
+  PetscCall(VecNorm(z, NORM_2, &yn));
+
+  PetscCall(MatMultDot(A, x, y, &xdoty, &xnorm, &ynorm));
+  PetscCall(VecAXPY(z, -1.0, y));
+  PetscCall(VecNorm(z, NORM_INFINITY, &err));
+  if (err > tol * yn) PetscCall(PetscPrintf(PETSC_COMM_WORLD, "MatMultDot() product differs from MatMult() by %g\n", (double)err));
+  if (PetscAbsScalar(xdoty - dot) > tol * PetscAbsScalar(dot)) PetscCall(PetscPrintf(PETSC_COMM_WORLD, "MatMultDot() inner product differs from VecDot() by %g\n", (double)PetscAbsScalar(xdoty - dot)));
+  if (PetscAbsReal(xnorm - xn) > tol * xn) PetscCall(PetscPrintf(PETSC_COMM_WORLD, "MatMultDot() norm of x differs from VecNorm() by %g\n", (double)PetscAbsReal(xnorm - xn)));
+  if (PetscAbsReal(ynorm - yn) > tol * yn) PetscCall(PetscPrintf(PETSC_COMM_WORLD, "MatMultDot() norm of y differs from VecNorm() by %g\n", (double)PetscAbsReal(ynorm - yn)));
+
+  /* only some of the outputs */
+  PetscCall(MatMultDot(A, x, y, NULL, NULL, &ynorm));
+  if (PetscAbsReal(ynorm - yn) > tol * yn) PetscCall(PetscPrintf(PETSC_COMM_WORLD, "MatMultDot() norm of y alone differs from VecNorm() by %g\n", (double)PetscAbsReal(ynorm - yn)));
+
+  PetscCall(PetscRandomDestroy(&rand));
+  PetscCall(VecDestroy(&x));
+  PetscCall(VecDestroy(&y));
+  PetscCall(VecDestroy(&z));
+  PetscCall(MatDestroy(&A));
+  PetscCall(PetscFinalize());
+  return 0;
+}
+
+/*TEST
+
+  testset:
+    output_file: output/empty.out
+    nsize: {{1 2}}
+
+    test:
+      suffix: aij
+      args: -mat_type aij
+
+    test:
+      suffix: baij
+      args: -mat_type baij -mat_block_size {{1 3}}
+
+    test:
+      suffix: sell
+      args: -mat_type sell
+
+    test:
+      suffix: aijsell
+      args: -mat_type aijsell
+
+    test:
+      suffix: dense
+      args: -mat_type dense
+
+TEST*/
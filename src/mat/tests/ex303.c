@@ -0,0 +1,108 @@
+static char help[] = "Tests MAT_THREADED_ASSEMBLY against MatSetValues() without it, with bilinear elements on a square.\n\
+  -n <n> : number of elements in each direction\n\n";
+
+#include <petscmat.h>
+
+/* element matrix of element e, scaled by s, and its global rows */
+static void ElementMatrix(PetscInt n, PetscInt e, PetscScalar s, PetscInt idx[], PetscScalar Ke[])
+{
+  PetscInt i = e / n, j = e % n;
+
+  idx[0] = i * (n + 1) + j;
+  idx[1] = idx[0] + 1;
+  idx[2] = idx[1] + n + 1;
+  idx[3] = idx[0] + n + 1;
+  for (PetscInt k = 0; k < 16; k++) Ke[k] = s * (k % 5 ? -1.0 : 4.0 + e % 3);
+}
+
+int main(int argc, char **args)
+{
+  Mat         A, B;
+  PetscInt    n = 6, N, ne, estart, eend;
+  PetscMPIInt rank, size;
+  PetscBool   flg;
+  PetscReal   nrm;
+
+  PetscFunctionBeginUser;
+  PetscCall(PetscInitialize(&argc, &args, (char *)0, help));
+  PetscCallMPI(MPI_Comm_rank(PETSC_COMM_WORLD, &rank));
+  PetscCallMPI(MPI_Comm_size(PETSC_COMM_WORLD, &size));
+  PetscCall(PetscOptionsGetInt(NULL, NULL, "-n", &n, NULL));
+  N  = (n + 1) * (n + 1);
+  ne = n * n;
+  /* the elements are divided between the processes independently of the rows, so many rows are set by other processes */
+  estart = (ne * rank) / size;
+  eend   = (ne * (rank + 1)) / size;
+
+  /* B is created as A, rather than duplicated, since not every type can duplicate an unassembled matrix */
+  PetscCall(MatCreate(PETSC_COMM_WORLD, &A));
+  PetscCall(MatSetSizes(A, PETSC_DECIDE, PETSC_DECIDE, N, N));
+  PetscCall(MatSetFromOptions(A));
+  PetscCall(MatSetUp(A));
+  PetscCall(MatCreate(PETSC_COMM_WORLD, &B));
+  PetscCall(MatSetSizes(B, PETSC_DECIDE, PETSC_DECIDE, N, N));
+  PetscCall(MatSetFromOptions(B));
+  PetscCall(MatSetUp(B));
+  PetscCall(MatSetOption(A, MAT_THREADED_ASSEMBLY, PETSC_TRUE));
+  PetscCall(MatGetOption(A, MAT_THREADED_ASSEMBLY, &flg));
+  PetscCheck(flg, PETSC_COMM_WORLD, PETSC_ERR_PLIB, "MAT_THREADED_ASSEMBLY not set");
+
+  /* the second assembly stages the same entries and reuses the COO preallocation of the first one */
+  for (PetscInt it = 0; it < 2; it++) {
+    if (it) {
+      PetscCall(MatZeroEntries(A));
+      PetscCall(MatZeroEntries(B));
+    }
+#if defined(PETSC_HAVE_THREADSAFETY)
+    PetscPragmaOMP(parallel for schedule(static))
+#endif
+    for (PetscInt e = estart; e < eend; e++) {
+      PetscInt    idx[4];
+      PetscScalar Ke[16];
+
+      ElementMatrix(n, e, it + 1, idx, Ke);
+      PetscCallAbort(PETSC_COMM_SELF, MatSetValues(A, 4, idx, 4, idx, Ke, ADD_VALUES));
+    }
+    for (PetscInt e = estart; e < eend; e++) {
+      PetscInt    idx[4];
+      PetscScalar Ke[16];
+
+      ElementMatrix(n, e, it + 1, idx, Ke);
+      PetscCall(MatSetValues(B, 4, idx, 4, idx, Ke, ADD_VALUES));
+    }
+    PetscCall(MatAssemblyBegin(A, MAT_FINAL_ASSEMBLY));
+    PetscCall(MatAssemblyEnd(A, MAT_FINAL_ASSEMBLY));
+    PetscCall(MatAssemblyBegin(B, MAT_FINAL_ASSEMBLY));
+    PetscCall(MatAssemblyEnd(B, MAT_FINAL_ASSEMBLY));
+
+    PetscCall(MatAXPY(B, -1.0, A, DIFFERENT_NONZERO_PATTERN));
+    PetscCall(MatNorm(B, NORM_FROBENIUS, &nrm));
+    PetscCall(PetscPrintf(PETSC_COMM_WORLD, "Assembly %" PetscInt_FMT ": norm of the difference %g\n", it, (double)nrm));
+  }
+  PetscCall(MatDestroy(&A));
+  PetscCall(MatDestroy(&B));
+  PetscCall(PetscFinalize());
+  return 0;
+}
+
+/*TEST
+
+  test:
+    suffix: 1
+    nsize: {{1 3}}
+    output_file: output/ex303_1.out
+
+  test:
+    suffix: coo_threads
+    requires: openmp
+    nsize: {{1 3}}
+    args: -n 40 -omp_num_threads 2
+    output_file: output/ex303_1.out
+
+  test:
+    suffix: types
+    nsize: {{1 2}}
+    args: -mat_type {{dense baij}}
+    output_file: output/ex303_1.out
+
+TEST*/
@@ -0,0 +1,131 @@
+static char help[] = "Tests -mat_detect_block_size with a block tridiagonal matrix assembled one entry at a time.\n\
+  -n <n>            : number of block rows\n\
+  -bs <bs>          : block size\n\
+  -variable         : blocks of sizes bs and 1 alternate, so there is no block size\n\
+  -nonsymmetric <k> : 1 to make the matrix nonsymmetric, 2 to make it nonsymmetric only at the second assembly\n\
+  -eternal          : set MAT_SYMMETRY_ETERNAL on the symmetric matrix\n\n";
+
+#include <petscmat.h>
+
+int main(int argc, char **args)
+{
+  Mat         A, B;
+  Vec         x, y, z;
+  PetscInt    n = 6, bs = 3, *start, rstart, rend, nblocks = 0, gnblocks, rbs, nonsymmetric = 0;
+  PetscMPIInt rank, size;
+  PetscBool   variable = PETSC_FALSE, eternal = PETSC_FALSE;
+  PetscReal   nrm;
+  MatType     type;
+
+  PetscFunctionBeginUser;
+  PetscCall(PetscInitialize(&argc, &args, (char *)0, help));
+  PetscCallMPI(MPI_Comm_rank(PETSC_COMM_WORLD, &rank));
+  PetscCallMPI(MPI_Comm_size(PETSC_COMM_WORLD, &size));
+  PetscCall(PetscOptionsGetInt(NULL, NULL, "-n", &n, NULL));
+  PetscCall(PetscOptionsGetInt(NULL, NULL, "-bs", &bs, NULL));
+  PetscCall(PetscOptionsGetBool(NULL, NULL, "-variable", &variable, NULL));
+  PetscCall(PetscOptionsGetInt(NULL, NULL, "-nonsymmetric", &nonsymmetric, NULL));
+  PetscCall(PetscOptionsGetBool(NULL, NULL, "-eternal", &eternal, NULL));
+
+  /* block I has rows start[I] to start[I+1]-1, each process owns whole blocks */
+  PetscCall(PetscMalloc1(n + 1, &start));
+  start[0] = 0;
+  for (PetscInt bi = 0; bi < n; bi++) start[bi + 1] = start[bi] + (variable && bi % 2 ? 1 : bs);
+  rstart = start[(n * rank) / size];
+  rend   = start[(n * (rank + 1)) / size];
+
+  PetscCall(MatCreate(PETSC_COMM_WORLD, &A));
+  PetscCall(MatSetOptionsPrefix(A, "a_"));
+  PetscCall(MatSetSizes(A, rend - rstart, rend - rstart, start[n], start[n]));
+  PetscCall(MatSetType(A, MATAIJ));
+  PetscCall(MatSetFromOptions(A));
+  PetscCall(MatSetUp(A));
+  if (eternal) {
+    PetscCall(MatSetOption(A, MAT_SYMMETRIC, PETSC_TRUE));
+    PetscCall(MatSetOption(A, MAT_SYMMETRY_ETERNAL, PETSC_TRUE));
+  }
+  PetscCall(MatCreate(PETSC_COMM_WORLD, &B));
+  PetscCall(MatSetSizes(B, rend - rstart, rend - rstart, start[n], start[n]));
+  PetscCall(MatSetType(B, MATAIJ));
+  PetscCall(MatSetUp(B));
+  PetscCall(MatCreateVecs(B, &x, &y));
+  PetscCall(VecDuplicate(y, &z));
+  PetscCall(VecSetRandom(x, NULL));
+
+  /* the second assembly sets the same entries, also below the diagonal, into the possibly converted matrix, nonsymmetric with -nonsymmetric 2 */
+  for (PetscInt it = 0; it < 2; it++) {
+    for (PetscInt bi = (n * rank) / size; bi < (n * (rank + 1)) / size; bi++) {
+      for (PetscInt bj = PetscMax(bi - 1, 0); bj <= PetscMin(bi + 1, n - 1); bj++) {
+        for (PetscInt r = start[bi]; r < start[bi + 1]; r++) {
+          for (PetscInt c = start[bj]; c < start[bj + 1]; c++) {
+            PetscScalar v = (it + 1) * (bi == bj ? (r == c ? 8.0 : 1.0) : -1.0) + (nonsymmetric && it >= nonsymmetric - 1 && c > r ? 0.25 : 0.0);
+
+            PetscCall(MatSetValue(A, r, c, v, INSERT_VALUES));
+            PetscCall(MatSetValue(B, r, c, v, INSERT_VALUES));
+          }
+        }
+      }
+    }
+    PetscCall(MatAssemblyBegin(A, MAT_FINAL_ASSEMBLY));
+    PetscCall(MatAssemblyEnd(A, MAT_FINAL_ASSEMBLY));
+    PetscCall(MatAssemblyBegin(B, MAT_FINAL_ASSEMBLY));
+    PetscCall(MatAssemblyEnd(B, MAT_FINAL_ASSEMBLY));
+
+    PetscCall(MatGetType(A, &type));
+    PetscCall(MatGetBlockSize(A, &rbs));
+    if (!it) {
+      const PetscInt *bsizes;
+
+      PetscCall(MatGetVariableBlockSizes(A, &nblocks, &bsizes));
+    }
+    PetscCallMPI(MPI_Allreduce(&nblocks, &gnblocks, 1, MPIU_INT, MPI_SUM, PETSC_COMM_WORLD));
+    PetscCall(MatMult(A, x, y));
+    PetscCall(MatMult(B, x, z));
+    PetscCall(VecAXPY(y, -1.0, z));
+    PetscCall(VecNorm(y, NORM_2, &nrm));
+    PetscCall(PetscPrintf(PETSC_COMM_WORLD, "Assembly %" PetscInt_FMT ": type %s, block size %" PetscInt_FMT ", %" PetscInt_FMT " variable blocks\n", it, type, rbs, gnblocks));
+    if (nrm > 100 * PETSC_MACHINE_EPSILON) PetscCall(PetscPrintf(PETSC_COMM_WORLD, "Norm of the difference of the products %g\n", (double)nrm));
+    PetscCall(MatZeroEntries(A));
+    PetscCall(MatZeroEntries(B));
+  }
+  PetscCall(PetscFree(start));
+  PetscCall(VecDestroy(&x));
+  PetscCall(VecDestroy(&y));
+  PetscCall(VecDestroy(&z));
+  PetscCall(MatDestroy(&A));
+  PetscCall(MatDestroy(&B));
+  PetscCall(PetscFinalize());
+  return 0;
+}
+
+/*TEST
+
+  test:
+    suffix: uniform
+    nsize: {{1 2}}
+    args: -a_mat_detect_block_size
+    filter: sed -e "s/seqaij/aij/g" -e "s/mpiaij/aij/g"
+    output_file: output/ex304_uniform.out
+
+  test:
+    suffix: sbaij
+    nsize: {{1 2}}
+    args: -a_mat_detect_block_size -a_mat_detect_block_size_convert -eternal
+    filter: sed -e "s/seqsbaij/sbaij/g" -e "s/mpisbaij/sbaij/g"
+    output_file: output/ex304_sbaij.out
+
+  test:
+    suffix: baij
+    nsize: {{1 2}}
+    args: -a_mat_detect_block_size -a_mat_detect_block_size_convert -nonsymmetric {{0 1 2}}
+    filter: sed -e "s/seqbaij/baij/g" -e "s/mpibaij/baij/g"
+    output_file: output/ex304_baij.out
+
+  test:
+    suffix: variable
+    nsize: {{1 2}}
+    args: -a_mat_detect_block_size -a_mat_detect_block_size_convert -variable
+    filter: sed -e "s/seqaij/aij/g" -e "s/mpiaij/aij/g"
+    output_file: output/ex304_variable.out
+
+TEST*/
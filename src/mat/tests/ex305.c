@@ -0,0 +1,114 @@
+static char help[] = "Tests assemblies that add new nonzeros to a few rows of an assembled AIJ matrix against matrices assembled once.\n\
+  -n <n>       : number of grid points in each direction, with two unknowns each\n\
+  -rounds <r>  : number of assemblies with new nonzeros\n\n";
+
+#include <petscmat.h>
+
+/* the entries of row r of the two dimensional grid with couplings between the two unknowns of each point */
+static PetscErrorCode SetGridRow(Mat A, PetscInt n, PetscInt r)
+{
+  PetscInt    p = r / 2, i = p / n, j = p % n, cols[10], nc = 0;
+  PetscScalar vals[10];
+
+  PetscFunctionBeginUser;
+  for (PetscInt d = 0; d < 2; d++) {
+    cols[nc++] = 2 * p + d;
+    if (i > 0) cols[nc++] = 2 * (p - n) + d;
+    if (i < n - 1) cols[nc++] = 2 * (p + n) + d;
+    if (j > 0) cols[nc++] = 2 * (p - 1) + d;
+    if (j < n - 1) cols[nc++] = 2 * (p + 1) + d;
+  }
+  for (PetscInt k = 0; k < nc; k++) vals[k] = cols[k] == r ? 8.0 : -1.0;
+  PetscCall(MatSetValues(A, 1, &r, nc, cols, vals, INSERT_VALUES));
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
+
+/* the new nonzeros of round it, a few long range couplings */
+static PetscErrorCode SetNewEntries(Mat A, PetscInt N, PetscInt it, PetscInt rstart, PetscInt rend)
+{
+  PetscFunctionBeginUser;
+  for (PetscInt k = 0; k < 3; k++) {
+    PetscInt    r = (37 * it + 11 * k + 3) % N, c = (r + 5 * it + 17 + k) % N;
+    PetscScalar v = 0.5 + it;
+
+    if (r < rstart || r >= rend) continue;
+    PetscCall(MatSetValues(A, 1, &r, 1, &c, &v, INSERT_VALUES));
+  }
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
+
+int main(int argc, char **args)
+{
+  Mat       A, B;
+  Vec       x, y, z;
+  PetscInt  n = 8, N, rounds = 4, rstart, rend;
+  PetscReal nrm, pnrm, snrm;
+
+  PetscFunctionBeginUser;
+  PetscCall(PetscInitialize(&argc, &args, (char *)0, help));
+  PetscCall(PetscOptionsGetInt(NULL, NULL, "-n", &n, NULL));
+  PetscCall(PetscOptionsGetInt(NULL, NULL, "-rounds", &rounds, NULL));
+  N = 2 * n * n;
+
+  PetscCall(MatCreate(PETSC_COMM_WORLD, &A));
+  PetscCall(MatSetSizes(A, PETSC_DECIDE, PETSC_DECIDE, N, N));
+  PetscCall(MatSetType(A, MATAIJ));
+  PetscCall(MatSetFromOptions(A));
+  PetscCall(MatSeqAIJSetPreallocation(A, 10, NULL));
+  PetscCall(MatMPIAIJSetPreallocation(A, 10, NULL, 10, NULL));
+  PetscCall(MatSetOption(A, MAT_NEW_NONZERO_ALLOCATION_ERR, PETSC_FALSE));
+  PetscCall(MatGetOwnershipRange(A, &rstart, &rend));
+  for (PetscInt r = rstart; r < rend; r++) PetscCall(SetGridRow(A, n, r));
+  PetscCall(MatAssemblyBegin(A, MAT_FINAL_ASSEMBLY));
+  PetscCall(MatAssemblyEnd(A, MAT_FINAL_ASSEMBLY));
+  PetscCall(MatCreateVecs(A, &x, &y));
+  PetscCall(VecDuplicate(y, &z));
+  PetscCall(VecSetRandom(x, NULL));
+
+  for (PetscInt it = 1; it <= rounds; it++) {
+    /* A gets the new entries of this round only, B is assembled from scratch with all the entries */
+    PetscCall(SetNewEntries(A, N, it, rstart, rend));
+    PetscCall(MatAssemblyBegin(A, MAT_FINAL_ASSEMBLY));
+    PetscCall(MatAssemblyEnd(A, MAT_FINAL_ASSEMBLY));
+
+    PetscCall(MatCreate(PETSC_COMM_WORLD, &B));
+    PetscCall(MatSetSizes(B, PETSC_DECIDE, PETSC_DECIDE, N, N));
+    PetscCall(MatSetType(B, MATAIJ));
+    PetscCall(MatSetFromOptions(B));
+    PetscCall(MatSetUp(B));
+    for (PetscInt r = rstart; r < rend; r++) PetscCall(SetGridRow(B, n, r));
+    for (PetscInt k = 1; k <= it; k++) PetscCall(SetNewEntries(B, N, k, rstart, rend));
+    PetscCall(MatAssemblyBegin(B, MAT_FINAL_ASSEMBLY));
+    PetscCall(MatAssemblyEnd(B, MAT_FINAL_ASSEMBLY));
+
+    PetscCall(MatMult(A, x, y));
+    PetscCall(MatMult(B, x, z));
+    PetscCall(VecAXPY(y, -1.0, z));
+    PetscCall(VecNorm(y, NORM_2, &pnrm));
+    PetscCall(VecZeroEntries(z));
+    PetscCall(MatSOR(A, x, 1.0, (MatSORType)(SOR_LOCAL_SYMMETRIC_SWEEP | SOR_ZERO_INITIAL_GUESS), 0.0, 1, 1, y));
+    PetscCall(MatSOR(B, x, 1.0, (MatSORType)(SOR_LOCAL_SYMMETRIC_SWEEP | SOR_ZERO_INITIAL_GUESS), 0.0, 1, 1, z));
+    PetscCall(VecAXPY(y, -1.0, z));
+    PetscCall(VecNorm(y, NORM_2, &snrm));
+    PetscCall(MatAXPY(B, -1.0, A, DIFFERENT_NONZERO_PATTERN));
+    PetscCall(MatNorm(B, NORM_FROBENIUS, &nrm));
+    PetscCall(PetscPrintf(PETSC_COMM_WORLD, "Assembly %" PetscInt_FMT ": norm of the difference %g, of the products %g, of the SOR sweeps %g\n", it, (double)nrm, (double)pnrm, (double)snrm));
+    PetscCall(MatDestroy(&B));
+  }
+  PetscCall(VecDestroy(&x));
+  PetscCall(VecDestroy(&y));
+  PetscCall(VecDestroy(&z));
+  PetscCall(MatDestroy(&A));
+  PetscCall(PetscFinalize());
+  return 0;
+}
+
+/*TEST
+
+  test:
+    suffix: 1
+    nsize: {{1 2}}
+    args: -mat_no_inode {{0 1}}
+    output_file: output/ex305_1.out
+
+TEST*/
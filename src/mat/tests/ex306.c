@@ -0,0 +1,154 @@
+static char help[] = "Tests the supernodal LU and Cholesky factorizations against the factorizations of MATSOLVERPETSC.\n\
+  -n <n>         : number of grid points in each direction\n\
+  -dof <dof>     : number of unknowns at each grid point\n\
+  -nonsymmetric  : add a convection term, for LU only\n\
+  -nrhs <nrhs>   : number of right-hand sides of MatMatSolve()\n\
+  -sbaij         : factor the matrix converted to MATSEQSBAIJ with the supernodal Cholesky factorization\n\
+  -ordering <o>  : the ordering of the factorizations\n\n";
+
+#include <petscmat.h>
+
+/* a dof x dof coupled Laplacian on an n x n grid, scaled by s, optionally with a convection term */
+static PetscErrorCode FillMatrix(Mat A, PetscInt n, PetscInt dof, PetscBool nonsymmetric, PetscReal s)
+{
+  PetscInt N = n * n * dof;
+
+  PetscFunctionBeginUser;
+  for (PetscInt r = 0; r < N; r++) {
+    PetscInt p = r / dof, d = r % dof, i = p / n, j = p % n, cols[5], nc = 0;
+
+    for (PetscInt e = 0; e < dof; e++) PetscCall(MatSetValue(A, r, dof * p + e, e == d ? s * (4.0 + dof) : -0.5, INSERT_VALUES));
+    if (i > 0) cols[nc++] = r - n * dof;
+    if (i < n - 1) cols[nc++] = r + n * dof;
+    if (j > 0) cols[nc++] = r - dof;
+    if (j < n - 1) cols[nc++] = r + dof;
+    for (PetscInt k = 0; k < nc; k++) PetscCall(MatSetValue(A, r, cols[k], -1.0 + (nonsymmetric && cols[k] > r ? 0.75 : 0.0), INSERT_VALUES));
+  }
+  PetscCall(MatAssemblyBegin(A, MAT_FINAL_ASSEMBLY));
+  PetscCall(MatAssemblyEnd(A, MAT_FINAL_ASSEMBLY));
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
+
+int main(int argc, char **args)
+{
+  Mat           A, S, F, G, B, X, Y;
+  Vec           b, x, y;
+  IS            rperm, cperm;
+  MatFactorInfo info;
+  MatInfo       minfo;
+  PetscInt      n = 8, dof = 3, N, nrhs = 3;
+  PetscBool     nonsymmetric = PETSC_FALSE, sbaij = PETSC_FALSE;
+  PetscReal     nrm, tol = 1000 * PETSC_MACHINE_EPSILON;
+  char          ordering[256] = MATORDERINGND;
+
+  PetscFunctionBeginUser;
+  PetscCall(PetscInitialize(&argc, &args, (char *)0, help));
+  PetscCall(PetscOptionsGetInt(NULL, NULL, "-n", &n, NULL));
+  PetscCall(PetscOptionsGetInt(NULL, NULL, "-dof", &dof, NULL));
+  PetscCall(PetscOptionsGetInt(NULL, NULL, "-nrhs", &nrhs, NULL));
+  PetscCall(PetscOptionsGetBool(NULL, NULL, "-nonsymmetric", &nonsymmetric, NULL));
+  PetscCall(PetscOptionsGetBool(NULL, NULL, "-sbaij", &sbaij, NULL));
+  PetscCall(PetscOptionsGetString(NULL, NULL, "-ordering", ordering, sizeof(ordering), NULL));
+  N = n * n * dof;
+
+  PetscCall(MatCreateSeqAIJ(PETSC_COMM_SELF, N, N, dof + 4, NULL, &A));
+  PetscCall(FillMatrix(A, n, dof, nonsymmetric, 1.0));
+  PetscCall(MatCreateVecs(A, &x, &b));
+  PetscCall(VecDuplicate(x, &y));
+  PetscCall(VecSetRandom(b, NULL));
+  PetscCall(MatCreateDense(PETSC_COMM_SELF, N, nrhs, N, nrhs, NULL, &B));
+  PetscCall(MatSetRandom(B, NULL));
+  PetscCall(MatDuplicate(B, MAT_DO_NOT_COPY_VALUES, &X));
+  PetscCall(MatDuplicate(B, MAT_DO_NOT_COPY_VALUES, &Y));
+  PetscCall(MatFactorInfoInitialize(&info));
+  PetscCall(MatGetOrdering(A, ordering, &rperm, &cperm));
+
+  if (sbaij) {
+    PetscCall(MatSetOption(A, MAT_SYMMETRIC, PETSC_TRUE));
+    PetscCall(MatSetOption(A, MAT_SYMMETRY_ETERNAL, PETSC_TRUE));
+    PetscCall(MatConvert(A, MATSEQSBAIJ, MAT_INITIAL_MATRIX, &S));
+  } else {
+    PetscCall(PetscObjectReference((PetscObject)A));
+    S = A;
+  }
+  if (nonsymmetric) {
+    PetscCall(MatGetFactor(S, MATSOLVERSUPERNODAL, MAT_FACTOR_LU, &F));
+    PetscCall(MatGetFactor(A, MATSOLVERPETSC, MAT_FACTOR_LU, &G));
+    PetscCall(MatLUFactorSymbolic(F, S, rperm, cperm, &info));
+    PetscCall(MatLUFactorSymbolic(G, A, rperm, cperm, &info));
+  } else {
+    PetscCall(MatGetFactor(S, MATSOLVERSUPERNODAL, MAT_FACTOR_CHOLESKY, &F));
+    PetscCall(MatGetFactor(A, MATSOLVERPETSC, MAT_FACTOR_CHOLESKY, &G));
+    PetscCall(MatCholeskyFactorSymbolic(F, S, rperm, &info));
+    PetscCall(MatCholeskyFactorSymbolic(G, A, rperm, &info));
+  }
+  PetscCall(MatGetInfo(F, MAT_LOCAL, &minfo));
+  if (minfo.nz_used <= 0) PetscCall(PetscPrintf(PETSC_COMM_SELF, "No nonzeros in the symbolic factor\n"));
+
+  /* the second factorization reuses the symbolic factorization with new values */
+  for (PetscInt it = 0; it < 2; it++) {
+    if (it) {
+      PetscCall(FillMatrix(A, n, dof, nonsymmetric, 2.0));
+      if (sbaij) PetscCall(MatConvert(A, MATSEQSBAIJ, MAT_REUSE_MATRIX, &S));
+    }
+    if (nonsymmetric) {
+      PetscCall(MatLUFactorNumeric(F, S, &info));
+      PetscCall(MatLUFactorNumeric(G, A, &info));
+    } else {
+      PetscCall(MatCholeskyFactorNumeric(F, S, &info));
+      PetscCall(MatCholeskyFactorNumeric(G, A, &info));
+    }
+    PetscCall(MatSolve(F, b, x));
+    PetscCall(MatSolve(G, b, y));
+    PetscCall(VecAXPY(x, -1.0, y));
+    PetscCall(VecNorm(x, NORM_2, &nrm));
+    if (nrm > tol) PetscCall(PetscPrintf(PETSC_COMM_SELF, "Factorization %" PetscInt_FMT ": norm of the difference of MatSolve() %g\n", it, (double)nrm));
+    if (!nonsymmetric && !PetscDefined(USE_COMPLEX)) {
+      PetscCall(MatSolveTranspose(F, b, x));
+      PetscCall(MatSolve(G, b, y));
+      PetscCall(VecAXPY(x, -1.0, y));
+      PetscCall(VecNorm(x, NORM_2, &nrm));
+      if (nrm > tol) PetscCall(PetscPrintf(PETSC_COMM_SELF, "Factorization %" PetscInt_FMT ": norm of the difference of MatSolveTranspose() %g\n", it, (double)nrm));
+    }
+    PetscCall(MatMatSolve(F, B, X));
+    PetscCall(MatMatSolve(G, B, Y));
+    PetscCall(MatAXPY(X, -1.0, Y, SAME_NONZERO_PATTERN));
+    PetscCall(MatNorm(X, NORM_FROBENIUS, &nrm));
+    if (nrm > tol) PetscCall(PetscPrintf(PETSC_COMM_SELF, "Factorization %" PetscInt_FMT ": norm of the difference of MatMatSolve() %g\n", it, (double)nrm));
+  }
+  PetscCall(PetscPrintf(PETSC_COMM_SELF, "Done\n"));
+
+  PetscCall(ISDestroy(&rperm));
+  PetscCall(ISDestroy(&cperm));
+  PetscCall(MatDestroy(&F));
+  PetscCall(MatDestroy(&G));
+  PetscCall(MatDestroy(&B));
+  PetscCall(MatDestroy(&X));
+  PetscCall(MatDestroy(&Y));
+  PetscCall(MatDestroy(&S));
+  PetscCall(MatDestroy(&A));
+  PetscCall(VecDestroy(&x));
+  PetscCall(VecDestroy(&y));
+  PetscCall(VecDestroy(&b));
+  PetscCall(PetscFinalize());
+  return 0;
+}
+
+/*TEST
+
+  test:
+    suffix: cholesky
+    args: -ordering {{nd qmd natural}} -dof {{1 3}}
+    output_file: output/ex306_1.out
+
+  test:
+    suffix: sbaij
+    args: -sbaij -ordering {{nd natural}}
+    output_file: output/ex306_1.out
+
+  test:
+    suffix: lu
+    args: -nonsymmetric -ordering {{nd qmd natural rcm}} -dof {{1 3}}
+    output_file: output/ex306_1.out
+
+TEST*/
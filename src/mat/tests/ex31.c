@@ -6,14 +6,23 @@ static char help[] = "Tests binary I/O of matrices and illustrates user-defined
   the same program.  This example is intended only to demonstrate
   both input and output. */
 
+/* the work of a row is its number of nonzeros squared */
+static PetscErrorCode RowWeight(Mat mat, PetscInt rstart, PetscInt n, const PetscInt rowlens[], PetscReal w[], void *ctx)
+{
+  PetscFunctionBeginUser;
+  for (PetscInt i = 0; i < n; i++) w[i] = (PetscReal)(rowlens[i] * rowlens[i]);
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
+
 int main(int argc, char **args)
 {
   Mat           C;
   PetscScalar   v;
-  PetscInt      i, j, Ii, J, Istart, Iend, N, m = 4, n = 4;
+  PetscInt      i, j, Ii, J, Istart, Iend, N, m = 4, n = 4, ndense = 0;
   PetscMPIInt   rank, size;
   PetscViewer   viewer;
   PetscLogEvent MATRIX_GENERATE, MATRIX_READ;
+  PetscBool     userweight = PETSC_FALSE, viewownership = PETSC_FALSE, usemmap = PETSC_FALSE, isseqaij;
 
   PetscFunctionBeginUser;
   PetscCall(PetscInitialize(&argc, &args, (char *)0, help));
@@ -21,6 +30,10 @@ int main(int argc, char **args)
   PetscCallMPI(MPI_Comm_size(PETSC_COMM_WORLD, &size));
   PetscCall(PetscOptionsGetInt(NULL, NULL, "-m", &m, NULL));
   PetscCall(PetscOptionsGetInt(NULL, NULL, "-n", &n, NULL));
+  PetscCall(PetscOptionsGetInt(NULL, NULL, "-dense_rows", &ndense, NULL));
+  PetscCall(PetscOptionsGetBool(NULL, NULL, "-user_row_weight", &userweight, NULL));
+  PetscCall(PetscOptionsGetBool(NULL, NULL, "-view_ownership", &viewownership, NULL));
+  PetscCall(PetscOptionsGetBool(NULL, NULL, "-viewer_binary_mmap", &usemmap, NULL));
   N = m * n;
 
   /* PART 1:  Generate matrix, then write it in binary format */
@@ -56,6 +69,11 @@ int main(int argc, char **args)
     }
     v = 4.0;
     PetscCall(MatSetValues(C, 1, &Ii, 1, &Ii, &v, ADD_VALUES));
+    /* the first rows are dense, to have uneven row lengths */
+    if (Ii < ndense) {
+      v = 0.0;
+      for (J = 0; J < N; J++) PetscCall(MatSetValues(C, 1, &Ii, 1, &J, &v, ADD_VALUES));
+    }
   }
   PetscCall(MatAssemblyBegin(C, MAT_FINAL_ASSEMBLY));
   PetscCall(MatAssemblyEnd(C, MAT_FINAL_ASSEMBLY));
@@ -78,9 +96,26 @@ int main(int argc, char **args)
   PetscCall(PetscPrintf(PETSC_COMM_WORLD, "reading matrix in binary from matrix.dat ...\n"));
   PetscCall(PetscViewerBinaryOpen(PETSC_COMM_WORLD, "matrix.dat", FILE_MODE_READ, &viewer));
   PetscCall(MatCreate(PETSC_COMM_WORLD, &C));
+  if (userweight) PetscCall(MatLoadSetRowWeightFunction(C, RowWeight, NULL));
   PetscCall(MatLoad(C, viewer));
   PetscCall(PetscViewerDestroy(&viewer));
   PetscCall(PetscLogEventEnd(MATRIX_READ, 0, 0, 0, 0));
+  /* a MATSEQAIJ matrix uses the mapped file exactly on big-endian systems, whose byte order is that of the file */
+  PetscCall(PetscObjectTypeCompare((PetscObject)C, MATSEQAIJ, &isseqaij));
+  if (usemmap && isseqaij) {
+    PetscObject map;
+
+    PetscCall(PetscObjectQuery((PetscObject)C, "PetscViewerBinaryMMap", &map));
+    PetscCheck(!map == !PetscBinaryBigEndian(), PETSC_COMM_SELF, PETSC_ERR_PLIB, "The file is %s on a %s-endian system", map ? "mapped" : "not mapped", PetscBinaryBigEndian() ? "big" : "little");
+  }
+  if (viewownership) {
+    MatInfo info;
+
+    PetscCall(MatGetOwnershipRange(C, &Istart, &Iend));
+    PetscCall(MatGetInfo(C, MAT_LOCAL, &info));
+    PetscCall(PetscSynchronizedPrintf(PETSC_COMM_WORLD, "[%d] rows %" PetscInt_FMT " to %" PetscInt_FMT ", %g nonzeros\n", rank, Istart, Iend, info.nz_used));
+    PetscCall(PetscSynchronizedFlush(PETSC_COMM_WORLD, PETSC_STDOUT));
+  }
   PetscCall(MatView(C, PETSC_VIEWER_STDOUT_WORLD));
 
   /* Free data structures */
@@ -95,4 +130,29 @@ int main(int argc, char **args)
    test:
       filter: grep -v " MPI process"
 
+   test:
+      suffix: mmap
+      filter: grep -v " MPI process"
+      args: -viewer_binary_mmap
+      output_file: output/ex31_1.out
+
+   test:
+      suffix: balance
+      nsize: 3
+      filter: grep -v " MPI process"
+      args: -m 8 -n 3 -dense_rows 2 -view_ownership -matload_balance_nonzeros -viewer_binary_mpiio {{0 1}}
+      output_file: output/ex31_balance.out
+
+   test:
+      suffix: balance_weight
+      nsize: 3
+      filter: grep -v " MPI process"
+      args: -m 8 -n 3 -dense_rows 2 -view_ownership -user_row_weight
+
+   test:
+      suffix: balance_block
+      nsize: 3
+      filter: grep -v " MPI process"
+      args: -m 8 -n 3 -dense_rows 2 -view_ownership -matload_balance_nonzeros -matload_block_size 2 -viewer_binary_skip_info
+
 TEST*/
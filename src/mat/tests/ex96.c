@@ -325,6 +325,26 @@ int main(int argc, char **argv)
      args: -Mx 10 -My 5 -Mz 10 -matmatmult_via scalable -matptap_via scalable -inner_diag_mat_product_algorithm rowmerge -inner_offdiag_mat_product_algorithm rowmerge
      output_file: output/ex96_1.out
 
+   test:
+     suffix: threaded
+     env: OMP_NUM_THREADS=3
+     args: -Mx 10 -My 5 -Mz 10 -matmatmult_via threaded -matptap_via threaded
+     output_file: output/ex96_1.out
+
+   test:
+     suffix: seq_threaded
+     nsize: 3
+     env: OMP_NUM_THREADS=2
+     args: -Mx 10 -My 5 -Mz 10 -matmatmult_via scalable -matptap_via scalable -inner_diag_mat_product_algorithm threaded -inner_offdiag_mat_product_algorithm threaded
+     output_file: output/ex96_1.out
+
+   test:
+     suffix: nonscalable_threaded
+     nsize: 3
+     env: OMP_NUM_THREADS=2
+     args: -Mx 10 -My 5 -Mz 10 -matptap_via nonscalable -inner_C_loc_mat_product_algorithm threaded -inner_C_oth_mat_product_algorithm threaded
+     output_file: output/ex96_1.out
+
    test:
      suffix: allatonce
      nsize: 3
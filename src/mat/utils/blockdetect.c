@@ -0,0 +1,168 @@
+#include <petsc/private/matimpl.h>
+#include <../src/mat/impls/aij/mpi/mpiaij.h>
+
+/* largest block size tried by -mat_detect_block_size */
+#define MAT_DETECT_BLOCK_SIZE_MAX 16
+
+/*
+  Checks if the local rows of a CSR structure consist of bs x bs blocks: the rows of each block row have the same columns, which come in
+  groups of bs consecutive columns starting at a multiple of bs. The global column of aj[k] is garray[aj[k]], or cstart + aj[k] without garray.
+*/
+static PetscErrorCode MatDetectBlockSizeCheck_Private(PetscInt m, const PetscInt ai[], const PetscInt aj[], const PetscInt garray[], PetscInt cstart, PetscInt bs, PetscBool *valid)
+{
+  PetscFunctionBegin;
+  *valid = PETSC_FALSE;
+  for (PetscInt r = 0; r < m; r += bs) {
+    PetscInt len = ai[r + 1] - ai[r];
+
+    if (len % bs) PetscFunctionReturn(PETSC_SUCCESS);
+    for (PetscInt k = ai[r]; k < ai[r + 1]; k += bs) {
+      PetscInt c = garray ? garray[aj[k]] : cstart + aj[k];
+
+      if (c % bs) PetscFunctionReturn(PETSC_SUCCESS);
+      for (PetscInt l = 1; l < bs; l++)
+        if ((garray ? garray[aj[k + l]] : cstart + aj[k + l]) != c + l) PetscFunctionReturn(PETSC_SUCCESS);
+    }
+    for (PetscInt l = 1; l < bs; l++) {
+      PetscBool same;
+
+      if (ai[r + l + 1] - ai[r + l] != len) PetscFunctionReturn(PETSC_SUCCESS);
+      PetscCall(PetscArraycmp(aj + ai[r], aj + ai[r + l], len, &same));
+      if (!same) PetscFunctionReturn(PETSC_SUCCESS);
+    }
+  }
+  *valid = PETSC_TRUE;
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
+
+/*
+  Divides the local rows into variable blocks, in the way of inodes: consecutive rows with the same columns whose diagonal block is dense.
+  Only used for square matrices with the same row and column layout.
+*/
+static PetscErrorCode MatDetectVariableBlocks_Private(PetscInt m, const PetscInt ai[], const PetscInt aj[], const PetscInt bi[], const PetscInt bj[], PetscInt *nblocks, PetscInt bsizes[])
+{
+  PetscFunctionBegin;
+  *nblocks = 0;
+  for (PetscInt r = 0; r < m;) {
+    PetscInt  k = 1, p, len = ai[r + 1] - ai[r];
+    PetscBool same = PETSC_TRUE;
+
+    while (r + k < m && same) {
+      same = (PetscBool)(ai[r + k + 1] - ai[r + k] == len);
+      if (same) PetscCall(PetscArraycmp(aj + ai[r], aj + ai[r + k], len, &same));
+      if (same && bi) {
+        same = (PetscBool)(bi[r + k + 1] - bi[r + k] == bi[r + 1] - bi[r]);
+        if (same) PetscCall(PetscArraycmp(bj + bi[r], bj + bi[r + k], bi[r + 1] - bi[r], &same));
+      }
+      if (same) k++;
+    }
+    /* shrink the block to its dense diagonal part */
+    PetscCall(PetscFindInt(r, len, aj + ai[r], &p));
+    if (p < 0) k = 1;
+    else {
+      PetscInt l = 1;
+
+      while (l < k && p + l < len && aj[ai[r] + p + l] == r + l) l++;
+      k = l;
+    }
+    bsizes[(*nblocks)++] = k;
+    r += k;
+  }
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
+
+/*
+  MatDetectBlockSize_Private - Detects the block structure of an assembled MATSEQAIJ or MATMPIAIJ matrix, requested with -mat_detect_block_size
+
+  Notes:
+  Called by MatAssemblyEnd() when the nonzero structure of the matrix has changed and it has no block size yet. The largest block size, up
+  to MAT_DETECT_BLOCK_SIZE_MAX, for which the matrix consists of dense bs x bs blocks is set with MatSetBlockSizes(). If there is none, the
+  rows are divided into inode-like blocks given to MatSetVariableBlockSizes(), unless variable block sizes were already set.
+
+  With -mat_detect_block_size_convert a matrix with a detected block size is converted in place to MATBAIJ, or to MATSBAIJ when it is
+  numerically symmetric, so that the unrolled block kernels are used. The entries below the diagonal set in later assemblies of a MATSBAIJ
+  matrix are ignored, so later assemblies must keep the matrix symmetric.
+*/
+PetscErrorCode MatDetectBlockSize_Private(Mat mat)
+{
+  PetscBool       isseq, ismpi, valid;
+  Mat             A, B = NULL;
+  Mat_SeqAIJ     *a, *b = NULL;
+  const PetscInt *garray = NULL;
+  PetscInt        m = mat->rmap->n, n = mat->cmap->n, rstart = mat->rmap->rstart, cstart = mat->cmap->rstart, bs = 1;
+  PetscMPIInt     ok[MAT_DETECT_BLOCK_SIZE_MAX + 1], gok[MAT_DETECT_BLOCK_SIZE_MAX + 1];
+  MPI_Comm        comm = PetscObjectComm((PetscObject)mat);
+
+  PetscFunctionBegin;
+  PetscCall(PetscObjectTypeCompare((PetscObject)mat, MATSEQAIJ, &isseq));
+  PetscCall(PetscObjectTypeCompare((PetscObject)mat, MATMPIAIJ, &ismpi));
+  if (!isseq && !ismpi) {
+    PetscCall(PetscInfo(mat, "Block size detection is not supported for matrix type %s\n", ((PetscObject)mat)->type_name));
+    PetscFunctionReturn(PETSC_SUCCESS);
+  }
+  if (mat->rmap->bs > 1 || mat->cmap->bs > 1) PetscFunctionReturn(PETSC_SUCCESS);
+  if (ismpi) {
+    Mat_MPIAIJ *aij = (Mat_MPIAIJ *)mat->data;
+
+    A      = aij->A;
+    B      = aij->B;
+    garray = aij->garray;
+    b      = (Mat_SeqAIJ *)B->data;
+  } else A = mat;
+  a = (Mat_SeqAIJ *)A->data;
+
+  /* the block sizes valid on all the processes */
+  for (PetscInt k = 0; k <= MAT_DETECT_BLOCK_SIZE_MAX; k++) {
+    ok[k] = 0;
+    if (k < 2 || m % k || n % k || rstart % k || cstart % k) continue;
+    PetscCall(MatDetectBlockSizeCheck_Private(m, a->i, a->j, NULL, cstart, k, &valid));
+    if (valid && b) PetscCall(MatDetectBlockSizeCheck_Private(m, b->i, b->j, garray, 0, k, &valid));
+    ok[k] = valid;
+  }
+  PetscCall(MPIU_Allreduce(ok, gok, MAT_DETECT_BLOCK_SIZE_MAX + 1, MPI_INT, MPI_MIN, comm));
+  for (PetscInt k = MAT_DETECT_BLOCK_SIZE_MAX; k > 1; k--) {
+    if (gok[k]) {
+      bs = k;
+      break;
+    }
+  }
+
+  if (bs > 1) {
+    PetscCall(PetscInfo(mat, "Detected block size %" PetscInt_FMT "\n", bs));
+    PetscCall(MatSetBlockSizes(mat, bs, bs));
+    if (mat->detectblocksizeconvert) {
+      /* MATSBAIJ ignores the values set below the diagonal by later assemblies, so the symmetry must be known to persist */
+      PetscBool   symmetric = (PetscBool)((mat->symmetry_eternal && mat->symmetric == PETSC_BOOL3_TRUE) || (mat->spd_eternal && mat->spd == PETSC_BOOL3_TRUE));
+      char       *prefix;
+      const char *oldprefix;
+
+      PetscCall(PetscInfo(mat, "Converting to %s\n", symmetric ? MATSBAIJ : MATBAIJ));
+      /* the in place conversion replaces the header of the matrix, which loses the options prefix */
+      PetscCall(MatGetOptionsPrefix(mat, &oldprefix));
+      PetscCall(PetscStrallocpy(oldprefix, &prefix));
+      PetscCall(MatConvert(mat, symmetric ? MATSBAIJ : MATBAIJ, MAT_INPLACE_MATRIX, &mat));
+      PetscCall(MatSetOptionsPrefix(mat, prefix));
+      PetscCall(PetscFree(prefix));
+      if (symmetric) PetscCall(MatSetOption(mat, MAT_IGNORE_LOWER_TRIANGULAR, PETSC_TRUE));
+    }
+  } else {
+    PetscBool square = (PetscBool)(m == n && rstart == cstart && !mat->nblocks);
+
+    /* the detection of variable blocks is collective, so all the processes must agree on attempting it */
+    PetscCall(MPIU_Allreduce(MPI_IN_PLACE, &square, 1, MPIU_BOOL, MPI_LAND, comm));
+    if (square) {
+      PetscInt nblocks, *bsizes, maxbs = 1, gmaxbs;
+
+      PetscCall(PetscMalloc1(m, &bsizes));
+      PetscCall(MatDetectVariableBlocks_Private(m, a->i, a->j, b ? b->i : NULL, b ? b->j : NULL, &nblocks, bsizes));
+      for (PetscInt k = 0; k < nblocks; k++) maxbs = PetscMax(maxbs, bsizes[k]);
+      PetscCall(MPIU_Allreduce(&maxbs, &gmaxbs, 1, MPIU_INT, MPI_MAX, comm));
+      if (gmaxbs > 1) {
+        PetscCall(PetscInfo(mat, "Detected %" PetscInt_FMT " local variable blocks of sizes up to %" PetscInt_FMT "\n", nblocks, maxbs));
+        PetscCall(MatSetVariableBlockSizes(mat, nblocks, bsizes));
+      } else PetscCall(PetscInfo(mat, "No block structure detected\n"));
+      PetscCall(PetscFree(bsizes));
+    } else PetscCall(PetscInfo(mat, "No block structure detected\n"));
+  }
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
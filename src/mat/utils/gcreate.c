@@ -304,6 +304,8 @@ PetscErrorCode MatSetFromOptions(Mat B)
 
   PetscCall(PetscOptionsName("-mat_is_symmetric", "Checks if mat is symmetric on MatAssemblyEnd()", "MatIsSymmetric", &B->checksymmetryonassembly));
   PetscCall(PetscOptionsReal("-mat_is_symmetric", "Checks if mat is symmetric on MatAssemblyEnd()", "MatIsSymmetric", B->checksymmetrytol, &B->checksymmetrytol, NULL));
+  PetscCall(PetscOptionsBool("-mat_detect_block_size", "Detects the block size of AIJ matrices on MatAssemblyEnd()", "MatSetBlockSize", B->detectblocksize, &B->detectblocksize, NULL));
+  PetscCall(PetscOptionsBool("-mat_detect_block_size_convert", "Converts AIJ matrices with a detected block size to BAIJ, or SBAIJ when their symmetry is eternal", "MatConvert", B->detectblocksizeconvert, &B->detectblocksizeconvert, NULL));
   PetscCall(PetscOptionsBool("-mat_null_space_test", "Checks if provided null space is correct in MatAssemblyEnd()", "MatSetNullSpaceTest", B->checknullspaceonassembly, &B->checknullspaceonassembly, NULL));
   PetscCall(PetscOptionsBool("-mat_error_if_failure", "Generate an error if an error occurs when factoring the matrix", "MatSetErrorIfFailure", B->erroriffailure, &B->erroriffailure, NULL));
 
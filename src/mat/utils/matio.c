@@ -1,5 +1,6 @@
 #include <petscviewer.h>
 #include <petsc/private/matimpl.h>
+#include <petscsf.h>
 
 PetscErrorCode MatView_Binary_BlockSizes(Mat mat, PetscViewer viewer)
 {
@@ -40,3 +41,159 @@ PetscErrorCode MatLoad_Binary_BlockSizes(Mat mat, PetscViewer viewer)
   PetscCall(MatSetBlockSizes(mat, rbs, cbs));
   PetscFunctionReturn(PETSC_SUCCESS);
 }
+
+typedef struct {
+  PetscErrorCode (*weight)(Mat, PetscInt, PetscInt, const PetscInt[], PetscReal[], void *);
+  void *ctx;
+} MatLoadRowWeight;
+
+/*@C
+  MatLoadSetRowWeightFunction - Sets a function that gives the work of each row, used by `MatLoad()` to balance the rows between the MPI processes
+
+  Logically Collective
+
+  Input Parameters:
++ mat    - the matrix, before `MatLoad()` is called
+. weight - the function, or `NULL` to balance the number of nonzeros
+- ctx    - optional context for the function
+
+  Calling sequence of `weight`:
++ mat     - the matrix
+. rstart  - the global index of the first row
+. n       - the number of rows
+. rowlens - the number of nonzeros of each row in the file
+. w       - the work of each row, computed by the function
+- ctx     - the context
+
+  Options Database Key:
+. -matload_balance_nonzeros - balance the rows by their number of nonzeros when the local sizes are not set
+
+  Level: advanced
+
+  Notes:
+  Setting the function turns on the balancing. Only `MATMPIAIJ` matrices loaded from a `PETSCVIEWERBINARY` viewer are balanced, and
+  only if their local sizes are not set. If the matrix is square the local column size is set to the local row size, so the vectors
+  created with `MatCreateVecs()` share the layout.
+
+  The row lengths are read from the file before the rows are distributed, then each MPI process reads its contiguous part of the
+  column indices and values, with a single collective read if the viewer uses MPI-IO, see `PetscViewerBinarySetUseMPIIO()`.
+
+.seealso: [](ch_matrices), `Mat`, `MatLoad()`, `PetscViewerBinaryOpen()`
+@*/
+PetscErrorCode MatLoadSetRowWeightFunction(Mat mat, PetscErrorCode (*weight)(Mat mat, PetscInt rstart, PetscInt n, const PetscInt rowlens[], PetscReal w[], void *ctx), void *ctx)
+{
+  MatLoadRowWeight *rw;
+  PetscContainer    container;
+
+  PetscFunctionBegin;
+  PetscValidHeaderSpecific(mat, MAT_CLASSID, 1);
+  PetscCall(PetscNew(&rw));
+  rw->weight = weight;
+  rw->ctx    = ctx;
+  PetscCall(PetscContainerCreate(PETSC_COMM_SELF, &container));
+  PetscCall(PetscContainerSetPointer(container, rw));
+  PetscCall(PetscContainerSetUserDestroy(container, PetscContainerUserDestroyDefault));
+  PetscCall(PetscObjectCompose((PetscObject)mat, "MatLoadRowWeight", (PetscObject)container));
+  PetscCall(PetscContainerDestroy(&container));
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
+
+/*
+  MatLoad_Binary_BalanceRows - Reads the row lengths of a matrix in a binary file and sets the local row sizes to balance the nonzeros,
+  or the work given by MatLoadSetRowWeightFunction(), between the MPI processes. Requested with -matload_balance_nonzeros.
+
+  Input Parameters:
++ mat    - the matrix, its global sizes and block sizes are set but not its local sizes
+- viewer - the viewer, positioned at the row lengths
+
+  Output Parameter:
+. rowidxs - rowidxs[1] to rowidxs[m] are the lengths of the m local rows, or NULL if the rows are not balanced; then nothing is read
+
+  Note:
+  The row lengths are read in the default layout, every row goes to the MPI process that owns the middle of its work in an equal
+  split of the total work, and the row lengths are then moved to the new layout with a `PetscSF`.
+*/
+PetscErrorCode MatLoad_Binary_BalanceRows(Mat mat, PetscViewer viewer, PetscInt *rowidxs[])
+{
+  MPI_Comm          comm = PetscObjectComm((PetscObject)mat);
+  PetscMPIInt       size, rank, p = 0;
+  PetscBool         balance = PETSC_FALSE;
+  PetscContainer    container;
+  MatLoadRowWeight *rw = NULL;
+  PetscLayout       dmap;
+  PetscSF           sf;
+  PetscInt          M, bs, dm, drstart, m, rstart, *dlens, *counts, *gcounts, *iremote;
+  PetscReal        *w, lwork = 0.0, offset = 0.0, total, cum = 0.0;
+
+  PetscFunctionBegin;
+  *rowidxs = NULL;
+  PetscCallMPI(MPI_Comm_size(comm, &size));
+  PetscCallMPI(MPI_Comm_rank(comm, &rank));
+  PetscCall(PetscObjectQuery((PetscObject)mat, "MatLoadRowWeight", (PetscObject *)&container));
+  if (container) {
+    PetscCall(PetscContainerGetPointer(container, (void **)&rw));
+    balance = PETSC_TRUE;
+  }
+  PetscCall(PetscOptionsGetBool(((PetscObject)mat)->options, ((PetscObject)mat)->prefix, "-matload_balance_nonzeros", &balance, NULL));
+  if (!balance || size == 1) PetscFunctionReturn(PETSC_SUCCESS);
+  if (mat->rmap->n >= 0) {
+    PetscCall(PetscInfo(mat, "Local row sizes are set, not balancing the rows\n"));
+    PetscFunctionReturn(PETSC_SUCCESS);
+  }
+
+  /* read in row lengths in the default layout */
+  M  = mat->rmap->N;
+  bs = PetscAbs(mat->rmap->bs);
+  PetscCall(PetscLayoutCreateFromSizes(comm, PETSC_DECIDE, M, bs, &dmap));
+  dm      = dmap->n;
+  drstart = dmap->rstart;
+  PetscCall(PetscMalloc2(dm, &dlens, dm, &w));
+  PetscCall(PetscViewerBinaryReadAll(viewer, dlens, dm, drstart, M, PETSC_INT));
+  if (rw && rw->weight) {
+    PetscCall((*rw->weight)(mat, drstart, dm, dlens, w, rw->ctx));
+  } else {
+    for (PetscInt i = 0; i < dm; i++) w[i] = (PetscReal)dlens[i];
+  }
+  for (PetscInt i = 0; i < dm; i++) lwork += w[i];
+  PetscCallMPI(MPI_Exscan(&lwork, &offset, 1, MPIU_REAL, MPIU_SUM, comm));
+  if (rank == 0) offset = 0.0;
+  PetscCall(MPIU_Allreduce(&lwork, &total, 1, MPIU_REAL, MPIU_SUM, comm));
+
+  /* count the rows going to each process, a block of rows goes to the process owning the middle of the work of its first row */
+  PetscCall(PetscCalloc2(size, &counts, size, &gcounts));
+  for (PetscInt i = 0; i < dm; i++) {
+    if ((drstart + i) % bs == 0) {
+      PetscReal mid = offset + cum + 0.5 * w[i];
+
+      p = total > 0.0 ? (PetscMPIInt)PetscClipInterval(PetscFloorReal(mid * size / total), 0, size - 1) : rank;
+    }
+    counts[p]++;
+    cum += w[i];
+  }
+  PetscCall(MPIU_Allreduce(counts, gcounts, size, MPIU_INT, MPI_SUM, comm));
+  m = gcounts[rank];
+  PetscCall(PetscFree2(counts, gcounts));
+
+  /* set the layout, square matrices get the same column layout */
+  mat->rmap->n = m;
+  if (mat->cmap->n < 0 && mat->cmap->N == M && PetscAbs(mat->cmap->bs) == bs) mat->cmap->n = m;
+  PetscCall(PetscLayoutSetUp(mat->rmap));
+  PetscCall(PetscLayoutSetUp(mat->cmap));
+  PetscCall(PetscInfo(mat, "Balanced rows, %" PetscInt_FMT " local rows instead of %" PetscInt_FMT "\n", m, dm));
+
+  /* move the row lengths to the new layout */
+  rstart = mat->rmap->rstart;
+  PetscCall(PetscMalloc1(m, &iremote));
+  for (PetscInt i = 0; i < m; i++) iremote[i] = rstart + i;
+  PetscCall(PetscSFCreate(comm, &sf));
+  PetscCall(PetscSFSetGraphLayout(sf, dmap, m, NULL, PETSC_OWN_POINTER, iremote));
+  PetscCall(PetscFree(iremote));
+  PetscCall(PetscMalloc1(m + 1, rowidxs));
+  (*rowidxs)[0] = 0;
+  PetscCall(PetscSFBcastBegin(sf, MPIU_INT, dlens, *rowidxs + 1, MPI_REPLACE));
+  PetscCall(PetscSFBcastEnd(sf, MPIU_INT, dlens, *rowidxs + 1, MPI_REPLACE));
+  PetscCall(PetscSFDestroy(&sf));
+  PetscCall(PetscFree2(dlens, w));
+  PetscCall(PetscLayoutDestroy(&dmap));
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
@@ -9,6 +9,8 @@ PETSC_INTERN PetscErrorCode MatStashScatterEnd_Ref(MatStash *);
 static PetscErrorCode MatStashScatterBegin_BTS(Mat, MatStash *, PetscInt *);
 static PetscErrorCode MatStashScatterGetMesg_BTS(MatStash *, PetscMPIInt *, PetscInt **, PetscInt **, PetscScalar **, PetscInt *);
 static PetscErrorCode MatStashScatterEnd_BTS(MatStash *);
+static PetscErrorCode MatStashFlush_BTS(Mat, MatStash *, PetscInt *);
+static PetscErrorCode MatStashFlushRecv_Private(MatStash *, PetscBool);
 #endif
 
 /*
@@ -75,6 +77,7 @@ PetscErrorCode MatStashCreate_Private(MPI_Comm comm, PetscInt bs, MatStash *stas
   stash->nprocessed  = 0;
   stash->reproduce   = PETSC_FALSE;
   stash->blocktype   = MPI_DATATYPE_NULL;
+  stash->flush_size  = 0;
 
   PetscCall(PetscOptionsGetBool(NULL, NULL, "-matstash_reproduce", &stash->reproduce, NULL));
 #if !defined(PETSC_HAVE_MPIUNI)
@@ -85,6 +88,15 @@ PetscErrorCode MatStashCreate_Private(MPI_Comm comm, PetscInt bs, MatStash *stas
     stash->ScatterGetMesg = MatStashScatterGetMesg_BTS;
     stash->ScatterEnd     = MatStashScatterEnd_BTS;
     stash->ScatterDestroy = MatStashScatterDestroy_BTS;
+    PetscCall(PetscOptionsGetInt(NULL, NULL, "-matstash_flush_size", &stash->flush_size, NULL));
+    if (stash->size == 1) stash->flush_size = 0;
+    if (stash->flush_size > 0) {
+      PetscCall(PetscCommGetNewTag(stash->comm, &stash->flush_tag[0]));
+      PetscCall(PetscCommGetNewTag(stash->comm, &stash->flush_tag[1]));
+      PetscCall(PetscCalloc1(stash->size, &stash->flush_nsent));
+      PetscCall(PetscSegBufferCreate(sizeof(MPI_Request), 16, &stash->flush_sendreqs));
+      PetscCall(PetscSegBufferCreate(sizeof(void *), 16, &stash->flush_sendbufs));
+    } else stash->flush_size = 0;
   } else {
 #endif
     stash->ScatterBegin   = MatStashScatterBegin_Ref;
@@ -103,6 +115,32 @@ PetscErrorCode MatStashCreate_Private(MPI_Comm comm, PetscInt bs, MatStash *stas
 PetscErrorCode MatStashDestroy_Private(MatStash *stash)
 {
   PetscFunctionBegin;
+  if (stash->flush_size) { /* Complete the messages flushed during MatSetValues() if the matrix was not assembled after them */
+#if !defined(PETSC_HAVE_MPIUNI)
+    MPI_Request *reqs;
+    char       **bufs;
+    size_t       nreqs, nbufs;
+
+  #if defined(PETSC_HAVE_MPI_REDUCE_SCATTER_BLOCK)
+    PetscCallMPI(MPI_Reduce_scatter_block(stash->flush_nsent, &stash->flush_nexpect, 1, MPI_INT, MPI_SUM, stash->comm));
+  #else
+    PetscCall(MPIU_Allreduce(MPI_IN_PLACE, stash->flush_nsent, stash->size, MPI_INT, MPI_SUM, stash->comm));
+    stash->flush_nexpect = stash->flush_nsent[stash->rank];
+  #endif
+    while (stash->flush_nrecvs < stash->flush_nexpect) PetscCall(MatStashFlushRecv_Private(stash, PETSC_TRUE));
+    PetscCall(PetscSegBufferGetSize(stash->flush_sendreqs, &nreqs));
+    PetscCall(PetscSegBufferExtractInPlace(stash->flush_sendreqs, &reqs));
+    PetscCallMPI(MPI_Waitall((PetscMPIInt)nreqs, reqs, MPI_STATUSES_IGNORE));
+    PetscCall(PetscSegBufferGetSize(stash->flush_sendbufs, &nbufs));
+    PetscCall(PetscSegBufferExtractInPlace(stash->flush_sendbufs, &bufs));
+    for (size_t b = 0; b < nbufs; b++) PetscCall(PetscFree(bufs[b]));
+#endif
+    for (PetscMPIInt r = 0; r < stash->flush_nrecvs; r++) PetscCall(PetscFree(stash->flush_recvframes[r].buffer));
+    PetscCall(PetscFree(stash->flush_recvframes));
+    PetscCall(PetscFree(stash->flush_nsent));
+    PetscCall(PetscSegBufferDestroy(&stash->flush_sendreqs));
+    PetscCall(PetscSegBufferDestroy(&stash->flush_sendbufs));
+  }
   PetscCall(PetscMatStashSpaceDestroy(&stash->space_head));
   if (stash->ScatterDestroy) PetscCall((*stash->ScatterDestroy)(stash));
   stash->space = NULL;
@@ -438,6 +476,32 @@ PetscErrorCode MatStashScatterBegin_Private(Mat mat, MatStash *stash, PetscInt *
   PetscFunctionReturn(PETSC_SUCCESS);
 }
 
+/*
+  MatStashFlush_Private - Sends the values in the stash to their owners before the assembly, called from MatSetValues() once the stash
+  has -matstash_flush_size blocks
+
+  Input Parameters:
+  mat    - the matrix
+  stash  - the stash
+  owners - the ownership ranges, as in MatStashScatterBegin_Private()
+
+  Notes:
+  The communication of the values then overlaps with the rest of the insertion, MatStashScatterBegin_Private() only sends what is left in
+  the stash, and MatStashScatterGetMesg_Private() returns the flushed values first. The flushed messages are received as they arrive
+  each time the stash is flushed, how much of the communication progresses in the background otherwise depends on the MPI implementation.
+
+  The stash is not flushed with the legacy scatters, nor with `MAT_SUBSET_OFF_PROC_ENTRIES`, where the communication pattern of the
+  first assembly, which only covers what is sent from the stash in MatStashScatterBegin_Private(), is reused by the later assemblies.
+*/
+PetscErrorCode MatStashFlush_Private(Mat mat, MatStash *stash, PetscInt *owners)
+{
+  PetscFunctionBegin;
+#if !defined(PETSC_HAVE_MPIUNI)
+  if (stash->flush_size && stash->n >= stash->flush_size && !mat->assembly_subset) PetscCall(MatStashFlush_BTS(mat, stash, owners));
+#endif
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
+
 static PetscErrorCode MatStashScatterBegin_Ref(Mat mat, MatStash *stash, PetscInt *owners)
 {
   PetscInt          *owner, *startv, *starti, tag1 = stash->tag1, tag2 = stash->tag2, bs2;
@@ -811,6 +875,90 @@ static PetscErrorCode MatStashBTSRecv_Private(MPI_Comm comm, const PetscMPIInt t
   PetscFunctionReturn(PETSC_SUCCESS);
 }
 
+/*
+    Receives the flushed messages of this assembly that have arrived, or waits for one message
+ */
+static PetscErrorCode MatStashFlushRecv_Private(MatStash *stash, PetscBool wait)
+{
+  PetscMPIInt tag = stash->flush_tag[stash->flush_parity];
+
+  PetscFunctionBegin;
+  PetscCall(MatStashBlockTypeSetUp(stash));
+  while (1) {
+    MPI_Status     status;
+    PetscMPIInt    flg = 1, count;
+    MatStashFrame *frame;
+
+    if (wait) PetscCallMPI(MPI_Probe(MPI_ANY_SOURCE, tag, stash->comm, &status));
+    else PetscCallMPI(MPI_Iprobe(MPI_ANY_SOURCE, tag, stash->comm, &flg, &status));
+    if (!flg) break;
+    PetscCallMPI(MPI_Get_count(&status, stash->blocktype, &count));
+    if (stash->flush_nrecvs == stash->flush_maxrecvs) {
+      stash->flush_maxrecvs = 2 * stash->flush_maxrecvs + 4;
+      PetscCall(PetscRealloc(stash->flush_maxrecvs * sizeof(MatStashFrame), &stash->flush_recvframes));
+    }
+    frame = &stash->flush_recvframes[stash->flush_nrecvs++];
+    PetscCall(PetscMalloc(count * stash->blocktype_size, &frame->buffer));
+    PetscCallMPI(MPI_Recv(frame->buffer, count, stash->blocktype, status.MPI_SOURCE, tag, stash->comm, MPI_STATUS_IGNORE));
+    frame->count   = count;
+    frame->pending = 0;
+    if (wait) break;
+  }
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
+
+/*
+    Sends the compressed stash to the owners in one message per owner, see MatStashFlush_Private()
+ */
+static PetscErrorCode MatStashFlush_BTS(Mat mat, MatStash *stash, PetscInt owners[])
+{
+  PetscMPIInt tag = stash->flush_tag[stash->flush_parity];
+  size_t      nblocks, rowstart, i;
+  char       *sendblocks, **buf;
+
+  PetscFunctionBegin;
+  PetscCall(MatStashBlockTypeSetUp(stash));
+  PetscCall(MatStashSortCompress_Private(stash, mat->insertmode));
+  PetscCall(PetscSegBufferGetSize(stash->segsendblocks, &nblocks));
+  PetscCall(PetscSegBufferExtractAlloc(stash->segsendblocks, &sendblocks));
+  PetscCall(PetscSegBufferGet(stash->flush_sendbufs, 1, &buf));
+  *buf = sendblocks;
+  for (rowstart = 0; rowstart < nblocks;) {
+    PetscInt       owner;
+    PetscMPIInt    count;
+    MPI_Request   *req;
+    MatStashBlock *sendblock_rowstart = (MatStashBlock *)&sendblocks[rowstart * stash->blocktype_size];
+
+    PetscCall(PetscFindInt(sendblock_rowstart->row, stash->size + 1, owners, &owner));
+    if (owner < 0) owner = -(owner + 2);
+    for (i = rowstart + 1; i < nblocks; i++) { /* Move forward through a run of blocks with the same owner */
+      MatStashBlock *sendblock_i = (MatStashBlock *)&sendblocks[i * stash->blocktype_size];
+      if (sendblock_i->row >= owners[owner + 1]) break;
+    }
+    if (mat->insertmode == INSERT_VALUES) { /* Encode insertmode as in MatStashScatterBegin_BTS() */
+      for (size_t b = rowstart; b < i; b++) {
+        MatStashBlock *sendblock_b = (MatStashBlock *)&sendblocks[b * stash->blocktype_size];
+        sendblock_b->row           = -(sendblock_b->row + 1);
+      }
+    }
+    PetscCall(PetscMPIIntCast(i - rowstart, &count));
+    PetscCall(PetscSegBufferGet(stash->flush_sendreqs, 1, &req));
+    PetscCallMPI(MPI_Isend(sendblock_rowstart, count, stash->blocktype, (PetscMPIInt)owner, tag, stash->comm, req));
+    stash->flush_nsent[owner]++;
+    rowstart = i;
+  }
+
+  /* Empty the stash, keeping the statistics used to size it */
+  stash->nmax = 0;
+  stash->n    = 0;
+  PetscCall(PetscMatStashSpaceDestroy(&stash->space_head));
+  stash->space = NULL;
+
+  /* Make progress on the messages flushed to this rank */
+  PetscCall(MatStashFlushRecv_Private(stash, PETSC_FALSE));
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
+
 /*
  * owners[] contains the ownership ranges; may be indexed by either blocks or scalars
  */
@@ -826,6 +974,18 @@ static PetscErrorCode MatStashScatterBegin_BTS(Mat mat, MatStash *stash, PetscIn
     PetscCheck(addv != (ADD_VALUES | INSERT_VALUES), PetscObjectComm((PetscObject)mat), PETSC_ERR_ARG_WRONGSTATE, "Some processors inserted others added");
   }
 
+  if (stash->flush_size) { /* Number of messages flushed to this rank during MatSetValues() */
+#if defined(PETSC_HAVE_MPI_REDUCE_SCATTER_BLOCK)
+    PetscCallMPI(MPI_Reduce_scatter_block(stash->flush_nsent, &stash->flush_nexpect, 1, MPI_INT, MPI_SUM, stash->comm));
+#else
+    PetscCall(MPIU_Allreduce(MPI_IN_PLACE, stash->flush_nsent, stash->size, MPI_INT, MPI_SUM, stash->comm));
+    stash->flush_nexpect = stash->flush_nsent[stash->rank];
+#endif
+    PetscCall(PetscArrayzero(stash->flush_nsent, stash->size));
+    stash->flush_recvframe   = 0;
+    stash->flush_recvframe_i = 0;
+  }
+
   PetscCall(MatStashBlockTypeSetUp(stash));
   PetscCall(MatStashSortCompress_Private(stash, mat->insertmode));
   PetscCall(PetscSegBufferGetSize(stash->segsendblocks, &nblocks));
@@ -924,6 +1084,32 @@ static PetscErrorCode MatStashScatterGetMesg_BTS(MatStash *stash, PetscMPIInt *n
 
   PetscFunctionBegin;
   *flg = 0;
+  while (stash->flush_size) { /* First the messages flushed during MatSetValues() */
+    if (stash->flush_recvframe < stash->flush_nrecvs) {
+      MatStashFrame *frame = &stash->flush_recvframes[stash->flush_recvframe];
+
+      if (stash->flush_recvframe_i < frame->count) {
+        block = (MatStashBlock *)&((char *)frame->buffer)[stash->flush_recvframe_i * stash->blocktype_size];
+        if (!stash->flush_recvframe_i) { /* Check for InsertMode consistency */
+          if (PetscUnlikely(*stash->insertmode == NOT_SET_VALUES)) *stash->insertmode = block->row < 0 ? INSERT_VALUES : ADD_VALUES;
+          PetscCheck(*stash->insertmode != INSERT_VALUES || block->row < 0, PETSC_COMM_SELF, PETSC_ERR_ARG_WRONGSTATE, "Assembling INSERT_VALUES, but another rank requested ADD_VALUES");
+          PetscCheck(*stash->insertmode != ADD_VALUES || block->row >= 0, PETSC_COMM_SELF, PETSC_ERR_ARG_WRONGSTATE, "Assembling ADD_VALUES, but another rank requested INSERT_VALUES");
+        }
+        if (block->row < 0) block->row = -(block->row + 1);
+        *n   = 1;
+        *row = &block->row;
+        *col = &block->col;
+        *val = block->vals;
+        stash->flush_recvframe_i++;
+        *flg = 1;
+        PetscFunctionReturn(PETSC_SUCCESS);
+      }
+      stash->flush_recvframe++;
+      stash->flush_recvframe_i = 0;
+    } else if (stash->flush_nrecvs < stash->flush_nexpect) {
+      PetscCall(MatStashFlushRecv_Private(stash, PETSC_TRUE));
+    } else break;
+  }
   while (!stash->recvframe_active || stash->recvframe_i == stash->recvframe_count) {
     if (stash->some_i == stash->some_count) {
       if (stash->recvcount == stash->nrecvranks) PetscFunctionReturn(PETSC_SUCCESS); /* Done */
@@ -960,6 +1146,22 @@ static PetscErrorCode MatStashScatterEnd_BTS(MatStash *stash)
 {
   PetscFunctionBegin;
   PetscCallMPI(MPI_Waitall(stash->nsendranks, stash->sendreqs, MPI_STATUSES_IGNORE));
+  if (stash->flush_size) { /* Complete the messages flushed during MatSetValues() */
+    MPI_Request *reqs;
+    char       **bufs;
+    size_t       nreqs, nbufs;
+
+    PetscCall(PetscSegBufferGetSize(stash->flush_sendreqs, &nreqs));
+    PetscCall(PetscSegBufferExtractInPlace(stash->flush_sendreqs, &reqs));
+    PetscCallMPI(MPI_Waitall((PetscMPIInt)nreqs, reqs, MPI_STATUSES_IGNORE));
+    PetscCall(PetscSegBufferGetSize(stash->flush_sendbufs, &nbufs));
+    PetscCall(PetscSegBufferExtractInPlace(stash->flush_sendbufs, &bufs));
+    for (size_t b = 0; b < nbufs; b++) PetscCall(PetscFree(bufs[b]));
+    for (PetscMPIInt r = 0; r < stash->flush_nrecvs; r++) PetscCall(PetscFree(stash->flush_recvframes[r].buffer));
+    stash->flush_nrecvs  = 0;
+    stash->flush_nexpect = 0;
+    stash->flush_parity  = !stash->flush_parity;
+  }
   if (stash->first_assembly_done) { /* Reuse the communication contexts, so consolidate and reset segrecvblocks  */
     PetscCall(PetscSegBufferExtractInPlace(stash->segrecvblocks, NULL));
   } else { /* No reuse, so collect everything. */
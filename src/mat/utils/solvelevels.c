@@ -0,0 +1,113 @@
+#include <petsc/private/matimpl.h>
+
+/*
+  MatSolveLevelsUse_Private - Determines if the triangular solves of the factor fact are level scheduled, requested with -mat_solve_levels
+
+  Level scheduling only pays off with several OpenMP threads and factors with many rows per level, so it is not used by default
+*/
+PetscErrorCode MatSolveLevelsUse_Private(Mat fact, PetscBool *use)
+{
+  PetscFunctionBegin;
+  *use = PETSC_FALSE;
+  PetscCall(PetscOptionsGetBool(((PetscObject)fact)->options, ((PetscObject)fact)->prefix, "-mat_solve_levels", use, NULL));
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
+
+/*
+  MatSolveLevelsCreate_Private - Computes the level sets of one sweep of a sparse triangular solve
+
+  Input Parameters:
++ n         - number of rows
+. bi, ei    - the strictly triangular entries of row r are j[bi[r]] to j[ei[r]-1]
+. j         - column indices of the factor
+. backward  - the sweep goes from the last row to the first
+- transpose - the sweep is with the transpose of the stored rows, then the dependencies are stored in lev
+
+  Output Parameter:
+. lev - the level sets
+
+  Note:
+  A row is in level l when the largest level of the rows it depends on is l-1, so all rows of a level can be computed concurrently once
+  the earlier levels are done.
+*/
+PetscErrorCode MatSolveLevelsCreate_Private(PetscInt n, const PetscInt bi[], const PetscInt ei[], const PetscInt j[], PetscBool backward, PetscBool transpose, Mat_SolveLevels *lev)
+{
+  PetscInt *level, *fill, nlevels = 0;
+
+  PetscFunctionBegin;
+  PetscCall(MatSolveLevelsReset_Private(lev));
+  if (transpose) {
+    PetscInt nz;
+
+    PetscCall(PetscCalloc1(n + 1, &lev->i));
+    for (PetscInt r = 0; r < n; r++) {
+      for (PetscInt k = bi[r]; k < ei[r]; k++) lev->i[j[k] + 1]++;
+    }
+    for (PetscInt r = 0; r < n; r++) lev->i[r + 1] += lev->i[r];
+    nz = lev->i[n];
+    PetscCall(PetscMalloc2(nz, &lev->j, nz, &lev->idx));
+    PetscCall(PetscMalloc1(n, &fill));
+    PetscCall(PetscArraycpy(fill, lev->i, n));
+    for (PetscInt r = 0; r < n; r++) {
+      for (PetscInt k = bi[r]; k < ei[r]; k++) {
+        PetscInt c = j[k];
+
+        lev->j[fill[c]]     = r;
+        lev->idx[fill[c]++] = k;
+      }
+    }
+    PetscCall(PetscFree(fill));
+  }
+
+  PetscCall(PetscMalloc1(n, &level));
+  for (PetscInt t = 0; t < n; t++) {
+    PetscInt r = backward ? n - 1 - t : t, l = 0;
+
+    if (transpose) {
+      for (PetscInt k = lev->i[r]; k < lev->i[r + 1]; k++) l = PetscMax(l, level[lev->j[k]] + 1);
+    } else {
+      for (PetscInt k = bi[r]; k < ei[r]; k++) l = PetscMax(l, level[j[k]] + 1);
+    }
+    level[r] = l;
+    nlevels  = PetscMax(nlevels, l + 1);
+  }
+
+  /* sort the rows by level, in the order of the sweep within each level */
+  lev->nlevels = nlevels;
+  PetscCall(PetscCalloc1(nlevels + 1, &lev->ptr));
+  PetscCall(PetscMalloc1(n, &lev->rows));
+  for (PetscInt r = 0; r < n; r++) lev->ptr[level[r] + 1]++;
+  for (PetscInt l = 0; l < nlevels; l++) lev->ptr[l + 1] += lev->ptr[l];
+  PetscCall(PetscMalloc1(nlevels, &fill));
+  PetscCall(PetscArraycpy(fill, lev->ptr, nlevels));
+  for (PetscInt t = 0; t < n; t++) {
+    PetscInt r = backward ? n - 1 - t : t;
+
+    lev->rows[fill[level[r]]++] = r;
+  }
+  PetscCall(PetscFree(fill));
+  PetscCall(PetscFree(level));
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
+
+PetscErrorCode MatSolveLevelsReset_Private(Mat_SolveLevels *lev)
+{
+  PetscFunctionBegin;
+  PetscCall(PetscFree(lev->ptr));
+  PetscCall(PetscFree(lev->rows));
+  PetscCall(PetscFree(lev->i));
+  PetscCall(PetscFree2(lev->j, lev->idx));
+  lev->nlevels = 0;
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
+
+PetscErrorCode MatSolveLevelsView_Private(const Mat_SolveLevels *lev, const char name[], PetscViewer viewer)
+{
+  PetscInt maxrows = 0;
+
+  PetscFunctionBegin;
+  if (!lev->nlevels) PetscFunctionReturn(PETSC_SUCCESS);
+  for (PetscInt l = 0; l < lev->nlevels; l++) maxrows = PetscMax(maxrows, lev->ptr[l + 1] - lev->ptr[l]);
+  PetscCall(PetscViewerASCIIPrintf(viewer, "%s: %" PetscInt_FMT " levels, %g rows per level on average, largest level %" PetscInt_FMT " rows\n", name, lev->nlevels, (double)lev->ptr[lev->nlevels] / lev->nlevels, maxrows));
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
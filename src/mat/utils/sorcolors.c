@@ -0,0 +1,94 @@
+#include <petsc/private/matimpl.h>
+
+/*
+  MatSORColorsSetUp_Private - Colors the rows of a sequential matrix for multicolor MatSOR(), requested with -mat_sor_multicolor
+
+  Input Parameters:
++ A    - the matrix, its options prefix and nonzero state are used
+. n    - number of (block) rows
+- i, j - the (block) nonzero structure of A
+
+  Output Parameter:
+. sc - the colors, sc->ncolors is zero if multicolor MatSOR() is not used
+
+  Notes:
+  The coloring is recomputed only when the nonzero structure of A changes. It is a distance one coloring of the structure of A + A^T
+  computed with `MatColoringApply()`, of type -mat_sor_multicolor_type (greedy by default), so rows of the same color are not coupled
+  and can be relaxed concurrently. Sweeping color by color is SOR for the matrix permuted by colors.
+*/
+PetscErrorCode MatSORColorsSetUp_Private(Mat A, PetscInt n, const PetscInt i[], const PetscInt j[], Mat_SORColors *sc)
+{
+  PetscBool              use = PETSC_FALSE;
+  char                   type[256] = MATCOLORINGGREEDY;
+  Mat                    G, Gt;
+  PetscScalar           *v;
+  MatColoring            mc;
+  ISColoring             iscoloring;
+  const ISColoringValue *colors;
+  PetscInt               nc, *fill;
+
+  PetscFunctionBegin;
+  if (sc->setup && sc->nonzerostate == A->nonzerostate) PetscFunctionReturn(PETSC_SUCCESS);
+  PetscCall(MatSORColorsReset_Private(sc));
+  sc->setup        = PETSC_TRUE;
+  sc->nonzerostate = A->nonzerostate;
+  PetscCall(PetscOptionsGetBool(((PetscObject)A)->options, ((PetscObject)A)->prefix, "-mat_sor_multicolor", &use, NULL));
+  if (!use || !n) PetscFunctionReturn(PETSC_SUCCESS);
+  PetscCall(PetscOptionsGetString(((PetscObject)A)->options, ((PetscObject)A)->prefix, "-mat_sor_multicolor_type", type, sizeof(type), NULL));
+
+  /* the graph of A + A^T */
+  PetscCall(PetscMalloc1(i[n], &v));
+  for (PetscInt k = 0; k < i[n]; k++) v[k] = 1.0;
+  PetscCall(MatCreateSeqAIJWithArrays(PETSC_COMM_SELF, n, n, (PetscInt *)i, (PetscInt *)j, v, &G));
+  PetscCall(MatTranspose(G, MAT_INITIAL_MATRIX, &Gt));
+  PetscCall(MatAXPY(Gt, 1.0, G, DIFFERENT_NONZERO_PATTERN));
+  PetscCall(MatDestroy(&G));
+  PetscCall(PetscFree(v));
+
+  PetscCall(MatColoringCreate(Gt, &mc));
+  PetscCall(MatColoringSetDistance(mc, 1));
+  PetscCall(MatColoringSetType(mc, type));
+  PetscCall(MatColoringSetWeightType(mc, MAT_COLORING_WEIGHT_LEXICAL));
+  PetscCall(MatColoringApply(mc, &iscoloring));
+  PetscCall(MatColoringDestroy(&mc));
+  PetscCall(MatDestroy(&Gt));
+  PetscCall(ISColoringGetColors(iscoloring, NULL, &nc, &colors));
+
+  /* sort the rows by color, in increasing order within each color */
+  sc->ncolors = nc;
+  PetscCall(PetscCalloc1(nc + 1, &sc->ptr));
+  PetscCall(PetscMalloc2(n, &sc->rows, n, &sc->color));
+  for (PetscInt r = 0; r < n; r++) {
+    sc->color[r] = (PetscInt)colors[r];
+    sc->ptr[sc->color[r] + 1]++;
+  }
+  for (PetscInt c = 0; c < nc; c++) sc->ptr[c + 1] += sc->ptr[c];
+  PetscCall(PetscMalloc1(nc, &fill));
+  PetscCall(PetscArraycpy(fill, sc->ptr, nc));
+  for (PetscInt r = 0; r < n; r++) sc->rows[fill[sc->color[r]]++] = r;
+  PetscCall(PetscFree(fill));
+  PetscCall(ISColoringDestroy(&iscoloring));
+  PetscCall(PetscInfo(A, "Multicolor SOR with %" PetscInt_FMT " colors of %s coloring for %" PetscInt_FMT " rows\n", nc, type, n));
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
+
+PetscErrorCode MatSORColorsReset_Private(Mat_SORColors *sc)
+{
+  PetscFunctionBegin;
+  PetscCall(PetscFree(sc->ptr));
+  PetscCall(PetscFree2(sc->rows, sc->color));
+  sc->ncolors = 0;
+  sc->setup   = PETSC_FALSE;
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
+
+PetscErrorCode MatSORColorsView_Private(const Mat_SORColors *sc, PetscViewer viewer)
+{
+  PetscInt maxrows = 0;
+
+  PetscFunctionBegin;
+  if (!sc->ncolors) PetscFunctionReturn(PETSC_SUCCESS);
+  for (PetscInt c = 0; c < sc->ncolors; c++) maxrows = PetscMax(maxrows, sc->ptr[c + 1] - sc->ptr[c]);
+  PetscCall(PetscViewerASCIIPrintf(viewer, "multicolor SOR: %" PetscInt_FMT " colors, largest color %" PetscInt_FMT " rows\n", sc->ncolors, maxrows));
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
@@ -0,0 +1,176 @@
+#include <petsc/private/matimpl.h>
+#if defined(PETSC_HAVE_OPENMP)
+  #include <omp.h>
+#endif
+
+/*
+  MatThreadedAssemblyCreate_Private - Creates the per-thread staging buffers of MAT_THREADED_ASSEMBLY, one for each OpenMP thread
+
+  The buffers are created here since allocating them from the threads would require thread safe memory allocation for more than
+  the growth of the buffers.
+*/
+PetscErrorCode MatThreadedAssemblyCreate_Private(Mat mat, Mat_ThreadedAssembly **ta)
+{
+  Mat_ThreadedAssembly *t;
+
+  PetscFunctionBegin;
+  PetscCall(PetscNew(&t));
+  t->ncoo = -1; /* no merge yet */
+#if defined(PETSC_HAVE_OPENMP)
+  t->nthreads = PetscMax(PetscNumOMPThreads, 1);
+#else
+  t->nthreads = 1;
+#endif
+  PetscCall(PetscMalloc3(t->nthreads, &t->segi, t->nthreads, &t->segj, t->nthreads, &t->segv));
+  for (PetscInt k = 0; k < t->nthreads; k++) {
+    PetscCall(PetscSegBufferCreate(sizeof(PetscInt), 1024, &t->segi[k]));
+    PetscCall(PetscSegBufferCreate(sizeof(PetscInt), 1024, &t->segj[k]));
+    PetscCall(PetscSegBufferCreate(sizeof(PetscScalar), 1024, &t->segv[k]));
+  }
+  PetscCall(PetscInfo(mat, "Threaded assembly with %" PetscInt_FMT " staging buffers\n", t->nthreads));
+  *ta = t;
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
+
+PetscErrorCode MatThreadedAssemblyDestroy_Private(Mat_ThreadedAssembly **ta)
+{
+  Mat_ThreadedAssembly *t = *ta;
+
+  PetscFunctionBegin;
+  if (!t) PetscFunctionReturn(PETSC_SUCCESS);
+  for (PetscInt k = 0; k < t->nthreads; k++) {
+    PetscCall(PetscSegBufferDestroy(&t->segi[k]));
+    PetscCall(PetscSegBufferDestroy(&t->segj[k]));
+    PetscCall(PetscSegBufferDestroy(&t->segv[k]));
+  }
+  PetscCall(PetscFree3(t->segi, t->segj, t->segv));
+  PetscCall(PetscFree(t->coo_i));
+  PetscCall(PetscFree(t->coo_j));
+  PetscCall(PetscFree(t->coo_v));
+  PetscCall(PetscFree(*ta));
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
+
+/*
+  MatThreadedAssemblySetValues_Private - Appends a logically dense, row oriented block of values to the buffers of the calling thread
+
+  Entries with a negative row or column index are dropped. Only the buffers of the calling thread are touched, so this can be called
+  concurrently by the threads of an OpenMP parallel region.
+*/
+PetscErrorCode MatThreadedAssemblySetValues_Private(Mat mat, PetscInt m, const PetscInt idxm[], PetscInt n, const PetscInt idxn[], const PetscScalar v[])
+{
+  Mat_ThreadedAssembly *ta  = mat->threadedassembly;
+  PetscInt              tid = 0, nz = 0, *bi, *bj;
+  PetscScalar          *bv;
+
+  PetscFunctionBegin;
+#if defined(PETSC_HAVE_OPENMP)
+  tid = omp_get_thread_num();
+#endif
+  PetscCheck(tid < ta->nthreads, PETSC_COMM_SELF, PETSC_ERR_ARG_OUTOFRANGE, "MatSetValues() from thread %" PetscInt_FMT " but MAT_THREADED_ASSEMBLY was set with %" PetscInt_FMT " threads", tid, ta->nthreads);
+  for (PetscInt i = 0; i < m; i++) {
+    if (idxm[i] < 0) continue;
+    for (PetscInt j = 0; j < n; j++) nz += idxn[j] >= 0;
+  }
+  if (!nz) PetscFunctionReturn(PETSC_SUCCESS);
+  PetscCall(PetscSegBufferGet(ta->segi[tid], nz, &bi));
+  PetscCall(PetscSegBufferGet(ta->segj[tid], nz, &bj));
+  PetscCall(PetscSegBufferGet(ta->segv[tid], nz, &bv));
+  for (PetscInt i = 0, k = 0; i < m; i++) {
+    if (idxm[i] < 0) continue;
+    for (PetscInt j = 0; j < n; j++) {
+      if (idxn[j] < 0) continue;
+      bi[k]   = idxm[i];
+      bj[k]   = idxn[j];
+      bv[k++] = v ? v[i * n + j] : 0.0;
+    }
+  }
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
+
+/*
+  MatThreadedAssemblyMerge_Private - Sets the values staged by the threads since the last assembly into the matrix, called by MatAssemblyBegin()
+
+  Notes:
+  The staged entries of all threads, in thread order, are the COO entries of the matrix. When every process staged the same indices in the same
+  order as at the previous merge only MatSetValuesCOO() is called, otherwise the COO preallocation is computed again first.
+*/
+PetscErrorCode MatThreadedAssemblyMerge_Private(Mat mat, MatAssemblyType type)
+{
+  Mat_ThreadedAssembly *ta = mat->threadedassembly;
+  size_t                len;
+  PetscCount            ncoo = 0, offset;
+  PetscInt             *coo_i, *coo_j;
+  PetscMPIInt           flg[3], gflg[3];
+
+  PetscFunctionBegin;
+  PetscCheck(type == MAT_FINAL_ASSEMBLY, PetscObjectComm((PetscObject)mat), PETSC_ERR_SUP, "MAT_FLUSH_ASSEMBLY is not supported with MAT_THREADED_ASSEMBLY");
+  for (PetscInt k = 0; k < ta->nthreads; k++) {
+    PetscCall(PetscSegBufferGetSize(ta->segi[k], &len));
+    ncoo += (PetscCount)len;
+  }
+  PetscCall(PetscMalloc1(ncoo, &coo_i));
+  PetscCall(PetscMalloc1(ncoo, &coo_j));
+  offset = 0;
+  for (PetscInt k = 0; k < ta->nthreads; k++) {
+    PetscCall(PetscSegBufferGetSize(ta->segi[k], &len));
+    PetscCall(PetscSegBufferExtractTo(ta->segi[k], coo_i + offset));
+    PetscCall(PetscSegBufferExtractTo(ta->segj[k], coo_j + offset));
+    offset += (PetscCount)len;
+  }
+
+  /* is anything staged, has the pattern changed on any process, and the insert mode of the processes that staged entries */
+  flg[0] = ncoo > 0;
+  flg[1] = ncoo != ta->ncoo;
+  flg[2] = (PetscMPIInt)mat->insertmode;
+  if (!flg[1]) {
+    PetscBool same;
+
+    PetscCall(PetscArraycmp(coo_i, ta->coo_i, ncoo, &same));
+    if (same) PetscCall(PetscArraycmp(coo_j, ta->coo_j, ncoo, &same));
+    flg[1] = !same;
+  }
+  PetscCall(MPIU_Allreduce(flg, gflg, 3, MPI_INT, MPI_MAX, PetscObjectComm((PetscObject)mat)));
+  if (!gflg[0]) {
+    PetscCall(PetscFree(coo_i));
+    PetscCall(PetscFree(coo_j));
+    PetscFunctionReturn(PETSC_SUCCESS);
+  }
+  if (gflg[1]) {
+    PetscCall(PetscFree(ta->coo_i));
+    PetscCall(PetscFree(ta->coo_j));
+    PetscCall(PetscFree(ta->coo_v));
+    PetscCall(PetscMalloc1(ncoo, &ta->coo_v));
+    ta->ncoo  = ncoo;
+    ta->coo_i = coo_i;
+    ta->coo_j = coo_j;
+  } else {
+    PetscCall(PetscFree(coo_i));
+    PetscCall(PetscFree(coo_j));
+  }
+  offset = 0;
+  for (PetscInt k = 0; k < ta->nthreads; k++) {
+    PetscCall(PetscSegBufferGetSize(ta->segv[k], &len));
+    PetscCall(PetscSegBufferExtractTo(ta->segv[k], ta->coo_v + offset));
+    offset += (PetscCount)len;
+  }
+
+  /* MatSetValuesCOO() assembles the matrix, possibly with MatSetValues(), which must not be staged. The insert mode of the staged
+     MatSetValues() is reset, since the preallocation of the types without native COO support inserts with INSERT_VALUES */
+  mat->threadedassembly = NULL;
+  mat->insertmode       = NOT_SET_VALUES;
+  if (gflg[1]) {
+    PetscInt *ci, *cj;
+
+    PetscCall(PetscInfo(mat, "New COO pattern with %" PetscCount_FMT " staged entries\n", ncoo));
+    /* MatSetPreallocationCOO() may modify the indices, which are kept to detect the same pattern at the next assembly */
+    PetscCall(PetscMalloc2(ncoo, &ci, ncoo, &cj));
+    PetscCall(PetscArraycpy(ci, ta->coo_i, ncoo));
+    PetscCall(PetscArraycpy(cj, ta->coo_j, ncoo));
+    PetscCall(MatSetPreallocationCOO(mat, ncoo, ci, cj));
+    PetscCall(PetscFree2(ci, cj));
+  }
+  PetscCall(MatSetValuesCOO(mat, ta->coo_v, gflg[2] == INSERT_VALUES ? INSERT_VALUES : ADD_VALUES));
+  mat->threadedassembly = ta;
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
@@ -675,6 +675,12 @@ PetscErrorCode NonlinearGS(SNES snes, Vec X, Vec B, void *ctx)
       args: -snes_monitor_short -pc_type mg -dm_mat_type baij -mg_coarse_pc_type bjacobi -da_refine 3 -ksp_type fgmres
       requires: !single
 
+   test:
+      suffix: sor_multicolor
+      nsize: 2
+      args: -snes_monitor_short -ksp_converged_reason -pc_type mg -dm_mat_type {{aij baij}separate output} -da_refine 2 -ksp_type fgmres -mat_sor_multicolor
+      requires: !single
+
    test:
       suffix: 14_ds
       nsize: 4
@@ -925,6 +931,21 @@ PetscErrorCode NonlinearGS(SNES snes, Vec X, Vec B, void *ctx)
       args: -ksp_type ibcgs -ksp_monitor_short -da_refine 2 -snes_view
       requires: !complex !single
 
+   test:
+      suffix: ilut
+      args: -da_refine 2 -pc_type ilu -pc_factor_drop_tolerance 0.01,0,5 -snes_monitor_short -snes_converged_reason
+      requires: !single
+
+   test:
+      suffix: ilut_baij
+      args: -da_refine 2 -dm_mat_type baij -pc_type ilu -pc_factor_drop_tolerance 0.01,0,5 -snes_monitor_short -snes_converged_reason
+      requires: !single
+
+   test:
+      suffix: ilutp
+      args: -da_refine 2 -pc_type ilu -pc_factor_drop_tolerance 0.01,0.5,5 -pc_factor_mat_ordering_type rcm -snes_monitor_short -snes_converged_reason
+      requires: !single
+
    test:
       suffix: kaczmarz
       nsize: 2
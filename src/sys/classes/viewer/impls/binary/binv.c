@@ -1,4 +1,7 @@
 #include <petsc/private/viewerimpl.h> /*I   "petscviewer.h"   I*/
+#if defined(PETSC_HAVE_MMAP) && !defined(PETSC_USE_REAL___FLOAT128)
+  #include <sys/mman.h>
+#endif
 
 /*
    This needs to start the same as PetscViewer_Socket.
@@ -13,15 +16,17 @@ typedef struct {
   MPI_File   mfsub; /* subviewer support */
   MPI_Offset moff;
 #endif
-  char         *filename;            /* file name */
-  PetscFileMode filemode;            /* read/write/append mode */
-  FILE         *fdes_info;           /* optional file containing info on binary file*/
-  PetscBool     storecompressed;     /* gzip the write binary file when closing it*/
-  char         *ogzfilename;         /* gzip can be run after the filename has been updated */
-  PetscBool     skipinfo;            /* Don't create info file for writing; don't use for reading */
-  PetscBool     skipoptions;         /* don't use PETSc options database when loading */
-  PetscBool     matlabheaderwritten; /* if format is PETSC_VIEWER_BINARY_MATLAB has the MATLAB .info header been written yet */
-  PetscBool     setfromoptionscalled;
+  char          *filename;            /* file name */
+  PetscFileMode  filemode;            /* read/write/append mode */
+  FILE          *fdes_info;           /* optional file containing info on binary file*/
+  PetscBool      storecompressed;     /* gzip the write binary file when closing it*/
+  char          *ogzfilename;         /* gzip can be run after the filename has been updated */
+  PetscBool      skipinfo;            /* Don't create info file for writing; don't use for reading */
+  PetscBool      skipoptions;         /* don't use PETSc options database when loading */
+  PetscBool      matlabheaderwritten; /* if format is PETSC_VIEWER_BINARY_MATLAB has the MATLAB .info header been written yet */
+  PetscBool      setfromoptionscalled;
+  PetscBool      usemmap; /* map the file with mmap() when loading, see PetscViewerBinaryReadMMap_Private() */
+  PetscContainer map;     /* the mapped file, also composed with the objects that use the mapped data */
 } PetscViewer_Binary;
 
 static PetscErrorCode PetscViewerBinaryClearFunctionList(PetscViewer v)
@@ -44,6 +49,8 @@ static PetscErrorCode PetscViewerBinaryClearFunctionList(PetscViewer v)
   PetscCall(PetscObjectComposeFunction((PetscObject)v, "PetscViewerBinaryGetUseMPIIO_C", NULL));
   PetscCall(PetscObjectComposeFunction((PetscObject)v, "PetscViewerBinarySetUseMPIIO_C", NULL));
 #endif
+  PetscCall(PetscObjectComposeFunction((PetscObject)v, "PetscViewerBinaryGetUseMMap_C", NULL));
+  PetscCall(PetscObjectComposeFunction((PetscObject)v, "PetscViewerBinarySetUseMMap_C", NULL));
   PetscFunctionReturn(PETSC_SUCCESS);
 }
 
@@ -328,6 +335,84 @@ static PetscErrorCode PetscViewerBinaryGetUseMPIIO_Binary(PetscViewer viewer, Pe
 }
 #endif
 
+/*@
+  PetscViewerBinarySetUseMMap - Sets a binary viewer to map the file into memory with `mmap()` when loading objects
+
+  Logically Collective
+
+  Input Parameters:
++ viewer - the `PetscViewer`; must be a `PETSCVIEWERBINARY`
+- use    - `PETSC_TRUE` means the file will be mapped
+
+  Options Database Key:
+. -viewer_binary_mmap - <true or false> flag for mapping the file
+
+  Level: advanced
+
+  Notes:
+  With a mapped file `MatLoad()` for `MATSEQAIJ` and `VecLoad()` for `VECSEQ` do not allocate and read the column indices, the
+  nonzero values and the vector entries, the object uses the data in the mapping directly. The mapping is private, pages are
+  copied only if the object changes them. The mapping stays alive until the viewer is closed and all objects using it are destroyed.
+
+  PETSc binary files are big-endian, so the file is only mapped on big-endian systems, where the data is used as it is in the file. On
+  little-endian systems, as for data that is not aligned in the file for its type, objects on more than one MPI process and viewers using
+  MPI-IO, the data is read as usual.
+
+.seealso: [](sec_viewers), `PETSCVIEWERBINARY`, `PetscViewerBinaryOpen()`, `PetscViewerBinaryGetUseMMap()`, `PetscViewerBinarySetUseMPIIO()`,
+          `MatLoad()`, `VecLoad()`
+@*/
+PetscErrorCode PetscViewerBinarySetUseMMap(PetscViewer viewer, PetscBool use)
+{
+  PetscFunctionBegin;
+  PetscValidHeaderSpecific(viewer, PETSC_VIEWER_CLASSID, 1);
+  PetscValidLogicalCollectiveBool(viewer, use, 2);
+  PetscTryMethod(viewer, "PetscViewerBinarySetUseMMap_C", (PetscViewer, PetscBool), (viewer, use));
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
+
+static PetscErrorCode PetscViewerBinarySetUseMMap_Binary(PetscViewer viewer, PetscBool use)
+{
+  PetscViewer_Binary *vbinary = (PetscViewer_Binary *)viewer->data;
+
+  PetscFunctionBegin;
+  vbinary->usemmap = use;
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
+
+/*@
+  PetscViewerBinaryGetUseMMap - Returns `PETSC_TRUE` if the binary viewer maps the file into memory when loading objects
+
+  Not Collective
+
+  Input Parameter:
+. viewer - `PetscViewer` context, obtained from `PetscViewerBinaryOpen()`; must be a `PETSCVIEWERBINARY`
+
+  Output Parameter:
+. use - `PETSC_TRUE` if the file is mapped
+
+  Level: advanced
+
+.seealso: [](sec_viewers), `PETSCVIEWERBINARY`, `PetscViewerBinaryOpen()`, `PetscViewerBinarySetUseMMap()`
+@*/
+PetscErrorCode PetscViewerBinaryGetUseMMap(PetscViewer viewer, PetscBool *use)
+{
+  PetscFunctionBegin;
+  PetscValidHeaderSpecific(viewer, PETSC_VIEWER_CLASSID, 1);
+  PetscAssertPointer(use, 2);
+  *use = PETSC_FALSE;
+  PetscTryMethod(viewer, "PetscViewerBinaryGetUseMMap_C", (PetscViewer, PetscBool *), (viewer, use));
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
+
+static PetscErrorCode PetscViewerBinaryGetUseMMap_Binary(PetscViewer viewer, PetscBool *use)
+{
+  PetscViewer_Binary *vbinary = (PetscViewer_Binary *)viewer->data;
+
+  PetscFunctionBegin;
+  *use = vbinary->usemmap;
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
+
 /*@
   PetscViewerBinarySetFlowControl - Sets how many messages are allowed to be outstanding at the same time during parallel IO reads/writes
 
@@ -763,6 +848,7 @@ static PetscErrorCode PetscViewerFileClose_BinarySTDIO(PetscViewer v)
   PetscViewer_Binary *vbinary = (PetscViewer_Binary *)v->data;
 
   PetscFunctionBegin;
+  PetscCall(PetscContainerDestroy(&vbinary->map));
   if (vbinary->fdes != -1) {
     PetscCall(PetscBinaryClose(vbinary->fdes));
     vbinary->fdes = -1;
@@ -853,7 +939,8 @@ static PetscErrorCode PetscViewerDestroy_Binary(PetscViewer v)
 . -viewer_binary_skip_info       - true to skip opening an info file
 . -viewer_binary_skip_options    - true to not use options database while creating viewer
 . -viewer_binary_skip_header     - true to skip output object headers to the file
-- -viewer_binary_mpiio           - true to use MPI-IO for input and output to the file (more scalable for large problems)
+. -viewer_binary_mpiio           - true to use MPI-IO for input and output to the file (more scalable for large problems)
+- -viewer_binary_mmap            - true to map the file into memory when loading sequential matrices and vectors
 
   Level: beginner
 
@@ -869,7 +956,7 @@ static PetscErrorCode PetscViewerDestroy_Binary(PetscViewer v)
 .seealso: [](sec_viewers), `PETSCVIEWERBINARY`, `PetscViewerASCIIOpen()`, `PetscViewerPushFormat()`, `PetscViewerDestroy()`,
           `VecView()`, `MatView()`, `VecLoad()`, `MatLoad()`, `PetscViewerBinaryGetDescriptor()`,
           `PetscViewerBinaryGetInfoPointer()`, `PetscFileMode`, `PetscViewer`, `PetscViewerBinaryRead()`, `PetscViewerBinarySetUseMPIIO()`,
-          `PetscViewerBinaryGetUseMPIIO()`, `PetscViewerBinaryGetMPIIOOffset()`
+          `PetscViewerBinaryGetUseMPIIO()`, `PetscViewerBinaryGetMPIIOOffset()`, `PetscViewerBinarySetUseMMap()`
 @*/
 PetscErrorCode PetscViewerBinaryOpen(MPI_Comm comm, const char name[], PetscFileMode mode, PetscViewer *viewer)
 {
@@ -955,6 +1042,106 @@ PetscErrorCode PetscViewerBinaryRead(PetscViewer viewer, void *data, PetscInt nu
   PetscFunctionReturn(PETSC_SUCCESS);
 }
 
+#if defined(PETSC_HAVE_MMAP) && !defined(PETSC_USE_REAL___FLOAT128)
+typedef struct {
+  void  *addr;
+  size_t len;
+} PetscViewerBinaryMap;
+
+static PetscErrorCode PetscViewerBinaryMapDestroy_Private(void *ctx)
+{
+  PetscViewerBinaryMap *map = (PetscViewerBinaryMap *)ctx;
+
+  PetscFunctionBegin;
+  if (map->len) PetscCheck(!munmap(map->addr, map->len), PETSC_COMM_SELF, PETSC_ERR_SYS, "munmap() failed on binary file");
+  PetscCall(PetscFree(map));
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
+#endif
+
+/*
+  PetscViewerBinaryReadMMap_Private - Reads from a binary file by pointing into the file mapped with mmap(), requested with -viewer_binary_mmap
+
+  Input Parameters:
++ viewer - the `PETSCVIEWERBINARY` viewer
+. num    - number of items of data to read
+. dtype  - type of data to read, `PETSC_INT`, `PETSC_REAL` or `PETSC_SCALAR`
+- obj    - the object that uses the data, the mapping is composed with it so it stays alive as long as obj, or NULL if the data is used right away
+
+  Output Parameter:
+. data - the data in the mapped file, or NULL if the data must be read with `PetscViewerBinaryRead()`; then nothing is read
+
+  Notes:
+  The data is only mapped on big-endian systems, whose byte order is that of the file, for viewers on one MPI process that read without MPI-IO.
+  The mapping is private so the data can be changed, which copies the changed pages. Data that is not aligned in the file for its type is not mapped.
+*/
+PetscErrorCode PetscViewerBinaryReadMMap_Private(PetscViewer viewer, PetscInt num, PetscDataType dtype, void **data, PetscObject obj)
+{
+#if defined(PETSC_HAVE_MMAP) && !defined(PETSC_USE_REAL___FLOAT128)
+  PetscViewer_Binary   *vbinary;
+  PetscViewerBinaryMap *map;
+  PetscMPIInt           size;
+  size_t                tsize, align;
+  off_t                 off, end;
+  char                 *p;
+#endif
+
+  PetscFunctionBegin;
+  PetscValidHeaderSpecificType(viewer, PETSC_VIEWER_CLASSID, 1, PETSCVIEWERBINARY);
+  PetscAssertPointer(data, 4);
+  *data = NULL;
+#if defined(PETSC_HAVE_MMAP) && !defined(PETSC_USE_REAL___FLOAT128)
+  PetscCheck(dtype == PETSC_INT || dtype == PETSC_REAL || dtype == PETSC_SCALAR, PETSC_COMM_SELF, PETSC_ERR_SUP, "Only PETSC_INT, PETSC_REAL and PETSC_SCALAR data can be mapped");
+  PetscCall(PetscViewerSetUp(viewer));
+  vbinary = (PetscViewer_Binary *)viewer->data;
+  if (!vbinary->usemmap || vbinary->filemode != FILE_MODE_READ || num <= 0) PetscFunctionReturn(PETSC_SUCCESS);
+  #if defined(PETSC_HAVE_MPIIO)
+  if (vbinary->usempiio) PetscFunctionReturn(PETSC_SUCCESS);
+  #endif
+  PetscCallMPI(MPI_Comm_size(PetscObjectComm((PetscObject)viewer), &size));
+  if (size > 1) PetscFunctionReturn(PETSC_SUCCESS);
+  /* byte swapping the data in place would copy every page of the mapping, more work than reading it */
+  if (!PetscBinaryBigEndian()) {
+    PetscCall(PetscInfo(viewer, "Little-endian system, reading file %s instead of mapping it\n", vbinary->filename));
+    vbinary->usemmap = PETSC_FALSE;
+    PetscFunctionReturn(PETSC_SUCCESS);
+  }
+
+  PetscCall(PetscBinarySeek(vbinary->fdes, 0, PETSC_BINARY_SEEK_CUR, &off));
+  if (!vbinary->map) {
+    PetscCall(PetscNew(&map));
+    PetscCall(PetscBinarySeek(vbinary->fdes, 0, PETSC_BINARY_SEEK_END, &end));
+    PetscCall(PetscBinarySeek(vbinary->fdes, off, PETSC_BINARY_SEEK_SET, &off));
+    map->len  = (size_t)end;
+    map->addr = map->len ? mmap(NULL, map->len, PROT_READ | PROT_WRITE, MAP_PRIVATE, vbinary->fdes, 0) : NULL;
+    if (map->addr == MAP_FAILED) {
+      PetscCall(PetscInfo(viewer, "mmap() failed on file %s, reading it\n", vbinary->filename));
+      PetscCall(PetscFree(map));
+      vbinary->usemmap = PETSC_FALSE;
+      PetscFunctionReturn(PETSC_SUCCESS);
+    }
+    PetscCall(PetscContainerCreate(PETSC_COMM_SELF, &vbinary->map));
+    PetscCall(PetscContainerSetPointer(vbinary->map, map));
+    PetscCall(PetscContainerSetUserDestroy(vbinary->map, PetscViewerBinaryMapDestroy_Private));
+    PetscCall(PetscInfo(viewer, "Mapped %zu bytes of file %s\n", map->len, vbinary->filename));
+  }
+  PetscCall(PetscContainerGetPointer(vbinary->map, (void **)&map));
+
+  PetscCall(PetscDataTypeGetSize(dtype, &tsize));
+  align = dtype == PETSC_INT ? sizeof(PetscInt) : sizeof(PetscReal);
+  PetscCheck((size_t)off + (size_t)num * tsize <= map->len, PETSC_COMM_SELF, PETSC_ERR_FILE_READ, "Read past end of file");
+  if ((size_t)off % align) {
+    PetscCall(PetscInfo(viewer, "Data at offset %zu is not aligned, reading it\n", (size_t)off));
+    PetscFunctionReturn(PETSC_SUCCESS);
+  }
+  p = (char *)map->addr + off;
+  PetscCall(PetscBinarySeek(vbinary->fdes, (off_t)((size_t)num * tsize), PETSC_BINARY_SEEK_CUR, &off));
+  if (obj) PetscCall(PetscObjectCompose(obj, "PetscViewerBinaryMMap", (PetscObject)vbinary->map));
+  *data = p;
+#endif
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
+
 /*@C
   PetscViewerBinaryWrite - writes to a binary file, only from the first MPI rank
 
@@ -1502,6 +1689,7 @@ static PetscErrorCode PetscViewerSetFromOptions_Binary(PetscViewer viewer, Petsc
 #else
   PetscCall(PetscOptionsBool("-viewer_binary_mpiio", "Use MPI-IO functionality to write/read binary file (NOT AVAILABLE)", "PetscViewerBinarySetUseMPIIO", PETSC_FALSE, &flg, NULL));
 #endif
+  PetscCall(PetscOptionsBool("-viewer_binary_mmap", "Map the binary file into memory when loading sequential objects", "PetscViewerBinarySetUseMMap", binary->usemmap, &binary->usemmap, NULL));
   PetscOptionsHeadEnd();
   binary->setfromoptionscalled = PETSC_TRUE;
   PetscFunctionReturn(PETSC_SUCCESS);
@@ -1550,6 +1738,8 @@ PETSC_EXTERN PetscErrorCode PetscViewerCreate_Binary(PetscViewer v)
   vbinary->storecompressed = PETSC_FALSE;
   vbinary->ogzfilename     = NULL;
   vbinary->flowcontrol     = 256; /* seems a good number for Cray XT-5 */
+  vbinary->usemmap         = PETSC_FALSE;
+  vbinary->map             = NULL;
 
   vbinary->setfromoptionscalled = PETSC_FALSE;
 
@@ -1570,6 +1760,8 @@ PETSC_EXTERN PetscErrorCode PetscViewerCreate_Binary(PetscViewer v)
   PetscCall(PetscObjectComposeFunction((PetscObject)v, "PetscViewerBinaryGetUseMPIIO_C", PetscViewerBinaryGetUseMPIIO_Binary));
   PetscCall(PetscObjectComposeFunction((PetscObject)v, "PetscViewerBinarySetUseMPIIO_C", PetscViewerBinarySetUseMPIIO_Binary));
 #endif
+  PetscCall(PetscObjectComposeFunction((PetscObject)v, "PetscViewerBinaryGetUseMMap_C", PetscViewerBinaryGetUseMMap_Binary));
+  PetscCall(PetscObjectComposeFunction((PetscObject)v, "PetscViewerBinarySetUseMMap_C", PetscViewerBinarySetUseMMap_Binary));
   PetscFunctionReturn(PETSC_SUCCESS);
 }
 
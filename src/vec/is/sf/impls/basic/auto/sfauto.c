@@ -0,0 +1,338 @@
+#include <../src/vec/is/sf/impls/basic/sfpack.h>
+#include <../src/vec/is/sf/impls/basic/sfbasic.h>
+#include <petsctime.h>
+
+/*
+   PETSCSFAUTO selects the fastest of several PetscSF types for its graph by timing a few rounds of PetscSFBcastBegin()/End() and
+   PetscSFReduceBegin()/End() with each of them, then turns itself into that type with PetscSFSetType(). The timings are done on
+   temporary star forests with the same graph, and the slowest process decides for each type so that all processes select the same.
+
+   Since the selection costs the setup of every candidate type, it is by default deferred until the star forest has been used for a
+   number of broadcasts and reductions, as a VecScatter in MatMult() is, so that star forests used only a few times are never timed.
+   Until then the star forest works as PETSCSFBASIC.
+*/
+
+#define PETSCSF_AUTO_MAXTYPES 16
+
+typedef struct {
+  SFBASICHEADER;
+  PetscInt  nuses;                        /* Number of broadcasts and reductions before the selection, 0 to select in PetscSFSetUp() */
+  PetscInt  uses;                         /* Number of broadcasts and reductions started so far */
+  PetscInt  nrounds;                      /* Number of timed rounds of a broadcast and a reduction per candidate type */
+  PetscInt  ntypes;                       /* Number of candidate types given by the user, 0 for the default ones */
+  char     *types[PETSCSF_AUTO_MAXTYPES]; /* Candidate types given by the user */
+  PetscBool setfromoptions;               /* PetscSFSetFromOptions() was called, so the candidate types read their options too */
+} PetscSF_Auto;
+
+/* Candidate types when none is given, all of them usable with any graph */
+static const char *const PetscSFAutoDefaultTypes[] = {PETSCSFBASIC,
+#if defined(PETSC_HAVE_MPI_NEIGHBORHOOD_COLLECTIVES)
+                                                      PETSCSFNEIGHBOR,
+#endif
+#if defined(PETSC_HAVE_MPI_PROCESS_SHARED_MEMORY)
+                                                      PETSCSFNODE,
+#endif
+                                                      NULL};
+
+/*===================================================================================*/
+/*              Internal routines for PetscSFAuto                                    */
+/*===================================================================================*/
+
+/* Let an instance of a candidate type read its own options, with the prefix of the star forest it is a candidate for */
+static PetscErrorCode PetscSFAutoSetTypeFromOptions_Private(PetscSF sf)
+{
+  PetscFunctionBegin;
+  PetscObjectOptionsBegin((PetscObject)sf);
+  PetscTryTypeMethod(sf, SetFromOptions, PetscOptionsObject);
+  PetscOptionsEnd();
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
+
+/* One round of the benchmark, a broadcast followed by a reduction, as in a MatMult() followed by a MatMultTranspose() */
+static PetscErrorCode PetscSFAutoRound_Private(PetscSF sf, PetscScalar *rootdata, PetscScalar *leafdata)
+{
+  PetscFunctionBegin;
+  PetscCall(PetscSFBcastBegin(sf, MPIU_SCALAR, rootdata, leafdata, MPI_REPLACE));
+  PetscCall(PetscSFBcastEnd(sf, MPIU_SCALAR, rootdata, leafdata, MPI_REPLACE));
+  PetscCall(PetscSFReduceBegin(sf, MPIU_SCALAR, leafdata, rootdata, MPI_SUM));
+  PetscCall(PetscSFReduceEnd(sf, MPIU_SCALAR, leafdata, rootdata, MPI_SUM));
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
+
+/* Time nrounds rounds on a temporary star forest of the given type with the graph of sf. The time is the maximum over processes */
+static PetscErrorCode PetscSFAutoTime_Private(PetscSF sf, PetscSFType type, PetscInt nrounds, PetscBool setfromoptions, PetscLogDouble *time)
+{
+  PetscSF            tsf;
+  PetscInt           nroots, nleaves, maxleaf;
+  const PetscInt    *ilocal;
+  const PetscSFNode *iremote;
+  PetscScalar       *rootdata, *leafdata;
+  PetscLogDouble     t;
+  PetscLogEvent      event;
+  char               name[64];
+  MPI_Comm           comm;
+
+  PetscFunctionBegin;
+  PetscCall(PetscObjectGetComm((PetscObject)sf, &comm));
+  PetscCall(PetscSFGetGraph(sf, &nroots, &nleaves, &ilocal, &iremote));
+  PetscCall(PetscSFGetLeafRange(sf, NULL, &maxleaf));
+  PetscCall(PetscSFCreate(comm, &tsf));
+  PetscCall(PetscObjectSetOptionsPrefix((PetscObject)tsf, ((PetscObject)sf)->prefix));
+  PetscCall(PetscSFSetType(tsf, type));
+  if (setfromoptions) PetscCall(PetscSFAutoSetTypeFromOptions_Private(tsf));
+  PetscCall(PetscSFSetGraph(tsf, nroots, nleaves, (PetscInt *)ilocal, PETSC_COPY_VALUES, (PetscSFNode *)iremote, PETSC_COPY_VALUES));
+  PetscCall(PetscSFSetUp(tsf));
+  PetscCall(PetscCalloc2(nroots, &rootdata, maxleaf + 1, &leafdata));
+
+  /* The first round creates the links, and with them the buffers, persistent requests or windows, which the timed rounds reuse */
+  PetscCall(PetscSFAutoRound_Private(tsf, rootdata, leafdata));
+  PetscCall(PetscSNPrintf(name, sizeof(name), "SFAuto_%s", type));
+  PetscCall(PetscLogEventRegister(name, PETSCSF_CLASSID, &event));
+  PetscCallMPI(MPI_Barrier(comm));
+  PetscCall(PetscLogEventBegin(event, sf, 0, 0, 0));
+  PetscCall(PetscTime(&t));
+  for (PetscInt r = 0; r < nrounds; r++) PetscCall(PetscSFAutoRound_Private(tsf, rootdata, leafdata));
+  PetscCall(PetscTimeSubtract(&t));
+  PetscCall(PetscLogEventEnd(event, sf, 0, 0, 0));
+  *time = -t;
+  PetscCall(MPIU_Allreduce(MPI_IN_PLACE, time, 1, MPI_DOUBLE, MPI_MAX, comm));
+
+  PetscCall(PetscFree2(rootdata, leafdata));
+  PetscCall(PetscSFDestroy(&tsf));
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
+
+/* Time the candidate types, then turn sf into the fastest one and set it up. sf->data is freed in the process */
+static PetscErrorCode PetscSFAutoSelect_Private(PetscSF sf)
+{
+  PetscSF_Auto *dat            = (PetscSF_Auto *)sf->data;
+  PetscInt      nrounds        = dat->nrounds, ntypes = 0;
+  PetscBool     setfromoptions = dat->setfromoptions, setup = (PetscBool)(dat->nuses > 0);
+  char          types[PETSCSF_AUTO_MAXTYPES][64], best[64];
+  PetscMPIInt   size;
+  PetscErrorCode (*sfmalloc)(PetscMemType, size_t, void **);
+  PetscErrorCode (*sffree)(PetscMemType, void *);
+
+  PetscFunctionBegin;
+  PetscCall(PetscLogEventBegin(PETSCSF_AutoSelect, sf, 0, 0, 0));
+  /* Copy the candidate types, since the PetscSFSetType() below frees dat */
+  if (dat->ntypes) {
+    for (; ntypes < dat->ntypes; ntypes++) PetscCall(PetscStrncpy(types[ntypes], dat->types[ntypes], sizeof(types[ntypes])));
+  } else {
+    for (; PetscSFAutoDefaultTypes[ntypes]; ntypes++) PetscCall(PetscStrncpy(types[ntypes], PetscSFAutoDefaultTypes[ntypes], sizeof(types[ntypes])));
+  }
+  PetscCall(PetscStrncpy(best, types[0], sizeof(best)));
+  PetscCallMPI(MPI_Comm_size(PetscObjectComm((PetscObject)sf), &size));
+  if (size > 1 && ntypes > 1) {
+    PetscLogDouble time, besttime = PETSC_MAX_REAL;
+
+    for (PetscInt i = 0; i < ntypes; i++) {
+      PetscCall(PetscSFAutoTime_Private(sf, types[i], nrounds, setfromoptions, &time));
+      PetscCall(PetscInfo(sf, "Type %s: %g seconds for %" PetscInt_FMT " rounds of broadcast and reduction\n", types[i], time, nrounds));
+      if (time < besttime) {
+        besttime = time;
+        PetscCall(PetscStrncpy(best, types[i], sizeof(best)));
+      }
+    }
+  }
+  PetscCall(PetscInfo(sf, "Selected type %s among %" PetscInt_FMT " candidate types\n", best, ntypes));
+
+  /* A star forest used before the selection was set up as PETSCSFBASIC, whose ranks the setup of the selected type recomputes */
+  if (setup) {
+    sf->nranks = -1;
+    PetscCall(PetscFree4(sf->ranks, sf->roffset, sf->rmine, sf->rremote));
+#if defined(PETSC_HAVE_DEVICE)
+    for (PetscInt i = 0; i < 2; i++) PetscCall(PetscSFFree(sf, PETSC_MEMTYPE_DEVICE, sf->rmine_d[i]));
+#endif
+  }
+  /* PetscSFSetType() zeros sf->ops, including the device allocators PetscSFSetUp() sets after the setup of the type */
+  sfmalloc = sf->ops->Malloc;
+  sffree   = sf->ops->Free;
+  PetscCall(PetscSFSetType(sf, best));
+  if (setfromoptions) PetscCall(PetscSFAutoSetTypeFromOptions_Private(sf));
+  PetscTryTypeMethod(sf, SetUp);
+  sf->ops->Malloc = sfmalloc;
+  sf->ops->Free   = sffree;
+  PetscCall(PetscLogEventEnd(PETSCSF_AutoSelect, sf, 0, 0, 0));
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
+
+/* Whether the next broadcast or reduction should select the type first. All processes agree, since they start the same operations */
+static inline PetscBool PetscSFAutoSelectNow_Private(PetscSF sf)
+{
+  PetscSF_Auto *dat = (PetscSF_Auto *)sf->data;
+
+  return (PetscBool)(dat->nuses > 0 && dat->uses++ >= dat->nuses && !dat->inuse);
+}
+
+/*===================================================================================*/
+/*              SF public interface implementations                                  */
+/*===================================================================================*/
+static PetscErrorCode PetscSFSetUp_Auto(PetscSF sf)
+{
+  PetscSF_Auto *dat = (PetscSF_Auto *)sf->data;
+
+  PetscFunctionBegin;
+  if (dat->nuses > 0) PetscCall(PetscSFSetUp_Basic(sf));
+  else PetscCall(PetscSFAutoSelect_Private(sf));
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
+
+static PetscErrorCode PetscSFDestroy_Auto(PetscSF sf)
+{
+  PetscSF_Auto *dat = (PetscSF_Auto *)sf->data;
+
+  PetscFunctionBegin;
+  for (PetscInt i = 0; i < dat->ntypes; i++) PetscCall(PetscFree(dat->types[i]));
+  PetscCall(PetscSFDestroy_Basic(sf));
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
+
+static PetscErrorCode PetscSFView_Auto(PetscSF sf, PetscViewer viewer)
+{
+  PetscSF_Auto *dat = (PetscSF_Auto *)sf->data;
+  PetscBool     isascii;
+
+  PetscFunctionBegin;
+  PetscCall(PetscObjectTypeCompare((PetscObject)viewer, PETSCVIEWERASCII, &isascii));
+  if (isascii) {
+    PetscCall(PetscViewerASCIIPrintf(viewer, "  selects its type after %" PetscInt_FMT " uses, with %" PetscInt_FMT " timed rounds, among", dat->nuses, dat->nrounds));
+    PetscCall(PetscViewerASCIIUseTabs(viewer, PETSC_FALSE));
+    if (dat->ntypes) {
+      for (PetscInt i = 0; i < dat->ntypes; i++) PetscCall(PetscViewerASCIIPrintf(viewer, " %s", dat->types[i]));
+    } else {
+      for (PetscInt i = 0; PetscSFAutoDefaultTypes[i]; i++) PetscCall(PetscViewerASCIIPrintf(viewer, " %s", PetscSFAutoDefaultTypes[i]));
+    }
+    PetscCall(PetscViewerASCIIPrintf(viewer, "\n"));
+    PetscCall(PetscViewerASCIIUseTabs(viewer, PETSC_TRUE));
+  }
+  PetscCall(PetscSFView_Basic(sf, viewer));
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
+
+static PetscErrorCode PetscSFSetFromOptions_Auto(PetscSF sf, PetscOptionItems *PetscOptionsObject)
+{
+  PetscSF_Auto *dat = (PetscSF_Auto *)sf->data;
+  char         *types[PETSCSF_AUTO_MAXTYPES];
+  PetscInt      ntypes = PETSCSF_AUTO_MAXTYPES;
+  PetscBool     flg, match;
+
+  PetscFunctionBegin;
+  PetscOptionsHeadBegin(PetscOptionsObject, "PetscSF Auto options");
+  PetscCall(PetscOptionsInt("-sf_auto_uses", "Number of broadcasts and reductions before selecting the type, 0 to select it in PetscSFSetUp()", "PetscSFSetFromOptions", dat->nuses, &dat->nuses, NULL));
+  PetscCall(PetscOptionsInt("-sf_auto_rounds", "Number of timed rounds of a broadcast and a reduction per candidate type", "PetscSFSetFromOptions", dat->nrounds, &dat->nrounds, NULL));
+  PetscCall(PetscOptionsStringArray("-sf_auto_types", "Candidate types", "PetscSFSetFromOptions", types, &ntypes, &flg));
+  if (flg) {
+    PetscCheck(ntypes > 0, PetscObjectComm((PetscObject)sf), PETSC_ERR_ARG_WRONG, "-sf_auto_types needs at least one type");
+    for (PetscInt i = 0; i < ntypes; i++) {
+      PetscErrorCode (*r)(PetscSF);
+
+      PetscCall(PetscFunctionListFind(PetscSFList, types[i], &r));
+      PetscCheck(r, PetscObjectComm((PetscObject)sf), PETSC_ERR_ARG_UNKNOWN_TYPE, "Unable to find requested PetscSF type %s", types[i]);
+      PetscCall(PetscStrcmpAny(types[i], &match, PETSCSFAUTO, PETSCSFALLGATHERV, PETSCSFALLGATHER, PETSCSFGATHERV, PETSCSFGATHER, PETSCSFALLTOALL, ""));
+      PetscCheck(!match, PetscObjectComm((PetscObject)sf), PETSC_ERR_ARG_WRONG, "PetscSF type %s is not a candidate type for a general graph", types[i]);
+    }
+    for (PetscInt i = 0; i < dat->ntypes; i++) PetscCall(PetscFree(dat->types[i]));
+    for (PetscInt i = 0; i < ntypes; i++) dat->types[i] = types[i];
+    dat->ntypes = ntypes;
+  }
+  PetscOptionsHeadEnd();
+  PetscCheck(dat->nuses >= 0, PetscObjectComm((PetscObject)sf), PETSC_ERR_ARG_OUTOFRANGE, "Number of uses %" PetscInt_FMT " must be nonnegative", dat->nuses);
+  PetscCheck(dat->nrounds > 0, PetscObjectComm((PetscObject)sf), PETSC_ERR_ARG_OUTOFRANGE, "Number of rounds %" PetscInt_FMT " must be positive", dat->nrounds);
+  dat->setfromoptions = PETSC_TRUE;
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
+
+static PetscErrorCode PetscSFDuplicate_Auto(PetscSF sf, PetscSFDuplicateOption opt, PetscSF newsf)
+{
+  PetscSF_Auto *dat = (PetscSF_Auto *)sf->data, *ndat = (PetscSF_Auto *)newsf->data;
+
+  PetscFunctionBegin;
+  ndat->nuses          = dat->nuses;
+  ndat->nrounds        = dat->nrounds;
+  ndat->setfromoptions = dat->setfromoptions;
+  for (PetscInt i = 0; i < ndat->ntypes; i++) PetscCall(PetscFree(ndat->types[i]));
+  for (PetscInt i = 0; i < dat->ntypes; i++) PetscCall(PetscStrallocpy(dat->types[i], &ndat->types[i]));
+  ndat->ntypes = dat->ntypes;
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
+
+/* Until the selection sf->ops holds the routines below, so the operation itself is that of PETSCSFBASIC */
+static PetscErrorCode PetscSFBcastBegin_Auto(PetscSF sf, MPI_Datatype unit, PetscMemType rootmtype, const void *rootdata, PetscMemType leafmtype, void *leafdata, MPI_Op op)
+{
+  PetscFunctionBegin;
+  if (PetscSFAutoSelectNow_Private(sf)) {
+    PetscCall(PetscSFAutoSelect_Private(sf));
+    PetscUseTypeMethod(sf, BcastBegin, unit, rootmtype, rootdata, leafmtype, leafdata, op);
+  } else PetscCall(PetscSFBcastBegin_Basic(sf, unit, rootmtype, rootdata, leafmtype, leafdata, op));
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
+
+static PetscErrorCode PetscSFReduceBegin_Auto(PetscSF sf, MPI_Datatype unit, PetscMemType leafmtype, const void *leafdata, PetscMemType rootmtype, void *rootdata, MPI_Op op)
+{
+  PetscFunctionBegin;
+  if (PetscSFAutoSelectNow_Private(sf)) {
+    PetscCall(PetscSFAutoSelect_Private(sf));
+    PetscUseTypeMethod(sf, ReduceBegin, unit, leafmtype, leafdata, rootmtype, rootdata, op);
+  } else PetscCall(PetscSFReduceBegin_Basic(sf, unit, leafmtype, leafdata, rootmtype, rootdata, op));
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
+
+/*MC
+   PETSCSFAUTO - "auto" - A `PetscSF` type that times a few broadcasts and reductions with each of several candidate types and
+   turns itself into the fastest one
+
+   Options Database Keys:
++  -sf_auto_uses <n>            - number of broadcasts and reductions after which the type is selected, 0 to select it in `PetscSFSetUp()` (default 10)
+.  -sf_auto_rounds <n>          - number of timed rounds of a broadcast and a reduction per candidate type (default 5)
+-  -sf_auto_types <t1,t2,...>   - candidate types, by default `PETSCSFBASIC`, `PETSCSFNEIGHBOR` and `PETSCSFNODE` when MPI supports them
+
+   Level: advanced
+
+   Notes:
+   Each candidate type is set up on a temporary star forest with the same graph, then timed on rounds of a `PetscSFBcastBegin()`/`PetscSFBcastEnd()`
+   and a `PetscSFReduceBegin()`/`PetscSFReduceEnd()` of `PetscScalar`. The time of a type is the maximum over the processes, so that they all select
+   the same type. The star forest then becomes of the selected type, as with `PetscSFSetType()`, and `PetscSFGetType()` returns it.
+
+   Since the selection costs the setup of every candidate type, it is meant for star forests used many times, such as the `VecScatter`
+   of `MatMult()` for `MATMPIAIJ`. By default it happens at the first broadcast or reduction after the star forest has been used 10 times,
+   so that star forests used only a few times never pay for it. Until then the star forest works as `PETSCSFBASIC`.
+
+   The selection is logged in the event SFAutoSelect and the timed rounds of each candidate type in the event SFAuto_<type>, which
+   `-log_view` shows. The time and the decision are reported by `PetscInfo()`, shown with `-info :sf`.
+
+   Type specific options, such as `-sf_node_size`, are used by the candidate types when `PetscSFSetFromOptions()` was called.
+
+.seealso: `PetscSF`, `PetscSFType`, `PetscSFSetType()`, `PETSCSFBASIC`, `PETSCSFNEIGHBOR`, `PETSCSFNODE`
+M*/
+
+PETSC_INTERN PetscErrorCode PetscSFCreate_Auto(PetscSF sf)
+{
+  PetscSF_Auto *dat;
+
+  PetscFunctionBegin;
+  sf->ops->SetUp                = PetscSFSetUp_Auto;
+  sf->ops->Reset                = PetscSFReset_Basic;
+  sf->ops->Destroy              = PetscSFDestroy_Auto;
+  sf->ops->View                 = PetscSFView_Auto;
+  sf->ops->SetFromOptions       = PetscSFSetFromOptions_Auto;
+  sf->ops->Duplicate            = PetscSFDuplicate_Auto;
+  sf->ops->BcastBegin           = PetscSFBcastBegin_Auto;
+  sf->ops->BcastEnd             = PetscSFBcastEnd_Basic;
+  sf->ops->ReduceBegin          = PetscSFReduceBegin_Auto;
+  sf->ops->ReduceEnd            = PetscSFReduceEnd_Basic;
+  sf->ops->FetchAndOpBegin      = PetscSFFetchAndOpBegin_Basic;
+  sf->ops->FetchAndOpEnd        = PetscSFFetchAndOpEnd_Basic;
+  sf->ops->GetLeafRanks         = PetscSFGetLeafRanks_Basic;
+  sf->ops->SetCommunicationOps  = PetscSFSetCommunicationOps_Basic;
+  /* No CreateEmbeddedRootSF, since that of PETSCSFBASIC does a broadcast, which may change the type of sf in the middle of it */
+
+  sf->persistent = PETSC_TRUE;
+  sf->collective = PETSC_FALSE;
+
+  PetscCall(PetscNew(&dat));
+  dat->nuses   = 10;
+  dat->nrounds = 5;
+  sf->data     = (void *)dat;
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
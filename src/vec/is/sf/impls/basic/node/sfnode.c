@@ -0,0 +1,481 @@
+#include <../src/vec/is/sf/impls/basic/sfpack.h>
+#include <../src/vec/is/sf/impls/basic/sfbasic.h>
+
+/*
+   PETSCSFNODE is PETSCSFBASIC with the remote ranks on the same shared memory node served through an MPI shared memory window
+   instead of MPI messages. In PetscSFBcastBegin() (resp. PetscSFReduceBegin()), a process packs its remote roots (resp. leaves) into
+   its own part of the window of the link and publishes the number of the operation in the header of its part. In PetscSFBcastEnd()
+   (resp. PetscSFReduceEnd()), the on-node ranks wait for that number and unpack the packed entries directly from the window into
+   their leafdata (resp. rootdata), then publish in their own header that they are done with the operation, which a process waits for
+   before packing again into its window. No message is exchanged between processes of the same node.
+
+   Ranks on other nodes are sent the packed entries with regular MPI messages, one per pair of processes as in PETSCSFBASIC; the
+   messages between two nodes are not aggregated.
+*/
+
+typedef struct {
+  SFBASICHEADER;
+  MPI_Comm     nodecomm;       /* Processes of the star forest on my node */
+  PetscInt     nodesize;       /* If positive, split the node into groups of nodesize processes treated as separate nodes */
+  PetscMPIInt *rootpeers;      /* [niranks-ndiranks], rank in nodecomm of my remote leaf ranks, MPI_PROC_NULL for those on other nodes */
+  PetscMPIInt *leafpeers;      /* [nranks-ndranks], rank in nodecomm of my remote root ranks, MPI_PROC_NULL for those on other nodes */
+  PetscInt    *rootpeeroffset; /* [niranks-ndiranks], offset in units in the window of an on-node leaf rank of the leaves it packs for me */
+  PetscInt    *leafpeeroffset; /* [nranks-ndranks], offset in units in the window of an on-node root rank of the roots it packs for me */
+} PetscSF_Node;
+
+/* Header of the part of a process in the shared memory window of a link, written by this process only */
+typedef struct {
+  volatile PetscInt64 ready;    /* Number of operations on the link whose entries the process has packed in its part of the window */
+  volatile PetscInt64 consumed; /* Number of operations on the link whose entries the process has unpacked from the windows of its peers */
+} PetscSFNodeHeader;
+
+/* Bytes reserved for the header at the beginning of the part of each process, so that the buffers start on a new cache line */
+#define PETSCSF_NODE_HEADER_SIZE 64
+
+/* Shared memory window of a link, stored in link->spptr */
+typedef struct {
+  MPI_Win             win;
+  PetscSFNodeHeader  *hdr;         /* The header of my part of win */
+  char               *buf;         /* My part of win after the header, the remote root buffer followed by the remote leaf buffer */
+  char              **rootpeerbuf; /* [niranks-ndiranks], leaves packed for me in the window of an on-node leaf rank, NULL for off-node ranks */
+  char              **leafpeerbuf; /* [nranks-ndranks], roots packed for me in the window of an on-node root rank, NULL for off-node ranks */
+  PetscSFNodeHeader **rootpeerhdr; /* [niranks-ndiranks], header of the part of an on-node leaf rank, NULL for off-node ranks */
+  PetscSFNodeHeader **leafpeerhdr; /* [nranks-ndranks], header of the part of an on-node root rank, NULL for off-node ranks */
+  PetscInt64          nops;        /* Number of operations started on the link through the window */
+  PetscBool           active;      /* Whether the ongoing operation on the link goes through the window */
+  MPI_Request        *reqs;        /* Requests of the messages to ranks on other nodes of the ongoing operation */
+  PetscMPIInt         nreqs;
+} PetscSFLink_Node;
+
+/* The remote ranks of one side (roots or leaves) of a communication */
+typedef struct {
+  PetscInt            n;       /* Number of remote ranks */
+  const PetscMPIInt  *ranks;   /* [n] */
+  const PetscInt     *offset;  /* [n+1], offset[i] - offset[0] is the offset of rank i in the remote buffer */
+  const PetscMPIInt  *peers;   /* [n], ranks in nodecomm, MPI_PROC_NULL for ranks on other nodes */
+  char               *buf;     /* The remote buffer in my part of the window */
+  char              **peerbuf; /* [n], where on-node ranks pack their entries for me in their window */
+  PetscSFNodeHeader **peerhdr; /* [n], headers of the parts of on-node ranks */
+} PetscSFNodeSide;
+
+/*===================================================================================*/
+/*              Internal routines for PetscSFNode                                    */
+/*===================================================================================*/
+
+/* Allocate the shared memory window of a link the first time the link is used */
+static PetscErrorCode PetscSFLinkGetWindow_Node(PetscSF sf, PetscSFLink link, PetscSFLink_Node **window)
+{
+  PetscSF_Node     *dat = (PetscSF_Node *)sf->data;
+  PetscSFLink_Node *w;
+  PetscInt          i, nrootranks, ndrootranks, nleafranks, ndleafranks, nr, nl;
+  MPI_Info          info;
+  MPI_Aint          size;
+  PetscMPIInt       disp_unit;
+  void             *base;
+
+  PetscFunctionBegin;
+  if (!link->spptr) {
+    PetscCall(PetscSFGetRootInfo_Basic(sf, &nrootranks, &ndrootranks, NULL, NULL, NULL));
+    PetscCall(PetscSFGetLeafInfo_Basic(sf, &nleafranks, &ndleafranks, NULL, NULL, NULL, NULL));
+    nr = nrootranks - ndrootranks;
+    nl = nleafranks - ndleafranks;
+    PetscCall(PetscNew(&w));
+    /* Let every process allocate its part of the window in its own NUMA domain */
+    PetscCallMPI(MPI_Info_create(&info));
+    PetscCallMPI(MPI_Info_set(info, "alloc_shared_noncontig", "true"));
+    PetscCallMPI(MPI_Win_allocate_shared((MPI_Aint)(PETSCSF_NODE_HEADER_SIZE + (dat->rootbuflen[PETSCSF_REMOTE] + sf->leafbuflen[PETSCSF_REMOTE]) * link->unitbytes), 1, info, dat->nodecomm, &base, &w->win));
+    PetscCallMPI(MPI_Info_free(&info));
+    PetscCallMPI(MPI_Win_lock_all(MPI_MODE_NOCHECK, w->win));
+    w->hdr           = (PetscSFNodeHeader *)base;
+    w->hdr->ready    = 0;
+    w->hdr->consumed = 0;
+    w->buf           = (char *)base + PETSCSF_NODE_HEADER_SIZE;
+    PetscCall(PetscMalloc5(nr, &w->rootpeerbuf, nl, &w->leafpeerbuf, nr, &w->rootpeerhdr, nl, &w->leafpeerhdr, nr + nl, &w->reqs));
+    for (i = 0; i < nr; i++) {
+      w->rootpeerbuf[i] = NULL;
+      w->rootpeerhdr[i] = NULL;
+      if (dat->rootpeers[i] == MPI_PROC_NULL) continue;
+      PetscCallMPI(MPI_Win_shared_query(w->win, dat->rootpeers[i], &size, &disp_unit, &base));
+      w->rootpeerhdr[i] = (PetscSFNodeHeader *)base;
+      w->rootpeerbuf[i] = (char *)base + PETSCSF_NODE_HEADER_SIZE + dat->rootpeeroffset[i] * link->unitbytes;
+    }
+    for (i = 0; i < nl; i++) {
+      w->leafpeerbuf[i] = NULL;
+      w->leafpeerhdr[i] = NULL;
+      if (dat->leafpeers[i] == MPI_PROC_NULL) continue;
+      PetscCallMPI(MPI_Win_shared_query(w->win, dat->leafpeers[i], &size, &disp_unit, &base));
+      w->leafpeerhdr[i] = (PetscSFNodeHeader *)base;
+      w->leafpeerbuf[i] = (char *)base + PETSCSF_NODE_HEADER_SIZE + dat->leafpeeroffset[i] * link->unitbytes;
+    }
+    /* The headers are initialized before any process reads them */
+    PetscCallMPI(MPI_Win_sync(w->win));
+    PetscCallMPI(MPI_Barrier(dat->nodecomm));
+    link->spptr = w;
+  }
+  *window = (PetscSFLink_Node *)link->spptr;
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
+
+static PetscErrorCode PetscSFLinkDestroyWindow_Node(PetscSFLink link)
+{
+  PetscSFLink_Node *w = (PetscSFLink_Node *)link->spptr;
+
+  PetscFunctionBegin;
+  if (w) {
+    PetscCallMPI(MPI_Win_unlock_all(w->win));
+    PetscCallMPI(MPI_Win_free(&w->win));
+    PetscCall(PetscFree5(w->rootpeerbuf, w->leafpeerbuf, w->rootpeerhdr, w->leafpeerhdr, w->reqs));
+    PetscCall(PetscFree(link->spptr));
+  }
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
+
+/* Wait until a counter in the header of an on-node process reaches a value; MPI_Win_sync() makes its updates and the data it wrote before them visible */
+static PetscErrorCode PetscSFNodeWaitCounter_Private(MPI_Win win, volatile PetscInt64 *counter, PetscInt64 value)
+{
+  PetscFunctionBegin;
+  do {
+    PetscCallMPI(MPI_Win_sync(win));
+  } while (*counter < value);
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
+
+/* Get the remote ranks of the root or leaf side of a communication on a link with an allocated window */
+static PetscErrorCode PetscSFNodeGetSide_Private(PetscSF sf, PetscSFLink link, PetscBool root, PetscSFNodeSide *side)
+{
+  PetscSF_Node      *dat = (PetscSF_Node *)sf->data;
+  PetscSFLink_Node  *w   = (PetscSFLink_Node *)link->spptr;
+  PetscInt           nranks, ndranks;
+  const PetscMPIInt *ranks;
+  const PetscInt    *offset;
+
+  PetscFunctionBegin;
+  if (root) {
+    PetscCall(PetscSFGetRootInfo_Basic(sf, &nranks, &ndranks, &ranks, &offset, NULL));
+    side->peers   = dat->rootpeers;
+    side->buf     = w->buf;
+    side->peerbuf = w->rootpeerbuf;
+    side->peerhdr = w->rootpeerhdr;
+  } else {
+    PetscCall(PetscSFGetLeafInfo_Basic(sf, &nranks, &ndranks, &ranks, &offset, NULL, NULL));
+    side->peers   = dat->leafpeers;
+    side->buf     = w->buf + dat->rootbuflen[PETSCSF_REMOTE] * link->unitbytes;
+    side->peerbuf = w->leafpeerbuf;
+    side->peerhdr = w->leafpeerhdr;
+  }
+  side->n      = nranks - ndranks;
+  side->ranks  = PetscSafePointerPlusOffset(ranks, ndranks);
+  side->offset = offset + ndranks;
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
+
+/* Pack the remote entries of data, send those of ranks on other nodes, and publish those of on-node ranks in the window */
+static PetscErrorCode PetscSFLinkStartCommunication_Node(PetscSF sf, PetscSFLink link, PetscSFDirection direction, const void *data)
+{
+  MPI_Comm          comm = PetscObjectComm((PetscObject)sf);
+  PetscSFLink_Node *w    = NULL;
+  PetscSFNodeSide   s, r;
+  PetscInt          i, start, count;
+  MPI_Request      *reqs;
+
+  PetscFunctionBegin;
+  PetscCall(PetscSFLinkGetWindow_Node(sf, link, &w));
+  PetscCall(PetscSFNodeGetSide_Private(sf, link, (PetscBool)(direction == PETSCSF_ROOT2LEAF), &s));
+  PetscCall(PetscSFNodeGetSide_Private(sf, link, (PetscBool)(direction == PETSCSF_LEAF2ROOT), &r));
+  w->nops++;
+  w->active = PETSC_TRUE;
+  reqs      = w->reqs;
+  /* Receive the entries of ranks on other nodes */
+  for (i = 0; i < r.n; i++) {
+    start = r.offset[i] - r.offset[0];
+    count = r.offset[i + 1] - r.offset[i];
+    if (r.peers[i] == MPI_PROC_NULL) PetscCallMPI(MPIU_Irecv(r.buf + start * link->unitbytes, count, link->unit, r.ranks[i], link->tag, comm, reqs++));
+  }
+  /* Pack and send the entries of ranks on other nodes */
+  for (i = 0; i < s.n; i++) {
+    if (s.peers[i] != MPI_PROC_NULL) continue;
+    start = s.offset[i] - s.offset[0];
+    count = s.offset[i + 1] - s.offset[i];
+    PetscCall(PetscSFLinkPackChunk_Host(sf, link, direction, start, count, data, s.buf + start * link->unitbytes));
+    PetscCallMPI(MPIU_Isend(s.buf + start * link->unitbytes, count, link->unit, s.ranks[i], link->tag, comm, reqs++));
+  }
+  PetscCall(PetscMPIIntCast(reqs - w->reqs, &w->nreqs));
+  /* The on-node ranks, which read my window in either direction, must be done with the previous operation on this link */
+  for (i = 0; i < r.n; i++) {
+    if (r.peerhdr[i]) PetscCall(PetscSFNodeWaitCounter_Private(w->win, &r.peerhdr[i]->consumed, w->nops - 1));
+  }
+  for (i = 0; i < s.n; i++) {
+    if (s.peerhdr[i]) PetscCall(PetscSFNodeWaitCounter_Private(w->win, &s.peerhdr[i]->consumed, w->nops - 1));
+  }
+  /* Pack the entries of on-node ranks and tell them they are ready */
+  for (i = 0; i < s.n; i++) {
+    if (s.peers[i] == MPI_PROC_NULL) continue;
+    start = s.offset[i] - s.offset[0];
+    count = s.offset[i + 1] - s.offset[i];
+    PetscCall(PetscSFLinkPackChunk_Host(sf, link, direction, start, count, data, s.buf + start * link->unitbytes));
+  }
+  PetscCallMPI(MPI_Win_sync(w->win));
+  w->hdr->ready = w->nops;
+  PetscCallMPI(MPI_Win_sync(w->win));
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
+
+/* Unpack the remote entries to data in rank order, from the windows of on-node ranks or from my window for ranks on other nodes */
+static PetscErrorCode PetscSFLinkFinishCommunication_Node(PetscSF sf, PetscSFLink link, PetscSFDirection direction, void *data, MPI_Op op)
+{
+  PetscSFLink_Node *w = (PetscSFLink_Node *)link->spptr;
+  PetscSFNodeSide   r;
+  PetscInt          i, start, count;
+  MPI_Request      *reqs = w->reqs;
+
+  PetscFunctionBegin;
+  PetscCall(PetscSFNodeGetSide_Private(sf, link, (PetscBool)(direction == PETSCSF_LEAF2ROOT), &r));
+  for (i = 0; i < r.n; i++) {
+    start = r.offset[i] - r.offset[0];
+    count = r.offset[i + 1] - r.offset[i];
+    if (r.peers[i] == MPI_PROC_NULL) {
+      PetscCallMPI(MPI_Wait(reqs++, MPI_STATUS_IGNORE));
+      PetscCall(PetscSFLinkUnpackChunk_Host(sf, link, direction, start, count, r.buf + start * link->unitbytes, data, op));
+    } else {
+      PetscCall(PetscSFNodeWaitCounter_Private(w->win, &r.peerhdr[i]->ready, w->nops));
+      PetscCall(PetscSFLinkUnpackChunk_Host(sf, link, direction, start, count, r.peerbuf[i], data, op));
+    }
+  }
+  /* Tell the on-node ranks that I am done with their windows, and wait for my sends so that the link can be reused */
+  PetscCallMPI(MPI_Win_sync(w->win));
+  w->hdr->consumed = w->nops;
+  PetscCallMPI(MPI_Win_sync(w->win));
+  PetscCallMPI(MPI_Waitall(w->nreqs - (PetscMPIInt)(reqs - w->reqs), reqs, MPI_STATUSES_IGNORE));
+  w->active = PETSC_FALSE;
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
+
+/*
+   The window is in host memory, so operations on device data are done as in PETSCSFBASIC. All the processes take the same path,
+   since the windows are allocated collectively on the node and the ranks on other nodes expect the messages of the path they take
+*/
+static PetscErrorCode PetscSFNodeUseWindow_Private(PetscSF sf, PetscMemType rootmtype, PetscMemType leafmtype, PetscBool *use)
+{
+  PetscFunctionBegin;
+  *use = (PetscBool)(!PetscMemTypeDevice(rootmtype) && !PetscMemTypeDevice(leafmtype));
+  if (PetscDefined(HAVE_DEVICE)) PetscCall(MPIU_Allreduce(MPI_IN_PLACE, use, 1, MPIU_BOOL, MPI_LAND, PetscObjectComm((PetscObject)sf)));
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
+
+/*===================================================================================*/
+/*              SF public interface implementations                                  */
+/*===================================================================================*/
+static PetscErrorCode PetscSFSetUp_Node(PetscSF sf)
+{
+  PetscSF_Node      *dat = (PetscSF_Node *)sf->data;
+  PetscInt           i, nrootranks, ndrootranks, nleafranks, ndleafranks, nr, nl, *sbuf, *rbuf;
+  const PetscInt    *rootoffset, *leafoffset;
+  const PetscMPIInt *rootranks, *leafranks;
+  PetscMPIInt        lrank, tag[2], nreqs = 0;
+  MPI_Comm           comm, shmcomm;
+  MPI_Group          group, nodegroup;
+  MPI_Request       *reqs;
+  PetscShmComm       pshmcomm;
+
+  PetscFunctionBegin;
+  PetscCall(PetscSFSetUp_Basic(sf));
+  PetscCall(PetscObjectGetComm((PetscObject)sf, &comm));
+  PetscCall(PetscShmCommGet(comm, &pshmcomm));
+  PetscCall(PetscShmCommGetMpiShmComm(pshmcomm, &shmcomm));
+  PetscCallMPI(MPI_Comm_rank(shmcomm, &lrank));
+  PetscCallMPI(MPI_Comm_split(shmcomm, dat->nodesize > 0 ? (PetscMPIInt)(lrank / dat->nodesize) : 0, lrank, &dat->nodecomm));
+
+  /* Find the remote ranks on my node */
+  PetscCall(PetscSFGetRootInfo_Basic(sf, &nrootranks, &ndrootranks, &rootranks, &rootoffset, NULL));
+  PetscCall(PetscSFGetLeafInfo_Basic(sf, &nleafranks, &ndleafranks, &leafranks, &leafoffset, NULL, NULL));
+  nr = nrootranks - ndrootranks;
+  nl = nleafranks - ndleafranks;
+  PetscCall(PetscMalloc4(nr, &dat->rootpeers, nl, &dat->leafpeers, nr, &dat->rootpeeroffset, nl, &dat->leafpeeroffset));
+  PetscCallMPI(MPI_Comm_group(comm, &group));
+  PetscCallMPI(MPI_Comm_group(dat->nodecomm, &nodegroup));
+  PetscCallMPI(MPI_Group_translate_ranks(group, (PetscMPIInt)nr, PetscSafePointerPlusOffset(rootranks, ndrootranks), nodegroup, dat->rootpeers));
+  PetscCallMPI(MPI_Group_translate_ranks(group, (PetscMPIInt)nl, PetscSafePointerPlusOffset(leafranks, ndleafranks), nodegroup, dat->leafpeers));
+  PetscCallMPI(MPI_Group_free(&group));
+  PetscCallMPI(MPI_Group_free(&nodegroup));
+  for (i = 0; i < nr; i++) {
+    if (dat->rootpeers[i] == MPI_UNDEFINED) dat->rootpeers[i] = MPI_PROC_NULL;
+  }
+  for (i = 0; i < nl; i++) {
+    if (dat->leafpeers[i] == MPI_UNDEFINED) dat->leafpeers[i] = MPI_PROC_NULL;
+  }
+
+  /* Tell each on-node rank where in my window, in units, I pack the roots or leaves it communicates with */
+  PetscCall(PetscObjectGetNewTag((PetscObject)sf, &tag[0]));
+  PetscCall(PetscObjectGetNewTag((PetscObject)sf, &tag[1]));
+  PetscCall(PetscMalloc3(nr + nl, &sbuf, nr + nl, &rbuf, 2 * (nr + nl), &reqs));
+  for (i = 0; i < nr; i++) {
+    if (dat->rootpeers[i] != MPI_PROC_NULL) PetscCallMPI(MPIU_Irecv(&rbuf[i], 1, MPIU_INT, rootranks[ndrootranks + i], tag[1], comm, &reqs[nreqs++]));
+  }
+  for (i = 0; i < nl; i++) {
+    if (dat->leafpeers[i] != MPI_PROC_NULL) PetscCallMPI(MPIU_Irecv(&rbuf[nr + i], 1, MPIU_INT, leafranks[ndleafranks + i], tag[0], comm, &reqs[nreqs++]));
+  }
+  for (i = 0; i < nr; i++) {
+    if (dat->rootpeers[i] == MPI_PROC_NULL) continue;
+    sbuf[i] = rootoffset[ndrootranks + i] - rootoffset[ndrootranks];
+    PetscCallMPI(MPIU_Isend(&sbuf[i], 1, MPIU_INT, rootranks[ndrootranks + i], tag[0], comm, &reqs[nreqs++]));
+  }
+  for (i = 0; i < nl; i++) {
+    if (dat->leafpeers[i] == MPI_PROC_NULL) continue;
+    sbuf[nr + i] = dat->rootbuflen[PETSCSF_REMOTE] + leafoffset[ndleafranks + i] - leafoffset[ndleafranks];
+    PetscCallMPI(MPIU_Isend(&sbuf[nr + i], 1, MPIU_INT, leafranks[ndleafranks + i], tag[1], comm, &reqs[nreqs++]));
+  }
+  PetscCallMPI(MPI_Waitall(nreqs, reqs, MPI_STATUSES_IGNORE));
+  for (i = 0; i < nr; i++) dat->rootpeeroffset[i] = dat->rootpeers[i] == MPI_PROC_NULL ? -1 : rbuf[i];
+  for (i = 0; i < nl; i++) dat->leafpeeroffset[i] = dat->leafpeers[i] == MPI_PROC_NULL ? -1 : rbuf[nr + i];
+  PetscCall(PetscFree3(sbuf, rbuf, reqs));
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
+
+static PetscErrorCode PetscSFReset_Node(PetscSF sf)
+{
+  PetscSF_Node *dat = (PetscSF_Node *)sf->data;
+
+  PetscFunctionBegin;
+  PetscCheck(!dat->inuse, PetscObjectComm((PetscObject)sf), PETSC_ERR_ARG_WRONGSTATE, "Outstanding operation has not been completed");
+  for (PetscSFLink link = dat->avail; link; link = link->next) PetscCall(PetscSFLinkDestroyWindow_Node(link));
+  PetscCall(PetscFree4(dat->rootpeers, dat->leafpeers, dat->rootpeeroffset, dat->leafpeeroffset));
+  if (dat->nodecomm != MPI_COMM_NULL) PetscCallMPI(MPI_Comm_free(&dat->nodecomm));
+  PetscCall(PetscSFReset_Basic(sf)); /* Common part */
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
+
+static PetscErrorCode PetscSFDestroy_Node(PetscSF sf)
+{
+  PetscFunctionBegin;
+  PetscCall(PetscSFReset_Node(sf));
+  PetscCall(PetscFree(sf->data));
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
+
+static PetscErrorCode PetscSFView_Node(PetscSF sf, PetscViewer viewer)
+{
+  PetscSF_Node *dat = (PetscSF_Node *)sf->data;
+  PetscBool     isascii;
+
+  PetscFunctionBegin;
+  PetscCall(PetscObjectTypeCompare((PetscObject)viewer, PETSCVIEWERASCII, &isascii));
+  if (isascii && dat->nodesize > 0) PetscCall(PetscViewerASCIIPrintf(viewer, "  node size %" PetscInt_FMT "\n", dat->nodesize));
+  PetscCall(PetscSFView_Basic(sf, viewer));
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
+
+static PetscErrorCode PetscSFSetFromOptions_Node(PetscSF sf, PetscOptionItems *PetscOptionsObject)
+{
+  PetscSF_Node *dat = (PetscSF_Node *)sf->data;
+
+  PetscFunctionBegin;
+  PetscOptionsHeadBegin(PetscOptionsObject, "PetscSF Node options");
+  PetscCall(PetscOptionsInt("-sf_node_size", "Treat groups of this many processes of a shared memory node as separate nodes, 0 for the whole node", "PetscSFSetFromOptions", dat->nodesize, &dat->nodesize, NULL));
+  PetscOptionsHeadEnd();
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
+
+static PetscErrorCode PetscSFDuplicate_Node(PetscSF sf, PetscSFDuplicateOption opt, PetscSF newsf)
+{
+  PetscFunctionBegin;
+  ((PetscSF_Node *)newsf->data)->nodesize = ((PetscSF_Node *)sf->data)->nodesize;
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
+
+/* See PetscSFNodeUseWindow_Private() for the operations done as in PETSCSFBASIC */
+static PetscErrorCode PetscSFBcastBegin_Node(PetscSF sf, MPI_Datatype unit, PetscMemType rootmtype, const void *rootdata, PetscMemType leafmtype, void *leafdata, MPI_Op op)
+{
+  PetscSFLink link = NULL;
+  PetscBool   use;
+
+  PetscFunctionBegin;
+  PetscCall(PetscSFNodeUseWindow_Private(sf, rootmtype, leafmtype, &use));
+  if (!use) {
+    PetscCall(PetscSFBcastBegin_Basic(sf, unit, rootmtype, rootdata, leafmtype, leafdata, op));
+    PetscFunctionReturn(PETSC_SUCCESS);
+  }
+  PetscCall(PetscSFLinkCreate(sf, unit, rootmtype, rootdata, leafmtype, leafdata, op, PETSCSF_BCAST, &link));
+  PetscCall(PetscSFLinkStartCommunication_Node(sf, link, PETSCSF_ROOT2LEAF, rootdata));
+  PetscCall(PetscSFLinkScatterLocal(sf, link, PETSCSF_ROOT2LEAF, (void *)rootdata, leafdata, op));
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
+
+static PetscErrorCode PetscSFBcastEnd_Node(PetscSF sf, MPI_Datatype unit, const void *rootdata, void *leafdata, MPI_Op op)
+{
+  PetscSFLink link = NULL;
+
+  PetscFunctionBegin;
+  PetscCall(PetscSFLinkGetInUse(sf, unit, rootdata, leafdata, PETSC_USE_POINTER, &link));
+  if (!link->spptr || !((PetscSFLink_Node *)link->spptr)->active) {
+    PetscCall(PetscSFBcastEnd_Basic(sf, unit, rootdata, leafdata, op));
+    PetscFunctionReturn(PETSC_SUCCESS);
+  }
+  PetscCall(PetscSFLinkGetInUse(sf, unit, rootdata, leafdata, PETSC_OWN_POINTER, &link));
+  PetscCall(PetscSFLinkFinishCommunication_Node(sf, link, PETSCSF_ROOT2LEAF, leafdata, op));
+  PetscCall(PetscSFLinkReclaim(sf, &link));
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
+
+static PetscErrorCode PetscSFReduceBegin_Node(PetscSF sf, MPI_Datatype unit, PetscMemType leafmtype, const void *leafdata, PetscMemType rootmtype, void *rootdata, MPI_Op op)
+{
+  PetscSFLink link = NULL;
+  PetscBool   use;
+
+  PetscFunctionBegin;
+  PetscCall(PetscSFNodeUseWindow_Private(sf, rootmtype, leafmtype, &use));
+  if (!use) {
+    PetscCall(PetscSFReduceBegin_Basic(sf, unit, leafmtype, leafdata, rootmtype, rootdata, op));
+    PetscFunctionReturn(PETSC_SUCCESS);
+  }
+  PetscCall(PetscSFLinkCreate(sf, unit, rootmtype, rootdata, leafmtype, leafdata, op, PETSCSF_REDUCE, &link));
+  PetscCall(PetscSFLinkStartCommunication_Node(sf, link, PETSCSF_LEAF2ROOT, leafdata));
+  PetscCall(PetscSFLinkScatterLocal(sf, link, PETSCSF_LEAF2ROOT, rootdata, (void *)leafdata, op));
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
+
+static PetscErrorCode PetscSFReduceEnd_Node(PetscSF sf, MPI_Datatype unit, const void *leafdata, void *rootdata, MPI_Op op)
+{
+  PetscSFLink link = NULL;
+
+  PetscFunctionBegin;
+  PetscCall(PetscSFLinkGetInUse(sf, unit, rootdata, leafdata, PETSC_USE_POINTER, &link));
+  if (!link->spptr || !((PetscSFLink_Node *)link->spptr)->active) {
+    PetscCall(PetscSFReduceEnd_Basic(sf, unit, leafdata, rootdata, op));
+    PetscFunctionReturn(PETSC_SUCCESS);
+  }
+  PetscCall(PetscSFLinkGetInUse(sf, unit, rootdata, leafdata, PETSC_OWN_POINTER, &link));
+  PetscCall(PetscSFLinkFinishCommunication_Node(sf, link, PETSCSF_LEAF2ROOT, rootdata, op));
+  PetscCall(PetscSFLinkReclaim(sf, &link));
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
+
+PETSC_INTERN PetscErrorCode PetscSFCreate_Node(PetscSF sf)
+{
+  PetscSF_Node *dat;
+
+  PetscFunctionBegin;
+  sf->ops->CreateEmbeddedRootSF = PetscSFCreateEmbeddedRootSF_Basic;
+  sf->ops->FetchAndOpBegin      = PetscSFFetchAndOpBegin_Basic; /* FetchAndOp uses MPI messages for all remote ranks */
+  sf->ops->FetchAndOpEnd        = PetscSFFetchAndOpEnd_Basic;
+  sf->ops->GetLeafRanks         = PetscSFGetLeafRanks_Basic;
+  sf->ops->SetCommunicationOps  = PetscSFSetCommunicationOps_Basic;
+
+  sf->ops->SetUp          = PetscSFSetUp_Node;
+  sf->ops->Reset          = PetscSFReset_Node;
+  sf->ops->Destroy        = PetscSFDestroy_Node;
+  sf->ops->View           = PetscSFView_Node;
+  sf->ops->SetFromOptions = PetscSFSetFromOptions_Node;
+  sf->ops->Duplicate      = PetscSFDuplicate_Node;
+  sf->ops->BcastBegin     = PetscSFBcastBegin_Node;
+  sf->ops->BcastEnd       = PetscSFBcastEnd_Node;
+  sf->ops->ReduceBegin    = PetscSFReduceBegin_Node;
+  sf->ops->ReduceEnd      = PetscSFReduceEnd_Node;
+
+  sf->persistent = PETSC_TRUE; /* FetchAndOp and operations on device data use the persistent requests of PETSCSFBASIC */
+  sf->collective = PETSC_FALSE;
+
+  PetscCall(PetscNew(&dat));
+  dat->nodecomm = MPI_COMM_NULL;
+  sf->data      = (void *)dat;
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
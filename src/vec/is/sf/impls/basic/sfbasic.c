@@ -156,7 +156,136 @@ static PetscErrorCode PetscSFLinkFinishCommunication_MPIX_Stream(PetscSF sf, Pet
 }
 #endif
 
-static PetscErrorCode PetscSFSetCommunicationOps_Basic(PetscSF sf, PetscSFLink link)
+/* Chunked remote messages (see PetscSFBasicSetPartitionSize()).
+
+   A message longer than a chunk is sent as a sequence of chunks with MPI_Isend(), each one right after it is packed, so that packing
+   the rest of the buffer overlaps with sending what is already packed. The receiver waits for the chunks in the order of its buffer and
+   unpacks each one as soon as it arrives, overlapping unpacking with receiving while keeping the order of the reductions, hence the
+   results, the same as with whole messages. Both ends split a message the same way from its length, and a message not longer than a
+   chunk is sent as one piece, which also matches the persistent requests of a process that has no long message at all.
+*/
+static PetscErrorCode PetscSFLinkGetChunks_Basic(PetscSF sf, PetscSFLink link, PetscSFDirection direction, PetscInt *csize, PetscInt *nsendchunks, PetscInt *nrecvchunks)
+{
+  PetscSF_Basic  *bas = (PetscSF_Basic *)sf->data;
+  PetscInt        i, nrootranks, ndrootranks, nleafranks, ndleafranks, len, nrootchunks = 0, nleafchunks = 0;
+  const PetscInt *rootoffset, *leafoffset;
+
+  PetscFunctionBegin;
+  *csize = PetscMax(bas->partsize / (PetscInt)link->unitbytes, 1);
+  PetscCall(PetscSFGetRootInfo_Basic(sf, &nrootranks, &ndrootranks, NULL, &rootoffset, NULL));
+  PetscCall(PetscSFGetLeafInfo_Basic(sf, &nleafranks, &ndleafranks, NULL, &leafoffset, NULL, NULL));
+  for (i = ndrootranks; i < nrootranks; i++) {
+    len = rootoffset[i + 1] - rootoffset[i];
+    nrootchunks += PetscMax((len + *csize - 1) / *csize, 1);
+  }
+  for (i = ndleafranks; i < nleafranks; i++) {
+    len = leafoffset[i + 1] - leafoffset[i];
+    nleafchunks += PetscMax((len + *csize - 1) / *csize, 1);
+  }
+  *nsendchunks = (direction == PETSCSF_ROOT2LEAF) ? nrootchunks : nleafchunks;
+  *nrecvchunks = (direction == PETSCSF_ROOT2LEAF) ? nleafchunks : nrootchunks;
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
+
+/* Decide whether the operation on link sends its remote messages in chunks, and if so post the receives of the chunks, then pack
+   and send them one by one. Otherwise, pack the whole buffer and start the persistent requests */
+static PetscErrorCode PetscSFLinkPackAndStartCommunication_Basic(PetscSF sf, PetscSFLink link, PetscSFDirection direction, const void *data)
+{
+  PetscSF_Basic     *bas  = (PetscSF_Basic *)sf->data;
+  MPI_Comm           comm = PetscObjectComm((PetscObject)sf);
+  PetscInt           i, c, nc, csize, nsendchunks, nrecvchunks, nsranks, ndsranks, nrranks, ndrranks, start, count;
+  const PetscInt    *soffset, *roffset;
+  const PetscMPIInt *sranks, *rranks;
+  char              *sbuf, *rbuf;
+  MPI_Request       *reqs;
+
+  PetscFunctionBegin;
+  link->chunked = PETSC_FALSE;
+  if (bas->partsize > 0 && PetscMemTypeHost(link->rootmtype) && PetscMemTypeHost(link->leafmtype) && !link->use_nvshmem) {
+    /* Chunks are only worth it if some message is split, i.e., there are more chunks than messages */
+    PetscCall(PetscSFLinkGetChunks_Basic(sf, link, direction, &csize, &nsendchunks, &nrecvchunks));
+    link->chunked = (nsendchunks + nrecvchunks > bas->nrootreqs + sf->nleafreqs) ? PETSC_TRUE : PETSC_FALSE;
+  }
+  if (!link->chunked) {
+    if (direction == PETSCSF_ROOT2LEAF) PetscCall(PetscSFLinkPackRootData(sf, link, PETSCSF_REMOTE, data));
+    else PetscCall(PetscSFLinkPackLeafData(sf, link, PETSCSF_REMOTE, data));
+    PetscCall(PetscSFLinkStartCommunication(sf, link, direction));
+    PetscFunctionReturn(PETSC_SUCCESS);
+  }
+
+  if (link->nchunkreqs < nsendchunks + nrecvchunks) {
+    PetscCall(PetscFree(link->chunkreqs));
+    PetscCall(PetscMalloc1(nsendchunks + nrecvchunks, &link->chunkreqs));
+    link->nchunkreqs = nsendchunks + nrecvchunks;
+  }
+  if (direction == PETSCSF_ROOT2LEAF) {
+    PetscCall(PetscSFGetRootInfo_Basic(sf, &nsranks, &ndsranks, &sranks, &soffset, NULL));
+    PetscCall(PetscSFGetLeafInfo_Basic(sf, &nrranks, &ndrranks, &rranks, &roffset, NULL, NULL));
+    sbuf = link->rootbuf[PETSCSF_REMOTE][PETSC_MEMTYPE_HOST];
+    rbuf = link->leafbuf[PETSCSF_REMOTE][PETSC_MEMTYPE_HOST];
+  } else {
+    PetscCall(PetscSFGetLeafInfo_Basic(sf, &nsranks, &ndsranks, &sranks, &soffset, NULL, NULL));
+    PetscCall(PetscSFGetRootInfo_Basic(sf, &nrranks, &ndrranks, &rranks, &roffset, NULL));
+    sbuf = link->leafbuf[PETSCSF_REMOTE][PETSC_MEMTYPE_HOST];
+    rbuf = link->rootbuf[PETSCSF_REMOTE][PETSC_MEMTYPE_HOST];
+  }
+
+  /* Receives of the chunks come first in chunkreqs[], followed by the sends */
+  reqs = link->chunkreqs;
+  for (i = ndrranks; i < nrranks; i++) {
+    nc = PetscMax((roffset[i + 1] - roffset[i] + csize - 1) / csize, 1);
+    for (c = 0; c < nc; c++) {
+      start = roffset[i] - roffset[ndrranks] + c * csize;
+      count = PetscMin(csize, roffset[i + 1] - roffset[ndrranks] - start);
+      PetscCallMPI(MPIU_Irecv(rbuf + start * link->unitbytes, count, link->unit, rranks[i], link->tag, comm, reqs++));
+    }
+  }
+  for (i = ndsranks; i < nsranks; i++) {
+    nc = PetscMax((soffset[i + 1] - soffset[i] + csize - 1) / csize, 1);
+    for (c = 0; c < nc; c++) {
+      start = soffset[i] - soffset[ndsranks] + c * csize;
+      count = PetscMin(csize, soffset[i + 1] - soffset[ndsranks] - start);
+      PetscCall(PetscSFLinkPackChunk_Host(sf, link, direction, start, count, data, NULL));
+      PetscCallMPI(MPIU_Isend(sbuf + start * link->unitbytes, count, link->unit, sranks[i], link->tag, comm, reqs++));
+    }
+  }
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
+
+/* Complete the communication started by PetscSFLinkPackAndStartCommunication_Basic() and unpack the received data */
+static PetscErrorCode PetscSFLinkFinishCommunicationAndUnpack_Basic(PetscSF sf, PetscSFLink link, PetscSFDirection direction, void *data, MPI_Op op)
+{
+  PetscInt        i, c, nc, csize, nsendchunks, nrecvchunks, nrranks, ndrranks, start, count;
+  const PetscInt *roffset;
+  MPI_Request    *reqs;
+
+  PetscFunctionBegin;
+  if (!link->chunked) {
+    PetscCall(PetscSFLinkFinishCommunication(sf, link, direction));
+    if (direction == PETSCSF_ROOT2LEAF) PetscCall(PetscSFLinkUnpackLeafData(sf, link, PETSCSF_REMOTE, data, op));
+    else PetscCall(PetscSFLinkUnpackRootData(sf, link, PETSCSF_REMOTE, data, op));
+    PetscFunctionReturn(PETSC_SUCCESS);
+  }
+
+  PetscCall(PetscSFLinkGetChunks_Basic(sf, link, direction, &csize, &nsendchunks, &nrecvchunks));
+  if (direction == PETSCSF_ROOT2LEAF) PetscCall(PetscSFGetLeafInfo_Basic(sf, &nrranks, &ndrranks, NULL, &roffset, NULL, NULL));
+  else PetscCall(PetscSFGetRootInfo_Basic(sf, &nrranks, &ndrranks, NULL, &roffset, NULL));
+  reqs = link->chunkreqs;
+  for (i = ndrranks; i < nrranks; i++) {
+    nc = PetscMax((roffset[i + 1] - roffset[i] + csize - 1) / csize, 1);
+    for (c = 0; c < nc; c++) {
+      start = roffset[i] - roffset[ndrranks] + c * csize;
+      count = PetscMin(csize, roffset[i + 1] - roffset[ndrranks] - start);
+      PetscCallMPI(MPI_Wait(reqs++, MPI_STATUS_IGNORE));
+      PetscCall(PetscSFLinkUnpackChunk_Host(sf, link, direction, start, count, NULL, data, op));
+    }
+  }
+  PetscCallMPI(MPI_Waitall((PetscMPIInt)nsendchunks, reqs, MPI_STATUSES_IGNORE));
+  link->chunked = PETSC_FALSE;
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
+
+PETSC_INTERN PetscErrorCode PetscSFSetCommunicationOps_Basic(PetscSF sf, PetscSFLink link)
 {
   PetscFunctionBegin;
   link->InitMPIRequests    = PetscSFLinkInitMPIRequests_Persistent_Basic;
@@ -276,6 +405,9 @@ PETSC_INTERN PetscErrorCode PetscSFReset_Basic(PetscSF sf)
   }
   bas->avail = NULL;
   PetscCall(PetscSFResetPackFields(sf));
+  /* The plans of the batches this star forest is part of, even when it is not the first one, are keyed on its state */
+  PetscCall(PetscSFBatchDestroyPlans_Private(&bas->batches));
+  PetscCall(PetscObjectStateIncrease((PetscObject)sf));
   PetscFunctionReturn(PETSC_SUCCESS);
 }
 
@@ -284,6 +416,109 @@ PETSC_INTERN PetscErrorCode PetscSFDestroy_Basic(PetscSF sf)
   PetscFunctionBegin;
   PetscCall(PetscSFReset_Basic(sf));
   PetscCall(PetscFree(sf->data));
+  PetscCall(PetscObjectComposeFunction((PetscObject)sf, "PetscSFBasicSetPartitionSize_C", NULL));
+  PetscCall(PetscObjectComposeFunction((PetscObject)sf, "PetscSFBasicGetPartitionSize_C", NULL));
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
+
+/*@
+  PetscSFBasicSetPartitionSize - Set the size of the chunks a `PETSCSFBASIC` star forest splits its long remote messages into
+
+  Logically Collective
+
+  Input Parameters:
++ sf    - star forest of type `PETSCSFBASIC`
+- bytes - the size of a chunk in bytes, or 0 (the default) to send every message whole
+
+  Options Database Key:
+. -sf_basic_partition_size <bytes> - the size of a chunk
+
+  Level: advanced
+
+  Notes:
+  With a positive size, `PetscSFBcastBegin()` and `PetscSFReduceBegin()` send a message longer than a chunk as a sequence of chunks,
+  each one as soon as it is packed, and `PetscSFBcastEnd()` and `PetscSFReduceEnd()` unpack each chunk as soon as it arrives, in
+  the order of the message. Packing, transfer and unpacking of long messages thus overlap, without changing the results. Messages
+  not longer than a chunk, data in device memory and `PetscSFFetchAndOpBegin()` keep using whole messages with persistent requests.
+
+  The size must be the same on all processes of the star forest. The chunks of a message are a whole number of units of the
+  `MPI_Datatype` being communicated, at least one, so the actual size of a chunk is rounded down to a multiple of the unit size.
+
+.seealso: `PetscSF`, `PETSCSFBASIC`, `PetscSFBasicGetPartitionSize()`, `PetscSFSetFromOptions()`, `PetscSFBcastBegin()`, `PetscSFReduceBegin()`
+@*/
+PetscErrorCode PetscSFBasicSetPartitionSize(PetscSF sf, PetscInt bytes)
+{
+  PetscFunctionBegin;
+  PetscValidHeaderSpecific(sf, PETSCSF_CLASSID, 1);
+  PetscValidLogicalCollectiveInt(sf, bytes, 2);
+  PetscCheck(bytes >= 0, PetscObjectComm((PetscObject)sf), PETSC_ERR_ARG_OUTOFRANGE, "Partition size %" PetscInt_FMT " must be nonnegative", bytes);
+  PetscTryMethod(sf, "PetscSFBasicSetPartitionSize_C", (PetscSF, PetscInt), (sf, bytes));
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
+
+/*@
+  PetscSFBasicGetPartitionSize - Get the size of the chunks a `PETSCSFBASIC` star forest splits its long remote messages into
+
+  Not Collective
+
+  Input Parameter:
+. sf - star forest of type `PETSCSFBASIC`
+
+  Output Parameter:
+. bytes - the size of a chunk in bytes, 0 if messages are sent whole
+
+  Level: advanced
+
+.seealso: `PetscSF`, `PETSCSFBASIC`, `PetscSFBasicSetPartitionSize()`
+@*/
+PetscErrorCode PetscSFBasicGetPartitionSize(PetscSF sf, PetscInt *bytes)
+{
+  PetscFunctionBegin;
+  PetscValidHeaderSpecific(sf, PETSCSF_CLASSID, 1);
+  PetscAssertPointer(bytes, 2);
+  PetscUseMethod(sf, "PetscSFBasicGetPartitionSize_C", (PetscSF, PetscInt *), (sf, bytes));
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
+
+static PetscErrorCode PetscSFBasicSetPartitionSize_Basic(PetscSF sf, PetscInt bytes)
+{
+  PetscSF_Basic *bas = (PetscSF_Basic *)sf->data;
+
+  PetscFunctionBegin;
+  PetscCheck(!bas->inuse, PetscObjectComm((PetscObject)sf), PETSC_ERR_ARG_WRONGSTATE, "Cannot change the partition size with outstanding operations");
+  bas->partsize = bytes;
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
+
+static PetscErrorCode PetscSFBasicGetPartitionSize_Basic(PetscSF sf, PetscInt *bytes)
+{
+  PetscSF_Basic *bas = (PetscSF_Basic *)sf->data;
+
+  PetscFunctionBegin;
+  *bytes = bas->partsize;
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
+
+static PetscErrorCode PetscSFDuplicate_Basic(PetscSF sf, PetscSFDuplicateOption opt, PetscSF newsf)
+{
+  PetscSF_Basic *bas = (PetscSF_Basic *)sf->data;
+
+  PetscFunctionBegin;
+  PetscCall(PetscSFBasicSetPartitionSize(newsf, bas->partsize));
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
+
+static PetscErrorCode PetscSFSetFromOptions_Basic(PetscSF sf, PetscOptionItems *PetscOptionsObject)
+{
+  PetscSF_Basic *bas   = (PetscSF_Basic *)sf->data;
+  PetscInt       bytes = bas->partsize;
+  PetscBool      flg;
+
+  PetscFunctionBegin;
+  PetscOptionsHeadBegin(PetscOptionsObject, "PetscSF Basic options");
+  PetscCall(PetscOptionsInt("-sf_basic_partition_size", "Size in bytes of the chunks long remote messages are split into, 0 to send them whole", "PetscSFBasicSetPartitionSize", bytes, &bytes, &flg));
+  if (flg) PetscCall(PetscSFBasicSetPartitionSize(sf, bytes));
+  PetscOptionsHeadEnd();
   PetscFunctionReturn(PETSC_SUCCESS);
 }
 
@@ -353,10 +588,8 @@ PETSC_INTERN PetscErrorCode PetscSFBcastBegin_Basic(PetscSF sf, MPI_Datatype uni
   PetscFunctionBegin;
   /* Create a communication link, which provides buffers, MPI requests etc (if MPI is used) */
   PetscCall(PetscSFLinkCreate(sf, unit, rootmtype, rootdata, leafmtype, leafdata, op, PETSCSF_BCAST, &link));
-  /* Pack rootdata to rootbuf for remote communication */
-  PetscCall(PetscSFLinkPackRootData(sf, link, PETSCSF_REMOTE, rootdata));
-  /* Start communication, e.g., post MPI_Isend */
-  PetscCall(PetscSFLinkStartCommunication(sf, link, PETSCSF_ROOT2LEAF));
+  /* Pack rootdata to rootbuf for remote communication and start communication, e.g., post MPI_Isend */
+  PetscCall(PetscSFLinkPackAndStartCommunication_Basic(sf, link, PETSCSF_ROOT2LEAF, rootdata));
   /* Do local scatter (i.e., self to self communication), which overlaps with the remote communication above */
   PetscCall(PetscSFLinkScatterLocal(sf, link, PETSCSF_ROOT2LEAF, (void *)rootdata, leafdata, op));
   PetscFunctionReturn(PETSC_SUCCESS);
@@ -369,10 +602,8 @@ PETSC_INTERN PetscErrorCode PetscSFBcastEnd_Basic(PetscSF sf, MPI_Datatype unit,
   PetscFunctionBegin;
   /* Retrieve the link used in XxxBegin() with root/leafdata as key */
   PetscCall(PetscSFLinkGetInUse(sf, unit, rootdata, leafdata, PETSC_OWN_POINTER, &link));
-  /* Finish remote communication, e.g., post MPI_Waitall */
-  PetscCall(PetscSFLinkFinishCommunication(sf, link, PETSCSF_ROOT2LEAF));
-  /* Unpack data in leafbuf to leafdata for remote communication */
-  PetscCall(PetscSFLinkUnpackLeafData(sf, link, PETSCSF_REMOTE, leafdata, op));
+  /* Finish remote communication, e.g., post MPI_Waitall, and unpack data in leafbuf to leafdata */
+  PetscCall(PetscSFLinkFinishCommunicationAndUnpack_Basic(sf, link, PETSCSF_ROOT2LEAF, leafdata, op));
   /* Recycle the link */
   PetscCall(PetscSFLinkReclaim(sf, &link));
   PetscFunctionReturn(PETSC_SUCCESS);
@@ -385,8 +616,11 @@ static inline PetscErrorCode PetscSFLeafToRootBegin_Basic(PetscSF sf, MPI_Dataty
 
   PetscFunctionBegin;
   PetscCall(PetscSFLinkCreate(sf, unit, rootmtype, rootdata, leafmtype, leafdata, op, sfop, &link));
-  PetscCall(PetscSFLinkPackLeafData(sf, link, PETSCSF_REMOTE, leafdata));
-  PetscCall(PetscSFLinkStartCommunication(sf, link, PETSCSF_LEAF2ROOT));
+  if (sfop == PETSCSF_REDUCE) PetscCall(PetscSFLinkPackAndStartCommunication_Basic(sf, link, PETSCSF_LEAF2ROOT, leafdata));
+  else { /* FetchAndOp needs rootbuf as a whole for the replies, so its messages are never sent in chunks */
+    PetscCall(PetscSFLinkPackLeafData(sf, link, PETSCSF_REMOTE, leafdata));
+    PetscCall(PetscSFLinkStartCommunication(sf, link, PETSCSF_LEAF2ROOT));
+  }
   *out = link;
   PetscFunctionReturn(PETSC_SUCCESS);
 }
@@ -408,8 +642,7 @@ PETSC_INTERN PetscErrorCode PetscSFReduceEnd_Basic(PetscSF sf, MPI_Datatype unit
 
   PetscFunctionBegin;
   PetscCall(PetscSFLinkGetInUse(sf, unit, rootdata, leafdata, PETSC_OWN_POINTER, &link));
-  PetscCall(PetscSFLinkFinishCommunication(sf, link, PETSCSF_LEAF2ROOT));
-  PetscCall(PetscSFLinkUnpackRootData(sf, link, PETSCSF_REMOTE, rootdata, op));
+  PetscCall(PetscSFLinkFinishCommunicationAndUnpack_Basic(sf, link, PETSCSF_LEAF2ROOT, rootdata, op));
   PetscCall(PetscSFLinkReclaim(sf, &link));
   PetscFunctionReturn(PETSC_SUCCESS);
 }
@@ -619,11 +852,15 @@ PETSC_EXTERN PetscErrorCode PetscSFCreate_Basic(PetscSF sf)
   sf->ops->GetLeafRanks         = PetscSFGetLeafRanks_Basic;
   sf->ops->CreateEmbeddedRootSF = PetscSFCreateEmbeddedRootSF_Basic;
   sf->ops->SetCommunicationOps  = PetscSFSetCommunicationOps_Basic;
+  sf->ops->SetFromOptions       = PetscSFSetFromOptions_Basic;
+  sf->ops->Duplicate            = PetscSFDuplicate_Basic;
 
   sf->persistent = PETSC_TRUE; // currently SFBASIC always uses persistent send/recv
   sf->collective = PETSC_FALSE;
 
   PetscCall(PetscNew(&dat));
   sf->data = (void *)dat;
+  PetscCall(PetscObjectComposeFunction((PetscObject)sf, "PetscSFBasicSetPartitionSize_C", PetscSFBasicSetPartitionSize_Basic));
+  PetscCall(PetscObjectComposeFunction((PetscObject)sf, "PetscSFBasicGetPartitionSize_C", PetscSFBasicGetPartitionSize_Basic));
   PetscFunctionReturn(PETSC_SUCCESS);
 }
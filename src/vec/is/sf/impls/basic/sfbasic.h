@@ -2,6 +2,9 @@
 
 #include <petsc/private/sfimpl.h> /*I "petscsf.h" I*/
 
+/* Fused communication of several star forests, see sfbatch.c */
+typedef struct _n_PetscSFBatch *PetscSFBatch;
+
 #define SFBASICHEADER \
   PetscMPIInt    niranks;          /* Number of incoming ranks (ranks accessing my roots) */ \
   PetscMPIInt    ndiranks;         /* Number of incoming ranks (ranks accessing my roots) in distinguished set */ \
@@ -17,8 +20,10 @@
   PetscSFPackOpt rootpackopt_d[2]; /* Copy of rootpackopt[] on device if needed */ \
   PetscBool      rootdups[2];      /* Indices of roots in irootloc[local/remote] have dups. Used for data-race test */ \
   PetscInt       nrootreqs;        /* Number of MPI requests */ \
+  PetscInt       partsize;         /* Size in bytes of the chunks remote messages are split into, 0 to send them whole */ \
   PetscSFLink    avail;            /* One or more entries per MPI Datatype, lazily constructed */ \
-  PetscSFLink    inuse             /* Buffers being used for transactions that have not yet completed */
+  PetscSFLink    inuse;            /* Buffers being used for transactions that have not yet completed */ \
+  PetscSFBatch   batches           /* Plans of the fused communications of batches starting with this star forest */
 
 typedef struct {
   SFBASICHEADER;
@@ -74,6 +79,8 @@ PETSC_INTERN PetscErrorCode PetscSFFetchAndOpBegin_Basic(PetscSF, MPI_Datatype,
 PETSC_INTERN PetscErrorCode PetscSFFetchAndOpEnd_Basic(PetscSF, MPI_Datatype, void *, const void *, void *, MPI_Op);
 PETSC_INTERN PetscErrorCode PetscSFCreateEmbeddedRootSF_Basic(PetscSF, PetscInt, const PetscInt *, PetscSF *);
 PETSC_INTERN PetscErrorCode PetscSFGetLeafRanks_Basic(PetscSF, PetscInt *, const PetscMPIInt **, const PetscInt **, const PetscInt **);
+PETSC_INTERN PetscErrorCode PetscSFSetCommunicationOps_Basic(PetscSF, PetscSFLink);
+PETSC_INTERN PetscErrorCode PetscSFBatchDestroyPlans_Private(PetscSFBatch *);
 
 #if defined(PETSC_HAVE_NVSHMEM)
 PETSC_INTERN PetscErrorCode PetscSFReset_Basic_NVSHMEM(PetscSF);
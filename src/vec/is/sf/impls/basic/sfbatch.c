@@ -0,0 +1,483 @@
+#include <../src/vec/is/sf/impls/basic/sfpack.h>
+#include <../src/vec/is/sf/impls/basic/sfbasic.h>
+
+/* The remote entries of star forest sf of a batch packed for, or received from, a neighbor */
+typedef struct {
+  PetscInt sf;    /* Index of the star forest in the batch */
+  PetscInt start; /* Offset of the entries in the remote buffer of the star forest */
+  PetscInt count; /* Number of entries */
+} PetscSFBatchSegment;
+
+/* The neighbors of one side (sending or receiving) of a batch, with one fused message per neighbor */
+typedef struct {
+  PetscInt             n;         /* Number of neighbors */
+  PetscMPIInt         *ranks;     /* [n], sorted */
+  PetscInt            *offset;    /* [n+1], offsets in bytes of the fused messages in buf */
+  PetscInt            *segoffset; /* [n+1], the message of neighbor k is made of segs[segoffset[k]], .., segs[segoffset[k+1]-1] in this order */
+  PetscSFBatchSegment *segs;
+  char                *buf;
+  MPI_Request         *reqs; /* [n] */
+} PetscSFBatchSide;
+
+/*
+   The plan of the fused communication of a batch, cached on the first star forest of the batch like the links of an operation. It is
+   reused by the batches with the same star forests, in the same states, with units of the same sizes and in the same direction
+*/
+struct _n_PetscSFBatch {
+  PetscInt          n;         /* Number of star forests */
+  PetscObjectId    *ids;       /* [n], the star forests */
+  PetscObjectState *states;    /* [n], their states, which PetscSFReset_Basic() increases */
+  size_t           *unitbytes; /* [n], the sizes of their units */
+  PetscSFDirection  direction;
+  PetscBool         inuse; /* The plan is used by an ongoing batch */
+  PetscSFBatchSide  send, recv;
+  PetscSFBatch      next;
+};
+
+/* Number of plans cached on a star forest, the least recently used ones that are not in use are destroyed beyond it */
+#define PETSCSF_BATCH_MAX_PLANS 16
+
+/* Round a byte offset in the buffer of a batch up to PETSC_MEMALIGN, so that segments of units of different sizes are aligned */
+static inline PetscInt PetscSFBatchAlign_Private(PetscInt pos)
+{
+  return (pos + PETSC_MEMALIGN - 1) / PETSC_MEMALIGN * PETSC_MEMALIGN;
+}
+
+/* Are the star forests of the batch all PETSCSFBASIC on the same communicator, so that the operations can be fused? */
+static PetscErrorCode PetscSFBatchCanFuse_Private(PetscInt n, const PetscSF sf[], PetscBool *fuse)
+{
+  PetscBool   isbasic;
+  PetscMPIInt result;
+
+  PetscFunctionBegin;
+  *fuse = PETSC_TRUE;
+  for (PetscInt i = 0; i < n && *fuse; i++) {
+    PetscCall(PetscObjectTypeCompare((PetscObject)sf[i], PETSCSFBASIC, &isbasic));
+    PetscCallMPI(MPI_Comm_compare(PetscObjectComm((PetscObject)sf[0]), PetscObjectComm((PetscObject)sf[i]), &result));
+    if (!isbasic || result != MPI_IDENT) *fuse = PETSC_FALSE;
+  }
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
+
+/*
+   Should the operations of the batch be fused? Otherwise they are done one by one. All processes must get the same answer, which the
+   types and communicators of the star forests give, but the memory types of the data may differ, so they are reduced over the
+   processes when PETSc has device support
+*/
+static PetscErrorCode PetscSFBatchFuseBegin_Private(PetscInt n, const PetscSF sf[], const void *const rootdata[], const void *const leafdata[], PetscBool *fuse)
+{
+  PetscMemType rootmtype, leafmtype;
+
+  PetscFunctionBegin;
+  PetscCall(PetscSFBatchCanFuse_Private(n, sf, fuse));
+  if (*fuse && PetscDefined(HAVE_DEVICE)) {
+    for (PetscInt i = 0; i < n && *fuse; i++) {
+      PetscCall(PetscGetMemType(rootdata[i], &rootmtype));
+      PetscCall(PetscGetMemType(leafdata[i], &leafmtype));
+      if (PetscMemTypeDevice(rootmtype) || PetscMemTypeDevice(leafmtype)) *fuse = PETSC_FALSE;
+    }
+    PetscCall(MPIU_Allreduce(MPI_IN_PLACE, fuse, 1, MPIU_BOOL, MPI_LAND, PetscObjectComm((PetscObject)sf[0])));
+  }
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
+
+/* Were the operations of the batch fused by the Begin routine? The link of the first star forest then has the plan of the batch */
+static PetscErrorCode PetscSFBatchFuseEnd_Private(PetscInt n, const PetscSF sf[], const MPI_Datatype unit[], const void *const rootdata[], const void *const leafdata[], PetscBool *fuse)
+{
+  PetscSFLink link;
+
+  PetscFunctionBegin;
+  PetscCall(PetscSFBatchCanFuse_Private(n, sf, fuse));
+  if (*fuse) {
+    PetscCall(PetscSFLinkGetInUse(sf[0], unit[0], rootdata[0], leafdata[0], PETSC_USE_POINTER, &link));
+    *fuse = (PetscBool)(link->batch != NULL);
+  }
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
+
+static PetscErrorCode PetscSFBatchGetSideInfo_Private(PetscSF sf, PetscBool root, PetscInt *nranks, PetscInt *ndranks, const PetscMPIInt **ranks, const PetscInt **offset)
+{
+  PetscFunctionBegin;
+  if (root) PetscCall(PetscSFGetRootInfo_Basic(sf, nranks, ndranks, ranks, offset, NULL));
+  else PetscCall(PetscSFGetLeafInfo_Basic(sf, nranks, ndranks, ranks, offset, NULL, NULL));
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
+
+/* Merge the remote ranks of the root (or leaf) side of the star forests into one list of neighbors, and lay out the fused messages */
+static PetscErrorCode PetscSFBatchSetUpSide_Private(PetscInt n, const PetscSF sf[], const PetscSFLink link[], PetscBool root, PetscSFBatchSide *side)
+{
+  PetscInt           i, j, k, nranks, ndranks, total = 0, *cursor;
+  const PetscMPIInt *ranks;
+  const PetscInt    *offset;
+
+  PetscFunctionBegin;
+  for (i = 0; i < n; i++) {
+    PetscCall(PetscSFBatchGetSideInfo_Private(sf[i], root, &nranks, &ndranks, NULL, NULL));
+    total += nranks - ndranks;
+  }
+  PetscCall(PetscMalloc2(total, &side->ranks, total, &side->segs));
+  for (i = 0, k = 0; i < n; i++) {
+    PetscCall(PetscSFBatchGetSideInfo_Private(sf[i], root, &nranks, &ndranks, &ranks, NULL));
+    for (j = ndranks; j < nranks; j++) side->ranks[k++] = ranks[j];
+  }
+  side->n = total;
+  PetscCall(PetscSortRemoveDupsMPIInt(&side->n, side->ranks));
+
+  PetscCall(PetscCalloc2(side->n + 1, &side->offset, side->n + 1, &side->segoffset));
+  PetscCall(PetscMalloc1(side->n, &cursor));
+  for (i = 0; i < n; i++) {
+    PetscCall(PetscSFBatchGetSideInfo_Private(sf[i], root, &nranks, &ndranks, &ranks, &offset));
+    for (j = ndranks; j < nranks; j++) {
+      PetscCall(PetscFindMPIInt(ranks[j], side->n, side->ranks, &k));
+      side->segoffset[k + 1]++;
+      side->offset[k + 1] = PetscSFBatchAlign_Private(side->offset[k + 1]) + (offset[j + 1] - offset[j]) * (PetscInt)link[i]->unitbytes;
+    }
+  }
+  /* The messages start aligned in buf, so the segments start aligned in memory as well */
+  for (k = 0; k < side->n; k++) {
+    side->offset[k + 1] = PetscSFBatchAlign_Private(side->offset[k + 1]);
+    side->segoffset[k + 1] += side->segoffset[k];
+    side->offset[k + 1] += side->offset[k];
+    cursor[k] = side->segoffset[k];
+  }
+  /* Within the message of a neighbor, segments are in the order of the star forests */
+  for (i = 0; i < n; i++) {
+    PetscCall(PetscSFBatchGetSideInfo_Private(sf[i], root, &nranks, &ndranks, &ranks, &offset));
+    for (j = ndranks; j < nranks; j++) {
+      PetscCall(PetscFindMPIInt(ranks[j], side->n, side->ranks, &k));
+      side->segs[cursor[k]].sf    = i;
+      side->segs[cursor[k]].start = offset[j] - offset[ndranks];
+      side->segs[cursor[k]].count = offset[j + 1] - offset[j];
+      cursor[k]++;
+    }
+  }
+  PetscCall(PetscFree(cursor));
+  PetscCall(PetscMalloc2(side->offset[side->n], &side->buf, side->n, &side->reqs));
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
+
+static PetscErrorCode PetscSFBatchDestroySide_Private(PetscSFBatchSide *side)
+{
+  PetscFunctionBegin;
+  PetscCall(PetscFree2(side->ranks, side->segs));
+  PetscCall(PetscFree2(side->offset, side->segoffset));
+  PetscCall(PetscFree2(side->buf, side->reqs));
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
+
+static PetscErrorCode PetscSFBatchDestroy_Private(PetscSFBatch *batch)
+{
+  PetscFunctionBegin;
+  PetscCall(PetscSFBatchDestroySide_Private(&(*batch)->send));
+  PetscCall(PetscSFBatchDestroySide_Private(&(*batch)->recv));
+  PetscCall(PetscFree3((*batch)->ids, (*batch)->states, (*batch)->unitbytes));
+  PetscCall(PetscFree(*batch));
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
+
+/* Destroy the plans cached on a star forest, called by PetscSFReset_Basic() */
+PetscErrorCode PetscSFBatchDestroyPlans_Private(PetscSFBatch *batches)
+{
+  PetscSFBatch batch = *batches, next;
+
+  PetscFunctionBegin;
+  for (; batch; batch = next) {
+    next = batch->next;
+    PetscCall(PetscSFBatchDestroy_Private(&batch));
+  }
+  *batches = NULL;
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
+
+/* Get the plan of a batch from the cache of its first star forest, or create it, and mark it in use */
+static PetscErrorCode PetscSFBatchGetPlan_Private(PetscInt n, const PetscSF sf[], const PetscSFLink link[], PetscSFDirection direction, PetscSFBatch *plan)
+{
+  PetscSF_Basic   *bas = (PetscSF_Basic *)sf[0]->data;
+  PetscSFBatch     batch, *p;
+  PetscObjectState state;
+  PetscInt         i, nplans;
+
+  PetscFunctionBegin;
+  for (p = &bas->batches; *p; p = &(*p)->next) {
+    batch = *p;
+    if (batch->inuse || batch->n != n || batch->direction != direction) continue;
+    for (i = 0; i < n; i++) {
+      PetscCall(PetscObjectStateGet((PetscObject)sf[i], &state));
+      if (batch->ids[i] != ((PetscObject)sf[i])->id || batch->states[i] != state || batch->unitbytes[i] != link[i]->unitbytes) break;
+    }
+    if (i == n) break;
+  }
+  if (*p) { /* Found, unlink it from the cache */
+    batch = *p;
+    *p    = batch->next;
+  } else {
+    PetscCall(PetscNew(&batch));
+    batch->n         = n;
+    batch->direction = direction;
+    PetscCall(PetscMalloc3(n, &batch->ids, n, &batch->states, n, &batch->unitbytes));
+    for (i = 0; i < n; i++) {
+      batch->ids[i] = ((PetscObject)sf[i])->id;
+      PetscCall(PetscObjectStateGet((PetscObject)sf[i], &batch->states[i]));
+      batch->unitbytes[i] = link[i]->unitbytes;
+    }
+    PetscCall(PetscSFBatchSetUpSide_Private(n, sf, link, (PetscBool)(direction == PETSCSF_ROOT2LEAF), &batch->send));
+    PetscCall(PetscSFBatchSetUpSide_Private(n, sf, link, (PetscBool)(direction == PETSCSF_LEAF2ROOT), &batch->recv));
+  }
+  /* Put it first in the cache, and trim the least recently used plans */
+  batch->next  = bas->batches;
+  bas->batches = batch;
+  for (p = &batch->next, nplans = 1; *p;) {
+    if (++nplans > PETSCSF_BATCH_MAX_PLANS && !(*p)->inuse) {
+      PetscSFBatch old = *p;
+
+      *p = old->next;
+      PetscCall(PetscSFBatchDestroy_Private(&old));
+    } else p = &(*p)->next;
+  }
+  batch->inuse = PETSC_TRUE;
+  *plan        = batch;
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
+
+/* Pack the remote entries of all star forests into one message per neighbor and send them; rootdata and leafdata are the arguments
+   of PetscSFBcastBegin() (direction = PETSCSF_ROOT2LEAF) or PetscSFReduceBegin() (PETSCSF_LEAF2ROOT) for each star forest */
+static PetscErrorCode PetscSFBatchBegin_Private(PetscInt n, const PetscSF sf[], const MPI_Datatype unit[], const void *const rootdata[], const void *const leafdata[], MPI_Op op, PetscSFDirection direction)
+{
+  PetscSFBatch      batch = NULL;
+  PetscSFLink      *link;
+  PetscSFBatchSide *s, *r;
+  PetscMemType      rootmtype, leafmtype;
+  MPI_Comm          comm = PetscObjectComm((PetscObject)sf[0]);
+  PetscInt          i, k, m, pos;
+
+  PetscFunctionBegin;
+  PetscCall(PetscMalloc1(n, &link));
+  for (i = 0; i < n; i++) {
+    PetscCall(PetscGetMemType(rootdata[i], &rootmtype));
+    PetscCall(PetscGetMemType(leafdata[i], &leafmtype));
+    PetscCall(PetscSFLinkCreate(sf[i], unit[i], rootmtype, rootdata[i], leafmtype, leafdata[i], op, direction == PETSCSF_ROOT2LEAF ? PETSCSF_BCAST : PETSCSF_REDUCE, &link[i]));
+  }
+  PetscCall(PetscSFBatchGetPlan_Private(n, sf, link, direction, &batch));
+  s = &batch->send;
+  r = &batch->recv;
+  /* The tag of the link of the first star forest is not used by any other ongoing operation */
+  for (k = 0; k < r->n; k++) PetscCallMPI(MPIU_Irecv(r->buf + r->offset[k], r->offset[k + 1] - r->offset[k], MPI_BYTE, r->ranks[k], link[0]->tag, comm, &r->reqs[k]));
+  for (k = 0; k < s->n; k++) {
+    for (m = s->segoffset[k], pos = s->offset[k]; m < s->segoffset[k + 1]; m++) {
+      const PetscSFBatchSegment *seg = &s->segs[m];
+
+      pos = PetscSFBatchAlign_Private(pos);
+      PetscCall(PetscSFLinkPackChunk_Host(sf[seg->sf], link[seg->sf], direction, seg->start, seg->count, direction == PETSCSF_ROOT2LEAF ? rootdata[seg->sf] : leafdata[seg->sf], s->buf + pos));
+      pos += seg->count * (PetscInt)link[seg->sf]->unitbytes;
+    }
+    PetscCallMPI(MPIU_Isend(s->buf + s->offset[k], s->offset[k + 1] - s->offset[k], MPI_BYTE, s->ranks[k], link[0]->tag, comm, &s->reqs[k]));
+  }
+  for (i = 0; i < n; i++) PetscCall(PetscSFLinkScatterLocal(sf[i], link[i], direction, (void *)rootdata[i], (void *)leafdata[i], op));
+  link[0]->batch = batch;
+  PetscCall(PetscFree(link));
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
+
+/* Unpack the fused messages in the order of the neighbors, so that the results are the same as with the operations done one by one */
+static PetscErrorCode PetscSFBatchEnd_Private(PetscInt n, const PetscSF sf[], const MPI_Datatype unit[], const void *const rootdata[], const void *const leafdata[], MPI_Op op, PetscSFDirection direction)
+{
+  PetscSFBatch      batch;
+  PetscSFLink      *link;
+  PetscSFBatchSide *r;
+  PetscInt          i, k, m, pos;
+
+  PetscFunctionBegin;
+  PetscCall(PetscMalloc1(n, &link));
+  for (i = 0; i < n; i++) PetscCall(PetscSFLinkGetInUse(sf[i], unit[i], rootdata[i], leafdata[i], PETSC_OWN_POINTER, &link[i]));
+  batch = link[0]->batch;
+  PetscCheck(batch, PETSC_COMM_SELF, PETSC_ERR_ARG_WRONGSTATE, "The operation was not started with the batch Begin routine");
+  r = &batch->recv;
+  for (k = 0; k < r->n; k++) {
+    PetscCallMPI(MPI_Wait(&r->reqs[k], MPI_STATUS_IGNORE));
+    for (m = r->segoffset[k], pos = r->offset[k]; m < r->segoffset[k + 1]; m++) {
+      const PetscSFBatchSegment *seg = &r->segs[m];
+
+      pos = PetscSFBatchAlign_Private(pos);
+      PetscCall(PetscSFLinkUnpackChunk_Host(sf[seg->sf], link[seg->sf], direction, seg->start, seg->count, r->buf + pos, (void *)(direction == PETSCSF_ROOT2LEAF ? leafdata[seg->sf] : rootdata[seg->sf]), op));
+      pos += seg->count * (PetscInt)link[seg->sf]->unitbytes;
+    }
+  }
+  PetscCallMPI(MPI_Waitall((PetscMPIInt)batch->send.n, batch->send.reqs, MPI_STATUSES_IGNORE));
+  batch->inuse   = PETSC_FALSE;
+  link[0]->batch = NULL;
+  for (i = 0; i < n; i++) PetscCall(PetscSFLinkReclaim(sf[i], &link[i]));
+  PetscCall(PetscFree(link));
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
+
+/*@C
+  PetscSFBcastBatchBegin - begin broadcasts on several star forests at once, with a single message per neighbor process for all of them,
+  to be concluded with a call to `PetscSFBcastBatchEnd()`
+
+  Collective
+
+  Input Parameters:
++ n        - number of star forests
+. sf       - the star forests, on the same communicator
+. unit     - data type of each star forest
+. rootdata - buffer to broadcast on each star forest
+- op       - operation to use for reduction
+
+  Output Parameter:
+. leafdata - buffer of each star forest to be reduced with values from each leaf's respective root
+
+  Level: advanced
+
+  Notes:
+  This is equivalent to calling `PetscSFBcastBegin()` with `sf[i]`, `unit[i]`, `rootdata[i]`, `leafdata[i]` and `op` for each i, and gives
+  the same results. When all star forests are of type `PETSCSFBASIC` and the data is in host memory, the entries each process sends to a
+  neighbor process in all the broadcasts are packed into a single message, so several concurrent scatters of a multi-field code, such
+  as updates of ghost values of different vectors, do not pay the latency of one message per field and neighbor. Otherwise the
+  broadcasts are done one by one. The data must be in host memory on all processes or in device memory on all processes.
+
+  The star forests and the data may be different, but the same tuple of arguments must be passed to `PetscSFBcastBatchEnd()`.
+  A star forest may not appear twice in a batch with the same root and leaf data.
+
+.seealso: `PetscSF`, `PetscSFBcastBatchEnd()`, `PetscSFBcastBegin()`, `PetscSFReduceBatchBegin()`
+@*/
+PetscErrorCode PetscSFBcastBatchBegin(PetscInt n, const PetscSF sf[], const MPI_Datatype unit[], const void *const rootdata[], void *const leafdata[], MPI_Op op)
+{
+  PetscBool fuse;
+
+  PetscFunctionBegin;
+  PetscCheck(n >= 0, PETSC_COMM_SELF, PETSC_ERR_ARG_OUTOFRANGE, "Number of star forests %" PetscInt_FMT " cannot be negative", n);
+  if (!n) PetscFunctionReturn(PETSC_SUCCESS);
+  PetscAssertPointer(sf, 2);
+  for (PetscInt i = 0; i < n; i++) {
+    PetscValidHeaderSpecific(sf[i], PETSCSF_CLASSID, 2);
+    PetscCall(PetscSFSetUp(sf[i]));
+  }
+  PetscCall(PetscSFBatchFuseBegin_Private(n, sf, rootdata, (const void *const *)leafdata, &fuse));
+  if (fuse) {
+    PetscCall(PetscLogEventBegin(PETSCSF_BcastBegin, sf[0], 0, 0, 0));
+    PetscCall(PetscSFBatchBegin_Private(n, sf, unit, rootdata, (const void *const *)leafdata, op, PETSCSF_ROOT2LEAF));
+    PetscCall(PetscLogEventEnd(PETSCSF_BcastBegin, sf[0], 0, 0, 0));
+  } else {
+    for (PetscInt i = 0; i < n; i++) PetscCall(PetscSFBcastBegin(sf[i], unit[i], rootdata[i], leafdata[i], op));
+  }
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
+
+/*@C
+  PetscSFBcastBatchEnd - end broadcasts started with `PetscSFBcastBatchBegin()`
+
+  Collective
+
+  Input Parameters:
++ n        - number of star forests
+. sf       - the star forests
+. unit     - data type of each star forest
+. rootdata - buffer to broadcast on each star forest
+- op       - operation to use for reduction
+
+  Output Parameter:
+. leafdata - buffer of each star forest to be reduced with values from each leaf's respective root
+
+  Level: advanced
+
+.seealso: `PetscSF`, `PetscSFBcastBatchBegin()`, `PetscSFBcastEnd()`
+@*/
+PetscErrorCode PetscSFBcastBatchEnd(PetscInt n, const PetscSF sf[], const MPI_Datatype unit[], const void *const rootdata[], void *const leafdata[], MPI_Op op)
+{
+  PetscBool fuse;
+
+  PetscFunctionBegin;
+  if (!n) PetscFunctionReturn(PETSC_SUCCESS);
+  PetscCall(PetscSFBatchFuseEnd_Private(n, sf, unit, rootdata, (const void *const *)leafdata, &fuse));
+  if (fuse) {
+    PetscCall(PetscLogEventBegin(PETSCSF_BcastEnd, sf[0], 0, 0, 0));
+    PetscCall(PetscSFBatchEnd_Private(n, sf, unit, rootdata, (const void *const *)leafdata, op, PETSCSF_ROOT2LEAF));
+    PetscCall(PetscLogEventEnd(PETSCSF_BcastEnd, sf[0], 0, 0, 0));
+  } else {
+    for (PetscInt i = 0; i < n; i++) PetscCall(PetscSFBcastEnd(sf[i], unit[i], rootdata[i], leafdata[i], op));
+  }
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
+
+/*@C
+  PetscSFReduceBatchBegin - begin reductions on several star forests at once, with a single message per neighbor process for all of them,
+  to be concluded with a call to `PetscSFReduceBatchEnd()`
+
+  Collective
+
+  Input Parameters:
++ n        - number of star forests
+. sf       - the star forests, on the same communicator
+. unit     - data type of each star forest
+. leafdata - values to reduce on each star forest
+- op       - reduction operation
+
+  Output Parameter:
+. rootdata - result of the reduction of values from all leaves of each root, for each star forest
+
+  Level: advanced
+
+  Note:
+  This is equivalent to calling `PetscSFReduceBegin()` with `sf[i]`, `unit[i]`, `leafdata[i]`, `rootdata[i]` and `op` for each i, and
+  gives the same results. See `PetscSFBcastBatchBegin()` for when the messages are fused.
+
+.seealso: `PetscSF`, `PetscSFReduceBatchEnd()`, `PetscSFReduceBegin()`, `PetscSFBcastBatchBegin()`
+@*/
+PetscErrorCode PetscSFReduceBatchBegin(PetscInt n, const PetscSF sf[], const MPI_Datatype unit[], const void *const leafdata[], void *const rootdata[], MPI_Op op)
+{
+  PetscBool fuse;
+
+  PetscFunctionBegin;
+  PetscCheck(n >= 0, PETSC_COMM_SELF, PETSC_ERR_ARG_OUTOFRANGE, "Number of star forests %" PetscInt_FMT " cannot be negative", n);
+  if (!n) PetscFunctionReturn(PETSC_SUCCESS);
+  PetscAssertPointer(sf, 2);
+  for (PetscInt i = 0; i < n; i++) {
+    PetscValidHeaderSpecific(sf[i], PETSCSF_CLASSID, 2);
+    PetscCall(PetscSFSetUp(sf[i]));
+  }
+  PetscCall(PetscSFBatchFuseBegin_Private(n, sf, (const void *const *)rootdata, leafdata, &fuse));
+  if (fuse) {
+    PetscCall(PetscLogEventBegin(PETSCSF_ReduceBegin, sf[0], 0, 0, 0));
+    PetscCall(PetscSFBatchBegin_Private(n, sf, unit, (const void *const *)rootdata, leafdata, op, PETSCSF_LEAF2ROOT));
+    PetscCall(PetscLogEventEnd(PETSCSF_ReduceBegin, sf[0], 0, 0, 0));
+  } else {
+    for (PetscInt i = 0; i < n; i++) PetscCall(PetscSFReduceBegin(sf[i], unit[i], leafdata[i], rootdata[i], op));
+  }
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
+
+/*@C
+  PetscSFReduceBatchEnd - end reductions started with `PetscSFReduceBatchBegin()`
+
+  Collective
+
+  Input Parameters:
++ n        - number of star forests
+. sf       - the star forests
+. unit     - data type of each star forest
+. leafdata - values to reduce on each star forest
+- op       - reduction operation
+
+  Output Parameter:
+. rootdata - result of the reduction of values from all leaves of each root, for each star forest
+
+  Level: advanced
+
+.seealso: `PetscSF`, `PetscSFReduceBatchBegin()`, `PetscSFReduceEnd()`
+@*/
+PetscErrorCode PetscSFReduceBatchEnd(PetscInt n, const PetscSF sf[], const MPI_Datatype unit[], const void *const leafdata[], void *const rootdata[], MPI_Op op)
+{
+  PetscBool fuse;
+
+  PetscFunctionBegin;
+  if (!n) PetscFunctionReturn(PETSC_SUCCESS);
+  PetscCall(PetscSFBatchFuseEnd_Private(n, sf, unit, (const void *const *)rootdata, leafdata, &fuse));
+  if (fuse) {
+    PetscCall(PetscLogEventBegin(PETSCSF_ReduceEnd, sf[0], 0, 0, 0));
+    PetscCall(PetscSFBatchEnd_Private(n, sf, unit, (const void *const *)rootdata, leafdata, op, PETSCSF_LEAF2ROOT));
+    PetscCall(PetscLogEventEnd(PETSCSF_ReduceEnd, sf[0], 0, 0, 0));
+  } else {
+    for (PetscInt i = 0; i < n; i++) PetscCall(PetscSFReduceEnd(sf[i], unit[i], leafdata[i], rootdata[i], op));
+  }
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
@@ -11,6 +11,20 @@
 
 #define CPPJoin4(a, b, c, d) a##_##b##_##c##_##d
 
+/* Runs of entries shorter than this many bytes are copied by an inline loop instead of memcpy() */
+#define PETSCSF_PACK_MEMCPY_MIN_BYTES 256
+
+/* Copy a run of n entries of Type. Short runs, such as the single entries of a fixed-stride pattern, for example a ghost column
+   of a structured grid, are copied inline, so that the call overhead of memcpy() is avoided and the copy is unrolled or vectorized
+   by the compiler when n is a compile-time constant */
+#define PACK_COPY_RUN(Type, dst, src, n) \
+  do { \
+    if ((n) * sizeof(Type) < PETSCSF_PACK_MEMCPY_MIN_BYTES) { \
+      PetscPragmaSIMD \
+      for (PetscInt _i = 0; _i < (n); _i++) (dst)[_i] = (src)[_i]; \
+    } else PetscCall(PetscArraycpy((dst), (src), (n))); \
+  } while (0)
+
 /* Operations working like s += t */
 #define OP_BINARY(op, s, t) \
   do { \
@@ -68,11 +82,12 @@
         Y  = opt->Y[r]; \
         for (k = 0; k < opt->dz[r]; k++) \
           for (j = 0; j < opt->dy[r]; j++) { \
-            PetscCall(PetscArraycpy(p2, u2 + (X * Y * k + X * j) * MBS, opt->dx[r] * MBS)); \
+            PACK_COPY_RUN(Type, p2, u2 + (X * Y * k + X * j) * MBS, opt->dx[r] * MBS); \
             p2 += opt->dx[r] * MBS; \
           } \
       } \
     } else { \
+      PetscPragmaSIMD /* Entries of the packed buffer are distinct */ \
       for (i = 0; i < count; i++) \
         for (j = 0; j < M; j++)    /* Decent compilers should eliminate this loop when M = const 1 */ \
           for (k = 0; k < BS; k++) /* Compiler either unrolls (BS=1) or vectorizes (BS=2,4,8,etc) this loop */ \
@@ -111,7 +126,7 @@
         Y  = opt->Y[r]; \
         for (k = 0; k < opt->dz[r]; k++) \
           for (j = 0; j < opt->dy[r]; j++) { \
-            PetscCall(PetscArraycpy(u2 + (X * Y * k + X * j) * MBS, p, opt->dx[r] * MBS)); \
+            PACK_COPY_RUN(Type, u2 + (X * Y * k + X * j) * MBS, p, opt->dx[r] * MBS); \
             p += opt->dx[r] * MBS; \
           } \
       } \
@@ -370,7 +385,7 @@ DEF_IntegerType(SignedChar, 1, 1) DEF_IntegerType(SignedChar, 2, 1) DEF_IntegerT
   typedef unsigned char UnsignedChar;
 DEF_IntegerType(UnsignedChar, 1, 1) DEF_IntegerType(UnsignedChar, 2, 1) DEF_IntegerType(UnsignedChar, 4, 1) DEF_IntegerType(UnsignedChar, 8, 1) DEF_IntegerType(UnsignedChar, 1, 0) DEF_IntegerType(UnsignedChar, 2, 0) DEF_IntegerType(UnsignedChar, 4, 0) DEF_IntegerType(UnsignedChar, 8, 0)
 
-  DEF_RealType(PetscReal, 1, 1) DEF_RealType(PetscReal, 2, 1) DEF_RealType(PetscReal, 4, 1) DEF_RealType(PetscReal, 8, 1) DEF_RealType(PetscReal, 1, 0) DEF_RealType(PetscReal, 2, 0) DEF_RealType(PetscReal, 4, 0) DEF_RealType(PetscReal, 8, 0)
+  DEF_RealType(PetscReal, 1, 1) DEF_RealType(PetscReal, 2, 1) DEF_RealType(PetscReal, 3, 1) DEF_RealType(PetscReal, 4, 1) DEF_RealType(PetscReal, 8, 1) DEF_RealType(PetscReal, 1, 0) DEF_RealType(PetscReal, 2, 0) DEF_RealType(PetscReal, 4, 0) DEF_RealType(PetscReal, 8, 0)
 #if defined(PETSC_HAVE_COMPLEX)
     DEF_ComplexType(PetscComplex, 1, 1) DEF_ComplexType(PetscComplex, 2, 1) DEF_ComplexType(PetscComplex, 4, 1) DEF_ComplexType(PetscComplex, 8, 1) DEF_ComplexType(PetscComplex, 1, 0) DEF_ComplexType(PetscComplex, 2, 0) DEF_ComplexType(PetscComplex, 4, 0) DEF_ComplexType(PetscComplex, 8, 0)
 #endif
@@ -408,6 +423,7 @@ DEF_DumbType(DumbInt, 1, 1) DEF_DumbType(DumbInt, 2, 1) DEF_DumbType(DumbInt, 4,
       if (link->reqs[i] != MPI_REQUEST_NULL) PetscCallMPI(MPI_Request_free(&link->reqs[i]));
     }
     PetscCall(PetscFree(link->reqs));
+    PetscCall(PetscFree(link->chunkreqs));
     for (i = PETSCSF_LOCAL; i <= PETSCSF_REMOTE; i++) {
       PetscCall(PetscFree(link->rootbuf_alloc[i][PETSC_MEMTYPE_HOST]));
       PetscCall(PetscFree(link->leafbuf_alloc[i][PETSC_MEMTYPE_HOST]));
@@ -550,6 +566,7 @@ PetscErrorCode PetscSFLinkSetUp_Host(PetscSF sf, PetscSFLink link, MPI_Datatype
     else if (nPetscReal % 8 == 0) PackInit_RealType_PetscReal_8_0(link);
     else if (nPetscReal == 4) PackInit_RealType_PetscReal_4_1(link);
     else if (nPetscReal % 4 == 0) PackInit_RealType_PetscReal_4_0(link);
+    else if (nPetscReal == 3) PackInit_RealType_PetscReal_3_1(link); /* Such as the coordinates or the velocity of 3D problems */
     else if (nPetscReal == 2) PackInit_RealType_PetscReal_2_1(link);
     else if (nPetscReal % 2 == 0) PackInit_RealType_PetscReal_2_0(link);
     else if (nPetscReal == 1) PackInit_RealType_PetscReal_1_1(link);
@@ -1057,6 +1074,67 @@ PetscErrorCode PetscSFLinkUnpackLeafData(PetscSF sf, PetscSFLink link, PetscSFSc
   PetscFunctionReturn(PETSC_SUCCESS);
 }
 
+/* Pack the entries [offset, offset + count) of the remote root buffer (direction = PETSCSF_ROOT2LEAF) or leaf buffer (PETSCSF_LEAF2ROOT)
+   from data on host, so that a long message can be sent in chunks as soon as each of them is packed. offset is relative to the start
+   of the remote buffer. The chunk is packed to buf, or in place in the buffer of the link if buf is NULL.
+ */
+PetscErrorCode PetscSFLinkPackChunk_Host(PetscSF sf, PetscSFLink link, PetscSFDirection direction, PetscInt offset, PetscInt count, const void *data, void *buf)
+{
+  const PetscInt *indices = NULL;
+  PetscInt        n, start;
+  PetscSFPackOpt  opt = NULL;
+
+  PetscFunctionBegin;
+  if (direction == PETSCSF_ROOT2LEAF) {
+    if (!buf && link->rootdirect[PETSCSF_REMOTE]) PetscFunctionReturn(PETSC_SUCCESS);
+    PetscCall(PetscSFLinkGetRootPackOptAndIndices(sf, link, PETSC_MEMTYPE_HOST, PETSCSF_REMOTE, &n, &start, &opt, &indices));
+    if (!buf) buf = link->rootbuf[PETSCSF_REMOTE][PETSC_MEMTYPE_HOST] + offset * link->unitbytes;
+  } else {
+    if (!buf && link->leafdirect[PETSCSF_REMOTE]) PetscFunctionReturn(PETSC_SUCCESS);
+    PetscCall(PetscSFLinkGetLeafPackOptAndIndices(sf, link, PETSC_MEMTYPE_HOST, PETSCSF_REMOTE, &n, &start, &opt, &indices));
+    if (!buf) buf = link->leafbuf[PETSCSF_REMOTE][PETSC_MEMTYPE_HOST] + offset * link->unitbytes;
+  }
+  /* On host, indices are available whenever they are not contiguous, so the chunk does not need the 3D optimization plan */
+  PetscCall(PetscLogEventBegin(PETSCSF_Pack, sf, 0, 0, 0));
+  PetscCall((*link->h_Pack)(link, count, start + offset, NULL, PetscSafePointerPlusOffset(indices, offset), data, buf));
+  PetscCall(PetscLogEventEnd(PETSCSF_Pack, sf, 0, 0, 0));
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
+
+/* Unpack the entries [offset, offset + count) of the remote leaf buffer (direction = PETSCSF_ROOT2LEAF) or root buffer (PETSCSF_LEAF2ROOT)
+   to data on host with op, the counterpart of PetscSFLinkPackChunk_Host() on the receiving side. The chunk is unpacked from buf, or
+   from the buffer of the link if buf is NULL.
+ */
+PetscErrorCode PetscSFLinkUnpackChunk_Host(PetscSF sf, PetscSFLink link, PetscSFDirection direction, PetscInt offset, PetscInt count, const void *buf, void *data, MPI_Op op)
+{
+  PetscSF_Basic  *bas     = (PetscSF_Basic *)sf->data;
+  const PetscInt *indices = NULL;
+  PetscInt        n, start;
+  PetscSFPackOpt  opt = NULL;
+  PetscBool       direct;
+  PetscErrorCode (*UnpackAndOp)(PetscSFLink, PetscInt, PetscInt, PetscSFPackOpt, const PetscInt *, void *, const void *) = NULL;
+
+  PetscFunctionBegin;
+  PetscCall(PetscLogEventBegin(PETSCSF_Unpack, sf, 0, 0, 0));
+  if (direction == PETSCSF_ROOT2LEAF) {
+    direct = (PetscBool)(!buf && link->leafdirect[PETSCSF_REMOTE]);
+    if (!direct) PetscCall(PetscSFLinkGetLeafPackOptAndIndices(sf, link, PETSC_MEMTYPE_HOST, PETSCSF_REMOTE, &n, &start, &opt, &indices));
+    if (!buf) buf = link->leafbuf[PETSCSF_REMOTE][PETSC_MEMTYPE_HOST] + offset * link->unitbytes;
+  } else {
+    direct = (PetscBool)(!buf && link->rootdirect[PETSCSF_REMOTE]);
+    if (!direct) PetscCall(PetscSFLinkGetRootPackOptAndIndices(sf, link, PETSC_MEMTYPE_HOST, PETSCSF_REMOTE, &n, &start, &opt, &indices));
+    if (!buf) buf = link->rootbuf[PETSCSF_REMOTE][PETSC_MEMTYPE_HOST] + offset * link->unitbytes;
+  }
+  if (!direct) { /* If data works directly as the buffer, MPI has already put the chunk in place */
+    PetscCall(PetscSFLinkGetUnpackAndOp(link, PETSC_MEMTYPE_HOST, op, direction == PETSCSF_ROOT2LEAF ? sf->leafdups[PETSCSF_REMOTE] : bas->rootdups[PETSCSF_REMOTE], &UnpackAndOp));
+    if (UnpackAndOp) PetscCall((*UnpackAndOp)(link, count, start + offset, NULL, PetscSafePointerPlusOffset(indices, offset), data, buf));
+    else PetscCall(PetscSFLinkUnpackDataWithMPIReduceLocal(sf, link, count, start + offset, PetscSafePointerPlusOffset(indices, offset), data, buf, op));
+  }
+  PetscCall(PetscLogEventEnd(PETSCSF_Unpack, sf, 0, 0, 0));
+  if (op != MPI_REPLACE && link->basicunit == MPIU_SCALAR) PetscCall(PetscLogFlops(count * link->bs));
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
+
 /* FetchAndOp rootdata with rootbuf, it is a kind of Unpack on rootdata, except it also updates rootbuf */
 PetscErrorCode PetscSFLinkFetchAndOpRemote(PetscSF sf, PetscSFLink link, void *rootdata, MPI_Op op)
 {
@@ -193,6 +193,11 @@ struct _n_PetscSFLink {
   PetscBool    rootreqsinited[2][2][2]; /* Are root requests initialized? Also in layout of [PETSCSF_DIRECTION][PETSC_MEMTYPE][rootdirect_mpi]*/
   PetscBool    leafreqsinited[2][2][2]; /* Are leaf requests initialized? Also in layout of [PETSCSF_DIRECTION][PETSC_MEMTYPE][leafdirect_mpi]*/
   MPI_Request *reqs;                    /* An array of length (nrootreqs+nleafreqs)*8. Pointers in rootreqs[][][] and leafreqs[][][] point here */
+  MPI_Request *chunkreqs;               /* Nonpersistent requests of the remote messages sent in chunks, see PetscSFBasicSetPartitionSize() */
+  PetscInt     nchunkreqs;              /* Length of chunkreqs[] */
+  PetscBool    chunked;                 /* Does the ongoing operation on this link send the remote messages in chunks? */
+  void        *spptr;                   /* Data of the link private to a PetscSF type, e.g., the shared memory window of PETSCSFNODE */
+  PetscSFBatch batch;                   /* The fused communication of several star forests the link takes part in, see PetscSFBcastBatchBegin() */
   PetscSFLink  next;
 
   PetscBool use_nvshmem; /* Does this link use nvshem (vs. MPI) for communication? */
@@ -237,6 +242,8 @@ PETSC_INTERN PetscErrorCode PetscSFLinkPackRootData(PetscSF, PetscSFLink, PetscS
 PETSC_INTERN PetscErrorCode PetscSFLinkPackLeafData(PetscSF, PetscSFLink, PetscSFScope, const void *);
 PETSC_INTERN PetscErrorCode PetscSFLinkUnpackRootData(PetscSF, PetscSFLink, PetscSFScope, void *, MPI_Op);
 PETSC_INTERN PetscErrorCode PetscSFLinkUnpackLeafData(PetscSF, PetscSFLink, PetscSFScope, void *, MPI_Op);
+PETSC_INTERN PetscErrorCode PetscSFLinkPackChunk_Host(PetscSF, PetscSFLink, PetscSFDirection, PetscInt, PetscInt, const void *, void *);
+PETSC_INTERN PetscErrorCode PetscSFLinkUnpackChunk_Host(PetscSF, PetscSFLink, PetscSFDirection, PetscInt, PetscInt, const void *, void *, MPI_Op);
 PETSC_INTERN PetscErrorCode PetscSFLinkFetchAndOpRemote(PetscSF, PetscSFLink, void *, MPI_Op);
 
 PETSC_INTERN PetscErrorCode PetscSFLinkScatterLocal(PetscSF, PetscSFLink, PetscSFDirection, void *, void *, MPI_Op);
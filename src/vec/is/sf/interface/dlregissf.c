@@ -18,6 +18,7 @@ PetscLogEvent PETSCSF_SectSF;
 PetscLogEvent PETSCSF_RemoteOff;
 PetscLogEvent PETSCSF_Pack;
 PetscLogEvent PETSCSF_Unpack;
+PetscLogEvent PETSCSF_AutoSelect;
 
 /*@C
   PetscSFInitializePackage - Initialize `PetscSF` package
@@ -55,6 +56,7 @@ PetscErrorCode PetscSFInitializePackage(void)
   PetscCall(PetscLogEventRegister("SFRemoteOff", PETSCSF_CLASSID, &PETSCSF_RemoteOff));
   PetscCall(PetscLogEventRegister("SFPack", PETSCSF_CLASSID, &PETSCSF_Pack));
   PetscCall(PetscLogEventRegister("SFUnpack", PETSCSF_CLASSID, &PETSCSF_Unpack));
+  PetscCall(PetscLogEventRegister("SFAutoSelect", PETSCSF_CLASSID, &PETSCSF_AutoSelect));
   /* Flag non-collective events */
   PetscCall(PetscLogEventSetCollective(PETSCSF_Pack, PETSC_FALSE));
   PetscCall(PetscLogEventSetCollective(PETSCSF_Unpack, PETSC_FALSE));
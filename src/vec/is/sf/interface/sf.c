@@ -42,7 +42,12 @@ const char *const PetscSFConcatenateRootModes[] = {"local", "shared", "global",
 + -sf_type basic                 - Use MPI persistent Isend/Irecv for communication (Default)
 . -sf_type window                - Use MPI-3 one-sided window for communication
 . -sf_type neighbor              - Use MPI-3 neighborhood collectives for communication
-- -sf_neighbor_persistent <bool> - If true, use MPI-4 persistent neighborhood collectives for communication (used along with -sf_type neighbor)
+. -sf_neighbor_persistent <bool> - If true, use MPI-4 persistent neighborhood collectives for communication (used along with -sf_type neighbor)
+. -sf_type node                  - Use MPI-3 shared memory windows for ranks on the same node and MPI Isend/Irecv for the others
+. -sf_node_size <n>              - Treat groups of n processes of a node as separate nodes (used along with -sf_type node)
+. -sf_type auto                  - Time a few broadcasts and reductions with several types and use the fastest one
+. -sf_auto_uses <n>              - Select the type after n broadcasts and reductions, 0 to select it in `PetscSFSetUp()` (used along with -sf_type auto)
+- -sf_auto_types <t1,t2,...>     - Candidate types (used along with -sf_type auto)
 
   Level: intermediate
 
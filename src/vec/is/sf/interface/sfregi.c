@@ -12,6 +12,10 @@ PETSC_INTERN PetscErrorCode PetscSFCreate_Alltoall(PetscSF);
 #if defined(PETSC_HAVE_MPI_NEIGHBORHOOD_COLLECTIVES)
 PETSC_INTERN PetscErrorCode PetscSFCreate_Neighbor(PetscSF);
 #endif
+#if defined(PETSC_HAVE_MPI_PROCESS_SHARED_MEMORY)
+PETSC_INTERN PetscErrorCode PetscSFCreate_Node(PetscSF);
+#endif
+PETSC_INTERN PetscErrorCode PetscSFCreate_Auto(PetscSF);
 
 PetscFunctionList PetscSFList;
 PetscBool         PetscSFRegisterAllCalled;
@@ -42,6 +46,10 @@ PetscErrorCode PetscSFRegisterAll(void)
 #if defined(PETSC_HAVE_MPI_NEIGHBORHOOD_COLLECTIVES)
   PetscCall(PetscSFRegister(PETSCSFNEIGHBOR, PetscSFCreate_Neighbor));
 #endif
+#if defined(PETSC_HAVE_MPI_PROCESS_SHARED_MEMORY)
+  PetscCall(PetscSFRegister(PETSCSFNODE, PetscSFCreate_Node));
+#endif
+  PetscCall(PetscSFRegister(PETSCSFAUTO, PetscSFCreate_Auto));
   PetscFunctionReturn(PETSC_SUCCESS);
 }
 
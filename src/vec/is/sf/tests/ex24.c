@@ -0,0 +1,151 @@
+static const char help[] = "Tests PetscSF types, and PetscSF basic with long remote messages sent in chunks, against PetscSF basic sending whole messages.\n\
+  -n <n>          : number of roots on each process\n\
+  -bs <bs>        : number of scalars of a unit, communicated with a contiguous MPI datatype when larger than one\n\
+  -contiguous     : leaves are contiguous, so leafdata works directly as the leaf buffer\n\n";
+
+#include <petscsf.h>
+
+/* Compare the results of an operation on the two star forests, which must be identical */
+static PetscErrorCode CheckEqual(MPI_Comm comm, const char name[], PetscInt n, const PetscScalar *a, const PetscScalar *b)
+{
+  PetscBool equal;
+
+  PetscFunctionBeginUser;
+  PetscCall(PetscArraycmp(a, b, n, &equal));
+  PetscCall(MPIU_Allreduce(MPI_IN_PLACE, &equal, 1, MPIU_BOOL, MPI_LAND, comm));
+  PetscCall(PetscPrintf(comm, "%s: %s\n", name, equal ? "identical" : "different"));
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
+
+int main(int argc, char **argv)
+{
+  PetscSF      sf, sf0;
+  PetscSFNode *iremote;
+  PetscInt    *ilocal = NULL, n = 1000, nleaves, bs = 1, nl;
+  PetscScalar *rootdata, *rootdata0, *leafdata, *leafdata0;
+  PetscMPIInt  rank, size;
+  PetscBool    contiguous = PETSC_FALSE;
+  PetscRandom  rnd;
+  MPI_Datatype unit = MPIU_SCALAR;
+  MPI_Comm     comm;
+
+  PetscFunctionBeginUser;
+  PetscCall(PetscInitialize(&argc, &argv, NULL, help));
+  comm = PETSC_COMM_WORLD;
+  PetscCallMPI(MPI_Comm_rank(comm, &rank));
+  PetscCallMPI(MPI_Comm_size(comm, &size));
+  PetscCall(PetscOptionsGetInt(NULL, NULL, "-n", &n, NULL));
+  PetscCall(PetscOptionsGetInt(NULL, NULL, "-bs", &bs, NULL));
+  PetscCall(PetscOptionsGetBool(NULL, NULL, "-contiguous", &contiguous, NULL));
+
+  /* Every process references many roots of every process, several times for most of them, so that reductions have to combine
+     values from different messages. The leaves are scattered in leafdata unless -contiguous is given */
+  nleaves = 3 * n;
+  nl      = contiguous ? nleaves : 2 * nleaves;
+  PetscCall(PetscMalloc1(nleaves, &iremote));
+  if (!contiguous) PetscCall(PetscMalloc1(nleaves, &ilocal));
+  for (PetscInt i = 0; i < nleaves; i++) {
+    iremote[i].rank  = (rank + 1 + i % size) % size;
+    iremote[i].index = (7 * i + 3 * rank) % n;
+    if (ilocal) ilocal[i] = 2 * (nleaves - 1 - i);
+  }
+  PetscCall(PetscSFCreate(comm, &sf));
+  PetscCall(PetscSFSetType(sf, PETSCSFBASIC));
+  PetscCall(PetscSFSetFromOptions(sf));
+  PetscCall(PetscSFSetGraph(sf, n, nleaves, ilocal, PETSC_COPY_VALUES, iremote, PETSC_COPY_VALUES));
+  PetscCall(PetscSFSetUp(sf));
+  /* the reference star forest is a PetscSF basic sending whole messages */
+  PetscCall(PetscSFCreate(comm, &sf0));
+  PetscCall(PetscSFSetType(sf0, PETSCSFBASIC));
+  PetscCall(PetscSFBasicSetPartitionSize(sf0, 0));
+  PetscCall(PetscSFSetGraph(sf0, n, nleaves, ilocal, PETSC_OWN_POINTER, iremote, PETSC_OWN_POINTER));
+  PetscCall(PetscSFSetUp(sf0));
+
+  if (bs > 1) {
+    PetscCallMPI(MPI_Type_contiguous((PetscMPIInt)bs, MPIU_SCALAR, &unit));
+    PetscCallMPI(MPI_Type_commit(&unit));
+  }
+  PetscCall(PetscMalloc4(n * bs, &rootdata, n * bs, &rootdata0, nl * bs, &leafdata, nl * bs, &leafdata0));
+  PetscCall(PetscRandomCreate(comm, &rnd));
+  PetscCall(PetscRandomSetFromOptions(rnd));
+
+  /* Bcast and Reduce from random data, twice so that PetscSF node reuses its shared memory windows and PetscSF auto selects its type
+     in the middle of them when run with a small -sf_auto_uses */
+  for (PetscInt k = 0; k < 8; k++) {
+    const char  *name[4] = {"Bcast with MPI_REPLACE", "Bcast with MPI_SUM", "Reduce with MPI_SUM", "Reduce with MPIU_MAX"};
+    const MPI_Op op[4]   = {MPI_REPLACE, MPI_SUM, MPI_SUM, MPIU_MAX};
+
+    for (PetscInt i = 0; i < n * bs; i++) PetscCall(PetscRandomGetValue(rnd, &rootdata[i]));
+    for (PetscInt i = 0; i < nl * bs; i++) PetscCall(PetscRandomGetValue(rnd, &leafdata[i]));
+    PetscCall(PetscArraycpy(rootdata0, rootdata, n * bs));
+    PetscCall(PetscArraycpy(leafdata0, leafdata, nl * bs));
+    if (k % 4 < 2) {
+      PetscCall(PetscSFBcastBegin(sf, unit, rootdata, leafdata, op[k % 4]));
+      PetscCall(PetscSFBcastBegin(sf0, unit, rootdata0, leafdata0, op[k % 4]));
+      PetscCall(PetscSFBcastEnd(sf0, unit, rootdata0, leafdata0, op[k % 4]));
+      PetscCall(PetscSFBcastEnd(sf, unit, rootdata, leafdata, op[k % 4]));
+      PetscCall(CheckEqual(comm, name[k % 4], nl * bs, leafdata, leafdata0));
+    } else {
+      PetscCall(PetscSFReduceBegin(sf, unit, leafdata, rootdata, op[k % 4]));
+      PetscCall(PetscSFReduceBegin(sf0, unit, leafdata0, rootdata0, op[k % 4]));
+      PetscCall(PetscSFReduceEnd(sf0, unit, leafdata0, rootdata0, op[k % 4]));
+      PetscCall(PetscSFReduceEnd(sf, unit, leafdata, rootdata, op[k % 4]));
+      PetscCall(CheckEqual(comm, name[k % 4], n * bs, rootdata, rootdata0));
+    }
+  }
+
+  /* Two operations in flight at the same time on the same star forest, with different links */
+  for (PetscInt i = 0; i < n * bs; i++) PetscCall(PetscRandomGetValue(rnd, &rootdata[i]));
+  PetscCall(PetscArraycpy(rootdata0, rootdata, n * bs));
+  PetscCall(PetscArrayzero(leafdata, nl * bs));
+  PetscCall(PetscArrayzero(leafdata0, nl * bs));
+  PetscCall(PetscSFBcastBegin(sf, unit, rootdata, leafdata, MPI_REPLACE));
+  PetscCall(PetscSFBcastBegin(sf, unit, rootdata0, leafdata0, MPI_REPLACE));
+  PetscCall(PetscSFBcastEnd(sf, unit, rootdata0, leafdata0, MPI_REPLACE));
+  PetscCall(PetscSFBcastEnd(sf, unit, rootdata, leafdata, MPI_REPLACE));
+  PetscCall(CheckEqual(comm, "Concurrent Bcast", nl * bs, leafdata, leafdata0));
+
+  if (bs > 1) PetscCallMPI(MPI_Type_free(&unit));
+  PetscCall(PetscRandomDestroy(&rnd));
+  PetscCall(PetscFree4(rootdata, rootdata0, leafdata, leafdata0));
+  PetscCall(PetscSFDestroy(&sf));
+  PetscCall(PetscSFDestroy(&sf0));
+  PetscCall(PetscFinalize());
+  return 0;
+}
+
+/*TEST
+
+  test:
+    requires: !complex
+    nsize: {{2 3}}
+    args: -sf_basic_partition_size {{8 100 2000}} -contiguous {{0 1}}
+    output_file: output/ex24_1.out
+
+  test:
+    suffix: bs
+    requires: !complex
+    nsize: 3
+    args: -sf_basic_partition_size 100 -bs 3
+    output_file: output/ex24_1.out
+
+  testset:
+    requires: !complex defined(PETSC_HAVE_MPI_PROCESS_SHARED_MEMORY)
+    output_file: output/ex24_1.out
+
+    test:
+      suffix: types
+      nsize: {{1 2 3}}
+      args: -n 100 -sf_type {{basic node auto}} -contiguous {{0 1}}
+
+    test:
+      suffix: types_bs
+      nsize: 3
+      args: -n 100 -sf_type {{node auto}} -bs 3
+
+    test:
+      suffix: auto_uses
+      nsize: 3
+      args: -n 100 -sf_type auto -sf_auto_uses {{0 3}}
+
+TEST*/
@@ -0,0 +1,115 @@
+static const char help[] = "Tests PetscSF node with the processes of a node split into groups, reusing its shared memory windows and with several links in flight.\n\
+  -n <n> : number of roots on each process\n\n";
+
+#include <petscsf.h>
+
+/* Value of root i on process r */
+static inline PetscReal RootValue(PetscMPIInt r, PetscInt i)
+{
+  return (PetscReal)(1000 * r + i);
+}
+
+/* Check the leaves hold scale times the value of the roots they reference and the entries in between are untouched */
+static PetscErrorCode CheckLeaves(PetscInt nleaves, const PetscSFNode *iremote, const PetscReal *leafdata, PetscReal scale, PetscBool *ok)
+{
+  PetscFunctionBeginUser;
+  for (PetscInt l = 0; l < nleaves; l++) *ok = (PetscBool)(*ok && leafdata[2 * l + 1] == scale * RootValue((PetscMPIInt)iremote[l].rank, iremote[l].index) && leafdata[2 * l] == -1.0);
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
+
+int main(int argc, char **argv)
+{
+  PetscSF            sf;
+  PetscSFNode       *iremote;
+  PetscInt          *ilocal, n = 100, nleaves, *degree;
+  PetscReal         *rootdata, *rootdata2, *leafdata, *leafdata2;
+  const PetscSFNode *gremote;
+  PetscMPIInt        rank, size;
+  PetscBool          ok = PETSC_TRUE;
+  MPI_Comm           comm;
+
+  PetscFunctionBeginUser;
+  PetscCall(PetscInitialize(&argc, &argv, NULL, help));
+  comm = PETSC_COMM_WORLD;
+  PetscCallMPI(MPI_Comm_rank(comm, &rank));
+  PetscCallMPI(MPI_Comm_size(comm, &size));
+  PetscCall(PetscOptionsGetInt(NULL, NULL, "-n", &n, NULL));
+
+  /* Every process references roots of every process including itself, several times for most of them, so that with -sf_node_size
+     each process has peers both in its group, served through the window, and outside of it. The leaves are at odd locations */
+  nleaves = 3 * n;
+  PetscCall(PetscMalloc1(nleaves, &iremote));
+  PetscCall(PetscMalloc1(nleaves, &ilocal));
+  for (PetscInt l = 0; l < nleaves; l++) {
+    iremote[l].rank  = (rank + l) % size;
+    iremote[l].index = (7 * l + 3 * rank) % n;
+    ilocal[l]        = 2 * l + 1;
+  }
+  PetscCall(PetscSFCreate(comm, &sf));
+  PetscCall(PetscSFSetType(sf, PETSCSFNODE));
+  PetscCall(PetscSFSetFromOptions(sf));
+  PetscCall(PetscSFSetGraph(sf, n, nleaves, ilocal, PETSC_OWN_POINTER, iremote, PETSC_OWN_POINTER));
+  PetscCall(PetscSFSetUp(sf));
+  PetscCall(PetscSFGetGraph(sf, NULL, NULL, NULL, &gremote));
+  PetscCall(PetscMalloc4(n, &rootdata, n, &rootdata2, 2 * nleaves, &leafdata, 2 * nleaves, &leafdata2));
+
+  /* The number of leaves referencing each root, which a reduction of ones must give */
+  PetscCall(PetscCalloc1(n, &degree));
+  for (PetscMPIInt r = 0; r < size; r++)
+    for (PetscInt l = 0; l < nleaves; l++)
+      if ((r + l) % size == rank) degree[(7 * l + 3 * r) % n]++;
+
+  /* Several rounds, so that the windows and their counters are reused */
+  for (PetscInt k = 0; k < 3; k++) {
+    for (PetscInt i = 0; i < n; i++) rootdata[i] = (k + 1) * RootValue(rank, i);
+    for (PetscInt l = 0; l < 2 * nleaves; l++) leafdata[l] = -1.0;
+    PetscCall(PetscSFBcastBegin(sf, MPIU_REAL, rootdata, leafdata, MPI_REPLACE));
+    PetscCall(PetscSFBcastEnd(sf, MPIU_REAL, rootdata, leafdata, MPI_REPLACE));
+    PetscCall(CheckLeaves(nleaves, gremote, leafdata, k + 1, &ok));
+
+    for (PetscInt l = 0; l < nleaves; l++) leafdata[2 * l + 1] = 1.0;
+    PetscCall(PetscArrayzero(rootdata, n));
+    PetscCall(PetscSFReduceBegin(sf, MPIU_REAL, leafdata, rootdata, MPI_SUM));
+    PetscCall(PetscSFReduceEnd(sf, MPIU_REAL, leafdata, rootdata, MPI_SUM));
+    for (PetscInt i = 0; i < n; i++) ok = (PetscBool)(ok && rootdata[i] == degree[i]);
+  }
+  PetscCall(MPIU_Allreduce(MPI_IN_PLACE, &ok, 1, MPIU_BOOL, MPI_LAND, comm));
+  PetscCall(PetscPrintf(comm, "Bcast and Reduce with reused windows: %s\n", ok ? "correct" : "wrong"));
+
+  /* Two broadcasts in flight at the same time on the same star forest, with different links and thus different windows */
+  for (PetscInt i = 0; i < n; i++) {
+    rootdata[i]  = RootValue(rank, i);
+    rootdata2[i] = 2 * RootValue(rank, i);
+  }
+  for (PetscInt l = 0; l < 2 * nleaves; l++) leafdata[l] = leafdata2[l] = -1.0;
+  PetscCall(PetscSFBcastBegin(sf, MPIU_REAL, rootdata, leafdata, MPI_REPLACE));
+  PetscCall(PetscSFBcastBegin(sf, MPIU_REAL, rootdata2, leafdata2, MPI_REPLACE));
+  PetscCall(PetscSFBcastEnd(sf, MPIU_REAL, rootdata2, leafdata2, MPI_REPLACE));
+  PetscCall(PetscSFBcastEnd(sf, MPIU_REAL, rootdata, leafdata, MPI_REPLACE));
+  PetscCall(CheckLeaves(nleaves, gremote, leafdata, 1, &ok));
+  PetscCall(CheckLeaves(nleaves, gremote, leafdata2, 2, &ok));
+  PetscCall(MPIU_Allreduce(MPI_IN_PLACE, &ok, 1, MPIU_BOOL, MPI_LAND, comm));
+  PetscCall(PetscPrintf(comm, "Concurrent Bcast: %s\n", ok ? "correct" : "wrong"));
+
+  PetscCall(PetscFree(degree));
+  PetscCall(PetscFree4(rootdata, rootdata2, leafdata, leafdata2));
+  PetscCall(PetscSFDestroy(&sf));
+  PetscCall(PetscFinalize());
+  return 0;
+}
+
+/*TEST
+
+  testset:
+    requires: defined(PETSC_HAVE_MPI_PROCESS_SHARED_MEMORY)
+    output_file: output/ex25_1.out
+
+    test:
+      nsize: {{1 3}}
+
+    test:
+      suffix: split
+      nsize: 4
+      args: -sf_node_size {{1 2 3}}
+
+TEST*/
@@ -0,0 +1,167 @@
+static const char help[] = "Tests broadcasts and reductions on several PetscSF with a single round of messages against the operations done one by one.\n\
+  -n <n> : number of roots on each process\n\n";
+
+#include <petscsf.h>
+
+/* Compare the results of the batch with the results of the operations done one by one, which must be identical */
+static PetscErrorCode CheckEqual(MPI_Comm comm, const char name[], PetscInt n, const void *a[], const void *b[], const size_t bytes[])
+{
+  PetscBool equal = PETSC_TRUE, eq;
+
+  PetscFunctionBeginUser;
+  for (PetscInt i = 0; i < n; i++) {
+    PetscCall(PetscMemcmp(a[i], b[i], bytes[i], &eq));
+    equal = (PetscBool)(equal && eq);
+  }
+  PetscCall(MPIU_Allreduce(MPI_IN_PLACE, &equal, 1, MPIU_BOOL, MPI_LAND, comm));
+  PetscCall(PetscPrintf(comm, "%s: %s\n", name, equal ? "identical" : "different"));
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
+
+int main(int argc, char **argv)
+{
+  PetscSF      sf[3];
+  PetscSFNode *iremote;
+  PetscInt    *ilocal, n = 50, nleaves[3], nroots[3], bs[3] = {1, 1, 3}, *iroot, *ileaf, *iroot0, *ileaf0;
+  PetscScalar *sroot[2], *sleaf[2], *sroot0[2], *sleaf0[2];
+  void        *rootdata[3], *leafdata[3], *rootdata0[3], *leafdata0[3];
+  size_t       rootbytes[3], leafbytes[3];
+  MPI_Datatype unit[3] = {MPIU_SCALAR, MPIU_INT, MPI_DATATYPE_NULL};
+  PetscMPIInt  rank, size;
+  PetscRandom  rnd;
+  MPI_Comm     comm;
+
+  PetscFunctionBeginUser;
+  PetscCall(PetscInitialize(&argc, &argv, NULL, help));
+  comm = PETSC_COMM_WORLD;
+  PetscCallMPI(MPI_Comm_rank(comm, &rank));
+  PetscCallMPI(MPI_Comm_size(comm, &size));
+  PetscCall(PetscOptionsGetInt(NULL, NULL, "-n", &n, NULL));
+  PetscCallMPI(MPI_Type_contiguous(3, MPIU_SCALAR, &unit[2]));
+  PetscCallMPI(MPI_Type_commit(&unit[2]));
+
+  /* Three star forests with different neighbors: every process references roots of every process, several times for most of them,
+     of its right neighbor only, or of its left neighbor and itself, with leaves scattered in leafdata */
+  for (PetscInt k = 0; k < 3; k++) {
+    nroots[k]  = n + k;
+    nleaves[k] = k == 0 ? 3 * n : n;
+    PetscCall(PetscMalloc1(nleaves[k], &iremote));
+    PetscCall(PetscMalloc1(nleaves[k], &ilocal));
+    for (PetscInt i = 0; i < nleaves[k]; i++) {
+      if (k == 0) iremote[i].rank = (rank + 1 + i % size) % size;
+      else if (k == 1) iremote[i].rank = (rank + 1) % size;
+      else iremote[i].rank = (rank + size - i % 2) % size;
+      iremote[i].index = (7 * i + 3 * rank) % nroots[k];
+      ilocal[i]        = 2 * (nleaves[k] - 1 - i);
+    }
+    PetscCall(PetscSFCreate(comm, &sf[k]));
+    PetscCall(PetscSFSetFromOptions(sf[k]));
+    PetscCall(PetscSFSetGraph(sf[k], nroots[k], nleaves[k], ilocal, PETSC_OWN_POINTER, iremote, PETSC_OWN_POINTER));
+    PetscCall(PetscSFSetUp(sf[k]));
+  }
+  for (PetscInt k = 0; k < 2; k++) {
+    PetscInt j = 2 * k; /* the scalar data is for the first and last star forests */
+
+    PetscCall(PetscMalloc4(nroots[j] * bs[j], &sroot[k], 2 * nleaves[j] * bs[j], &sleaf[k], nroots[j] * bs[j], &sroot0[k], 2 * nleaves[j] * bs[j], &sleaf0[k]));
+    rootdata[j]  = sroot[k];
+    leafdata[j]  = sleaf[k];
+    rootdata0[j] = sroot0[k];
+    leafdata0[j] = sleaf0[k];
+    rootbytes[j] = nroots[j] * bs[j] * sizeof(PetscScalar);
+    leafbytes[j] = 2 * nleaves[j] * bs[j] * sizeof(PetscScalar);
+  }
+  PetscCall(PetscMalloc4(nroots[1], &iroot, 2 * nleaves[1], &ileaf, nroots[1], &iroot0, 2 * nleaves[1], &ileaf0));
+  rootdata[1]  = iroot;
+  leafdata[1]  = ileaf;
+  rootdata0[1] = iroot0;
+  leafdata0[1] = ileaf0;
+  rootbytes[1] = nroots[1] * sizeof(PetscInt);
+  leafbytes[1] = 2 * nleaves[1] * sizeof(PetscInt);
+  PetscCall(PetscRandomCreate(comm, &rnd));
+  PetscCall(PetscRandomSetFromOptions(rnd));
+
+  for (PetscInt t = 0; t < 4; t++) {
+    const char  *name[4] = {"Bcast with MPI_REPLACE", "Bcast with MPI_SUM", "Reduce with MPI_SUM", "Reduce with MPIU_MAX"};
+    const MPI_Op op[4]   = {MPI_REPLACE, MPI_SUM, MPI_SUM, MPIU_MAX};
+
+    for (PetscInt k = 0; k < 2; k++) {
+      PetscInt j = 2 * k;
+
+      for (PetscInt i = 0; i < nroots[j] * bs[j]; i++) PetscCall(PetscRandomGetValue(rnd, &sroot[k][i]));
+      for (PetscInt i = 0; i < 2 * nleaves[j] * bs[j]; i++) PetscCall(PetscRandomGetValue(rnd, &sleaf[k][i]));
+    }
+    for (PetscInt i = 0; i < nroots[1]; i++) iroot[i] = (13 * i + 5 * rank + t) % 17;
+    for (PetscInt i = 0; i < 2 * nleaves[1]; i++) ileaf[i] = (11 * i + 3 * rank + t) % 19;
+    for (PetscInt k = 0; k < 3; k++) {
+      PetscCall(PetscMemcpy(rootdata0[k], rootdata[k], rootbytes[k]));
+      PetscCall(PetscMemcpy(leafdata0[k], leafdata[k], leafbytes[k]));
+    }
+    if (t < 2) {
+      PetscCall(PetscSFBcastBatchBegin(3, sf, unit, (const void *const *)rootdata, leafdata, op[t]));
+      PetscCall(PetscSFBcastBatchEnd(3, sf, unit, (const void *const *)rootdata, leafdata, op[t]));
+      for (PetscInt k = 0; k < 3; k++) {
+        PetscCall(PetscSFBcastBegin(sf[k], unit[k], rootdata0[k], leafdata0[k], op[t]));
+        PetscCall(PetscSFBcastEnd(sf[k], unit[k], rootdata0[k], leafdata0[k], op[t]));
+      }
+      PetscCall(CheckEqual(comm, name[t], 3, (const void **)leafdata, (const void **)leafdata0, leafbytes));
+    } else {
+      PetscCall(PetscSFReduceBatchBegin(3, sf, unit, (const void *const *)leafdata, rootdata, op[t]));
+      PetscCall(PetscSFReduceBatchEnd(3, sf, unit, (const void *const *)leafdata, rootdata, op[t]));
+      for (PetscInt k = 0; k < 3; k++) {
+        PetscCall(PetscSFReduceBegin(sf[k], unit[k], leafdata0[k], rootdata0[k], op[t]));
+        PetscCall(PetscSFReduceEnd(sf[k], unit[k], leafdata0[k], rootdata0[k], op[t]));
+      }
+      PetscCall(CheckEqual(comm, name[t], 3, (const void **)rootdata, (const void **)rootdata0, rootbytes));
+    }
+  }
+
+  /* The plan of the batch, kept from the broadcasts above, must not be used once the graph of one of the star forests changes */
+  PetscCall(PetscMalloc1(nleaves[1], &iremote));
+  PetscCall(PetscMalloc1(nleaves[1], &ilocal));
+  for (PetscInt i = 0; i < nleaves[1]; i++) {
+    iremote[i].rank  = (rank + size - 1) % size;
+    iremote[i].index = (5 * i + rank) % nroots[1];
+    ilocal[i]        = 2 * i + 1;
+  }
+  PetscCall(PetscSFSetGraph(sf[1], nroots[1], nleaves[1], ilocal, PETSC_OWN_POINTER, iremote, PETSC_OWN_POINTER));
+  PetscCall(PetscSFSetUp(sf[1]));
+  for (PetscInt k = 0; k < 3; k++) PetscCall(PetscMemcpy(leafdata0[k], leafdata[k], leafbytes[k]));
+  PetscCall(PetscSFBcastBatchBegin(3, sf, unit, (const void *const *)rootdata, leafdata, MPI_REPLACE));
+  PetscCall(PetscSFBcastBatchEnd(3, sf, unit, (const void *const *)rootdata, leafdata, MPI_REPLACE));
+  for (PetscInt k = 0; k < 3; k++) {
+    PetscCall(PetscSFBcastBegin(sf[k], unit[k], rootdata[k], leafdata0[k], MPI_REPLACE));
+    PetscCall(PetscSFBcastEnd(sf[k], unit[k], rootdata[k], leafdata0[k], MPI_REPLACE));
+  }
+  PetscCall(CheckEqual(comm, "Bcast after a new graph", 3, (const void **)leafdata, (const void **)leafdata0, leafbytes));
+
+  PetscCallMPI(MPI_Type_free(&unit[2]));
+  PetscCall(PetscRandomDestroy(&rnd));
+  for (PetscInt k = 0; k < 2; k++) PetscCall(PetscFree4(sroot[k], sleaf[k], sroot0[k], sleaf0[k]));
+  PetscCall(PetscFree4(iroot, ileaf, iroot0, ileaf0));
+  for (PetscInt k = 0; k < 3; k++) PetscCall(PetscSFDestroy(&sf[k]));
+  PetscCall(PetscFinalize());
+  return 0;
+}
+
+/*TEST
+
+  testset:
+    requires: !complex
+    output_file: output/ex26_1.out
+
+    test:
+      nsize: {{1 2 3 4}}
+
+    # An odd number of MPIU_INT entries before the scalars of the last star forest in the fused messages
+    test:
+      suffix: odd
+      nsize: 3
+      args: -n 25
+
+    test:
+      suffix: neighbor
+      nsize: 3
+      requires: defined(PETSC_HAVE_MPI_NEIGHBORHOOD_COLLECTIVES)
+      args: -sf_type neighbor
+
+TEST*/
@@ -0,0 +1,108 @@
+static const char help[] = "Tests when PetscSF auto switches to the type it selects, and that it selects one of the candidate types.\n\
+  -n <n>              : number of roots on each process\n\
+  -sf_auto_uses <n>   : number of broadcasts and reductions before the selection, as given to the star forest\n\
+  -sf_auto_types <t>  : candidate types, as given to the star forest\n\n";
+
+#include <petscsf.h>
+
+/* Whether the star forest still is of type PETSCSFAUTO, that is has not selected its type yet */
+static PetscErrorCode IsAuto(PetscSF sf, PetscBool *isauto)
+{
+  PetscFunctionBeginUser;
+  PetscCall(PetscObjectTypeCompare((PetscObject)sf, PETSCSFAUTO, isauto));
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
+
+int main(int argc, char **argv)
+{
+  PetscSF      sf;
+  PetscSFNode *iremote;
+  PetscInt     n = 100, nuses = 10, ntypes = 8, nleaves;
+  PetscReal   *rootdata, *rootdata2, *leafdata, *leafdata2;
+  PetscMPIInt  rank, size;
+  PetscBool    isauto, switched = PETSC_TRUE, candidate = PETSC_FALSE, flg;
+  char        *types[8];
+  const char  *defaults[] = {PETSCSFBASIC, PETSCSFNEIGHBOR, PETSCSFNODE};
+  MPI_Comm     comm;
+
+  PetscFunctionBeginUser;
+  PetscCall(PetscInitialize(&argc, &argv, NULL, help));
+  comm = PETSC_COMM_WORLD;
+  PetscCallMPI(MPI_Comm_rank(comm, &rank));
+  PetscCallMPI(MPI_Comm_size(comm, &size));
+  PetscCall(PetscOptionsGetInt(NULL, NULL, "-n", &n, NULL));
+  PetscCall(PetscOptionsGetInt(NULL, NULL, "-sf_auto_uses", &nuses, NULL));
+  PetscCall(PetscOptionsGetStringArray(NULL, NULL, "-sf_auto_types", types, &ntypes, &flg));
+  if (!flg) ntypes = 0;
+
+  /* Every process references all the roots of its right neighbor */
+  nleaves = n;
+  PetscCall(PetscMalloc1(nleaves, &iremote));
+  for (PetscInt l = 0; l < nleaves; l++) {
+    iremote[l].rank  = (rank + 1) % size;
+    iremote[l].index = l;
+  }
+  PetscCall(PetscSFCreate(comm, &sf));
+  PetscCall(PetscSFSetType(sf, PETSCSFAUTO));
+  PetscCall(PetscSFSetFromOptions(sf));
+  PetscCall(PetscSFSetGraph(sf, n, nleaves, NULL, PETSC_OWN_POINTER, iremote, PETSC_OWN_POINTER));
+  PetscCall(PetscSFSetUp(sf));
+  PetscCall(PetscCalloc4(n, &rootdata, n, &rootdata2, nleaves, &leafdata, nleaves, &leafdata2));
+
+  /* The type is selected at the first broadcast or reduction started after nuses of them, unless another one is still in flight then,
+     or in PetscSFSetUp() when nuses is 0 */
+  if (nuses > 0) {
+    for (PetscInt k = 0; k < nuses - 1; k++) {
+      PetscCall(IsAuto(sf, &isauto));
+      switched = (PetscBool)(switched && isauto);
+      if (k % 2) {
+        PetscCall(PetscSFReduceBegin(sf, MPIU_REAL, leafdata, rootdata, MPI_SUM));
+        PetscCall(PetscSFReduceEnd(sf, MPIU_REAL, leafdata, rootdata, MPI_SUM));
+      } else {
+        PetscCall(PetscSFBcastBegin(sf, MPIU_REAL, rootdata, leafdata, MPI_REPLACE));
+        PetscCall(PetscSFBcastEnd(sf, MPIU_REAL, rootdata, leafdata, MPI_REPLACE));
+      }
+    }
+    /* The last use and the first one after it overlap, which must postpone the selection to the next one */
+    PetscCall(PetscSFBcastBegin(sf, MPIU_REAL, rootdata, leafdata, MPI_REPLACE));
+    PetscCall(PetscSFBcastBegin(sf, MPIU_REAL, rootdata2, leafdata2, MPI_REPLACE));
+    PetscCall(PetscSFBcastEnd(sf, MPIU_REAL, rootdata2, leafdata2, MPI_REPLACE));
+    PetscCall(PetscSFBcastEnd(sf, MPIU_REAL, rootdata, leafdata, MPI_REPLACE));
+    PetscCall(IsAuto(sf, &isauto));
+    switched = (PetscBool)(switched && isauto);
+    PetscCall(PetscSFReduceBegin(sf, MPIU_REAL, leafdata, rootdata, MPI_SUM));
+    PetscCall(PetscSFReduceEnd(sf, MPIU_REAL, leafdata, rootdata, MPI_SUM));
+  }
+  PetscCall(IsAuto(sf, &isauto));
+  switched = (PetscBool)(switched && !isauto);
+  PetscCall(PetscPrintf(comm, "Type selected when expected: %s\n", switched ? "yes" : "no"));
+
+  /* The selected type is one of the candidates given, or of the default ones */
+  for (PetscInt i = 0; i < (ntypes ? ntypes : 3); i++) {
+    PetscCall(PetscObjectTypeCompare((PetscObject)sf, ntypes ? types[i] : defaults[i], &flg));
+    candidate = (PetscBool)(candidate || flg);
+  }
+  PetscCall(PetscPrintf(comm, "Type selected among the candidates: %s\n", candidate ? "yes" : "no"));
+
+  for (PetscInt i = 0; i < ntypes; i++) PetscCall(PetscFree(types[i]));
+  PetscCall(PetscFree4(rootdata, rootdata2, leafdata, leafdata2));
+  PetscCall(PetscSFDestroy(&sf));
+  PetscCall(PetscFinalize());
+  return 0;
+}
+
+/*TEST
+
+  test:
+    nsize: {{1 2 3}}
+    args: -sf_auto_uses {{0 1 3}}
+    output_file: output/ex27_1.out
+
+  test:
+    suffix: types
+    nsize: 4
+    requires: defined(PETSC_HAVE_MPI_ONE_SIDED)
+    args: -sf_auto_uses 5 -sf_auto_rounds 2 -sf_auto_types basic,window
+    output_file: output/ex27_1.out
+
+TEST*/
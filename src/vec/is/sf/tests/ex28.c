@@ -0,0 +1,98 @@
+static const char help[] = "Tests PetscSF pack and unpack of structured patterns of roots and leaves, such as ghost columns and blocks of structured grids.\n\
+  -pattern <p> : 0 for a column of the grid of roots (fixed stride), 1 for a 2D block, 2 for a 3D block\n\
+  -bs <bs>     : number of reals of a unit, communicated with a contiguous MPI datatype when larger than one\n\n";
+
+#include <petscsf.h>
+
+/* Value of component c of root i on process r */
+static inline PetscReal RootValue(PetscMPIInt r, PetscInt i, PetscInt c)
+{
+  return (PetscReal)(1000 * r + 10 * i + c);
+}
+
+int main(int argc, char **argv)
+{
+  PetscSF      sf;
+  PetscSFNode *iremote;
+  PetscInt    *ilocal, nx = 7, ny = 5, nz = 3, n, nleaves = 0, pattern = 0, bs = 1, *ridx;
+  PetscReal   *rootdata, *leafdata;
+  PetscMPIInt  rank, size, q;
+  PetscBool    ok = PETSC_TRUE;
+  MPI_Datatype unit = MPIU_REAL;
+  MPI_Comm     comm;
+
+  PetscFunctionBeginUser;
+  PetscCall(PetscInitialize(&argc, &argv, NULL, help));
+  comm = PETSC_COMM_WORLD;
+  PetscCallMPI(MPI_Comm_rank(comm, &rank));
+  PetscCallMPI(MPI_Comm_size(comm, &size));
+  PetscCall(PetscOptionsGetInt(NULL, NULL, "-pattern", &pattern, NULL));
+  PetscCall(PetscOptionsGetInt(NULL, NULL, "-bs", &bs, NULL));
+
+  /* Every process references, on its right neighbor, roots forming a column, a 2D block or a 3D block of a nx*ny*nz grid. Its leaves
+     are at a fixed stride of 2, so that both the roots and the leaves have patterns to pack and unpack */
+  n = nx * ny * nz;
+  q = (rank + 1) % size;
+  PetscCall(PetscMalloc1(n, &ridx));
+  for (PetscInt k = 0; k < nz; k++)
+    for (PetscInt j = 0; j < ny; j++)
+      for (PetscInt i = 0; i < nx; i++) {
+        if ((pattern == 0 && i == 2 && k == 1) || (pattern == 1 && i >= 1 && i < 4 && j >= 2 && k == 0) || (pattern == 2 && i >= 3 && j >= 1 && j < 3 && k >= 1)) ridx[nleaves++] = i + nx * (j + ny * k);
+      }
+  PetscCall(PetscMalloc1(nleaves, &iremote));
+  PetscCall(PetscMalloc1(nleaves, &ilocal));
+  for (PetscInt l = 0; l < nleaves; l++) {
+    iremote[l].rank  = q;
+    iremote[l].index = ridx[l];
+    ilocal[l]        = 2 * l + 1;
+  }
+  PetscCall(PetscSFCreate(comm, &sf));
+  PetscCall(PetscSFSetFromOptions(sf));
+  PetscCall(PetscSFSetGraph(sf, n, nleaves, ilocal, PETSC_OWN_POINTER, iremote, PETSC_OWN_POINTER));
+  PetscCall(PetscSFSetUp(sf));
+
+  if (bs > 1) {
+    PetscCallMPI(MPI_Type_contiguous((PetscMPIInt)bs, MPIU_REAL, &unit));
+    PetscCallMPI(MPI_Type_commit(&unit));
+  }
+  PetscCall(PetscMalloc2(n * bs, &rootdata, 2 * nleaves * bs, &leafdata));
+
+  /* Broadcast: the referenced entries land at the odd leaves, the even ones are untouched */
+  for (PetscInt i = 0; i < n; i++)
+    for (PetscInt c = 0; c < bs; c++) rootdata[i * bs + c] = RootValue(rank, i, c);
+  for (PetscInt l = 0; l < 2 * nleaves * bs; l++) leafdata[l] = -1.0;
+  PetscCall(PetscSFBcastBegin(sf, unit, rootdata, leafdata, MPI_REPLACE));
+  PetscCall(PetscSFBcastEnd(sf, unit, rootdata, leafdata, MPI_REPLACE));
+  for (PetscInt l = 0; l < nleaves; l++)
+    for (PetscInt c = 0; c < bs; c++) ok = (PetscBool)(ok && leafdata[(2 * l + 1) * bs + c] == RootValue(q, ridx[l], c) && leafdata[2 * l * bs + c] == -1.0);
+  PetscCall(MPIU_Allreduce(MPI_IN_PLACE, &ok, 1, MPIU_BOOL, MPI_LAND, comm));
+  PetscCall(PetscPrintf(comm, "Bcast with MPI_REPLACE: %s\n", ok ? "correct" : "wrong"));
+
+  /* Reduction: each referenced root is added the value of the only leaf referencing it, that of its left neighbor */
+  PetscCall(PetscSFReduceBegin(sf, unit, leafdata, rootdata, MPI_SUM));
+  PetscCall(PetscSFReduceEnd(sf, unit, leafdata, rootdata, MPI_SUM));
+  for (PetscInt i = 0, l = 0; i < n; i++) {
+    PetscBool referenced = (PetscBool)(l < nleaves && ridx[l] == i);
+
+    for (PetscInt c = 0; c < bs; c++) ok = (PetscBool)(ok && rootdata[i * bs + c] == RootValue(rank, i, c) * (referenced ? 2 : 1));
+    if (referenced) l++;
+  }
+  PetscCall(MPIU_Allreduce(MPI_IN_PLACE, &ok, 1, MPIU_BOOL, MPI_LAND, comm));
+  PetscCall(PetscPrintf(comm, "Reduce with MPI_SUM: %s\n", ok ? "correct" : "wrong"));
+
+  if (bs > 1) PetscCallMPI(MPI_Type_free(&unit));
+  PetscCall(PetscFree2(rootdata, leafdata));
+  PetscCall(PetscFree(ridx));
+  PetscCall(PetscSFDestroy(&sf));
+  PetscCall(PetscFinalize());
+  return 0;
+}
+
+/*TEST
+
+  test:
+    nsize: {{1 3}}
+    args: -pattern {{0 1 2}} -bs {{1 2 3 4 5 8}}
+    output_file: output/ex28_1.out
+
+TEST*/
@@ -14,7 +14,7 @@ int main(int argc, char **args)
   PetscScalar v;
   Vec         u;
   PetscViewer viewer;
-  PetscBool   vstage2, vstage3, mpiio_use, isbinary = PETSC_FALSE;
+  PetscBool   vstage2, vstage3, mpiio_use, isbinary = PETSC_FALSE, usemmap = PETSC_FALSE, isseq;
 #if defined(PETSC_HAVE_HDF5)
   PetscBool ishdf5 = PETSC_FALSE;
 #endif
@@ -36,6 +36,7 @@ int main(int argc, char **args)
   PetscCall(PetscOptionsGetBool(NULL, NULL, "-adios", &isadios, NULL));
 #endif
   PetscCall(PetscOptionsGetBool(NULL, NULL, "-mpiio", &mpiio_use, NULL));
+  PetscCall(PetscOptionsGetBool(NULL, NULL, "-viewer_binary_mmap", &usemmap, NULL));
   PetscCall(PetscOptionsGetBool(NULL, NULL, "-sizes_set", &vstage2, NULL));
   PetscCall(PetscOptionsGetBool(NULL, NULL, "-type_set", &vstage3, NULL));
 
@@ -135,6 +136,14 @@ int main(int argc, char **args)
   PetscCall(VecLoad(u, viewer));
   PetscCall(PetscViewerDestroy(&viewer));
   PetscCall(PetscLogEventEnd(VECTOR_READ, 0, 0, 0, 0));
+  /* a VECSEQ vector uses the mapped file exactly on big-endian systems, whose byte order is that of the file */
+  PetscCall(PetscObjectTypeCompare((PetscObject)u, VECSEQ, &isseq));
+  if (isbinary && usemmap && isseq) {
+    PetscObject map;
+
+    PetscCall(PetscObjectQuery((PetscObject)u, "PetscViewerBinaryMMap", &map));
+    PetscCheck(!map == !PetscBinaryBigEndian(), PETSC_COMM_SELF, PETSC_ERR_PLIB, "The file is %s on a %s-endian system", map ? "mapped" : "not mapped", PetscBinaryBigEndian() ? "big" : "little");
+  }
   PetscCall(VecView(u, PETSC_VIEWER_STDOUT_WORLD));
   PetscCall(VecGetArrayRead(u, &values));
   PetscCall(VecGetLocalSize(u, &ldim));
@@ -181,4 +190,8 @@ int main(int argc, char **args)
        nsize: 4
        args: -hdf5 -sizes_set
 
+     test:
+       suffix: mmap
+       args: -binary -viewer_binary_mmap
+
 TEST*/
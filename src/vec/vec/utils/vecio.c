@@ -6,7 +6,7 @@
 
 #include <petscsys.h>
 #include <petscvec.h> /*I  "petscvec.h"  I*/
-#include <petsc/private/vecimpl.h>
+#include <../src/vec/vec/impls/dvecimpl.h>
 #include <petsc/private/viewerimpl.h>
 #include <petsclayouthdf5.h>
 
@@ -62,9 +62,9 @@ PetscErrorCode VecView_Binary(Vec vec, PetscViewer viewer)
 
 static PetscErrorCode VecLoad_Binary(Vec vec, PetscViewer viewer)
 {
-  PetscBool    skipHeader, flg;
+  PetscBool    skipHeader, flg, isseq;
   PetscInt     tr[2], rows, N, n, s, bs;
-  PetscScalar *array;
+  PetscScalar *array, *mapped = NULL;
   PetscLayout  map;
 
   PetscFunctionBegin;
@@ -100,6 +100,18 @@ static PetscErrorCode VecLoad_Binary(Vec vec, PetscViewer viewer)
   PetscCall(VecGetOwnershipRange(vec, &s, NULL));
   PetscCheck(N == rows, PETSC_COMM_SELF, PETSC_ERR_FILE_UNEXPECTED, "Vector in file different size (%" PetscInt_FMT ") than input vector (%" PetscInt_FMT ")", rows, N);
 
+  /* use the vector values in the file mapped with -viewer_binary_mmap */
+  PetscCall(PetscObjectTypeCompare((PetscObject)vec, VECSEQ, &isseq));
+  if (isseq && !((Vec_Seq *)vec->data)->unplacedarray) PetscCall(PetscViewerBinaryReadMMap_Private(viewer, n, PETSC_SCALAR, (void **)&mapped, (PetscObject)vec));
+  if (mapped) {
+    Vec_Seq *x = (Vec_Seq *)vec->data;
+
+    PetscCall(PetscFree(x->array_allocated));
+    x->array = mapped;
+    PetscCall(PetscObjectStateIncrease((PetscObject)vec));
+    PetscFunctionReturn(PETSC_SUCCESS);
+  }
+
   /* read vector values */
   PetscCall(VecGetArray(vec, &array));
   PetscCall(PetscViewerBinaryReadAll(viewer, array, n, s, N, PETSC_SCALAR));